@@ -25,6 +25,12 @@ extern asn_TYPE_descriptor_t asn_DEF_BIT_STRING;
 asn_struct_print_f BIT_STRING_print;	/* Human-readable output */
 asn_constr_check_f BIT_STRING_constraint;
 xer_type_encoder_f BIT_STRING_encode_xer;
+jer_type_decoder_f BIT_STRING_decode_jer;
+jer_type_encoder_f BIT_STRING_encode_jer;
+oer_type_decoder_f BIT_STRING_decode_oer;
+oer_type_encoder_f BIT_STRING_encode_oer;
+asn_struct_equals_f BIT_STRING_equals;
+asn_struct_hash_f BIT_STRING_hash;
 
 #ifdef __cplusplus
 }
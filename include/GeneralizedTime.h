@@ -62,6 +62,23 @@ GeneralizedTime_t *asn_time2GT(GeneralizedTime_t *_optional_gt,
 GeneralizedTime_t *asn_time2GT_frac(GeneralizedTime_t *_optional_gt,
 	const struct tm *, int frac_value, int frac_digits, int force_gmt);
 
+/*
+ * Fast conversion of time_t (with optional fractions of seconds) into the
+ * canonical GMT form "YYYYMMDDhhmmss[.ffffff]Z", bypassing struct tm and
+ * snprintf(3). The last converted second is cached per thread, so a stream
+ * of timestamps within the same second only re-formats the fractions.
+ * asn_time2GT_buf() writes into the given buffer (ASN_GT_BUF_SIZE is always
+ * enough) and returns the number of characters written, not including
+ * the terminating '\0'. On error returns -1 and sets errno.
+ * asn_time2GT_fast() formats directly into the existing _optional_gt buffer
+ * if it is large enough, otherwise it (re)allocates it, as asn_time2GT() does.
+ */
+#define	ASN_GT_BUF_SIZE	(14 + 1 + 6 + 1 + 1)	/* ...ss.ffffffZ\0 */
+ssize_t asn_time2GT_buf(char *buf, size_t size,
+	time_t, int frac_value, int frac_digits);
+GeneralizedTime_t *asn_time2GT_fast(GeneralizedTime_t *_optional_gt,
+	time_t, int frac_value, int frac_digits);
+
 #ifdef __cplusplus
 }
 #endif
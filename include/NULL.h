@@ -23,6 +23,12 @@ asn_struct_print_f NULL_print;
 der_type_encoder_f NULL_encode_der;
 xer_type_decoder_f NULL_decode_xer;
 xer_type_encoder_f NULL_encode_xer;
+jer_type_decoder_f NULL_decode_jer;
+jer_type_encoder_f NULL_encode_jer;
+oer_type_decoder_f NULL_decode_oer;
+oer_type_encoder_f NULL_encode_oer;
+asn_struct_equals_f NULL_equals;
+asn_struct_hash_f NULL_hash;
 per_type_decoder_f NULL_decode_uper;
 per_type_encoder_f NULL_encode_uper;
 
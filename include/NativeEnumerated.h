@@ -24,6 +24,9 @@ extern asn_TYPE_descriptor_t asn_DEF_NativeEnumerated;
 xer_type_encoder_f NativeEnumerated_encode_xer;
 per_type_decoder_f NativeEnumerated_decode_uper;
 per_type_encoder_f NativeEnumerated_encode_uper;
+jer_type_encoder_f NativeEnumerated_encode_jer;
+oer_type_decoder_f NativeEnumerated_decode_oer;
+oer_type_encoder_f NativeEnumerated_encode_oer;
 
 #ifdef __cplusplus
 }
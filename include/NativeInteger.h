@@ -29,6 +29,13 @@ xer_type_decoder_f NativeInteger_decode_xer;
 xer_type_encoder_f NativeInteger_encode_xer;
 per_type_decoder_f NativeInteger_decode_uper;
 per_type_encoder_f NativeInteger_encode_uper;
+jer_type_decoder_f NativeInteger_decode_jer;
+jer_type_encoder_f NativeInteger_encode_jer;
+oer_type_decoder_f NativeInteger_decode_oer;
+oer_type_encoder_f NativeInteger_encode_oer;
+asn_struct_equals_f NativeInteger_equals;
+asn_struct_hash_f NativeInteger_hash;
+asn_struct_copy_f NativeInteger_copy;
 
 #ifdef __cplusplus
 }
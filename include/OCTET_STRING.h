@@ -25,13 +25,23 @@ asn_struct_print_f OCTET_STRING_print;
 asn_struct_print_f OCTET_STRING_print_utf8;
 ber_type_decoder_f OCTET_STRING_decode_ber;
 der_type_encoder_f OCTET_STRING_encode_der;
+cer_type_encoder_f OCTET_STRING_encode_cer;
 xer_type_decoder_f OCTET_STRING_decode_xer_hex;		/* Hexadecimal */
 xer_type_decoder_f OCTET_STRING_decode_xer_binary;	/* 01010111010 */
 xer_type_decoder_f OCTET_STRING_decode_xer_utf8;	/* ASCII/UTF-8 */
 xer_type_encoder_f OCTET_STRING_encode_xer;
 xer_type_encoder_f OCTET_STRING_encode_xer_utf8;
+jer_type_decoder_f OCTET_STRING_decode_jer_hex;		/* Hexadecimal */
+jer_type_decoder_f OCTET_STRING_decode_jer_utf8;	/* ASCII/UTF-8 */
+jer_type_encoder_f OCTET_STRING_encode_jer;
+jer_type_encoder_f OCTET_STRING_encode_jer_utf8;
 per_type_decoder_f OCTET_STRING_decode_uper;
 per_type_encoder_f OCTET_STRING_encode_uper;
+oer_type_decoder_f OCTET_STRING_decode_oer;
+oer_type_encoder_f OCTET_STRING_encode_oer;
+asn_struct_equals_f OCTET_STRING_equals;
+asn_struct_hash_f OCTET_STRING_hash;
+asn_struct_copy_f OCTET_STRING_copy;
 
 /******************************
  * Handy conversion routines. *
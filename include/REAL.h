@@ -19,12 +19,20 @@ extern asn_TYPE_descriptor_t asn_DEF_REAL;
 asn_struct_print_f REAL_print;
 xer_type_decoder_f REAL_decode_xer;
 xer_type_encoder_f REAL_encode_xer;
+jer_type_decoder_f REAL_decode_jer;
+jer_type_encoder_f REAL_encode_jer;
+oer_type_encoder_f REAL_encode_oer;
+asn_struct_equals_f REAL_equals;
+asn_struct_hash_f REAL_hash;
 
 /***********************************
  * Some handy conversion routines. *
  ***********************************/
 
 ssize_t REAL__dump(double d, int canonical, asn_app_consume_bytes_f *cb, void *app_key);
+ssize_t REAL__dump_jer(double d, asn_app_consume_bytes_f *cb, void *app_key);
+int REAL__same(double a, double b);	/* Equal, as by REAL_equals() */
+uint64_t REAL__hash(double d);		/* As by REAL_hash() */
 
 /*
  * Convert between native double type and REAL representation (DER).
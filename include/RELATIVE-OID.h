@@ -19,6 +19,8 @@ extern asn_TYPE_descriptor_t asn_DEF_RELATIVE_OID;
 asn_struct_print_f RELATIVE_OID_print;
 xer_type_decoder_f RELATIVE_OID_decode_xer;
 xer_type_encoder_f RELATIVE_OID_encode_xer;
+jer_type_decoder_f RELATIVE_OID_decode_jer;
+jer_type_encoder_f RELATIVE_OID_encode_jer;
 
 /**********************************
  * Some handy conversion routines *
@@ -18,6 +18,8 @@ extern asn_TYPE_descriptor_t asn_DEF_UniversalString;
 asn_struct_print_f UniversalString_print;	/* Human-readable output */
 xer_type_decoder_f UniversalString_decode_xer;
 xer_type_encoder_f UniversalString_encode_xer;
+jer_type_decoder_f UniversalString_decode_jer;
+jer_type_encoder_f UniversalString_encode_jer;
 
 #ifdef __cplusplus
 }
@@ -38,6 +38,96 @@ typedef void (asn_app_constraint_failed_f)(void *application_specific_key,
 	const void *structure_which_failed_ptr,
 	const char *error_message_format, ...) GCC_PRINTFLIKE(4, 5);
 
+/*
+ * The encoding rules known to the generic asn_encode() and asn_decode().
+ */
+enum asn_transfer_syntax {
+	ATS_BER,		/* BER; encoded as DER */
+	ATS_DER,		/* Distinguished Encoding Rules */
+	ATS_CER,		/* Canonical Encoding Rules */
+	ATS_BASIC_XER,		/* XML Encoding Rules, pretty-printed */
+	ATS_CANONICAL_XER,	/* Canonical XER */
+	ATS_BASIC_JER,		/* JSON Encoding Rules, pretty-printed */
+	ATS_MINIFIED_JER,	/* JER without the insignificant whitespace */
+	ATS_BASIC_OER,		/* Octet Encoding Rules */
+	ATS_CANONICAL_OER,	/* Canonical OER */
+	ATS_UNALIGNED_PER	/* Unaligned PER, in whole octets */
+};
+
+/*
+ * Encode the structure according to the chosen rules.
+ * Unlike uper_encode(), the number of bytes (not bits) is returned
+ * for ATS_UNALIGNED_PER, the last octet padded with zero bits.
+ */
+asn_enc_rval_t asn_encode(enum asn_transfer_syntax syntax,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void *struct_ptr,	/* Structure to be encoded */
+	asn_app_consume_bytes_f *consume_bytes_cb,
+	void *app_key		/* Arbitrary callback argument */
+	);
+
+/*
+ * Encode the structure into the buffer according to the chosen rules.
+ * Like snprintf(3), the size of the whole encoding is returned even if
+ * it exceeds the (buffer_size): the buffer then holds its first bytes,
+ * and the rest is only counted, not encoded twice.
+ */
+asn_enc_rval_t asn_encode_to_buffer(enum asn_transfer_syntax syntax,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void *struct_ptr,	/* Structure to be encoded */
+	void *buffer,		/* Pre-allocated buffer */
+	size_t buffer_size	/* Its size */
+	);
+
+/*
+ * The chain of buffers taking the encoding by asn_enc_chain_cb(), e.g.,
+ * asn_encode(syntax, td, sptr, asn_enc_chain_cb, &chain).
+ * Once the (buffer) is full, next_buffer() is called to take it away
+ * and to put the next one in place, setting the (buffer, size, used).
+ * Without next_buffer(), or if it returns -1, the rest of the encoding
+ * is only counted into the (total), and (overflow) is set.
+ */
+typedef struct asn_enc_chain_s {
+	uint8_t *buffer;	/* The current buffer */
+	size_t size;		/* Its size */
+	size_t used;		/* Bytes written into it */
+	size_t total;		/* Bytes of the encoding so far */
+	int overflow;		/* The rest did not fit */
+	int (*next_buffer)(struct asn_enc_chain_s *chain, void *app_key);
+	void *app_key;		/* Argument of next_buffer() */
+} asn_enc_chain_t;
+int asn_enc_chain_cb(const void *buffer, size_t size, void *chain);
+
+/*
+ * Decode the buffer according to the chosen rules.
+ * The number of consumed bytes is returned for ATS_UNALIGNED_PER as well.
+ */
+asn_dec_rval_t asn_decode(struct asn_codec_ctx_s *opt_codec_ctx,
+	enum asn_transfer_syntax syntax,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void **struct_ptr,	/* Pointer to a target structure's pointer */
+	const void *buffer,	/* Data to be decoded */
+	size_t size		/* Size of that buffer */
+	);
+
+/*
+ * Decode the buffer as asn_decode() does, with the options of the
+ * decoding (opt_opts, see asn_dec_opts_t), and account for the memory
+ * allocated by the decoder. The (max_memory) limit is enforced, and
+ * (memory_exceeded) is set if the decoding failed for it.
+ * Called from within another accounted decoding, e.g. from a decoder
+ * callback, it leaves the accounting to the outer call and reports zeros.
+ * The options other than (max_stack_size) need the thread-local storage
+ * (ASN_THREAD_LOCAL); without it, the call fails if any of them is set.
+ */
+asn_dec_ext_rval_t asn_decode_ext(const struct asn_dec_opts_s *opt_opts,
+	enum asn_transfer_syntax syntax,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void **struct_ptr,	/* Pointer to a target structure's pointer */
+	const void *buffer,	/* Data to be decoded */
+	size_t size		/* Size of that buffer */
+	);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,87 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_ASN_CODEC_STATS_H_
+#define	_ASN_CODEC_STATS_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * Statistics of the codec calls per type descriptor.
+ * The runtime records them only when built with ASN_CODEC_STATS defined;
+ * otherwise the codecs are called directly, at no cost, and the snapshot
+ * is always empty.
+ *
+ * Every call of a type's codec (both the top level one and those made
+ * for the members of the constructed types) is counted for that type.
+ * Each thread counts into a table of its own, without any locking,
+ * and the tables are summed up by asn_codec_stats_snapshot().
+ */
+enum asn_codec_slot_e {
+	ASN_CODEC_BER_DECODER,
+	ASN_CODEC_DER_ENCODER,	/* Also the members of the CER encoding */
+	ASN_CODEC_XER_DECODER,
+	ASN_CODEC_XER_ENCODER,
+	ASN_CODEC_UPER_DECODER,
+	ASN_CODEC_UPER_ENCODER,
+	ASN_CODEC_SLOTS		/* Number of the slots above */
+};
+
+typedef struct asn_codec_counters_s {
+	unsigned long long calls;	/* Number of calls */
+	unsigned long long failures;	/* Calls returned RC_FAIL or -1 */
+	unsigned long long bytes;	/* Bytes consumed or produced */
+	unsigned long long allocations;	/* Heap allocations made */
+	/*
+	 * Time spent, in the CPU timestamp counter cycles where available
+	 * or in the units of the monotonic clock of the platform otherwise
+	 * (nanoseconds on POSIX systems). The (ticks) include the time spent
+	 * in the nested members, while (self_ticks) do not. The calls
+	 * (and the allocations) of the recursive types are counted at each
+	 * level of nesting, so their (ticks) overlap.
+	 */
+	unsigned long long ticks;
+	unsigned long long self_ticks;
+} asn_codec_counters_t;
+
+typedef struct asn_codec_stats_s {
+	struct asn_TYPE_descriptor_s *type;
+	asn_codec_counters_t slot[ASN_CODEC_SLOTS];
+} asn_codec_stats_t;
+
+/*
+ * Sum up the counters of all threads.
+ * Returns the array of the (*count) types called so far, the most
+ * time consuming first, to be freed with free(), or NULL if there is none.
+ * The counters of the codecs running at the moment in other threads
+ * may be slightly behind.
+ */
+asn_codec_stats_t *asn_codec_stats_snapshot(size_t *count);
+
+/*
+ * Zero the counters of all threads.
+ */
+void asn_codec_stats_reset(void);
+
+/*
+ * Print the snapshot of the counters as a table, one line per type
+ * and codec called. Returns 0 on success or -1 on output error.
+ */
+int asn_codec_stats_fprint(FILE *stream);
+
+/*
+ * The name of the codec slot, e.g. "ber_decoder".
+ */
+const char *asn_codec_slot_name(enum asn_codec_slot_e slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _ASN_CODEC_STATS_H_ */
@@ -0,0 +1,104 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_ASN_CODEC_TRACE_H_
+#define	_ASN_CODEC_TRACE_H_
+
+#include <asn_application.h>
+#include <asn_codec_stats.h>	/* for enum asn_codec_slot_e */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * Tracing of the codecs.
+ * The runtime records the events only when built with ASN_CODEC_TRACE
+ * defined, and then only while the tracing is enabled at run time,
+ * at the cost of a test of a flag per call otherwise. With the tracing
+ * built in, the ASN_DEBUG() messages go into the trace as well,
+ * instead of being compiled out.
+ *
+ * Each thread records the events of the codecs it calls into a ring
+ * buffer of its own, keeping the latest ones. The application may
+ * print them out when a PDU fails to decode, or export them for
+ * the external tools.
+ */
+#define	ASN_TRACE_TEXT_MAX	96	/* Including the terminating '\0' */
+typedef struct asn_trace_event_s {
+	enum asn_trace_event_e {
+		ASN_TRACE_BEGIN,	/* The (slot) codec of the (type) called */
+		ASN_TRACE_END,		/* ... returned (code) after (size) */
+		ASN_TRACE_PHASE,	/* The BER decoder entered the phase (code) */
+		ASN_TRACE_MESSAGE	/* The diagnostic (text) */
+	} kind;
+	enum asn_codec_slot_e slot;	/* Of BEGIN and END */
+	/*
+	 * The RC_OK, RC_WMORE or RC_FAIL of the decoders,
+	 * 0 or -1 of the encoders, or the number of the phase.
+	 */
+	int code;
+	/* The type of the codec, or the innermost one for the MESSAGE */
+	struct asn_TYPE_descriptor_s *type;
+	/*
+	 * The offset from the start of the buffer passed to the outermost
+	 * decoder; the number of bits written before for the PER encoder.
+	 * It is counted in bits for the PER codecs and is -1 when not known,
+	 * as with the other encoders.
+	 */
+	long offset;
+	size_t size;		/* Consumed or produced (bits for PER), of END */
+	unsigned long long time;	/* Monotonic time, in nanoseconds */
+	const char *file;	/* The source of the MESSAGE, or NULL */
+	int line;
+	char text[ASN_TRACE_TEXT_MAX];	/* MESSAGE */
+} asn_trace_event_t;
+
+/*
+ * Enable the tracing in all threads, with the ring buffers of (events)
+ * events each; 0 selects 4096. The size applies to the buffers allocated
+ * afterwards, on the first event of each thread.
+ * Returns 0, or -1 if the tracing is not built in.
+ */
+int asn_trace_enable(size_t events);
+
+/*
+ * Disable the tracing. The events recorded so far are kept.
+ */
+void asn_trace_disable(void);
+
+/*
+ * Forget the events of the calling thread.
+ */
+void asn_trace_clear(void);
+
+/*
+ * Copy the latest (up to max) events of the calling thread, oldest first.
+ * Returns the number of events copied.
+ */
+size_t asn_trace_snapshot(asn_trace_event_t *events, size_t max);
+
+/*
+ * Print out the events of the calling thread:
+ * ASN_TRACE_TEXT: one line per event, indented by the nesting level;
+ * ASN_TRACE_CHROME: the JSON trace of the Chrome trace viewer
+ *   (chrome://tracing, Perfetto);
+ * ASN_TRACE_FOLDED: the time spent in each stack of the nested types,
+ *   one "ber_decoder;Outer;Inner nanoseconds" line per call, in the format
+ *   of the folded perf(1) stacks taken by flamegraph.pl and the like.
+ * Returns 0 on success or -1 on output error.
+ */
+enum asn_trace_format_e {
+	ASN_TRACE_TEXT,
+	ASN_TRACE_CHROME,
+	ASN_TRACE_FOLDED
+};
+int asn_trace_fprint(FILE *stream, enum asn_trace_format_e format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _ASN_CODEC_TRACE_H_ */
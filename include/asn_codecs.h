@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 struct asn_TYPE_descriptor_s;	/* Forward declaration */
+struct asn_oid_interned_s;	/* Forward declaration */
 
 /*
  * This structure defines a set of parameters that may be passed
@@ -36,6 +37,80 @@ typedef struct asn_codec_ctx_s {
 	size_t  max_stack_size; /* 0 disables stack bounds checking */
 } asn_codec_ctx_t;
 
+/*
+ * The options of the decoding by asn_decode_ext(), beyond the stack limit.
+ * They are kept apart from asn_codec_ctx_t, so the decoders called in
+ * any other way see none of them.
+ * Clear the whole structure (memset) before setting up its members.
+ */
+typedef struct asn_dec_opts_s {
+	size_t  max_stack_size;	/* As in asn_codec_ctx_t */
+
+	/*
+	 * Decode BER by ber_decode_iterative() rather than by ber_decode(),
+	 * limiting the nesting of the constructed types to this depth.
+	 * That decoder is not restartable: the whole PDU must be in the
+	 * buffer, RC_WMORE meaning the decoding is to be started over.
+	 * 0 keeps ber_decode().
+	 */
+	size_t  max_depth;
+
+	/*
+	 * Limit the memory the decoders may allocate within the call,
+	 * counted as the bytes allocated and not freed yet, plus a fixed
+	 * overhead per block for its bookkeeping. Once an
+	 * allocation would exceed the limit, it fails and the decoding
+	 * ends with RC_FAIL and (memory_exceeded) set. The memory allocated
+	 * by the earlier calls, e.g. into the structure of a restarted
+	 * decoding, is not counted, except when it is reallocated.
+	 * 0 disables the limit.
+	 */
+	size_t  max_memory;
+
+	/*
+	 * Streaming decoding of an unbounded SEQUENCE OF or SET OF.
+	 * The BER decoder hands each element of the list to the
+	 * (element_cb) as soon as it is decoded, instead of appending it
+	 * to the list, so the list stays empty and the memory footprint
+	 * does not grow with the number of elements.
+	 * (stream_type) selects the lists to stream: either the
+	 * SEQUENCE OF/SET OF type itself or the type of its elements,
+	 * the latter being useful for the anonymous inner lists.
+	 * The callback returns 0 to have the element freed by the decoder,
+	 * 1 if it has taken over the element, or -1 to stop the decoding
+	 * with RC_FAIL.
+	 * The decoding is restartable across the buffer refills as usual,
+	 * unless (max_depth) is set: the elements are then streamed out of
+	 * a PDU which is all in one buffer, and a restarted decoding hands
+	 * the elements of the earlier attempts to the (element_cb) again.
+	 * Leave these members zeroed if streaming is not needed.
+	 */
+	struct asn_TYPE_descriptor_s *stream_type;
+	int (*element_cb)(struct asn_TYPE_descriptor_s *list_type,
+		void *element, void *cb_key);
+	void *cb_key;
+
+	/*
+	 * The record of the reason, the position and the path of the member
+	 * which caused a decoder to fail, see asn_dec_error_t below.
+	 * It is filled only on the way out of a failed decoding, so the
+	 * successful decodings are not slowed down by it.
+	 * NULL disables the recording.
+	 */
+	struct asn_dec_error_s *error;
+
+	/*
+	 * Intern each OBJECT IDENTIFIER value decoded from BER,
+	 * see OBJECT_IDENTIFIER_intern(), and hand its handle to the
+	 * (oid_cb), if set, along with the value and the (cb_key),
+	 * so the application may keep it. A failure to intern the value
+	 * is not a decoding failure and leaves the (oid_cb) uncalled.
+	 */
+	int intern_oids;
+	void (*oid_cb)(const struct asn_oid_interned_s *handle,
+		const void *oid_value, void *cb_key);
+} asn_dec_opts_t;
+
 /*
  * Type of the return value of the encoding functions (der_encode, xer_encode).
  */
@@ -102,6 +177,103 @@ typedef struct asn_dec_rval_s {
 	return tmp_error;					\
 } while(0)
 
+/*
+ * Type of the return value of asn_decode_ext(): that of asn_decode()
+ * along with the account of the memory allocated while decoding.
+ */
+typedef struct asn_dec_ext_rval_s {
+	enum asn_dec_rval_code_e code;	/* Result code */
+	size_t consumed;		/* Number of bytes consumed */
+	int memory_exceeded;	/* Failed for hitting (max_memory) */
+	size_t allocations;	/* Number of the allocations made */
+	size_t allocated;	/* Bytes allocated in total */
+	size_t peak;		/* Maximum of the bytes held at once */
+	size_t retained;	/* Bytes held by the structure in the end */
+} asn_dec_ext_rval_t;
+
+/*
+ * The decoding failure, as recorded into the (error) of asn_dec_opts_t
+ * by asn_decode_ext() when it returns RC_FAIL. The outcome of the other
+ * calls leaves (reason) at ASN_DEC_ERROR_NONE.
+ */
+#define	ASN_DEC_ERROR_PATH_MAX	128	/* Including the terminating '\0' */
+#define	ASN_DEC_ERROR_SEGMENTS	32
+typedef struct asn_dec_error_s {
+	enum asn_dec_error_reason_e {
+		ASN_DEC_ERROR_NONE,	/* The decoding has not failed */
+		ASN_DEC_ERROR_VALUE,	/* Malformed contents of the value */
+		ASN_DEC_ERROR_TAG,	/* Malformed or unexpected tag */
+		ASN_DEC_ERROR_LENGTH,	/* Malformed length or overrun */
+		ASN_DEC_ERROR_MISSING,	/* Mandatory member is absent */
+		ASN_DEC_ERROR_DEPTH,	/* Nesting exceeds the stack or depth */
+		ASN_DEC_ERROR_MEMORY,	/* Out of memory or (max_memory) */
+		ASN_DEC_ERROR_UNSUPPORTED	/* Codec is not compiled in */
+	} reason;
+	/* The innermost type which failed */
+	struct asn_TYPE_descriptor_s *type;
+	/*
+	 * The offset of the failure in the buffer passed to the decoder.
+	 * For BER, XER and the like, it points to the offending tag or
+	 * length, or to the start of the value which failed to decode.
+	 * For uper_decode(), it is the number of bits read before the
+	 * failure, counted as the (consumed) bits.
+	 */
+	long offset;
+	/* The failing member, such as "Msg.body.items[17].id" */
+	char path[ASN_DEC_ERROR_PATH_MAX];
+
+	/* Used by the decoders while recording, innermost first */
+	int nesting;
+	size_t segments_count;
+	struct asn_dec_error_segment_s {
+		const char *name;	/* The member, or NULL */
+		long index;		/* The element of the list, or -1 */
+	} segments[ASN_DEC_ERROR_SEGMENTS];
+} asn_dec_error_t;
+
+/*
+ * The name of the reason, e.g. "unexpected tag".
+ */
+const char *asn_dec_error_reason_name(enum asn_dec_error_reason_e reason);
+
+/*
+ * An item of the batch decoders (ber_decode_batch, uper_decode_batch):
+ * the complete encoding of a PDU and the slot for the decoded structure.
+ */
+typedef struct asn_dec_batch_item_s {
+	const void *buffer;	/* Data to be decoded */
+	size_t size;		/* Size of that buffer */
+
+	/*
+	 * The decoded structure. If non-NULL on input, the structure of
+	 * the previous batch is emptied and decoded into, keeping its
+	 * allocation. Also emptied if the item fails to decode, or freed
+	 * and set to NULL if the size of the structure is not known
+	 * (the type can not be copied by asn_clone()).
+	 */
+	void *structure;
+
+	asn_dec_rval_t result;	/* Outcome of the decoding of this item */
+} asn_dec_batch_item_t;
+
+/*
+ * An item of the batch encoders (asn_parallel_encode): the structure
+ * and the buffer receiving its encoding.
+ */
+typedef struct asn_enc_batch_item_s {
+	void *structure;	/* Structure to be encoded */
+
+	/*
+	 * The encoding, (result.encoded) bytes long. The buffer is grown
+	 * with realloc() as needed and kept by the application, which may
+	 * hand it over again with the next batch; free() it when done.
+	 */
+	uint8_t *buffer;
+	size_t allocated;	/* Size of the (buffer) */
+
+	asn_enc_rval_t result;	/* Outcome of the encoding of this item */
+} asn_enc_batch_item_t;
+
 #ifdef __cplusplus
 }
 #endif
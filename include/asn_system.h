@@ -90,6 +90,18 @@ typedef	unsigned int	uint32_t;
 #endif
 #endif
 
+/*
+ * Thread-local storage class, if the compiler offers one.
+ * Left undefined otherwise; the users must then fall back to no caching.
+ */
+#ifndef	ASN_THREAD_LOCAL
+#if	defined(_MSC_VER)
+#define	ASN_THREAD_LOCAL	__declspec(thread)
+#elif	defined(__GNUC__)
+#define	ASN_THREAD_LOCAL	__thread
+#endif
+#endif	/* ASN_THREAD_LOCAL */
+
 #ifndef	offsetof	/* If not defined by <stddef.h> */
 #define	offsetof(s, m)	((ptrdiff_t)&(((s *)0)->m) - (ptrdiff_t)((s *)0))
 #endif	/* offsetof */
@@ -40,6 +40,11 @@ typedef struct asn_SET_specifics_s {
 	 */
 	int extensible;				/* Whether SET is extensible */
 	unsigned int *_mandatory_elements;	/* Bitmask of mandatory ones */
+
+	/*
+	 * Member lookup by XML tag name, built by the XER decoder.
+	 */
+	struct asn_xer_member_index_s *xer_index;
 } asn_SET_specifics_t;
 
 /*
@@ -50,10 +55,18 @@ asn_struct_print_f SET_print;
 asn_constr_check_f SET_constraint;
 ber_type_decoder_f SET_decode_ber;
 der_type_encoder_f SET_encode_der;
+cer_type_encoder_f SET_encode_cer;
 xer_type_decoder_f SET_decode_xer;
 xer_type_encoder_f SET_encode_xer;
+jer_type_decoder_f SET_decode_jer;
+jer_type_encoder_f SET_encode_jer;
 per_type_decoder_f SET_decode_uper;
 per_type_encoder_f SET_encode_uper;
+oer_type_decoder_f SET_decode_oer;
+oer_type_encoder_f SET_encode_oer;
+asn_struct_equals_f SET_equals;
+asn_struct_hash_f SET_hash;
+asn_struct_copy_f SET_copy;
 
 /***********************
  * Some handy helpers. *
@@ -30,10 +30,18 @@ asn_struct_print_f SET_OF_print;
 asn_constr_check_f SET_OF_constraint;
 ber_type_decoder_f SET_OF_decode_ber;
 der_type_encoder_f SET_OF_encode_der;
+cer_type_encoder_f SET_OF_encode_cer;
 xer_type_decoder_f SET_OF_decode_xer;
 xer_type_encoder_f SET_OF_encode_xer;
+jer_type_decoder_f SET_OF_decode_jer;
+jer_type_encoder_f SET_OF_encode_jer;
 per_type_decoder_f SET_OF_decode_uper;
 per_type_encoder_f SET_OF_encode_uper;
+oer_type_decoder_f SET_OF_decode_oer;
+oer_type_encoder_f SET_OF_encode_oer;
+asn_struct_equals_f SET_OF_equals;
+asn_struct_hash_f SET_OF_hash;
+asn_struct_copy_f SET_OF_copy;
 
 #ifdef __cplusplus
 }
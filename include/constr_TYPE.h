@@ -37,10 +37,15 @@ typedef struct asn_struct_ctx_s {
 
 #include <ber_decoder.h>	/* Basic Encoding Rules decoder */
 #include <der_encoder.h>	/* Distinguished Encoding Rules encoder */
+#include <cer_encoder.h>	/* Canonical Encoding Rules encoder */
 #include <xer_decoder.h>	/* Decoder of XER (XML, text) */
 #include <xer_encoder.h>	/* Encoder into XER (XML, text) */
 #include <per_decoder.h>	/* Packet Encoding Rules decoder */
 #include <per_encoder.h>	/* Packet Encoding Rules encoder */
+#include <jer_decoder.h>	/* Decoder of JER (JSON) */
+#include <jer_encoder.h>	/* Encoder into JER (JSON) */
+#include <oer_decoder.h>	/* Octet Encoding Rules decoder */
+#include <oer_encoder.h>	/* Octet Encoding Rules encoder */
 #include <constraints.h>	/* Subtype constraints support */
 
 /*
@@ -66,6 +71,34 @@ typedef int (asn_struct_print_f)(
 		int level,	/* Indentation level */
 		asn_app_consume_bytes_f *callback, void *app_key);
 
+/*
+ * Compare two structures by value, see asn_equals() below.
+ * Both (struct_a) and (struct_b) are given.
+ * RETURN VALUES: 1 if the values are equal, 0 otherwise.
+ */
+typedef int (asn_struct_equals_f)(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		const void *struct_a, const void *struct_b);
+
+/*
+ * Hash the structure by value, see asn_hash() below.
+ */
+typedef uint64_t (asn_struct_hash_f)(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		const void *struct_ptr);
+
+/*
+ * Copy the structure, see asn_clone() below. If (*struct_dst) is given,
+ * the copy is made into it in place (it must be zeroed), otherwise into
+ * a new structure stored into (*struct_dst).
+ * RETURN VALUES: 0 if copied, -1 if out of memory.
+ */
+struct asn_copy_s;	/* Forward declaration, see asn_internal.h */
+typedef int (asn_struct_copy_f)(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		void **struct_dst, const void *struct_src,
+		struct asn_copy_s *copy);
+
 /*
  * Return the outmost tag of the type.
  * If the type is untagged CHOICE, the dynamic operation is performed.
@@ -78,6 +111,15 @@ typedef ber_tlv_tag_t (asn_outmost_tag_f)(
 /* The instance of the above function type; used internally. */
 asn_outmost_tag_f asn_TYPE_outmost_tag;
 
+/*
+ * Have the descriptor of a type derived by the compiler (Foo ::= INTEGER)
+ * take over the functions of its base type, as its first use would.
+ * Returns 1 if the descriptor has changed, 0 if there was nothing to take.
+ * NOTE: This function is only useful internally, to find out the base type
+ * of a descriptor by its functions.
+ */
+int asn_TYPE_resolve(struct asn_TYPE_descriptor_s *type_descriptor);
+
 
 /*
  * The definitive description of the destination language's structure.
@@ -126,6 +168,33 @@ typedef struct asn_TYPE_descriptor_s {
 	 * functions above.
 	 */
 	void *specifics;
+
+	/*
+	 * JSON Encoding Rules. Placed last to keep the existing descriptor
+	 * initializers valid; zero slots are resolved by jer_type_decoder()
+	 * and jer_type_encoder().
+	 */
+	jer_type_decoder_f *jer_decoder;	/* Generic JER decoder */
+	jer_type_encoder_f *jer_encoder;	/* JER encoder */
+
+	/*
+	 * Octet Encoding Rules, likewise resolved by oer_type_decoder()
+	 * and oer_type_encoder() when left zero.
+	 */
+	oer_type_decoder_f *oer_decoder;	/* BASIC/CANONICAL-OER decoder */
+	oer_type_encoder_f *oer_encoder;	/* BASIC/CANONICAL-OER encoder */
+
+	/*
+	 * Comparison and hashing by value, likewise resolved
+	 * by asn_equals() and asn_hash() when left zero.
+	 */
+	asn_struct_equals_f *equals_struct;	/* Compare two structures */
+	asn_struct_hash_f *hash_struct;		/* Hash of the structure */
+
+	/*
+	 * Copying, resolved by asn_clone() when left zero.
+	 */
+	asn_struct_copy_f *copy_struct;		/* Deep copy */
 } asn_TYPE_descriptor_t;
 
 /*
@@ -173,6 +242,51 @@ int asn_fprint(FILE *stream,		/* Destination stream descriptor */
 	asn_TYPE_descriptor_t *td,	/* ASN.1 type descriptor */
 	const void *struct_ptr);	/* Structure to be printed */
 
+/*
+ * Compare the values of two structures of the type (td), without
+ * encoding them. The INTEGERs are equal regardless of the redundant
+ * leading octets, the BIT STRINGs regardless of their unused bits,
+ * the members of SEQUENCE and SET which are absent are equal to
+ * their DEFAULT values, and the SET OF lists compare as unordered
+ * collections. Either structure may be absent (0).
+ * RETURN VALUES:
+ * 	1: The values are equal.
+ * 	0: The values differ, or the type can not be compared.
+ */
+int asn_equals(asn_TYPE_descriptor_t *td,	/* ASN.1 type descriptor */
+	const void *struct_a,			/* Structures to be compared */
+	const void *struct_b);
+
+/*
+ * Hash the value of the structure of the type (td), so that the values
+ * equal as per asn_equals() have the same hash. Use it with asn_equals()
+ * to key the hash tables by the decoded values. The hash is not stable
+ * between the versions of this library.
+ */
+uint64_t asn_hash(asn_TYPE_descriptor_t *td,	/* ASN.1 type descriptor */
+	const void *struct_ptr);		/* Structure to be hashed */
+
+/*
+ * Make a deep copy of the structure of the type (td), without encoding
+ * and decoding it. The copy is freed by ASN_STRUCT_FREE() as usual.
+ * With ACF_COMPACT, the size of the copy is computed first, and the copy
+ * is laid out in a single allocation, with all the members and buffers
+ * inline. Such a copy is to be freed by a single free(3) and never by
+ * ASN_STRUCT_FREE(), and is not to be modified, but it is contiguous
+ * in memory and cheap to keep around. asn_clone_size() returns the size
+ * of that allocation.
+ * RETURN VALUES:
+ * 	The copy, or 0 if out of memory or the type can not be copied.
+ */
+enum asn_clone_flags_e {
+	ACF_NOFLAGS	= 0x00,
+	ACF_COMPACT	= 0x01	/* A single allocation, see above */
+};
+void *asn_clone(asn_TYPE_descriptor_t *td,	/* ASN.1 type descriptor */
+	const void *struct_ptr,			/* Structure to be copied */
+	enum asn_clone_flags_e flags);
+size_t asn_clone_size(asn_TYPE_descriptor_t *td, const void *struct_ptr);
+
 #ifdef __cplusplus
 }
 #endif
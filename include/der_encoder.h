@@ -22,7 +22,10 @@ asn_enc_rval_t der_encode(struct asn_TYPE_descriptor_s *type_descriptor,
 		void *app_key		/* Arbitrary callback argument */
 	);
 
-/* A variant of der_encode() which encodes data into the pre-allocated buffer */
+/*
+ * A variant of der_encode() which encodes data into the pre-allocated buffer.
+ * Fails if the buffer is too small; asn_encode_to_buffer() tells the size.
+ */
 asn_enc_rval_t der_encode_to_buffer(
 		struct asn_TYPE_descriptor_s *type_descriptor,
 		void *struct_ptr,	/* Structure to be encoded */
@@ -0,0 +1,54 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_JER_DECODER_H_
+#define	_JER_DECODER_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * The JSON Encoding Rules (JER) decoder of any ASN.1 type.
+ * May be invoked by the application.
+ * The value is decoded once the complete JSON text is available;
+ * until then RC_WMORE is returned with nothing consumed, and the whole
+ * text has to be presented again along with the rest of it.
+ */
+asn_dec_rval_t jer_decode(struct asn_codec_ctx_s *opt_codec_ctx,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void **struct_ptr,	/* Pointer to a target structure's pointer */
+	const void *buffer,	/* Data to be decoded */
+	size_t size		/* Size of data buffer */
+	);
+
+/*
+ * Type of the type-specific JER decoder function.
+ * The (buf_ptr) points to the JSON value, possibly preceded by whitespace.
+ */
+typedef asn_dec_rval_t (jer_type_decoder_f)(asn_codec_ctx_t *opt_codec_ctx,
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		void **struct_ptr,
+		const void *buf_ptr, size_t size
+	);
+
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * Get the JER decoder of the type. Descriptors compiled without the JER
+ * slot are served by the runtime's decoder matching their XER decoder.
+ * Returns 0 if the type has no JER decoder.
+ */
+jer_type_decoder_f *jer_type_decoder(struct asn_TYPE_descriptor_s *td);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _JER_DECODER_H_ */
@@ -0,0 +1,89 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_JER_ENCODER_H_
+#define	_JER_ENCODER_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/* Flags used by the jer_encode() and (*jer_type_encoder_f), defined below */
+enum jer_encoder_flags_e {
+	/* Mode of encoding */
+	JER_F_BASIC	= 0x01,	/* Pretty-printed, with indentation */
+	JER_F_MINIFIED	= 0x02	/* No insignificant whitespace */
+};
+
+/*
+ * The JSON Encoding Rules (JER) encoder of any type.
+ * May be invoked by the application.
+ */
+asn_enc_rval_t jer_encode(struct asn_TYPE_descriptor_s *type_descriptor,
+		void *struct_ptr,	/* Structure to be encoded */
+		enum jer_encoder_flags_e jer_flags,
+		asn_app_consume_bytes_f *consume_bytes_cb,
+		void *app_key		/* Arbitrary callback argument */
+	);
+
+/*
+ * The variant of the above function which dumps the JER_F_BASIC output
+ * into the chosen file pointer.
+ * RETURN VALUES:
+ * 	 0: The structure is printed.
+ * 	-1: Problem printing the structure.
+ * WARNING: No sensible errno value is returned.
+ */
+int jer_fprint(FILE *stream, struct asn_TYPE_descriptor_s *td, void *sptr);
+
+/*
+ * Type of the generic JER encoder.
+ */
+typedef asn_enc_rval_t (jer_type_encoder_f)(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		void *struct_ptr,	/* Structure to be encoded */
+		int ilevel,		/* Level of indentation */
+		enum jer_encoder_flags_e jer_flags,
+		asn_app_consume_bytes_f *consume_bytes_cb,	/* Callback */
+		void *app_key		/* Arbitrary callback argument */
+	);
+
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * Get the JER encoder of the type. Descriptors compiled without the JER
+ * slot are served by the runtime's encoder matching their XER encoder.
+ * Returns 0 if the type has no JER encoder.
+ */
+jer_type_encoder_f *jer_type_encoder(struct asn_TYPE_descriptor_s *td);
+
+/*
+ * Escape the UTF-8 text for the inside of a JSON string.
+ * Use jer_escape_consume() as the callback with a jer_escape_arg_t
+ * as its (app_key) to escape the output of the existing dumpers.
+ */
+typedef struct jer_escape_arg_s {
+	asn_app_consume_bytes_f *cb;	/* Application callback */
+	void *app_key;			/* Its argument */
+	ssize_t encoded;		/* Escaped bytes produced */
+} jer_escape_arg_t;
+asn_app_consume_bytes_f jer_escape_consume;
+
+/*
+ * Emit the quoted and escaped JSON string.
+ * Returns the number of bytes produced or -1 on callback failure.
+ */
+ssize_t jer_encode_string(const void *buf, size_t size,
+	asn_app_consume_bytes_f *cb, void *app_key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _JER_ENCODER_H_ */
@@ -0,0 +1,67 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_OER_DECODER_H_
+#define	_OER_DECODER_H_
+
+#include <asn_application.h>
+#include <oer_support.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * The Octet Encoding Rules (OER) decoder of any ASN.1 type.
+ * May be invoked by the application.
+ * Both the BASIC-OER and CANONICAL-OER encodings are accepted.
+ * The value is decoded once it is complete; until then RC_WMORE is
+ * returned with nothing consumed, and the whole encoding has to be
+ * presented again along with the rest of it. If the target structure
+ * was allocated by the decoder, it is released on RC_WMORE.
+ */
+asn_dec_rval_t oer_decode(struct asn_codec_ctx_s *opt_codec_ctx,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void **struct_ptr,	/* Pointer to a target structure's pointer */
+	const void *buffer,	/* Data to be decoded */
+	size_t size		/* Size of data buffer */
+	);
+
+/*
+ * Type of the type-specific OER decoder function.
+ * The (constraints) of the member override those of the type.
+ */
+typedef asn_dec_rval_t (oer_type_decoder_f)(asn_codec_ctx_t *opt_codec_ctx,
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		asn_per_constraints_t *constraints,
+		void **struct_ptr,
+		const void *buf_ptr, size_t size
+	);
+
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * Get the OER decoder of the type. Descriptors compiled without the OER
+ * slot are served by the runtime's decoder matching their XER encoder.
+ * Returns 0 if the type has no OER decoder.
+ */
+oer_type_decoder_f *oer_type_decoder(struct asn_TYPE_descriptor_s *td);
+
+/*
+ * Decode the value wrapped into the open type (length-prefixed);
+ * the value must take up the whole wrapper.
+ */
+asn_dec_rval_t oer_open_type_get(asn_codec_ctx_t *opt_codec_ctx,
+	struct asn_TYPE_descriptor_s *td,
+	asn_per_constraints_t *constraints,
+	void **struct_ptr, const void *buf_ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _OER_DECODER_H_ */
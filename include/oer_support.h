@@ -0,0 +1,82 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_OER_SUPPORT_H_
+#define	_OER_SUPPORT_H_
+
+#include <asn_application.h>
+#include <ber_tlv_tag.h>	/* ber_tlv_tag_t */
+#include <per_support.h>	/* asn_per_constraint_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The fetch functions below return the number of bytes consumed,
+ * 0 if the buffer ends before the element does,
+ * or -1 if the encoding is broken or does not fit the C type.
+ * The serialize functions return the number of bytes produced or -1.
+ */
+
+/*
+ * The length determinant (X.696 #8.6): a single octet below 128,
+ * otherwise 0x80|n followed by the n octets of the length.
+ */
+ssize_t oer_fetch_length(const void *bufptr, size_t size, size_t *len_r);
+ssize_t oer_serialize_length(size_t length,
+	asn_app_consume_bytes_f *cb, void *app_key);
+
+/*
+ * The tag of a CHOICE alternative (X.696 #8.7): class in the top two bits,
+ * then the number below 63 or 0x3f followed by the base-128 number.
+ */
+ssize_t oer_fetch_tag(const void *bufptr, size_t size, ber_tlv_tag_t *tag_r);
+ssize_t oer_serialize_tag(ber_tlv_tag_t tag,
+	asn_app_consume_bytes_f *cb, void *app_key);
+
+/*
+ * Figure out the OER form of the INTEGER from its PER visible constraint.
+ * Returns the fixed width (1, 2, 4 or 8 octets) or 0 for the
+ * length-prefixed form. (*is_unsigned) is set if the lower bound
+ * is non-negative, so the value is encoded as unsigned.
+ * Extensible constraints are not OER-visible.
+ */
+int oer_integer_width(const asn_per_constraint_t *ct, int *is_unsigned);
+
+/*
+ * The INTEGER value which fits the (long) type, either in the fixed
+ * (width) octets or, for (width) 0, length-prefixed.
+ */
+ssize_t oer_fetch_long(const void *bufptr, size_t size,
+	int width, int is_unsigned, long *value_r);
+ssize_t oer_serialize_long(long value, int width, int is_unsigned,
+	asn_app_consume_bytes_f *cb, void *app_key);
+
+/*
+ * The ENUMERATED value (X.696 #11): a single octet for 0..127,
+ * otherwise 0x80|n followed by the n octets of the value.
+ */
+ssize_t oer_fetch_enumerated(const void *bufptr, size_t size, long *value_r);
+ssize_t oer_serialize_enumerated(long value,
+	asn_app_consume_bytes_f *cb, void *app_key);
+
+/*
+ * Skip the length-prefixed open type or unknown extension.
+ */
+ssize_t oer_open_type_skip(const void *bufptr, size_t size);
+
+/*
+ * The bits of the presence bitmaps (X.696 #16.2, #16.4), the first bit
+ * being the most significant bit of the first octet.
+ */
+#define	OER_BITMAP_GET(map, bit)	\
+	(((map)[(bit) >> 3] >> (7 - ((bit) & 7))) & 1)
+#define	OER_BITMAP_SET(map, bit)	\
+	((map)[(bit) >> 3] |= (0x80 >> ((bit) & 7)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _OER_SUPPORT_H_ */
@@ -26,6 +26,18 @@ asn_dec_rval_t uper_decode(struct asn_codec_ctx_s *opt_codec_ctx,
 	int unused_bits		/* Number of unused tailing bits, 0..7 */
 	);
 
+/*
+ * Decode the (count) independent PDUs of the same type, each of them
+ * occupying the whole octets of its buffer.
+ * The codec context is set up once for the whole batch.
+ * Returns the number of items decoded successfully; the outcome of each one
+ * is placed into its (result), with the number of consumed bits.
+ */
+size_t uper_decode_batch(struct asn_codec_ctx_s *opt_codec_ctx,
+	struct asn_TYPE_descriptor_s *type_descriptor,	/* Type to decode */
+	asn_dec_batch_item_t *items,	/* Input spans and output slots */
+	size_t count			/* Number of items */
+	);
 
 /*
  * Type of the type-specific PER decoder function.
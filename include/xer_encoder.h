@@ -52,6 +52,47 @@ typedef asn_enc_rval_t (xer_type_encoder_f)(
 		void *app_key		/* Arbitrary callback argument */
 	);
 
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * The output buffer coalescing the many tiny writes of the encoders and
+ * printers into larger chunks for the application callback.
+ * Pass asn_output_buffer_consume() as the callback and the buffer as its
+ * (app_key), then call asn_output_buffer_flush() once the encoding is over.
+ * Once the application callback fails, all further output is discarded
+ * and both functions return -1.
+ */
+#ifndef	ASN_OUTPUT_BUFFER_SIZE
+#define	ASN_OUTPUT_BUFFER_SIZE	4096
+#endif
+typedef struct asn_output_buffer_s {
+	asn_app_consume_bytes_f *cb;	/* Application callback */
+	void *app_key;			/* Its argument */
+	size_t fill;			/* Bytes pending in buf[] */
+	int failed;			/* The callback has failed */
+	char buf[ASN_OUTPUT_BUFFER_SIZE];
+} asn_output_buffer_t;
+void asn_output_buffer_init(asn_output_buffer_t *ob,
+	asn_app_consume_bytes_f *consume_bytes_cb, void *app_key);
+asn_app_consume_bytes_f asn_output_buffer_consume;
+int asn_output_buffer_flush(asn_output_buffer_t *ob);
+
+/*
+ * The "<name>" and "</name>" tags of the constructed type's member, formatted
+ * once per type and shared with the xer_find_member() index (xer_decoder.h).
+ * Returns 0 if the table is not available; use td->elements[edx].name then.
+ */
+typedef struct xer_member_tags_s {
+	const char *open;	/* "<name>" */
+	const char *close;	/* "</name>" */
+	size_t name_len;	/* strlen(name) */
+} xer_member_tags_t;
+struct asn_xer_member_index_s;	/* Opaque */
+const xer_member_tags_t *xer_member_tags(struct asn_xer_member_index_s **index,
+	struct asn_TYPE_descriptor_s *td, int edx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,8 @@
 #include <asn_internal.h>
 #include <BIT_STRING.h>
 #include <asn_internal.h>
+#include <jer_support.h>	/* JSON tokenizer */
+#include <limits.h>	/* for INT_MAX */
 
 /*
  * BIT STRING basic type description.
@@ -38,7 +40,14 @@ asn_TYPE_descriptor_t asn_DEF_BIT_STRING = {
 	  / sizeof(asn_DEF_BIT_STRING_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	&asn_DEF_BIT_STRING_specs
+	&asn_DEF_BIT_STRING_specs,
+	BIT_STRING_decode_jer,
+	BIT_STRING_encode_jer,
+	BIT_STRING_decode_oer,
+	BIT_STRING_encode_oer,
+	BIT_STRING_equals,
+	BIT_STRING_hash,
+	OCTET_STRING_copy
 };
 
 /*
@@ -132,6 +141,243 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * JER encodes BIT STRING as {"value":"<hex>","length":<bits>}.
+ */
+asn_enc_rval_t
+BIT_STRING_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const BIT_STRING_t *st = (const BIT_STRING_t *)sptr;
+	asn_enc_rval_t er, tmper;
+	char scratch[32];
+	int ret;
+
+	if(!st || (!st->buf && st->size))
+		_ASN_ENCODE_FAILED;
+
+	_ASN_CALLBACK("{\"value\":", 9);
+	tmper = OCTET_STRING_encode_jer(td, sptr, ilevel, flags, cb, app_key);
+	if(tmper.encoded == -1) return tmper;
+
+	ret = snprintf(scratch, sizeof(scratch), ",\"length\":%ld}",
+		(long)st->size * 8 - (st->size ? (st->bits_unused & 0x07) : 0));
+	assert(ret > 0 && (size_t)ret < sizeof(scratch));
+	_ASN_CALLBACK(scratch, ret);
+
+	er.encoded = 9 + tmper.encoded + ret;
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
+asn_dec_rval_t
+BIT_STRING_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	const char *buf = (const char *)buf_ptr;
+	BIT_STRING_t *st;
+	asn_dec_rval_t rval;
+	jer_token_t tok;
+	size_t consumed;
+	long length = -1;
+	int have_value = 0;
+	int st_allocated = (*sptr == 0);
+
+#define	BS_NEXT_TOKEN()	do {					\
+		size_t n = jer_next_token(buf + consumed,		\
+			size - consumed, &tok);				\
+		if(tok.type == JT_MORE) goto want_more;			\
+		consumed += n;						\
+	} while(0)
+
+	consumed = 0;
+	BS_NEXT_TOKEN();
+	if(tok.type != JT_OBJECT_START) _ASN_DECODE_FAILED;
+
+	for(;;) {
+		BS_NEXT_TOKEN();
+		if(tok.type != JT_STRING) goto failed;
+		if(tok.length == 5 && !memcmp(tok.start, "value", 5)
+		&& !have_value) {
+			BS_NEXT_TOKEN();
+			if(tok.type != JT_COLON) goto failed;
+			rval = OCTET_STRING_decode_jer_hex(opt_codec_ctx, td,
+				sptr, buf + consumed, size - consumed);
+			if(rval.code != RC_OK) {
+				if(rval.code == RC_WMORE) goto want_more;
+				goto failed;
+			}
+			consumed += rval.consumed;
+			have_value = 1;
+		} else if(tok.length == 6 && !memcmp(tok.start, "length", 6)
+		&& length < 0) {
+			const char *p;
+			BS_NEXT_TOKEN();
+			if(tok.type != JT_COLON) goto failed;
+			BS_NEXT_TOKEN();
+			if(tok.type != JT_NUMBER || tok.start[0] == 0x2d)
+				goto failed;
+			for(length = 0, p = tok.start;
+					p < tok.start + tok.length; p++) {
+				if(*p < 0x30 || *p > 0x39
+				|| length > (0x7fffffff - 9) / 10)
+					goto failed;	/* 1.5, 1e3 */
+				length = length * 10 + (*p - 0x30);
+			}
+		} else {
+			goto failed;
+		}
+		BS_NEXT_TOKEN();
+		if(tok.type == JT_OBJECT_END) break;
+		if(tok.type != JT_COMMA) goto failed;
+	}
+#undef	BS_NEXT_TOKEN
+
+	/*
+	 * The length must be in the last octet of the value.
+	 */
+	if(!have_value || length < 0) goto failed;
+	st = (BIT_STRING_t *)*sptr;
+	if(st->size ? (length > (long)st->size * 8
+			|| length <= ((long)st->size - 1) * 8)
+		    : length != 0)
+		goto failed;
+	st->bits_unused = st->size * 8 - length;
+	if(st->size) /* Clear the unused bits */
+		st->buf[st->size - 1] &= 0xff << st->bits_unused;
+
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+
+want_more:
+	rval.code = RC_WMORE;
+	rval.consumed = 0;
+	goto cleanup;
+failed:
+	rval.code = RC_FAIL;
+	rval.consumed = 0;
+cleanup:
+	if(st_allocated && *sptr) {
+		ASN_STRUCT_FREE(*td, *sptr);
+		*sptr = 0;
+	}
+	return rval;
+}
+
+/*
+ * X.696 #16: the fixed size BIT STRING is just the bits,
+ * otherwise the length-prefixed count of unused bits and the bits.
+ */
+asn_dec_rval_t
+BIT_STRING_decode_oer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+	void **sptr, const void *buf_ptr, size_t size) {
+	asn_OCTET_STRING_specifics_t *specs = td->specifics
+		? (asn_OCTET_STRING_specifics_t *)td->specifics
+		: &asn_DEF_BIT_STRING_specs;
+	asn_per_constraint_t *ct = constraints ? &constraints->size
+			: (td->per_constraints
+				? &td->per_constraints->size : 0);
+	asn_dec_rval_t rval = { RC_OK, 0 };
+	BIT_STRING_t *st = (BIT_STRING_t *)*sptr;
+	const uint8_t *buf = (const uint8_t *)buf_ptr;
+	int bits_unused;
+	ssize_t skip = 0;
+	size_t len;
+
+	(void)opt_codec_ctx;
+
+	if(ct && ct->flags == APC_CONSTRAINED
+	&& ct->lower_bound == ct->upper_bound) {
+		len = (ct->upper_bound + 7) >> 3;
+		bits_unused = (len << 3) - ct->upper_bound;
+	} else {
+		skip = oer_fetch_length(buf, size, &len);
+		if(skip < 0 || (skip && len == 0)) _ASN_DECODE_FAILED;
+		if(skip == 0 || size - skip < 1) {
+			rval.code = RC_WMORE;
+			return rval;
+		}
+		bits_unused = buf[skip];
+		if(bits_unused > 7 || (len == 1 && bits_unused))
+			_ASN_DECODE_FAILED;
+		skip++;
+		len--;
+	}
+	if(len >= INT_MAX) _ASN_DECODE_FAILED;
+	if(size - skip < len) {
+		rval.code = RC_WMORE;
+		return rval;
+	}
+
+	if(!st) {
+		st = (BIT_STRING_t *)(*sptr = CALLOC(1, specs->struct_size));
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	FREEMEM(st->buf);
+	st->buf = (uint8_t *)MALLOC(len + 1);
+	if(!st->buf) {
+		st->size = 0;
+		_ASN_DECODE_FAILED;
+	}
+	memcpy(st->buf, buf + skip, len);
+	st->buf[len] = 0;
+	st->size = len;
+	st->bits_unused = bits_unused;
+	if(len) st->buf[len - 1] &= 0xff << bits_unused;
+
+	rval.consumed = skip + len;
+	return rval;
+}
+
+asn_enc_rval_t
+BIT_STRING_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_per_constraint_t *ct = constraints ? &constraints->size
+			: (td->per_constraints
+				? &td->per_constraints->size : 0);
+	const BIT_STRING_t *st = (const BIT_STRING_t *)sptr;
+	int bits_unused;
+	asn_enc_rval_t er;
+	ssize_t ret = 0;
+	uint8_t last;
+
+	if(!st || (st->size && !st->buf))
+		_ASN_ENCODE_FAILED;
+
+	bits_unused = st->size ? (st->bits_unused & 0x07) : 0;
+
+	if(ct && ct->flags == APC_CONSTRAINED
+	&& ct->lower_bound == ct->upper_bound) {
+		if(st->size * 8 - bits_unused != ct->upper_bound)
+			_ASN_ENCODE_FAILED;
+	} else {
+		uint8_t ub = bits_unused;
+		ret = oer_serialize_length(1 + st->size, cb, app_key);
+		if(ret < 0) _ASN_ENCODE_FAILED;
+		_ASN_CALLBACK(&ub, 1);
+		ret++;
+	}
+	er.encoded = ret + st->size;
+	if(!st->size)
+		_ASN_ENCODED_OK(er);
+
+	/* CANONICAL-OER: the unused bits are zero */
+	last = st->buf[st->size - 1];
+	if(flags & OER_F_CANONICAL)
+		last &= 0xff << bits_unused;
+	_ASN_CALLBACK2(st->buf, st->size - 1, &last, 1);
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
 
 /*
  * BIT STRING specific contents printer.
@@ -186,3 +432,45 @@ BIT_STRING_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	return 0;
 }
 
+
+/*
+ * The unused bits of the last octet take no part in the value.
+ */
+#define	BIT_STRING_UNUSED(st)	((st)->size > 0 ? ((st)->bits_unused & 0x07) : 0)
+#define	BIT_STRING_LAST(st)	\
+	((st)->buf[(st)->size - 1] & (0xff << BIT_STRING_UNUSED(st)))
+
+int
+BIT_STRING_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	const BIT_STRING_t *a = (const BIT_STRING_t *)struct_a;
+	const BIT_STRING_t *b = (const BIT_STRING_t *)struct_b;
+
+	(void)td;
+
+	if(a->size != b->size
+	|| BIT_STRING_UNUSED(a) != BIT_STRING_UNUSED(b))
+		return 0;
+	if(a->size <= 0)
+		return 1;
+
+	return memcmp(a->buf, b->buf, a->size - 1) == 0
+		&& BIT_STRING_LAST(a) == BIT_STRING_LAST(b);
+}
+
+uint64_t
+BIT_STRING_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	const BIT_STRING_t *st = (const BIT_STRING_t *)sptr;
+	uint64_t hash;
+
+	(void)td;
+
+	if(st->size <= 0)
+		return asn_hash__end(asn_hash__bytes(0, 0, 0));
+
+	hash = asn_hash__bytes(0, st->buf, st->size - 1);
+	hash = asn_hash__value(hash, BIT_STRING_LAST(st));
+	hash = asn_hash__value(hash, BIT_STRING_UNUSED(st));
+
+	return asn_hash__end(hash);
+}
@@ -33,7 +33,14 @@ asn_TYPE_descriptor_t asn_DEF_BMPString = {
 	  / sizeof(asn_DEF_BMPString_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	BMPString_decode_jer,
+	BMPString_encode_jer,
+	OCTET_STRING_decode_oer,
+	OCTET_STRING_encode_oer,
+	OCTET_STRING_equals,
+	OCTET_STRING_hash,
+	OCTET_STRING_copy
 };
 
 /*
@@ -77,6 +84,55 @@ BMPString__dump(const BMPString_t *st,
 	return wrote;
 }
 
+/*
+ * Convert the string decoded in UTF-8 format into UCS-2 in place.
+ */
+static int
+BMPString__from_utf8(UTF8String_t *st) {
+	uint32_t *wcs;
+	size_t wcs_len;
+
+	assert(st->buf);
+	wcs_len = UTF8String_to_wcs(st, 0, 0);
+
+	wcs = (uint32_t *)MALLOC(4 * (wcs_len + 1));
+	if(wcs == 0 || UTF8String_to_wcs(st, wcs, wcs_len) != wcs_len) {
+		FREEMEM(wcs);
+		return -1;
+	} else {
+		wcs[wcs_len] = 0;	/* nul-terminate */
+	}
+
+	if(1) {
+		/* Swap byte order and trim encoding to 2 bytes */
+		uint32_t *wc = wcs;
+		uint32_t *wc_end = wcs + wcs_len;
+		uint16_t *dstwc = (uint16_t *)wcs;
+		for(; wc < wc_end; wc++, dstwc++) {
+			uint32_t wch = *wc;
+			if(wch > 0xffff) {
+				FREEMEM(wcs);
+				return -1;
+			}
+			*((uint8_t *)dstwc + 0) = wch >> 8;
+			*((uint8_t *)dstwc + 1) = wch;
+		}
+		dstwc = (uint16_t *)REALLOC(wcs, 2 * (wcs_len + 1));
+		if(!dstwc) {
+			FREEMEM(wcs);
+			return -1;
+		} else {
+			dstwc[wcs_len] = 0;
+			wcs = (uint32_t *)dstwc;
+		}
+	}
+
+	FREEMEM(st->buf);
+	st->buf = (uint8_t *)wcs;
+	st->size = 2 * wcs_len;
+	return 0;
+}
+
 asn_dec_rval_t
 BMPString_decode_xer(asn_codec_ctx_t *opt_codec_ctx,
 	asn_TYPE_descriptor_t *td, void **sptr,
@@ -88,57 +144,12 @@ BMPString_decode_xer(asn_codec_ctx_t *opt_codec_ctx,
 	if(rc.code == RC_OK) {
 		/*
 		 * Now we have a whole string in UTF-8 format.
-		 * Convert it into UCS-2.
 		 */
-		uint32_t *wcs;
-		size_t wcs_len;
-		UTF8String_t *st;
-
 		assert(*sptr);
-		st = (UTF8String_t *)*sptr;
-		assert(st->buf);
-		wcs_len = UTF8String_to_wcs(st, 0, 0);
-
-		wcs = (uint32_t *)MALLOC(4 * (wcs_len + 1));
-		if(wcs == 0 || UTF8String_to_wcs(st, wcs, wcs_len) != wcs_len) {
+		if(BMPString__from_utf8((UTF8String_t *)*sptr)) {
 			rc.code = RC_FAIL;
 			rc.consumed = 0;
-			return rc;
-		} else {
-			wcs[wcs_len] = 0;	/* nul-terminate */
-		}
-
-		if(1) {
-			/* Swap byte order and trim encoding to 2 bytes */
-			uint32_t *wc = wcs;
-			uint32_t *wc_end = wcs + wcs_len;
-			uint16_t *dstwc = (uint16_t *)wcs;
-			for(; wc < wc_end; wc++, dstwc++) {
-				uint32_t wch = *wc;
-				if(wch > 0xffff) {
-					FREEMEM(wcs);
-					rc.code = RC_FAIL;
-					rc.consumed = 0;
-					return rc;
-				}
-				*((uint8_t *)dstwc + 0) = wch >> 8;
-				*((uint8_t *)dstwc + 1) = wch;
-			}
-			dstwc = (uint16_t *)REALLOC(wcs, 2 * (wcs_len + 1));
-			if(!dstwc) {
-				FREEMEM(wcs);
-				rc.code = RC_FAIL;
-				rc.consumed = 0;
-				return rc;
-			} else {
-				dstwc[2 * wcs_len] = 0;
-				wcs = (uint32_t *)dstwc;
-			}
 		}
-
-		FREEMEM(st->buf);
-		st->buf = (uint8_t *)wcs;
-		st->size = 2 * wcs_len;
 	}
 	return rc;
 }
@@ -162,6 +173,51 @@ BMPString_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+asn_dec_rval_t
+BMPString_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rc;
+
+	rc = OCTET_STRING_decode_jer_utf8(opt_codec_ctx, td, sptr,
+		buf_ptr, size);
+	if(rc.code == RC_OK) {
+		assert(*sptr);
+		if(BMPString__from_utf8((UTF8String_t *)*sptr)) {
+			rc.code = RC_FAIL;
+			rc.consumed = 0;
+		}
+	}
+	return rc;
+}
+
+asn_enc_rval_t
+BMPString_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const BMPString_t *st = (const BMPString_t *)sptr;
+	jer_escape_arg_t arg;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || !st->buf)
+		_ASN_ENCODE_FAILED;
+
+	/* Escape the UTF-8 produced by the printer */
+	arg.cb = cb;
+	arg.app_key = app_key;
+	arg.encoded = 0;
+	if(cb("\"", 1, app_key) < 0
+	|| BMPString__dump(st, jer_escape_consume, &arg) < 0
+	|| cb("\"", 1, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+
+	er.encoded = arg.encoded + 2;
+	_ASN_ENCODED_OK(er);
+}
+
 int
 BMPString_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 		asn_app_consume_bytes_f *cb, void *app_key) {
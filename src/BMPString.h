@@ -18,6 +18,8 @@ extern asn_TYPE_descriptor_t asn_DEF_BMPString;
 asn_struct_print_f BMPString_print;	/* Human-readable output */
 xer_type_decoder_f BMPString_decode_xer;
 xer_type_encoder_f BMPString_encode_xer;
+jer_type_decoder_f BMPString_decode_jer;
+jer_type_encoder_f BMPString_encode_jer;
 
 #ifdef __cplusplus
 }
@@ -31,7 +31,14 @@ asn_TYPE_descriptor_t asn_DEF_BOOLEAN = {
 	sizeof(asn_DEF_BOOLEAN_tags) / sizeof(asn_DEF_BOOLEAN_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	BOOLEAN_decode_jer,
+	BOOLEAN_encode_jer,
+	BOOLEAN_decode_oer,
+	BOOLEAN_encode_oer,
+	BOOLEAN_equals,
+	BOOLEAN_hash,
+	BOOLEAN_copy
 };
 
 /*
@@ -45,6 +52,7 @@ BOOLEAN_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	BOOLEAN_t *st = (BOOLEAN_t *)*bool_value;
 	asn_dec_rval_t rval;
 	ber_tlv_len_t length;
+	int eocs;
 	ber_tlv_len_t lidx;
 
 	if(st == NULL) {
@@ -62,8 +70,8 @@ BOOLEAN_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	/*
 	 * Check tags.
 	 */
-	rval = ber_check_tags(opt_codec_ctx, td, 0, buf_ptr, size,
-		tag_mode, 0, &length, 0);
+	rval = ber_check_tags_eocs(opt_codec_ctx, td, 0, buf_ptr, size,
+		tag_mode, 0, &length, 0, &eocs);
 	if(rval.code != RC_OK)
 		return rval;
 
@@ -76,6 +84,16 @@ BOOLEAN_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 		rval.consumed = 0;
 		return rval;
 	}
+	if(eocs) {
+		/* The outer tags of indefinite length are closed */
+		ssize_t skip = ber_skip_eocs((const char *)buf_ptr + length,
+			size - length, eocs);
+		if(skip <= 0) {
+			rval.code = skip ? RC_FAIL : RC_WMORE;
+			rval.consumed = 0;
+			return rval;
+		}
+	}
 
 	/*
 	 * Compute boolean value.
@@ -91,7 +109,7 @@ BOOLEAN_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	}
 
 	rval.code = RC_OK;
-	rval.consumed += length;
+	rval.consumed += length + 2 * eocs;
 
 	ASN_DEBUG("Took %ld/%ld bytes to encode %s, value=%d",
 		(long)rval.consumed, (long)length,
@@ -204,6 +222,60 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * Decode the JSON literal encoding BOOLEAN.
+ */
+static enum xer_pbd_rval
+BOOLEAN__jer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chunk_buf, size_t chunk_size) {
+	BOOLEAN_t *st = (BOOLEAN_t *)sptr;
+
+	(void)td;
+
+	if(chunk_size == 4 && memcmp(chunk_buf, "true", 4) == 0)
+		*st = 1;
+	else if(chunk_size == 5 && memcmp(chunk_buf, "false", 5) == 0)
+		*st = 0;
+	else
+		return XPBD_BROKEN_ENCODING;
+
+	return XPBD_BODY_CONSUMED;
+}
+
+asn_dec_rval_t
+BOOLEAN_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+
+	return jer_decode_primitive(opt_codec_ctx, td,
+		sptr, sizeof(BOOLEAN_t), buf_ptr, size,
+		JPB_LITERAL, BOOLEAN__jer_body_decode);
+}
+
+asn_enc_rval_t
+BOOLEAN_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const BOOLEAN_t *st = (const BOOLEAN_t *)sptr;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st) _ASN_ENCODE_FAILED;
+
+	if(*st) {
+		_ASN_CALLBACK("true", 4);
+		er.encoded = 4;
+	} else {
+		_ASN_CALLBACK("false", 5);
+		er.encoded = 5;
+	}
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
 int
 BOOLEAN_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	asn_app_consume_bytes_f *cb, void *app_key) {
@@ -230,6 +302,34 @@ BOOLEAN_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	return (cb(buf, buflen, app_key) < 0) ? -1 : 0;
 }
 
+int
+BOOLEAN_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	(void)td;
+	return !*(const BOOLEAN_t *)struct_a == !*(const BOOLEAN_t *)struct_b;
+}
+
+uint64_t
+BOOLEAN_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	(void)td;
+	return asn_hash__end(asn_hash__value(0, !!*(const BOOLEAN_t *)sptr));
+}
+
+int
+BOOLEAN_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	BOOLEAN_t *st;
+
+	(void)td;
+
+	st = (BOOLEAN_t *)asn_copy__struct(copy, struct_dst, sizeof(*st));
+	if(!st) return -1;
+	if(!ASN_COPY_MEASURING(copy))
+		*st = *(const BOOLEAN_t *)struct_src;
+
+	return 0;
+}
+
 void
 BOOLEAN_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 	if(td && ptr && !contents_only) {
@@ -278,7 +378,61 @@ BOOLEAN_encode_uper(asn_TYPE_descriptor_t *td,
 
 	if(!st) _ASN_ENCODE_FAILED;
 
-	per_put_few_bits(po, *st ? 1 : 0, 1);
+	if(per_put_few_bits(po, *st ? 1 : 0, 1))
+		_ASN_ENCODE_FAILED;
 
+	er.encoded = 0;	/* The bits are counted by uper_encode() */
 	_ASN_ENCODED_OK(er);
 }
+
+asn_dec_rval_t
+BOOLEAN_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rv;
+	BOOLEAN_t *st = (BOOLEAN_t *)*sptr;
+
+	(void)opt_codec_ctx;
+	(void)constraints;
+
+	if(size < 1) {
+		rv.code = RC_WMORE;
+		rv.consumed = 0;
+		return rv;
+	}
+
+	if(!st) {
+		st = (BOOLEAN_t *)(*sptr = MALLOC(sizeof(*st)));
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	/* Any non-zero octet is TRUE in BASIC-OER */
+	*st = *(const uint8_t *)buf_ptr ? 1 : 0;
+
+	ASN_DEBUG("%s decoded as %s", td->name, *st ? "TRUE" : "FALSE");
+
+	rv.code = RC_OK;
+	rv.consumed = 1;
+	return rv;
+}
+
+asn_enc_rval_t
+BOOLEAN_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const BOOLEAN_t *st = (const BOOLEAN_t *)sptr;
+	asn_enc_rval_t er;
+
+	(void)constraints;
+	(void)flags;
+
+	if(!st) _ASN_ENCODE_FAILED;
+
+	_ASN_CALLBACK(*st ? "\xff" : "\0", 1);
+	er.encoded = 1;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
@@ -33,7 +33,14 @@ asn_TYPE_descriptor_t asn_DEF_ENUMERATED = {
 	sizeof(asn_DEF_ENUMERATED_tags) / sizeof(asn_DEF_ENUMERATED_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	INTEGER_decode_jer,
+	INTEGER_encode_jer,
+	ENUMERATED_decode_oer,
+	ENUMERATED_encode_oer,
+	INTEGER_equals,
+	INTEGER_hash,
+	ASN__PRIMITIVE_TYPE_copy
 };
 
 asn_dec_rval_t
@@ -69,3 +76,40 @@ ENUMERATED_encode_uper(asn_TYPE_descriptor_t *td,
 	return NativeEnumerated_encode_uper(td, constraints, &value, po);
 }
 
+
+asn_dec_rval_t
+ENUMERATED_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rval;
+	ENUMERATED_t *st = (ENUMERATED_t *)*sptr;
+	long value;
+	void *vptr = &value;
+
+	if(!st) {
+		st = (ENUMERATED_t *)(*sptr = CALLOC(1, sizeof(*st)));
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	rval = NativeEnumerated_decode_oer(opt_codec_ctx, td, constraints,
+			(void **)&vptr, buf_ptr, size);
+	if(rval.code == RC_OK)
+		if(asn_long2INTEGER(st, value))
+			rval.code = RC_FAIL;
+	return rval;
+}
+
+asn_enc_rval_t
+ENUMERATED_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	ENUMERATED_t *st = (ENUMERATED_t *)sptr;
+	long value;
+
+	if(asn_INTEGER2long(st, &value))
+		_ASN_ENCODE_FAILED;
+
+	return NativeEnumerated_encode_oer(td, constraints, &value, flags,
+		cb, app_key);
+}
@@ -167,7 +167,14 @@ asn_TYPE_descriptor_t asn_DEF_GeneralizedTime = {
 	  / sizeof(asn_DEF_GeneralizedTime_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	OCTET_STRING_decode_jer_utf8,
+	OCTET_STRING_encode_jer_utf8,
+	OCTET_STRING_decode_oer,
+	OCTET_STRING_encode_oer,
+	OCTET_STRING_equals,
+	OCTET_STRING_hash,
+	OCTET_STRING_copy
 };
 
 #endif	/* __ASN_INTERNAL_TEST_MODE__ */
@@ -198,29 +205,30 @@ GeneralizedTime_encode_der(asn_TYPE_descriptor_t *td, void *sptr,
 	int tag_mode, ber_tlv_tag_t tag,
 	asn_app_consume_bytes_f *cb, void *app_key) {
 	GeneralizedTime_t *st = (GeneralizedTime_t *)sptr;
-	asn_enc_rval_t erval;
+	GeneralizedTime_t gt;
+	char buf[ASN_GT_BUF_SIZE];
+	ssize_t size;
 	int fv, fd;	/* seconds fraction value and number of digits */
-	struct tm tm;
 	time_t tloc;
 
 	/*
 	 * Encode as a canonical DER.
 	 */
 	errno = EPERM;
-	tloc = asn_GT2time_frac(st, &fv, &fd, &tm, 1);	/* Recognize time */
+	tloc = asn_GT2time_frac(st, &fv, &fd, 0, 1);	/* Recognize time */
 	if(tloc == -1 && errno != EPERM)
 		/* Failed to recognize time. Fail completely. */
 		_ASN_ENCODE_FAILED;
 
-	st = asn_time2GT_frac(0, &tm, fv, fd, 1); /* Save time canonically */
-	if(!st) _ASN_ENCODE_FAILED;	/* Memory allocation failure. */
+	/* Save time canonically, on stack */
+	size = asn_time2GT_buf(buf, sizeof(buf), tloc, fv, fd);
+	if(size < 0) _ASN_ENCODE_FAILED;
 
-	erval = OCTET_STRING_encode_der(td, st, tag_mode, tag, cb, app_key);
+	memset(&gt, 0, sizeof(gt));
+	gt.buf = (uint8_t *)buf;
+	gt.size = size;
 
-	FREEMEM(st->buf);
-	FREEMEM(st);
-
-	return erval;
+	return OCTET_STRING_encode_der(td, &gt, tag_mode, tag, cb, app_key);
 }
 
 #ifndef	__ASN_INTERNAL_TEST_MODE__
@@ -681,3 +689,183 @@ asn_time2GT_frac(GeneralizedTime_t *opt_gt, const struct tm *tm, int frac_value,
 }
 
 
+
+/*
+ * "00" "01" ... "99": two digits at a time.
+ */
+static const char _asn_digit_pairs[] =
+	"00010203040506070809101112131415161718192021222324"
+	"25262728293031323334353637383940414243444546474849"
+	"50515253545556575859606162636465666768697071727374"
+	"75767778798081828384858687888990919293949596979899";
+#define	_ASN_PUT2(p, v)	do {			\
+		memcpy((p), &_asn_digit_pairs[2 * (v)], 2);	\
+		(p) += 2;			\
+	} while(0)
+
+/*
+ * Render the seconds part "YYYYMMDDhhmmss" of the GMT time.
+ * The calendar date is derived from the number of days since the epoch
+ * directly (proleptic Gregorian calendar), without gmtime_r().
+ */
+static int
+_asn_time2GT_seconds(time_t tloc, char *text) {
+	long days = (long)(tloc / 86400);
+	long secs = (long)(tloc % 86400);
+	long era;
+	unsigned long doe, yoe, doy, mp;
+	unsigned int month, mday;
+	long year;
+
+	if(secs < 0) { secs += 86400; days--; }
+
+	/* Days since 0000-03-01, split into 400-year eras */
+	days += 719468;
+	era = (days >= 0 ? days : days - 146096) / 146097;
+	doe = (unsigned long)(days - era * 146097);
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+	mday = (unsigned int)(doy - (153 * mp + 2) / 5 + 1);
+	month = (unsigned int)(mp < 10 ? mp + 3 : mp - 9);
+	year = (long)yoe + era * 400 + (month <= 2);
+
+	if(year < 0 || year > 9999) {
+		errno = ERANGE;
+		return -1;
+	}
+
+	_ASN_PUT2(text, year / 100);
+	_ASN_PUT2(text, year % 100);
+	_ASN_PUT2(text, month);
+	_ASN_PUT2(text, mday);
+	_ASN_PUT2(text, secs / 3600);
+	_ASN_PUT2(text, (secs / 60) % 60);
+	_ASN_PUT2(text, secs % 60);
+
+	return 0;
+}
+
+#ifdef	ASN_THREAD_LOCAL
+/* The last second converted by this thread */
+static ASN_THREAD_LOCAL struct {
+	time_t tloc;
+	int valid;
+	char text[14];
+} _asn_GT_cache;
+#endif	/* ASN_THREAD_LOCAL */
+
+ssize_t
+asn_time2GT_buf(char *buf, size_t size, time_t tloc, int frac_value, int frac_digits) {
+	static const long pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+	char frac[1 + 6];
+	size_t flen = 0;
+	const char *text;
+#ifndef	ASN_THREAD_LOCAL
+	char text_s[14];
+#endif
+	char *p;
+
+	if(!buf) {
+		errno = EINVAL;
+		return -1;
+	}
+
+#ifdef	ASN_THREAD_LOCAL
+	if(!_asn_GT_cache.valid || _asn_GT_cache.tloc != tloc) {
+		_asn_GT_cache.valid = 0;
+		if(_asn_time2GT_seconds(tloc, _asn_GT_cache.text))
+			return -1;
+		_asn_GT_cache.tloc = tloc;
+		_asn_GT_cache.valid = 1;
+	}
+	text = _asn_GT_cache.text;
+#else	/* !ASN_THREAD_LOCAL */
+	if(_asn_time2GT_seconds(tloc, text_s))
+		return -1;
+	text = text_s;
+#endif	/* ASN_THREAD_LOCAL */
+
+	/*
+	 * Deal with fractions, same as asn_time2GT_frac() does:
+	 * at most 6 digits, trailing zeroes stripped, omitted if out of range.
+	 */
+	if(frac_value > 0 && frac_digits > 0) {
+		long fv = frac_value;
+
+		/* Place bounds on precision */
+		for(; frac_digits > 6; frac_digits--)
+			fv /= 10;
+
+		if(fv > 0 && fv < pow10[frac_digits]) {
+			char *z = frac;
+			fv *= pow10[6 - frac_digits];	/* Scale to usec */
+			*z++ = '.';
+			_ASN_PUT2(z, fv / 10000);
+			_ASN_PUT2(z, (fv / 100) % 100);
+			_ASN_PUT2(z, fv % 100);
+			for(--z; *z == 0x30; --z);	/* Strip zeroes */
+			flen = z + 1 - frac;
+		}
+	}
+
+	if(size < 14 + flen + 1 + 1) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	memcpy(buf, text, 14);
+	p = buf + 14;
+	if(flen) {
+		memcpy(p, frac, flen);
+		p += flen;
+	}
+	*p++ = 0x5a;	/* "Z" */
+	*p = 0;
+
+	return p - buf;
+}
+
+GeneralizedTime_t *
+asn_time2GT_fast(GeneralizedTime_t *opt_gt, time_t tloc, int frac_value, int frac_digits) {
+	ssize_t size;
+	char *buf;
+
+	/*
+	 * Reuse the buffer in place, if the text and its '\0' fit into it.
+	 * Nothing is known about the memory past its (size) bytes.
+	 */
+	if(opt_gt && opt_gt->buf && opt_gt->size > 0) {
+		size = asn_time2GT_buf((char *)opt_gt->buf, opt_gt->size,
+			tloc, frac_value, frac_digits);
+		if(size >= 0) {
+			opt_gt->size = size;
+			return opt_gt;
+		}
+		if(errno != EINVAL)
+			return 0;
+	}
+
+	buf = (char *)MALLOC(ASN_GT_BUF_SIZE);
+	if(!buf) return 0;
+
+	size = asn_time2GT_buf(buf, ASN_GT_BUF_SIZE,
+		tloc, frac_value, frac_digits);
+	if(size < 0) {
+		FREEMEM(buf);
+		return 0;
+	}
+
+	if(opt_gt) {
+		if(opt_gt->buf)
+			FREEMEM(opt_gt->buf);
+	} else {
+		opt_gt = (GeneralizedTime_t *)CALLOC(1, sizeof *opt_gt);
+		if(!opt_gt) { FREEMEM(buf); return 0; }
+	}
+
+	opt_gt->buf = (unsigned char *)buf;
+	opt_gt->size = size;
+
+	return opt_gt;
+}
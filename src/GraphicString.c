@@ -32,6 +32,13 @@ asn_TYPE_descriptor_t asn_DEF_GraphicString = {
 	  / sizeof(asn_DEF_GraphicString_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	OCTET_STRING_decode_jer_hex,
+	OCTET_STRING_encode_jer,
+	OCTET_STRING_decode_oer,
+	OCTET_STRING_encode_oer,
+	OCTET_STRING_equals,
+	OCTET_STRING_hash,
+	OCTET_STRING_copy
 };
 
@@ -7,6 +7,15 @@
 #include <INTEGER.h>
 #include <asn_codecs_prim.h>	/* Encoder and decoder of a primitive type */
 #include <errno.h>
+#include <limits.h>	/* for LONG_MAX */
+
+/*
+ * The longest JER number accepted: the cost of its conversion
+ * into the binary form grows as the square of its length.
+ */
+#ifndef	ASN_JER_INTEGER_DIGITS_MAX
+#define	ASN_JER_INTEGER_DIGITS_MAX	2560	/* Fits 8192-bit numbers */
+#endif
 
 /*
  * INTEGER basic type description.
@@ -33,7 +42,14 @@ asn_TYPE_descriptor_t asn_DEF_INTEGER = {
 	sizeof(asn_DEF_INTEGER_tags) / sizeof(asn_DEF_INTEGER_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	INTEGER_decode_jer,
+	INTEGER_encode_jer,
+	INTEGER_decode_oer,
+	INTEGER_encode_oer,
+	INTEGER_equals,
+	INTEGER_hash,
+	ASN__PRIMITIVE_TYPE_copy
 };
 
 /*
@@ -137,7 +153,8 @@ INTEGER__dump(asn_TYPE_descriptor_t *td, const INTEGER_t *st, asn_app_consume_by
 		} else {
 			accum = (*buf & 0x80) ? -1 : 0;
 			for(; buf < buf_end; buf++)
-				accum = (accum << 8) | *buf;
+				accum = (long)(((unsigned long)accum << 8)
+					| *buf);
 		}
 
 		el = INTEGER_map_value2enum(specs, accum);
@@ -215,6 +232,57 @@ INTEGER_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	return (ret < 0) ? -1 : 0;
 }
 
+/*
+ * Skip the leading octets which only extend the sign, so that the
+ * differently padded encodings of the same number compare equal.
+ */
+static const uint8_t *
+INTEGER__significant(const INTEGER_t *st, size_t *size_r) {
+	static const uint8_t zero[1] = { 0 };
+	const uint8_t *buf = st->buf;
+	size_t size = st->size > 0 ? st->size : 0;
+
+	if(!buf || !size) {
+		*size_r = sizeof(zero);
+		return zero;
+	}
+
+	for(; size > 1; buf++, size--) {
+		if(!((buf[0] == 0x00 && !(buf[1] & 0x80))
+		  || (buf[0] == 0xff && (buf[1] & 0x80))))
+			break;
+	}
+
+	*size_r = size;
+	return buf;
+}
+
+int
+INTEGER_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	const uint8_t *a, *b;
+	size_t a_size, b_size;
+
+	(void)td;
+
+	a = INTEGER__significant((const INTEGER_t *)struct_a, &a_size);
+	b = INTEGER__significant((const INTEGER_t *)struct_b, &b_size);
+
+	return a_size == b_size && memcmp(a, b, a_size) == 0;
+}
+
+uint64_t
+INTEGER_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	const uint8_t *buf;
+	size_t size;
+
+	(void)td;
+
+	buf = INTEGER__significant((const INTEGER_t *)sptr, &size);
+
+	return asn_hash__end(asn_hash__bytes(0, buf, size));
+}
+
 struct e2v_key {
 	const char *start;
 	const char *stop;
@@ -240,11 +308,12 @@ INTEGER__compar_enum2value(const void *kp, const void *am) {
 	return name[0] ? -1 : 0;
 }
 
+static const asn_INTEGER_enum_map_t *INTEGER__map_name2value(
+	asn_INTEGER_specifics_t *specs, const char *lstart, const char *lstop);
+
 static const asn_INTEGER_enum_map_t *
 INTEGER_map_enum2value(asn_INTEGER_specifics_t *specs, const char *lstart, const char *lstop) {
-	asn_INTEGER_enum_map_t *el_found;
 	int count = specs ? specs->map_count : 0;
-	struct e2v_key key;
 	const char *lp;
 
 	if(!count) return NULL;
@@ -264,6 +333,20 @@ INTEGER_map_enum2value(asn_INTEGER_specifics_t *specs, const char *lstart, const
 	if(lp == lstop) return NULL;	/* No tag found */
 	lstop = lp;
 
+	return INTEGER__map_name2value(specs, lstart, lstop);
+}
+
+/*
+ * Find the enumeration map entry by the bare identifier.
+ */
+static const asn_INTEGER_enum_map_t *
+INTEGER__map_name2value(asn_INTEGER_specifics_t *specs, const char *lstart, const char *lstop) {
+	asn_INTEGER_enum_map_t *el_found;
+	int count = specs ? specs->map_count : 0;
+	struct e2v_key key;
+
+	if(!count) return NULL;
+
 	key.start = lstart;
 	key.stop = lstop;
 	key.vemap = specs->value2enum;
@@ -394,24 +477,21 @@ INTEGER__xer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chun
 			}
 
 		    {
-			long new_value = value * 10;
-
-			if(new_value / 10 != value)
-				/* Overflow */
-				return XPBD_DECODER_LIMIT;
+			long d = lv - 0x30;
 
-			value = new_value + (lv - 0x30);
-			/* Check for two's complement overflow */
-			if(value < 0) {
+			if(value < 0	/* Past LONG_MIN already */
+			|| value > (LONG_MAX - d) / 10) {
 				/* Check whether it is a LONG_MIN */
-				if(sign == -1
-				&& (unsigned long)value
-						== ~((unsigned long)-1 >> 1)) {
+				if(sign == -1 && value == LONG_MAX / 10
+				&& d == LONG_MAX % 10 + 1) {
+					value = LONG_MIN;
 					sign = 1;
 				} else {
 					/* Overflow */
 					return XPBD_DECODER_LIMIT;
 				}
+			} else {
+				value = value * 10 + d;
 			}
 		    }
 			continue;
@@ -457,7 +537,6 @@ INTEGER__xer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chun
 		case 0x61:case 0x62:case 0x63:case 0x64:case 0x65:case 0x66:
 			switch(state) {
 			case ST_SKIPSPHEX:
-			case ST_SKIPSPACE: /* Fall through */
 			case ST_HEXDIGIT1:
 				value = lv - ((lv < 0x61) ? 0x41 : 0x61);
 				value += 10;
@@ -470,6 +549,7 @@ INTEGER__xer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chun
 				st->buf[st->size++] = value;
 				state = ST_HEXCOLON;
 				continue;
+			case ST_SKIPSPACE:	/* No buffer for the hex yet */
 			case ST_DIGITS:
 				ASN_DEBUG("INTEGER re-evaluate as hex form");
 				if(INTEGER_st_prealloc(st, (chunk_size/3) + 1))
@@ -551,6 +631,239 @@ INTEGER_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * Print the INTEGER of any size in decimal.
+ */
+static ssize_t
+INTEGER__dump_decimal(const INTEGER_t *st, asn_app_consume_bytes_f *cb, void *app_key) {
+	char scratch[32];	/* Enough for 64-bit integer */
+	uint8_t *mag;		/* Magnitude, big-endian */
+	char *digits;
+	char *dp;
+	size_t mag_size;
+	size_t i;
+	long value;
+	int negative;
+	int ret;
+
+	if(asn_INTEGER2long(st, &value) == 0) {
+		ret = snprintf(scratch, sizeof(scratch), "%ld", value);
+		assert(ret > 0 && (size_t)ret < sizeof(scratch));
+		return (cb(scratch, ret, app_key) < 0) ? -1 : ret;
+	}
+
+	/*
+	 * Too large for long: divide the magnitude by 10^9 repeatedly.
+	 * Every byte yields at most 3 decimal digits.
+	 */
+	mag_size = st->size;
+	mag = (uint8_t *)MALLOC(mag_size + mag_size * 3 + 1);
+	if(!mag) return -1;
+	digits = (char *)mag + mag_size;
+	dp = digits + mag_size * 3 + 1;
+
+	memcpy(mag, st->buf, mag_size);
+	negative = (mag[0] & 0x80) != 0;
+	if(negative) {
+		/* Two's complement negation */
+		int carry = 1;
+		for(i = mag_size; i-- > 0;) {
+			int v = (uint8_t)~mag[i] + carry;
+			mag[i] = (uint8_t)v;
+			carry = v >> 8;
+		}
+	}
+
+	for(i = 0; i < mag_size;) {
+		uint32_t rem = 0;
+		size_t j;
+		int k;
+		for(j = i; j < mag_size; j++) {
+			uint64_t cur = ((uint64_t)rem << 8) | mag[j];
+			mag[j] = (uint8_t)(cur / 1000000000);
+			rem = (uint32_t)(cur % 1000000000);
+		}
+		while(i < mag_size && mag[i] == 0) i++;
+		/* Nine digits, except for the most significant group */
+		for(k = 0; k < 9 && (rem || i < mag_size); k++) {
+			*--dp = 0x30 + (rem % 10);
+			rem /= 10;
+		}
+	}
+	if(negative) *--dp = 0x2d;	/* '-' */
+
+	ret = (digits + mag_size * 3 + 1) - dp;
+	if(cb(dp, ret, app_key) < 0)
+		ret = -1;
+	FREEMEM(mag);
+	return ret;
+}
+
+/*
+ * Decode the JSON number or the identifier of the named value.
+ */
+static enum xer_pbd_rval
+INTEGER__jer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chunk_buf, size_t chunk_size) {
+	asn_INTEGER_specifics_t *specs=(asn_INTEGER_specifics_t *)td->specifics;
+	INTEGER_t *st = (INTEGER_t *)sptr;
+	const char *lstart = (const char *)chunk_buf;
+	const char *lstop = lstart + chunk_size;
+	const char *lp = lstart;
+	int negative = 0;
+	long value = 0;
+	uint32_t *limbs;
+	size_t limbs_count;
+	size_t used;
+	uint8_t *buf;
+	size_t size;
+	size_t i;
+
+	if(!chunk_size)
+		return XPBD_BROKEN_ENCODING;
+
+	if(*lp == 0x2d) {	/* '-' */
+		negative = 1;
+		lp++;
+	}
+
+	if(lp == lstop || *lp < 0x30 || *lp > 0x39) {
+		/* Must be an identifier */
+		const asn_INTEGER_enum_map_t *el;
+		if(negative) return XPBD_BROKEN_ENCODING;
+		el = INTEGER__map_name2value(specs, lstart, lstop);
+		if(!el) return XPBD_BROKEN_ENCODING;
+		if(asn_long2INTEGER(st, el->nat_value))
+			return XPBD_SYSTEM_FAILURE;
+		return XPBD_BODY_CONSUMED;
+	}
+
+	/* Simple case: the value fits the long */
+	for(; lp < lstop; lp++) {
+		int d = *lp - 0x30;
+		if(d < 0 || d > 9) return XPBD_BROKEN_ENCODING;	/* 1.0, 1e3 */
+		if(value > (LONG_MAX - d) / 10) break;
+		value = value * 10 + d;
+	}
+	if(lp == lstop) {
+		if(asn_long2INTEGER(st, negative ? -value : value))
+			return XPBD_SYSTEM_FAILURE;
+		return XPBD_BODY_CONSUMED;
+	}
+
+	if(lstop - (lstart + negative) > ASN_JER_INTEGER_DIGITS_MAX)
+		return XPBD_BROKEN_ENCODING;
+
+	/*
+	 * Long arithmetic: accumulate the magnitude in the 32-bit limbs,
+	 * least significant first. The digits are taken nine at a time,
+	 * and only the (used) limbs are multiplied, for the cost is
+	 * quadratic. Every decimal digit takes less than half a byte.
+	 */
+	size = (lstop - lstart) / 2 + 2;
+	limbs_count = size / 4 + 1;
+	size = limbs_count * 4;
+	limbs = (uint32_t *)CALLOC(limbs_count, sizeof(limbs[0]));
+	if(!limbs) return XPBD_SYSTEM_FAILURE;
+	for(used = 0, lp = lstart + negative; lp < lstop;) {
+		unsigned long long carry = 0;
+		unsigned long scale = 1;
+		for(; lp < lstop && scale < 1000000000UL; lp++, scale *= 10) {
+			int d = *lp - 0x30;
+			if(d < 0 || d > 9) {
+				FREEMEM(limbs);
+				return XPBD_BROKEN_ENCODING;
+			}
+			carry = carry * 10 + d;
+		}
+		for(i = 0; i < used; i++) {
+			unsigned long long v = limbs[i]
+				* (unsigned long long)scale + carry;
+			limbs[i] = (uint32_t)v;
+			carry = v >> 32;
+		}
+		if(carry && used < limbs_count)
+			limbs[used++] = (uint32_t)carry;
+	}
+
+	/* Serialize the magnitude in base 256, most significant first */
+	buf = (uint8_t *)MALLOC(size + 1);
+	if(!buf) {
+		FREEMEM(limbs);
+		return XPBD_SYSTEM_FAILURE;
+	}
+	for(i = 0; i < size; i++)
+		buf[size - 1 - i] = (uint8_t)(limbs[i >> 2] >> ((i & 3) << 3));
+	FREEMEM(limbs);
+	if(negative) {
+		int carry = 1;
+		for(i = size; i-- > 0;) {
+			int v = (uint8_t)~buf[i] + carry;
+			buf[i] = (uint8_t)v;
+			carry = v >> 8;
+		}
+	}
+
+	/* Strip the insignificant leading bytes */
+	for(i = 0; i < size - 1; i++) {
+		if(buf[i] == 0x00 && !(buf[i+1] & 0x80)) continue;
+		if(buf[i] == 0xff && (buf[i+1] & 0x80)) continue;
+		break;
+	}
+	memmove(buf, buf + i, size - i);
+
+	FREEMEM(st->buf);
+	st->buf = buf;
+	st->size = size - i;
+	st->buf[st->size] = 0;	/* Just in case termination */
+	return XPBD_BODY_CONSUMED;
+}
+
+asn_dec_rval_t
+INTEGER_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+
+	return jer_decode_primitive(opt_codec_ctx, td,
+		sptr, sizeof(INTEGER_t), buf_ptr, size,
+		JPB_NUMBER | JPB_STRING, INTEGER__jer_body_decode);
+}
+
+asn_enc_rval_t
+INTEGER_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_INTEGER_specifics_t *specs=(asn_INTEGER_specifics_t *)td->specifics;
+	const INTEGER_t *st = (const INTEGER_t *)sptr;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || !st->buf)
+		_ASN_ENCODE_FAILED;
+
+	if(specs && specs->strict_enumeration) {
+		/* ENUMERATED is represented by the identifier */
+		const asn_INTEGER_enum_map_t *el;
+		long value;
+		if(asn_INTEGER2long(st, &value))
+			_ASN_ENCODE_FAILED;
+		el = INTEGER_map_value2enum(specs, value);
+		if(!el) {
+			ASN_DEBUG("ASN.1 forbids dealing with "
+				"unknown value of ENUMERATED type");
+			_ASN_ENCODE_FAILED;
+		}
+		er.encoded = jer_encode_string(el->enum_name, el->enum_len,
+			cb, app_key);
+	} else {
+		er.encoded = INTEGER__dump_decimal(st, cb, app_key);
+	}
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
 asn_dec_rval_t
 INTEGER_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 	asn_per_constraints_t *constraints, void **sptr, asn_per_data_t *pd) {
@@ -719,6 +1032,150 @@ INTEGER_encode_uper(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(er);
 }
 
+asn_dec_rval_t
+INTEGER_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_INTEGER_specifics_t *specs=(asn_INTEGER_specifics_t *)td->specifics;
+	asn_dec_rval_t rval = { RC_OK, 0 };
+	INTEGER_t *st = (INTEGER_t *)*sptr;
+	const uint8_t *buf = (const uint8_t *)buf_ptr;
+	asn_per_constraint_t *ct;
+	int width, is_unsigned = 0;
+	long value = 0;
+	ssize_t skip;
+	size_t len = 0;
+
+	(void)opt_codec_ctx;
+
+	if(!constraints) constraints = td->per_constraints;
+	ct = constraints ? &constraints->value : 0;
+
+	if(specs && specs->strict_enumeration) {
+		skip = oer_fetch_enumerated(buf, size, &value);
+		width = -1;
+	} else {
+		width = oer_integer_width(ct, &is_unsigned);
+		if(width) {
+			skip = oer_fetch_long(buf, size, width, is_unsigned,
+				&value);
+		} else {
+			skip = oer_fetch_length(buf, size, &len);
+			if(skip > 0 && size - skip < len) skip = 0;
+		}
+	}
+	if(skip < 0) _ASN_DECODE_FAILED;
+	if(skip == 0) {
+		rval.code = RC_WMORE;
+		return rval;
+	}
+
+	if(!st) {
+		st = (INTEGER_t *)(*sptr = CALLOC(1, sizeof(*st)));
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	if(width) {
+		/* Fixed width or ENUMERATED, fits the long */
+		if(asn_long2INTEGER(st, value))
+			_ASN_DECODE_FAILED;
+		rval.consumed = skip;
+		return rval;
+	}
+
+	/* X.696 #10.3, #10.4: length-prefixed, possibly beyond the long */
+	buf += skip;
+	if(len == 0 || len >= INT_MAX)
+		_ASN_DECODE_FAILED;
+	FREEMEM(st->buf);
+	st->buf = (uint8_t *)MALLOC(len + 2);
+	if(!st->buf) {
+		st->size = 0;
+		_ASN_DECODE_FAILED;
+	}
+	st->size = 0;
+	if(is_unsigned && (buf[0] & 0x80))
+		st->buf[st->size++] = 0x00;	/* Not a negative number */
+	memcpy(st->buf + st->size, buf, len);
+	st->size += len;
+	st->buf[st->size] = 0;
+
+	rval.consumed = skip + len;
+	return rval;
+}
+
+asn_enc_rval_t
+INTEGER_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_INTEGER_specifics_t *specs=(asn_INTEGER_specifics_t *)td->specifics;
+	const INTEGER_t *st = (const INTEGER_t *)sptr;
+	asn_per_constraint_t *ct;
+	const uint8_t *buf, *end;
+	int width, is_unsigned;
+	asn_enc_rval_t er;
+	long value;
+	ssize_t ret;
+
+	(void)flags;
+
+	if(!st || (st->size && !st->buf))
+		_ASN_ENCODE_FAILED;
+
+	if(!constraints) constraints = td->per_constraints;
+	ct = constraints ? &constraints->value : 0;
+
+	if(specs && specs->strict_enumeration) {
+		if(asn_INTEGER2long(st, &value))
+			_ASN_ENCODE_FAILED;
+		er.encoded = oer_serialize_enumerated(value, cb, app_key);
+		if(er.encoded < 0) _ASN_ENCODE_FAILED;
+		_ASN_ENCODED_OK(er);
+	}
+
+	width = oer_integer_width(ct, &is_unsigned);
+	if(width) {
+		if(asn_INTEGER2long(st, &value)
+		|| value < ct->lower_bound || value > ct->upper_bound)
+			_ASN_ENCODE_FAILED;
+		er.encoded = oer_serialize_long(value, width, is_unsigned,
+			cb, app_key);
+		if(er.encoded < 0) _ASN_ENCODE_FAILED;
+		_ASN_ENCODED_OK(er);
+	}
+
+	if(st->size) {
+		buf = st->buf;
+		end = st->buf + st->size;
+	} else {
+		buf = (const uint8_t *)"";	/* Zero */
+		end = buf + 1;
+	}
+
+	/* Skip the redundant leading octets */
+	for(; buf < end - 1; buf++) {
+		if(buf[0] == 0x00 && !(buf[1] & 0x80)) continue;
+		if(buf[0] == 0xff && (buf[1] & 0x80)) continue;
+		break;
+	}
+	if(is_unsigned) {
+		if(buf[0] & 0x80)
+			_ASN_ENCODE_FAILED;	/* Negative */
+		if(buf[0] == 0x00 && buf < end - 1)
+			buf++;	/* The sign octet is implied */
+	}
+
+	ret = oer_serialize_length(end - buf, cb, app_key);
+	if(ret < 0) _ASN_ENCODE_FAILED;
+	_ASN_CALLBACK(buf, end - buf);
+	er.encoded = ret + (end - buf);
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
 int
 asn_INTEGER2long(const INTEGER_t *iptr, long *lptr) {
 	uint8_t *b, *end;
@@ -773,7 +1230,7 @@ asn_INTEGER2long(const INTEGER_t *iptr, long *lptr) {
 
 	/* Conversion engine */
 	for(; b < end; b++)
-		l = (l << 8) | *b;
+		l = (long)(((unsigned long)l << 8) | *b);
 
 	*lptr = l;
 	return 0;
@@ -32,7 +32,14 @@ asn_TYPE_descriptor_t asn_DEF_NULL = {
 	sizeof(asn_DEF_NULL_tags) / sizeof(asn_DEF_NULL_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	NULL_decode_jer,
+	NULL_encode_jer,
+	NULL_decode_oer,
+	NULL_encode_oer,
+	NULL_equals,
+	NULL_hash,
+	BOOLEAN_copy
 };
 
 asn_enc_rval_t
@@ -90,6 +97,44 @@ NULL_decode_xer(asn_codec_ctx_t *opt_codec_ctx,
 		NULL__xer_body_decode);
 }
 
+static enum xer_pbd_rval
+NULL__jer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chunk_buf, size_t chunk_size) {
+	(void)td;
+	(void)sptr;
+
+	if(chunk_size == 4 && memcmp(chunk_buf, "null", 4) == 0)
+		return XPBD_BODY_CONSUMED;
+	else
+		return XPBD_BROKEN_ENCODING;
+}
+
+asn_dec_rval_t
+NULL_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+
+	return jer_decode_primitive(opt_codec_ctx, td,
+		sptr, sizeof(NULL_t), buf_ptr, size,
+		JPB_LITERAL, NULL__jer_body_decode);
+}
+
+asn_enc_rval_t
+NULL_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	_ASN_CALLBACK("null", 4);
+	er.encoded = 4;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
 int
 NULL_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	asn_app_consume_bytes_f *cb, void *app_key) {
@@ -104,6 +149,22 @@ NULL_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	}
 }
 
+int
+NULL_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	(void)td;
+	(void)struct_a;
+	(void)struct_b;
+	return 1;	/* Present NULLs are all the same */
+}
+
+uint64_t
+NULL_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	(void)td;
+	(void)sptr;
+	return asn_hash__end(1);
+}
+
 asn_dec_rval_t
 NULL_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 	asn_per_constraints_t *constraints, void **sptr, asn_per_data_t *pd) {
@@ -145,3 +206,50 @@ NULL_encode_uper(asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
 	er.encoded = 0;
 	_ASN_ENCODED_OK(er);
 }
+
+asn_dec_rval_t
+NULL_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rv;
+
+	(void)opt_codec_ctx;
+	(void)td;
+	(void)constraints;
+	(void)buf_ptr;
+	(void)size;
+
+	if(!*sptr) {
+		*sptr = MALLOC(sizeof(NULL_t));
+		if(*sptr) {
+			*(NULL_t *)*sptr = 0;
+		} else {
+			_ASN_DECODE_FAILED;
+		}
+	}
+
+	/*
+	 * NULL type does not have content octets.
+	 */
+
+	rv.code = RC_OK;
+	rv.consumed = 0;
+	return rv;
+}
+
+asn_enc_rval_t
+NULL_encode_oer(asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+	void *sptr, enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+
+	(void)td;
+	(void)constraints;
+	(void)sptr;
+	(void)flags;
+	(void)cb;
+	(void)app_key;
+
+	er.encoded = 0;
+	_ASN_ENCODED_OK(er);
+}
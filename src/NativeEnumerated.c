@@ -37,7 +37,14 @@ asn_TYPE_descriptor_t asn_DEF_NativeEnumerated = {
 	sizeof(asn_DEF_NativeEnumerated_tags) / sizeof(asn_DEF_NativeEnumerated_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	NativeInteger_decode_jer,
+	NativeEnumerated_encode_jer,
+	NativeEnumerated_decode_oer,
+	NativeEnumerated_encode_oer,
+	NativeInteger_equals,
+	NativeInteger_hash,
+	NativeInteger_copy
 };
 
 asn_enc_rval_t
@@ -70,6 +77,34 @@ NativeEnumerated_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	}
 }
 
+asn_enc_rval_t
+NativeEnumerated_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_INTEGER_specifics_t *specs=(asn_INTEGER_specifics_t *)td->specifics;
+	asn_enc_rval_t er;
+	const long *native = (const long *)sptr;
+	const asn_INTEGER_enum_map_t *el;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!native) _ASN_ENCODE_FAILED;
+
+	el = INTEGER_map_value2enum(specs, *native);
+	if(!el) {
+		ASN_DEBUG("ASN.1 forbids dealing with "
+			"unknown value of ENUMERATED type");
+		_ASN_ENCODE_FAILED;
+	}
+
+	er.encoded = jer_encode_string(el->enum_name, el->enum_len,
+		cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
 asn_dec_rval_t
 NativeEnumerated_decode_uper(asn_codec_ctx_t *opt_codec_ctx,
 	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
@@ -202,3 +237,53 @@ NativeEnumerated_encode_uper(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(er);
 }
 
+asn_dec_rval_t
+NativeEnumerated_decode_oer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+	void **sptr, const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rval = { RC_OK, 0 };
+	long *native = (long *)*sptr;
+	long value;
+	ssize_t skip;
+
+	(void)opt_codec_ctx;
+	(void)constraints;
+
+	/* X.696 #11: the enumeration value itself, not its index */
+	skip = oer_fetch_enumerated(buf_ptr, size, &value);
+	if(skip < 0) _ASN_DECODE_FAILED;
+	if(skip == 0) {
+		rval.code = RC_WMORE;
+		return rval;
+	}
+
+	if(!native) {
+		native = (long *)(*sptr = CALLOC(1, sizeof(*native)));
+		if(!native) _ASN_DECODE_FAILED;
+	}
+
+	*native = value;
+	ASN_DEBUG("Decoded %s = %ld", td->name, *native);
+
+	rval.consumed = skip;
+	return rval;
+}
+
+asn_enc_rval_t
+NativeEnumerated_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+
+	(void)constraints;
+	(void)flags;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+
+	er.encoded = oer_serialize_enumerated(*(long *)sptr, cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
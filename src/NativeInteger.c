@@ -12,6 +12,7 @@
  */
 #include <asn_internal.h>
 #include <NativeInteger.h>
+#include <jer_support.h>	/* JSON tokenizer */
 
 /*
  * NativeInteger basic type description.
@@ -38,7 +39,14 @@ asn_TYPE_descriptor_t asn_DEF_NativeInteger = {
 	sizeof(asn_DEF_NativeInteger_tags) / sizeof(asn_DEF_NativeInteger_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	NativeInteger_decode_jer,
+	NativeInteger_encode_jer,
+	NativeInteger_decode_oer,
+	NativeInteger_encode_oer,
+	NativeInteger_equals,
+	NativeInteger_hash,
+	NativeInteger_copy
 };
 
 /*
@@ -51,6 +59,7 @@ NativeInteger_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	long *native = (long *)*nint_ptr;
 	asn_dec_rval_t rval;
 	ber_tlv_len_t length;
+	int eocs;
 
 	/*
 	 * If the structure is not there, allocate it.
@@ -70,8 +79,8 @@ NativeInteger_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	/*
 	 * Check tags.
 	 */
-	rval = ber_check_tags(opt_codec_ctx, td, 0, buf_ptr, size,
-			tag_mode, 0, &length, 0);
+	rval = ber_check_tags_eocs(opt_codec_ctx, td, 0, buf_ptr, size,
+			tag_mode, 0, &length, 0, &eocs);
 	if(rval.code != RC_OK)
 		return rval;
 
@@ -87,6 +96,16 @@ NativeInteger_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 		rval.consumed = 0;
 		return rval;
 	}
+	if(eocs) {
+		/* The outer tags of indefinite length are closed */
+		ssize_t skip = ber_skip_eocs((const char *)buf_ptr + length,
+			size - length, eocs);
+		if(skip <= 0) {
+			rval.code = skip ? RC_FAIL : RC_WMORE;
+			rval.consumed = 0;
+			return rval;
+		}
+	}
 
 	/*
 	 * ASN.1 encoded INTEGER: buf_ptr, length
@@ -115,7 +134,7 @@ NativeInteger_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	}
 
 	rval.code = RC_OK;
-	rval.consumed += length;
+	rval.consumed += length + 2 * eocs;
 
 	ASN_DEBUG("Took %ld/%ld bytes to encode %s (%ld)",
 		(long)rval.consumed, (long)length, td->name, (long)*native);
@@ -222,6 +241,75 @@ NativeInteger_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * Decode the chunk of JSON text encoding INTEGER.
+ */
+asn_dec_rval_t
+NativeInteger_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rval;
+	INTEGER_t st;
+	void *st_ptr = (void *)&st;
+	long *native = (long *)*sptr;
+	jer_token_t tok;
+
+	if(!native) {
+		native = (long *)(*sptr = CALLOC(1, sizeof(*native)));
+		if(!native) _ASN_DECODE_FAILED;
+	}
+
+	/*
+	 * Refuse the numbers with more digits than a long may have
+	 * before the long arithmetic of INTEGER is spent on them.
+	 */
+	if(jer_next_token(buf_ptr, size, &tok) && tok.type == JT_NUMBER) {
+		const char *p = tok.start;
+		const char *end = tok.start + tok.length;
+		if(p < end && *p == 0x2d) p++;	/* '-' */
+		while(p < end && *p == 0x30) p++;	/* '0' */
+		if((size_t)(end - p) > sizeof(long) * 5 / 2 + 1)
+			_ASN_DECODE_FAILED;
+	}
+
+	memset(&st, 0, sizeof(st));
+	rval = INTEGER_decode_jer(opt_codec_ctx, td, &st_ptr, buf_ptr, size);
+	if(rval.code == RC_OK) {
+		long l;
+		if(asn_INTEGER2long(&st, &l)) {
+			rval.code = RC_FAIL;
+			rval.consumed = 0;
+		} else {
+			*native = l;
+		}
+	} else {
+		rval.consumed = 0;
+	}
+	ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_INTEGER, &st);
+	return rval;
+}
+
+asn_enc_rval_t
+NativeInteger_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	char scratch[32];	/* Enough for 64-bit int */
+	asn_enc_rval_t er;
+	const long *native = (const long *)sptr;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!native) _ASN_ENCODE_FAILED;
+
+	er.encoded = snprintf(scratch, sizeof(scratch), "%ld", *native);
+	if(er.encoded <= 0 || (size_t)er.encoded >= sizeof(scratch)
+		|| cb(scratch, er.encoded, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
 asn_dec_rval_t
 NativeInteger_decode_uper(asn_codec_ctx_t *opt_codec_ctx,
 	asn_TYPE_descriptor_t *td,
@@ -276,6 +364,71 @@ NativeInteger_encode_uper(asn_TYPE_descriptor_t *td,
 	return er;
 }
 
+asn_dec_rval_t
+NativeInteger_decode_oer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+	void **sptr, const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rval = { RC_OK, 0 };
+	long *native = (long *)*sptr;
+	asn_per_constraint_t *ct;
+	int width, is_unsigned;
+	long value;
+	ssize_t skip;
+
+	(void)opt_codec_ctx;
+
+	if(!constraints) constraints = td->per_constraints;
+	ct = constraints ? &constraints->value : 0;
+
+	width = oer_integer_width(ct, &is_unsigned);
+	skip = oer_fetch_long(buf_ptr, size, width, is_unsigned, &value);
+	if(skip < 0) _ASN_DECODE_FAILED;
+	if(skip == 0) {
+		rval.code = RC_WMORE;
+		return rval;
+	}
+
+	if(!native) {
+		native = (long *)(*sptr = CALLOC(1, sizeof(*native)));
+		if(!native) _ASN_DECODE_FAILED;
+	}
+
+	*native = value;
+	ASN_DEBUG("Decoded %s = %ld", td->name, *native);
+
+	rval.consumed = skip;
+	return rval;
+}
+
+asn_enc_rval_t
+NativeInteger_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+	asn_per_constraint_t *ct;
+	int width, is_unsigned;
+	long native;
+
+	(void)flags;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+	native = *(long *)sptr;
+
+	if(!constraints) constraints = td->per_constraints;
+	ct = constraints ? &constraints->value : 0;
+
+	width = oer_integer_width(ct, &is_unsigned);
+	if(width && (native < ct->lower_bound || native > ct->upper_bound))
+		_ASN_ENCODE_FAILED;
+
+	er.encoded = oer_serialize_long(native, width, is_unsigned,
+		cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
 /*
  * INTEGER specific human-readable output.
  */
@@ -298,6 +451,34 @@ NativeInteger_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	}
 }
 
+int
+NativeInteger_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	(void)td;
+	return *(const long *)struct_a == *(const long *)struct_b;
+}
+
+uint64_t
+NativeInteger_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	(void)td;
+	return asn_hash__end(asn_hash__value(0, *(const long *)sptr));
+}
+
+int
+NativeInteger_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	long *st;
+
+	(void)td;
+
+	st = (long *)asn_copy__struct(copy, struct_dst, sizeof(*st));
+	if(!st) return -1;
+	if(!ASN_COPY_MEASURING(copy))
+		*st = *(const long *)struct_src;
+
+	return 0;
+}
+
 void
 NativeInteger_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 
@@ -37,7 +37,14 @@ asn_TYPE_descriptor_t asn_DEF_NativeReal = {
 	sizeof(asn_DEF_NativeReal_tags) / sizeof(asn_DEF_NativeReal_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	NativeReal_decode_jer,
+	NativeReal_encode_jer,
+	NativeReal_decode_oer,
+	NativeReal_encode_oer,
+	NativeReal_equals,
+	NativeReal_hash,
+	NativeReal_copy
 };
 
 /*
@@ -50,6 +57,7 @@ NativeReal_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	double *Dbl = (double *)*dbl_ptr;
 	asn_dec_rval_t rval;
 	ber_tlv_len_t length;
+	int eocs;
 
 	/*
 	 * If the structure is not there, allocate it.
@@ -70,8 +78,8 @@ NativeReal_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	/*
 	 * Check tags.
 	 */
-	rval = ber_check_tags(opt_codec_ctx, td, 0, buf_ptr, size,
-			tag_mode, 0, &length, 0);
+	rval = ber_check_tags_eocs(opt_codec_ctx, td, 0, buf_ptr, size,
+			tag_mode, 0, &length, 0, &eocs);
 	if(rval.code != RC_OK)
 		return rval;
 
@@ -87,6 +95,16 @@ NativeReal_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 		rval.consumed = 0;
 		return rval;
 	}
+	if(eocs) {
+		/* The outer tags of indefinite length are closed */
+		ssize_t skip = ber_skip_eocs((const char *)buf_ptr + length,
+			size - length, eocs);
+		if(skip <= 0) {
+			rval.code = skip ? RC_FAIL : RC_WMORE;
+			rval.consumed = 0;
+			return rval;
+		}
+	}
 
 	/*
 	 * ASN.1 encoded REAL: buf_ptr, length
@@ -115,7 +133,7 @@ NativeReal_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	}
 
 	rval.code = RC_OK;
-	rval.consumed += length;
+	rval.consumed += length + 2 * eocs;
 
 	ASN_DEBUG("Took %ld/%ld bytes to encode %s (%f)",
 		(long)rval.consumed, (long)length, td->name, *Dbl);
@@ -212,6 +230,121 @@ NativeReal_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * Decode the chunk of JSON text encoding REAL.
+ */
+asn_dec_rval_t
+NativeReal_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rval;
+	REAL_t *st = 0;
+	REAL_t **stp = &st;
+	double *Dbl = (double *)*sptr;
+
+	if(!Dbl) {
+		*sptr = CALLOC(1, sizeof(double));
+		Dbl = (double *)*sptr;
+		if(!Dbl) {
+			rval.code = RC_FAIL;
+			rval.consumed = 0;
+			return rval;
+		}
+	}
+
+	rval = REAL_decode_jer(opt_codec_ctx, td, (void **)stp,
+		buf_ptr, size);
+	if(rval.code == RC_OK) {
+		if(asn_REAL2double(st, Dbl)) {
+			rval.code = RC_FAIL;
+			rval.consumed = 0;
+		}
+	} else {
+		rval.consumed = 0;
+	}
+	ASN_STRUCT_FREE(asn_DEF_REAL, st);
+	return rval;
+}
+
+asn_enc_rval_t
+NativeReal_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const double *Dbl = (const double *)sptr;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!Dbl) _ASN_ENCODE_FAILED;
+
+	er.encoded = REAL__dump_jer(*Dbl, cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
+asn_dec_rval_t
+NativeReal_decode_oer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+	void **sptr, const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rval;
+	REAL_t *st = 0;
+	REAL_t **stp = &st;
+	double *Dbl = (double *)*sptr;
+
+	if(!Dbl) {
+		*sptr = CALLOC(1, sizeof(double));
+		Dbl = (double *)*sptr;
+		if(!Dbl) {
+			rval.code = RC_FAIL;
+			rval.consumed = 0;
+			return rval;
+		}
+	}
+
+	rval = oer_decode_primitive(opt_codec_ctx, td, constraints,
+		(void **)stp, buf_ptr, size);
+	if(rval.code == RC_OK) {
+		if(asn_REAL2double(st, Dbl)) {
+			rval.code = RC_FAIL;
+			rval.consumed = 0;
+		}
+	} else {
+		rval.consumed = 0;
+	}
+	ASN_STRUCT_FREE(asn_DEF_REAL, st);
+	return rval;
+}
+
+asn_enc_rval_t
+NativeReal_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t erval;
+	REAL_t tmp;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+
+	/* Prepare a temporary clean structure */
+	memset(&tmp, 0, sizeof(tmp));
+
+	if(asn_double2REAL(&tmp, *(const double *)sptr))
+		_ASN_ENCODE_FAILED;
+
+	/* Encode a fake REAL, canonical as made by asn_double2REAL() */
+	erval = oer_encode_primitive(td, constraints, &tmp, flags,
+		cb, app_key);
+	if(erval.encoded == -1)
+		erval.structure_ptr = sptr;
+
+	/* Free possibly allocated members of the temporary structure */
+	ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_REAL, &tmp);
+
+	return erval;
+}
+
 /*
  * REAL specific human-readable output.
  */
@@ -228,6 +361,34 @@ NativeReal_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	return (REAL__dump(*Dbl, 0, cb, app_key) < 0) ? -1 : 0;
 }
 
+int
+NativeReal_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	(void)td;
+	return REAL__same(*(const double *)struct_a, *(const double *)struct_b);
+}
+
+uint64_t
+NativeReal_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	(void)td;
+	return REAL__hash(*(const double *)sptr);
+}
+
+int
+NativeReal_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	double *st;
+
+	(void)td;
+
+	st = (double *)asn_copy__struct(copy, struct_dst, sizeof(*st));
+	if(!st) return -1;
+	if(!ASN_COPY_MEASURING(copy))
+		*st = *(const double *)struct_src;
+
+	return 0;
+}
+
 void
 NativeReal_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 
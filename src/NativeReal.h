@@ -25,6 +25,13 @@ ber_type_decoder_f NativeReal_decode_ber;
 der_type_encoder_f NativeReal_encode_der;
 xer_type_decoder_f NativeReal_decode_xer;
 xer_type_encoder_f NativeReal_encode_xer;
+jer_type_decoder_f NativeReal_decode_jer;
+jer_type_encoder_f NativeReal_encode_jer;
+oer_type_decoder_f NativeReal_decode_oer;
+oer_type_encoder_f NativeReal_encode_oer;
+asn_struct_equals_f NativeReal_equals;
+asn_struct_hash_f NativeReal_hash;
+asn_struct_copy_f NativeReal_copy;
 
 #ifdef __cplusplus
 }
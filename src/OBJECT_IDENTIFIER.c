@@ -19,7 +19,7 @@ asn_TYPE_descriptor_t asn_DEF_OBJECT_IDENTIFIER = {
 	ASN__PRIMITIVE_TYPE_free,
 	OBJECT_IDENTIFIER_print,
 	OBJECT_IDENTIFIER_constraint,
-	ber_decode_primitive,
+	OBJECT_IDENTIFIER_decode_ber,
 	der_encode_primitive,
 	OBJECT_IDENTIFIER_decode_xer,
 	OBJECT_IDENTIFIER_encode_xer,
@@ -33,7 +33,14 @@ asn_TYPE_descriptor_t asn_DEF_OBJECT_IDENTIFIER = {
 	    / sizeof(asn_DEF_OBJECT_IDENTIFIER_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	OBJECT_IDENTIFIER_decode_jer,
+	OBJECT_IDENTIFIER_encode_jer,
+	oer_decode_primitive,
+	oer_encode_primitive,
+	ASN__PRIMITIVE_TYPE_equals,
+	ASN__PRIMITIVE_TYPE_hash,
+	ASN__PRIMITIVE_TYPE_copy
 };
 
 
@@ -219,7 +226,7 @@ OBJECT_IDENTIFIER_print_arc(uint8_t *arcbuf, int arclen, int add,
 }
 
 static ssize_t
-OBJECT_IDENTIFIER__dump_body(const OBJECT_IDENTIFIER_t *st, asn_app_consume_bytes_f *cb, void *app_key) {
+OBJECT_IDENTIFIER__dump_arcs(const OBJECT_IDENTIFIER_t *st, asn_app_consume_bytes_f *cb, void *app_key) {
 	ssize_t wrote_len = 0;
 	int startn;
 	int add = 0;
@@ -264,24 +271,289 @@ OBJECT_IDENTIFIER__dump_body(const OBJECT_IDENTIFIER_t *st, asn_app_consume_byte
 	return wrote_len;
 }
 
+static ssize_t
+OBJECT_IDENTIFIER__dump_body(const OBJECT_IDENTIFIER_t *st, asn_app_consume_bytes_f *cb, void *app_key) {
+	const asn_oid_interned_t *ih;
+
+	/* Interned values come with the precomputed text */
+	ih = OBJECT_IDENTIFIER_intern_lookup(st);	/* 0 if none interned */
+	if(ih) {
+		if(cb(ih->text, ih->text_size, app_key) < 0)
+			return -1;
+		return ih->text_size;
+	}
+
+	return OBJECT_IDENTIFIER__dump_arcs(st, cb, app_key);
+}
+
+/*
+ * The table of interned values.
+ * The (count) is only changed under the write lock, and is read
+ * without locking to skip the lookups while nothing is interned.
+ */
+typedef struct oid_intern_entry_s {
+	asn_oid_interned_t handle;	/* Must be first */
+	struct oid_intern_entry_s *next;	/* Next in the bucket */
+} oid_intern_entry_t;
+static struct {
+	asn_rwlock_t lock;
+	oid_intern_entry_t **buckets;
+	unsigned int buckets_count;	/* Power of 2 */
+	volatile long count;
+} _oid_intern = { ASN_RWLOCK_INITIALIZER, 0, 0, 0 };
+
+/*
+ * Whether any value has been interned.
+ */
+static int
+_oid_intern_used(void) {
+#ifdef	ASN_ATOMIC_LOAD_LONG
+	return ASN_ATOMIC_LOAD_LONG(&_oid_intern.count) != 0;
+#else	/* !ASN_ATOMIC_LOAD_LONG */
+	long count;
+	asn_rwlock_rdlock(&_oid_intern.lock);
+	count = _oid_intern.count;
+	asn_rwlock_rdunlock(&_oid_intern.lock);
+	return count != 0;
+#endif	/* ASN_ATOMIC_LOAD_LONG */
+}
+
+static int
+_oid_is_wellformed(const OBJECT_IDENTIFIER_t *st) {
+	return (st && st->buf && st->size > 0
+		&& !(st->buf[st->size - 1] & 0x80));
+}
+
+/* FNV-1a */
+static unsigned int
+_oid_hash(const uint8_t *buf, int size) {
+	unsigned int h = 2166136261U;
+	for(; size > 0; size--, buf++)
+		h = (h ^ *buf) * 16777619U;
+	return h;
+}
+
+static oid_intern_entry_t *
+_oid_intern_find(const OBJECT_IDENTIFIER_t *st, unsigned int hash) {
+	oid_intern_entry_t *e;
+
+	if(!_oid_intern.buckets_count)
+		return 0;
+
+	for(e = _oid_intern.buckets[hash & (_oid_intern.buckets_count - 1)];
+			e; e = e->next) {
+		if(e->handle.hash == hash
+		&& e->handle.der_size == st->size
+		&& memcmp(e->handle.der, st->buf, st->size) == 0)
+			return e;
+	}
+
+	return 0;
+}
+
+static int
+_oid_count_cb(const void *buffer, size_t size, void *app_key) {
+	(void)buffer;
+	*(size_t *)app_key += size;
+	return 0;
+}
+
+static int
+_oid_write_cb(const void *buffer, size_t size, void *app_key) {
+	char **p = (char **)app_key;
+	memcpy(*p, buffer, size);
+	*p += size;
+	return 0;
+}
+
+/*
+ * Build the entry (handle, arcs, content octets and text)
+ * in a single memory block.
+ */
+static oid_intern_entry_t *
+_oid_intern_build(const OBJECT_IDENTIFIER_t *st, unsigned int hash) {
+	oid_intern_entry_t *e;
+	size_t text_size = 0;
+	char *p;
+	int arcs_count;
+
+	arcs_count = OBJECT_IDENTIFIER_get_arcs((OBJECT_IDENTIFIER_t *)st,
+			0, sizeof(unsigned long), 0);
+	if(arcs_count < 2
+	|| OBJECT_IDENTIFIER__dump_arcs(st, _oid_count_cb, &text_size) < 0) {
+		errno = EINVAL;
+		return 0;
+	}
+
+	e = (oid_intern_entry_t *)MALLOC(sizeof(*e)
+		+ arcs_count * sizeof(unsigned long)
+		+ st->size + text_size + 1);
+	if(!e) return 0;
+
+	p = (char *)(e + 1);
+	if(OBJECT_IDENTIFIER_get_arcs((OBJECT_IDENTIFIER_t *)st, p,
+			sizeof(unsigned long), arcs_count) != arcs_count) {
+		FREEMEM(e);
+		errno = EINVAL;
+		return 0;
+	}
+	e->handle.arcs = (const unsigned long *)p;
+	e->handle.arcs_count = arcs_count;
+	p += arcs_count * sizeof(unsigned long);
+
+	memcpy(p, st->buf, st->size);
+	e->handle.der = (const uint8_t *)p;
+	e->handle.der_size = st->size;
+	p += st->size;
+
+	e->handle.text = p;
+	e->handle.text_size = text_size;
+	(void)OBJECT_IDENTIFIER__dump_arcs(st, _oid_write_cb, &p);
+	*p = '\0';
+
+	e->handle.hash = hash;
+	e->next = 0;
+
+	return e;
+}
+
+/*
+ * Double the number of buckets. The write lock must be held.
+ */
+static int
+_oid_intern_grow(void) {
+	unsigned int new_count = _oid_intern.buckets_count
+		? _oid_intern.buckets_count << 1 : 64;
+	oid_intern_entry_t **nb;
+	unsigned int i;
+
+	nb = (oid_intern_entry_t **)CALLOC(new_count, sizeof(*nb));
+	if(!nb) return -1;
+
+	for(i = 0; i < _oid_intern.buckets_count; i++) {
+		oid_intern_entry_t *e, *next;
+		for(e = _oid_intern.buckets[i]; e; e = next) {
+			oid_intern_entry_t **b;
+			next = e->next;
+			b = &nb[e->handle.hash & (new_count - 1)];
+			e->next = *b;
+			*b = e;
+		}
+	}
+
+	FREEMEM(_oid_intern.buckets);
+	_oid_intern.buckets = nb;
+	_oid_intern.buckets_count = new_count;
+
+	return 0;
+}
+
+const asn_oid_interned_t *
+OBJECT_IDENTIFIER_intern_lookup(const OBJECT_IDENTIFIER_t *st) {
+	oid_intern_entry_t *e;
+	unsigned int hash;
+
+	if(!_oid_intern_used() || !_oid_is_wellformed(st))
+		return 0;
+
+	hash = _oid_hash(st->buf, st->size);
+	asn_rwlock_rdlock(&_oid_intern.lock);
+	e = _oid_intern_find(st, hash);
+	asn_rwlock_rdunlock(&_oid_intern.lock);
+
+	return e ? &e->handle : 0;
+}
+
+const asn_oid_interned_t *
+OBJECT_IDENTIFIER_intern(const OBJECT_IDENTIFIER_t *st) {
+	oid_intern_entry_t *e, *ne;
+	oid_intern_entry_t **b;
+	unsigned int hash;
+
+	if(!_oid_is_wellformed(st)) {
+		errno = EINVAL;
+		return 0;
+	}
+
+	hash = _oid_hash(st->buf, st->size);
+	asn_rwlock_rdlock(&_oid_intern.lock);
+	e = _oid_intern_find(st, hash);
+	asn_rwlock_rdunlock(&_oid_intern.lock);
+	if(e) return &e->handle;
+
+	/* Prepare the entry outside of the lock */
+	ne = _oid_intern_build(st, hash);
+	if(!ne) return 0;
+
+	asn_rwlock_wrlock(&_oid_intern.lock);
+	e = _oid_intern_find(st, hash);	/* Raced with another thread? */
+	if(!e) {
+		if(_oid_intern.count >= ASN_OID_INTERN_MAX) {
+			asn_rwlock_wrunlock(&_oid_intern.lock);
+			FREEMEM(ne);
+			errno = ENOSPC;
+			return 0;
+		}
+		if((unsigned long)_oid_intern.count >= _oid_intern.buckets_count
+		&& _oid_intern_grow()) {
+			asn_rwlock_wrunlock(&_oid_intern.lock);
+			FREEMEM(ne);
+			errno = ENOMEM;
+			return 0;
+		}
+		b = &_oid_intern.buckets[hash & (_oid_intern.buckets_count - 1)];
+		ne->next = *b;
+		*b = ne;
+#ifdef	ASN_ATOMIC_FETCH_INC
+		(void)ASN_ATOMIC_FETCH_INC(&_oid_intern.count);
+#else
+		_oid_intern.count++;
+#endif
+		e = ne;
+		ne = 0;
+	}
+	asn_rwlock_wrunlock(&_oid_intern.lock);
+
+	if(ne) FREEMEM(ne);
+	return &e->handle;
+}
+
+asn_dec_rval_t
+OBJECT_IDENTIFIER_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td,
+	void **sptr, const void *buf_ptr, size_t size, int tag_mode) {
+	const asn_dec_opts_t *opts = ASN_DEC_OPTS(opt_codec_ctx);
+	asn_dec_rval_t rval;
+
+	rval = ber_decode_primitive(opt_codec_ctx, td, sptr,
+		buf_ptr, size, tag_mode);
+	if(rval.code == RC_OK && opts && opts->intern_oids) {
+		const asn_oid_interned_t *ih;
+		/* Failure to intern is not a decoding failure */
+		ih = OBJECT_IDENTIFIER_intern(
+			(const OBJECT_IDENTIFIER_t *)*sptr);
+		if(ih && opts->oid_cb)
+			opts->oid_cb(ih, *sptr, opts->cb_key);
+	}
+
+	return rval;
+}
+
 static enum xer_pbd_rval
 OBJECT_IDENTIFIER__xer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chunk_buf, size_t chunk_size) {
 	OBJECT_IDENTIFIER_t *st = (OBJECT_IDENTIFIER_t *)sptr;
 	const char *chunk_end = (const char *)chunk_buf + chunk_size;
 	const char *endptr;
-	long s_arcs[10];
-	long *arcs = s_arcs;
-	int arcs_count;
-	int ret;
 
 	(void)td;
 
-	arcs_count = OBJECT_IDENTIFIER_parse_arcs(
-		(const char *)chunk_buf, chunk_size, arcs,
-			sizeof(s_arcs)/sizeof(s_arcs[0]), &endptr);
-	if(arcs_count <= 0) {
-		/* Expecting more than zero arcs */
-		return XPBD_BROKEN_ENCODING;
+	/*
+	 * Convert text directly into BER representation.
+	 */
+	if(OBJECT_IDENTIFIER_from_text(st, (const char *)chunk_buf,
+			chunk_size, &endptr)) {
+		return (errno == ENOMEM)
+			? XPBD_SYSTEM_FAILURE : XPBD_BROKEN_ENCODING;
 	}
 	if(endptr < chunk_end) {
 		/* We have a tail of unrecognized data. Check its safety. */
@@ -289,23 +561,7 @@ OBJECT_IDENTIFIER__xer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const
 			return XPBD_BROKEN_ENCODING;
 	}
 
-	if((size_t)arcs_count > sizeof(s_arcs)/sizeof(s_arcs[0])) {
-		arcs = (long *)MALLOC(arcs_count * sizeof(long));
-		if(!arcs) return XPBD_SYSTEM_FAILURE;
-		ret = OBJECT_IDENTIFIER_parse_arcs(
-			(const char *)chunk_buf, chunk_size,
-			arcs, arcs_count, &endptr);
-		if(ret != arcs_count)
-			return XPBD_SYSTEM_FAILURE;	/* assert?.. */
-	}
-
-	/*
-	 * Convert arcs into BER representation.
-	 */
-	ret = OBJECT_IDENTIFIER_set_arcs(st, arcs, sizeof(*arcs), arcs_count);
-	if(arcs != s_arcs) FREEMEM(arcs);
-
-	return ret ? XPBD_SYSTEM_FAILURE : XPBD_BODY_CONSUMED;
+	return XPBD_BODY_CONSUMED;
 }
 
 asn_dec_rval_t
@@ -337,6 +593,43 @@ OBJECT_IDENTIFIER_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * JER represents the identifier by the string of dotted arcs.
+ */
+asn_dec_rval_t
+OBJECT_IDENTIFIER_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+
+	return jer_decode_primitive(opt_codec_ctx, td,
+		sptr, sizeof(OBJECT_IDENTIFIER_t), buf_ptr, size,
+			JPB_STRING, OBJECT_IDENTIFIER__xer_body_decode);
+}
+
+asn_enc_rval_t
+OBJECT_IDENTIFIER_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const OBJECT_IDENTIFIER_t *st = (const OBJECT_IDENTIFIER_t *)sptr;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || !st->buf)
+		_ASN_ENCODE_FAILED;
+
+	/* The arcs need no escaping */
+	if(cb("\"", 1, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+	er.encoded = OBJECT_IDENTIFIER__dump_body(st, cb, app_key);
+	if(er.encoded < 0 || cb("\"", 1, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+	er.encoded += 2;
+
+	_ASN_ENCODED_OK(er);
+}
+
 int
 OBJECT_IDENTIFIER_print(asn_TYPE_descriptor_t *td, const void *sptr,
 	int ilevel, asn_app_consume_bytes_f *cb, void *app_key) {
@@ -725,3 +1018,176 @@ OBJECT_IDENTIFIER_parse_arcs(const char *oid_text, ssize_t oid_txt_length,
 }
 
 
+
+/*
+ * Store the arc in base-128 form, if there is (avail) space for it.
+ * Returns the number of octets the arc takes.
+ */
+static size_t
+_oid_put_arc(uint8_t *bp, size_t avail, uint64_t value) {
+	uint64_t v;
+	size_t len;
+
+	if(value < 0x80) {	/* Most of the arcs */
+		if(avail) *bp = (uint8_t)value;
+		return 1;
+	}
+
+	for(len = 1, v = value >> 7; v; v >>= 7)
+		len++;
+
+	if(len <= avail) {
+		uint8_t *p = bp + len - 1;
+		*p = (uint8_t)(value & 0x7f);
+		for(value >>= 7; p > bp; value >>= 7)
+			*--p = (uint8_t)(0x80 | (value & 0x7f));
+	}
+
+	return len;
+}
+
+ssize_t
+OBJECT_IDENTIFIER_text2der(const char *oid_text, ssize_t oid_txt_length,
+	uint8_t *buf, size_t size, const char **opt_oid_text_end) {
+	const uint64_t max_arc = ~(uint64_t)0;
+	const char *oid_end;
+	uint64_t arc0 = 0;
+	size_t len = 0;		/* Octets produced, or needed */
+	int arcs_count = 0;
+
+	if(!oid_text || oid_txt_length < -1 || (size && !buf)) {
+		if(opt_oid_text_end) *opt_oid_text_end = oid_text;
+		errno = EINVAL;
+		return -1;
+	}
+
+	if(oid_txt_length == -1)
+		oid_txt_length = strlen(oid_text);
+	oid_end = oid_text + oid_txt_length;
+
+	/* Skip the leading whitespace */
+	for(; oid_text < oid_end; oid_text++) {
+		switch(*oid_text) {
+		case 0x09: case 0x0a: case 0x0d: case 0x20:
+			continue;
+		}
+		break;
+	}
+
+	for(;;) {
+		const char *digits = oid_text;
+		uint64_t value = 0;
+
+		for(; oid_text < oid_end; oid_text++) {
+			unsigned int d = (unsigned char)*oid_text - 0x30;
+			if(d > 9) break;
+			if(value > (max_arc - d) / 10) {
+				/* Overflow */
+				if(opt_oid_text_end) *opt_oid_text_end = oid_text;
+				errno = ERANGE;
+				return -1;
+			}
+			value = value * 10 + d;
+		}
+		if(oid_text == digits) {
+			/* Expected a digit */
+			if(opt_oid_text_end) *opt_oid_text_end = oid_text;
+			errno = EINVAL;
+			return -1;
+		}
+
+		switch(arcs_count++) {
+		case 0:
+			arc0 = value;
+			if(arc0 > 2) {
+				/* 8.19.4: Only three values from the root node */
+				if(opt_oid_text_end) *opt_oid_text_end = digits;
+				errno = ERANGE;
+				return -1;
+			}
+			break;
+		case 1:
+			/* Same restrictions as OBJECT_IDENTIFIER_set_arcs() */
+			if((arc0 <= 1 && value >= 39)
+			|| value > max_arc - 80) {
+				if(opt_oid_text_end) *opt_oid_text_end = digits;
+				errno = ERANGE;
+				return -1;
+			}
+			value += arc0 * 40;
+			/* Fall through */
+		default:
+			len += _oid_put_arc(buf + len,
+				len < size ? size - len : 0, value);
+		}
+
+		if(oid_text < oid_end && *oid_text == 0x2e) {	/* '.' */
+			oid_text++;
+			continue;
+		}
+		break;
+	}
+
+	if(opt_oid_text_end) *opt_oid_text_end = oid_text;
+
+	if(oid_text < oid_end) {
+		switch(*oid_text) {
+		case 0x09: case 0x0a: case 0x0d: case 0x20:
+			break;	/* Finish */
+		default:
+			/* Unexpected symbols */
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	if(arcs_count < 2) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return len;
+}
+
+int
+OBJECT_IDENTIFIER_from_text(OBJECT_IDENTIFIER_t *oid, const char *oid_text,
+	ssize_t oid_txt_length, const char **opt_oid_text_end) {
+	uint8_t scratch[64];	/* Enough for the typical OIDs */
+	ssize_t len;
+	uint8_t *buf;
+
+	if(!oid) {
+		if(opt_oid_text_end) *opt_oid_text_end = oid_text;
+		errno = EINVAL;
+		return -1;
+	}
+
+	len = OBJECT_IDENTIFIER_text2der(oid_text, oid_txt_length,
+		scratch, sizeof(scratch), opt_oid_text_end);
+	if(len < 0) return -1;
+
+	buf = (uint8_t *)MALLOC(len + 1);
+	if(!buf) return -1;	/* ENOMEM */
+
+	if((size_t)len <= sizeof(scratch)) {
+		memcpy(buf, scratch, len);
+	} else {
+		/* Unusually long one, the second pass is required */
+		if(OBJECT_IDENTIFIER_text2der(oid_text, oid_txt_length,
+				buf, len, 0) != len) {
+			FREEMEM(buf);
+			errno = EINVAL;
+			return -1;
+		}
+	}
+	buf[len] = '\0';	/* Just in case */
+
+	/*
+	 * Replace buffer.
+	 */
+	if(oid->buf) FREEMEM(oid->buf);
+	oid->buf = buf;
+	oid->size = len;
+
+	return 0;
+}
@@ -19,9 +19,12 @@ extern asn_TYPE_descriptor_t asn_DEF_OBJECT_IDENTIFIER;
 
 asn_struct_print_f OBJECT_IDENTIFIER_print;
 asn_constr_check_f OBJECT_IDENTIFIER_constraint;
+ber_type_decoder_f OBJECT_IDENTIFIER_decode_ber;
 der_type_encoder_f OBJECT_IDENTIFIER_encode_der;
 xer_type_decoder_f OBJECT_IDENTIFIER_decode_xer;
 xer_type_encoder_f OBJECT_IDENTIFIER_encode_xer;
+jer_type_decoder_f OBJECT_IDENTIFIER_decode_jer;
+jer_type_encoder_f OBJECT_IDENTIFIER_encode_jer;
 
 /**********************************
  * Some handy conversion routines *
@@ -123,6 +126,77 @@ ssize_t OBJECT_IDENTIFIER__dump_arc(uint8_t *arcbuf, int arclen, int add,
 int OBJECT_IDENTIFIER_parse_arcs(const char *oid_text, ssize_t oid_txt_length,
 	long arcs[], unsigned int arcs_slots, const char **opt_oid_text_end);
 
+/*
+ * Convert the OBJECT IDENTIFIER textual representation ("1.3.6.1.4.1.9363")
+ * directly into the content octets, in a single pass and without the
+ * intermediate arcs array. Arcs up to the 64-bit range are supported.
+ * The whitespace around the value is skipped, (oid_txt_length == -1) and
+ * (opt_oid_text_end) are treated as in OBJECT_IDENTIFIER_parse_arcs().
+ *
+ * OBJECT_IDENTIFIER_text2der() writes into the (buf) of (size) bytes, and
+ * does not allocate memory.
+ * RETURN VALUES:
+ * -1/EINVAL:	Parse error, or less than two arcs
+ * -1/ERANGE:	The arcs do not conform to ASN.1 restrictions or overflow
+ * >=0:		Number of content octets
+ * WARNING: The function always returns the real number of octets,
+ * even if there is no sufficient (size) provided.
+ *
+ * OBJECT_IDENTIFIER_from_text() initializes the OBJECT IDENTIFIER object.
+ * RETURN VALUES:
+ * -1/EINVAL, -1/ERANGE:	As above
+ * -1/ENOMEM:	Memory allocation failed
+ * 0:		The object was initialized with new arcs.
+ */
+ssize_t OBJECT_IDENTIFIER_text2der(const char *oid_text,
+	ssize_t oid_txt_length, uint8_t *buf, size_t size,
+	const char **opt_oid_text_end);
+int OBJECT_IDENTIFIER_from_text(OBJECT_IDENTIFIER_t *_oid,
+	const char *oid_text, ssize_t oid_txt_length,
+	const char **opt_oid_text_end);
+
+/*
+ * Interned OBJECT IDENTIFIER values.
+ * The process-wide, thread-safe table keyed on the content octets keeps
+ * a single immutable handle per distinct value, with the arcs and the
+ * dotted text precomputed. Handles are never freed, so two interned values
+ * are equal if and only if their handles are the same pointer.
+ */
+typedef struct asn_oid_interned_s {
+	const uint8_t *der;	/* Content octets, as in OBJECT_IDENTIFIER_t */
+	int der_size;
+	const unsigned long *arcs;	/* As per OBJECT_IDENTIFIER_get_arcs() */
+	int arcs_count;
+	const char *text;	/* "1.3.6.1.4.1.9363", '\0'-terminated */
+	int text_size;
+	unsigned int hash;	/* Hash of the content octets */
+} asn_oid_interned_t;
+
+/*
+ * Find the handle for the given value, adding it to the table if necessary.
+ * RETURN VALUES:
+ * 0/EINVAL:	The value is missing, is not a valid OBJECT IDENTIFIER,
+ * 		or has arcs not fitting into unsigned long
+ * 0/ENOSPC:	The table reached ASN_OID_INTERN_MAX entries
+ * 0/ENOMEM:	Memory allocation failed
+ * Otherwise, the stable handle.
+ */
+const asn_oid_interned_t *OBJECT_IDENTIFIER_intern(const OBJECT_IDENTIFIER_t *);
+
+/* Same as above, but never adds to the table: returns 0 if not interned */
+const asn_oid_interned_t *OBJECT_IDENTIFIER_intern_lookup(
+	const OBJECT_IDENTIFIER_t *);
+
+/*
+ * Interned values are printed (OBJECT_IDENTIFIER_print(), XER, JER)
+ * straight from their precomputed text. The BER decoder interns the values
+ * it decodes if asked to by the (intern_oids) of asn_dec_opts_t.
+ */
+
+#ifndef	ASN_OID_INTERN_MAX
+#define	ASN_OID_INTERN_MAX	65536	/* Bound against hostile inputs */
+#endif
+
 /*
  * Internal functions.
  * Used by RELATIVE-OID implementation in particular.
@@ -6,7 +6,9 @@
 #include <asn_internal.h>
 #include <OCTET_STRING.h>
 #include <BIT_STRING.h>	/* for .bits_unused member */
+#include <jer_support.h>	/* JSON tokenizer */
 #include <errno.h>
+#include <limits.h>	/* for INT_MAX */
 
 /*
  * OCTET STRING basic type description.
@@ -43,7 +45,14 @@ asn_TYPE_descriptor_t asn_DEF_OCTET_STRING = {
 	  / sizeof(asn_DEF_OCTET_STRING_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	&asn_DEF_OCTET_STRING_specs
+	&asn_DEF_OCTET_STRING_specs,
+	OCTET_STRING_decode_jer_hex,
+	OCTET_STRING_encode_jer,
+	OCTET_STRING_decode_oer,
+	OCTET_STRING_encode_oer,
+	OCTET_STRING_equals,
+	OCTET_STRING_hash,
+	OCTET_STRING_copy
 };
 
 #undef	_CH_PHASE
@@ -185,6 +194,7 @@ OCTET_STRING_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 	struct _stack *stck;		/* Expectations stack structure */
 	struct _stack_el *sel = 0;	/* Stack element */
 	int tlv_constr;
+	int eocs;
 	OS_type_e type_variant = (OS_type_e)specs->subvariant;
 
 	ASN_DEBUG("Decoding %s as %s (frame %ld)",
@@ -209,11 +219,12 @@ OCTET_STRING_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 		/*
 		 * Check tags.
 		 */
-		rval = ber_check_tags(opt_codec_ctx, td, ctx,
+		rval = ber_check_tags_eocs(opt_codec_ctx, td, ctx,
 			buf_ptr, size, tag_mode, -1,
-			&ctx->left, &tlv_constr);
+			&ctx->left, &tlv_constr, &eocs);
 		if(rval.code != RC_OK)
 			return rval;
+		ctx->step = eocs;	/* Closing the primitive form */
 
 		if(tlv_constr) {
 			/*
@@ -499,12 +510,30 @@ OCTET_STRING_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
 		}
 	}
 
+	if(!sel && ctx->step) {
+		/*
+		 * The primitive form within the outer tags
+		 * of indefinite length: skip their end-of-contents.
+		 */
+		ssize_t skip = ber_skip_eocs(buf_ptr, size, ctx->step);
+		if(skip == -1) RETURN(RC_FAIL);
+		if(skip == 0) RETURN(RC_WMORE);
+		ADVANCE(skip);
+		ctx->step = 0;
+	}
+
 	/*
 	 * BIT STRING-specific processing.
 	 */
-	if(type_variant == _TT_BIT_STRING && st->size) {
+	if(type_variant == _TT_BIT_STRING) {
+		if(st->bits_unused < 0 || st->bits_unused > 7) {
+			ASN_DEBUG("Invalid number of unused bits %d",
+				st->bits_unused);
+			RETURN(RC_FAIL);
+		}
 		/* Finalize BIT STRING: zero out unused bits. */
-		st->buf[st->size-1] &= 0xff << st->bits_unused;
+		if(st->size)
+			st->buf[st->size-1] &= 0xff << st->bits_unused;
 	}
 
 	ASN_DEBUG("Took %ld bytes to encode %s: [%s]:%ld",
@@ -582,6 +611,101 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * Encode OCTET STRING type using CER: the strings longer than 1000 octets
+ * are encoded in the constructed form, as the 1000-octet segments (X.690 #9.2).
+ */
+#define	CER_SEGMENT_SIZE	1000
+asn_enc_rval_t
+OCTET_STRING_encode_cer(asn_TYPE_descriptor_t *td, void *sptr,
+	int tag_mode, ber_tlv_tag_t tag,
+	asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+	asn_OCTET_STRING_specifics_t *specs = td->specifics
+				? (asn_OCTET_STRING_specifics_t *)td->specifics
+				: &asn_DEF_OCTET_STRING_specs;
+	BIT_STRING_t *st = (BIT_STRING_t *)sptr;
+	OS_type_e type_variant = (OS_type_e)specs->subvariant;
+	int is_bits = (type_variant == _TT_BIT_STRING);
+	ber_tlv_tag_t seg_tag = is_bits
+		? (ASN_TAG_CLASS_UNIVERSAL | (3 << 2))
+		: (ASN_TAG_CLASS_UNIVERSAL | (4 << 2));
+	uint8_t *buf;
+	size_t left;
+	ssize_t ret;
+
+	if(!st || (!st->buf && st->size))
+		_ASN_ENCODE_FAILED;
+
+	ASN_DEBUG("Encoding %s as OCTET STRING (CER)", td->name);
+
+	if(type_variant == _TT_ANY) {
+		/* The ready encoding, possibly wrapped into EXPLICIT tag */
+		er.encoded = 0;
+		if(tag_mode == 1) {
+			ret = cer_write_tags(td, 0, tag_mode, 1, tag,
+				cb, app_key);
+			if(ret == -1) _ASN_ENCODE_FAILED;
+			er.encoded += ret;
+		}
+		_ASN_CALLBACK(st->buf, st->size);
+		er.encoded += st->size;
+		if(tag_mode == 1) {
+			ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+			if(ret == -1) _ASN_ENCODE_FAILED;
+			er.encoded += ret;
+		}
+		_ASN_ENCODED_OK(er);
+	}
+
+	if(is_bits + (size_t)st->size <= CER_SEGMENT_SIZE)
+		return cer_encode_via_der(td, sptr, tag_mode, tag,
+			cb, app_key);
+
+	ret = cer_write_tags(td, 0, tag_mode, 1, tag, cb, app_key);
+	if(ret == -1) _ASN_ENCODE_FAILED;
+	er.encoded = ret;
+
+	for(buf = st->buf, left = st->size; left; ) {
+		size_t seg = CER_SEGMENT_SIZE - is_bits;
+		uint8_t scratch[16];
+		ssize_t tsize;
+		ssize_t lsize;
+
+		if(seg > left) seg = left;
+
+		tsize = ber_tlv_tag_serialize(seg_tag, scratch, sizeof(scratch));
+		lsize = der_tlv_length_serialize(is_bits + seg,
+			scratch + tsize, sizeof(scratch) - tsize);
+		if(tsize == -1 || lsize == -1) _ASN_ENCODE_FAILED;
+		er.encoded += tsize + lsize + is_bits + seg;
+
+		if(!is_bits) {
+			_ASN_CALLBACK2(scratch, tsize + lsize, buf, seg);
+		} else if(seg < left || !(st->bits_unused & 0x07)) {
+			/* The bits are unused in the last segment only */
+			scratch[tsize + lsize] = 0;
+			_ASN_CALLBACK2(scratch, tsize + lsize + 1, buf, seg);
+		} else {
+			uint8_t b = buf[seg - 1] & (0xff << st->bits_unused);
+			scratch[tsize + lsize] = st->bits_unused & 0x07;
+			_ASN_CALLBACK3(scratch, tsize + lsize + 1,
+				buf, seg - 1, &b, 1);
+		}
+
+		buf += seg;
+		left -= seg;
+	}
+
+	ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+	if(ret == -1) _ASN_ENCODE_FAILED;
+	er.encoded += ret;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
 asn_enc_rval_t
 OCTET_STRING_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	int ilevel, enum xer_encoder_flags_e flags,
@@ -1197,6 +1321,175 @@ OCTET_STRING_decode_xer_utf8(asn_codec_ctx_t *opt_codec_ctx,
 		OCTET_STRING__convert_entrefs);
 }
 
+/*
+ * Encode OCTET STRING as the JSON string of hexadecimal digits.
+ */
+asn_enc_rval_t
+OCTET_STRING_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	static const char *h2c = "0123456789ABCDEF";
+	const OCTET_STRING_t *st = (const OCTET_STRING_t *)sptr;
+	asn_enc_rval_t er;
+	char scratch[64];
+	char *scend = scratch + sizeof(scratch);
+	char *p = scratch;
+	uint8_t *buf;
+	uint8_t *end;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || (!st->buf && st->size))
+		_ASN_ENCODE_FAILED;
+
+	*p++ = 0x22;	/* " */
+	buf = st->buf;
+	end = buf + st->size;
+	for(; buf < end; buf++) {
+		if(p >= scend) {
+			_ASN_CALLBACK(scratch, p - scratch);
+			p = scratch;
+		}
+		*p++ = h2c[(*buf >> 4) & 0x0F];
+		*p++ = h2c[*buf & 0x0F];
+	}
+	if(p >= scend) {
+		_ASN_CALLBACK(scratch, p - scratch);
+		p = scratch;
+	}
+	*p++ = 0x22;
+	_ASN_CALLBACK(scratch, p - scratch);	/* Dump the rest */
+
+	er.encoded = 2 + 2 * st->size;
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
+/*
+ * Encode OCTET STRING as the JSON string of (ASCII/UTF-8) characters.
+ */
+asn_enc_rval_t
+OCTET_STRING_encode_jer_utf8(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const OCTET_STRING_t *st = (const OCTET_STRING_t *)sptr;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || (!st->buf && st->size))
+		_ASN_ENCODE_FAILED;
+
+	er.encoded = jer_encode_string(st->buf, st->size, cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
+/*
+ * Decode OCTET STRING from the JSON string.
+ */
+static asn_dec_rval_t
+OCTET_STRING__decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+	const void *buf_ptr, size_t size, int hexadecimal) {
+	OCTET_STRING_t *st = (OCTET_STRING_t *)*sptr;
+	asn_OCTET_STRING_specifics_t *specs = td->specifics
+				? (asn_OCTET_STRING_specifics_t *)td->specifics
+				: &asn_DEF_OCTET_STRING_specs;
+	asn_dec_rval_t rval;
+	jer_token_t tok;
+	size_t consumed;
+	uint8_t *buf;
+	ssize_t len;
+
+	(void)opt_codec_ctx;
+
+	consumed = jer_next_token(buf_ptr, size, &tok);
+	if(tok.type == JT_MORE) {
+		rval.code = RC_WMORE;
+		rval.consumed = 0;
+		return rval;
+	} else if(tok.type != JT_STRING) {
+		_ASN_DECODE_FAILED;
+	}
+
+	/*
+	 * The unescaped text is never longer than the escaped one.
+	 */
+	buf = (uint8_t *)MALLOC(tok.length + 1);
+	if(!buf) _ASN_DECODE_FAILED;
+	if(tok.escaped) {
+		len = jer_unescape(tok.start, tok.length, (char *)buf);
+		if(len < 0) {
+			FREEMEM(buf);
+			_ASN_DECODE_FAILED;
+		}
+	} else {
+		memcpy(buf, tok.start, tok.length);
+		len = tok.length;
+	}
+
+	if(hexadecimal) {
+		/* Two digits per octet, converted in place */
+		OCTET_STRING_t tmp;
+		ssize_t ret;
+		memset(&tmp, 0, sizeof(tmp));
+		ret = (len & 1) ? -1 : OCTET_STRING__convert_hexadecimal(
+			&tmp, buf, len, 0);
+		FREEMEM(buf);
+		if(ret != len) {
+			FREEMEM(tmp.buf);
+			_ASN_DECODE_FAILED;
+		}
+		if(!tmp.buf) {
+			tmp.buf = (uint8_t *)CALLOC(1, 1);
+			if(!tmp.buf) _ASN_DECODE_FAILED;
+		}
+		buf = tmp.buf;
+		len = tmp.size;
+	}
+	buf[len] = 0;	/* Courtesy termination */
+
+	/*
+	 * Create the string if does not exist.
+	 */
+	if(!st) {
+		st = (OCTET_STRING_t *)CALLOC(1, specs->struct_size);
+		*sptr = (void *)st;
+		if(!st) {
+			FREEMEM(buf);
+			_ASN_DECODE_FAILED;
+		}
+	}
+	FREEMEM(st->buf);
+	st->buf = buf;
+	st->size = len;
+
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+}
+
+asn_dec_rval_t
+OCTET_STRING_decode_jer_hex(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	return OCTET_STRING__decode_jer(opt_codec_ctx, td, sptr,
+		buf_ptr, size, 1);
+}
+
+asn_dec_rval_t
+OCTET_STRING_decode_jer_utf8(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	return OCTET_STRING__decode_jer(opt_codec_ctx, td, sptr,
+		buf_ptr, size, 0);
+}
+
 asn_dec_rval_t
 OCTET_STRING_decode_uper(asn_codec_ctx_t *opt_codec_ctx,
 	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
@@ -1321,6 +1614,7 @@ OCTET_STRING_encode_uper(asn_TYPE_descriptor_t *td,
 
 	if(!st || !st->buf)
 		_ASN_ENCODE_FAILED;
+	er.encoded = 0;	/* The bits are counted by uper_encode() */
 
 	if(unit_bits == 1) {
 		ASN_DEBUG("BIT STRING of %d bytes, %d bits unused",
@@ -1399,6 +1693,102 @@ OCTET_STRING_encode_uper(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * X.696 #14, #21: the size constraint fixing the number of octets
+ * makes the length determinant redundant.
+ */
+asn_dec_rval_t
+OCTET_STRING_decode_oer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+	void **sptr, const void *buf_ptr, size_t size) {
+
+	asn_OCTET_STRING_specifics_t *specs = td->specifics
+		? (asn_OCTET_STRING_specifics_t *)td->specifics
+		: &asn_DEF_OCTET_STRING_specs;
+	asn_per_constraint_t *ct = constraints ? &constraints->size
+			: (td->per_constraints
+				? &td->per_constraints->size
+				: &asn_DEF_OCTET_STRING_constraint);
+	asn_dec_rval_t rval = { RC_OK, 0 };
+	OCTET_STRING_t *st = (OCTET_STRING_t *)*sptr;
+	ssize_t skip = 0;
+	size_t len;
+
+	(void)opt_codec_ctx;
+
+	if(ct->flags == APC_CONSTRAINED
+	&& ct->lower_bound == ct->upper_bound) {
+		len = ct->upper_bound;
+	} else {
+		skip = oer_fetch_length(buf_ptr, size, &len);
+		if(skip < 0) _ASN_DECODE_FAILED;
+		if(skip == 0) {
+			rval.code = RC_WMORE;
+			return rval;
+		}
+	}
+	if(len >= INT_MAX) _ASN_DECODE_FAILED;
+	if(size - skip < len) {
+		rval.code = RC_WMORE;
+		return rval;
+	}
+
+	if(!st) {
+		st = (OCTET_STRING_t *)(*sptr = CALLOC(1, specs->struct_size));
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	FREEMEM(st->buf);
+	st->buf = (uint8_t *)MALLOC(len + 1);
+	if(!st->buf) {
+		st->size = 0;
+		_ASN_DECODE_FAILED;
+	}
+	memcpy(st->buf, (const char *)buf_ptr + skip, len);
+	st->buf[len] = 0;	/* Nul-terminate for convenience */
+	st->size = len;
+
+	rval.consumed = skip + len;
+	return rval;
+}
+
+asn_enc_rval_t
+OCTET_STRING_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+
+	asn_per_constraint_t *ct = constraints ? &constraints->size
+			: (td->per_constraints
+				? &td->per_constraints->size
+				: &asn_DEF_OCTET_STRING_constraint);
+	const OCTET_STRING_t *st = (const OCTET_STRING_t *)sptr;
+	asn_enc_rval_t er;
+	ssize_t ret = 0;
+
+	(void)flags;
+
+	if(!st || (st->size && !st->buf))
+		_ASN_ENCODE_FAILED;
+
+	if(ct->flags == APC_CONSTRAINED
+	&& ct->lower_bound == ct->upper_bound) {
+		if(st->size != ct->upper_bound)
+			_ASN_ENCODE_FAILED;
+	} else {
+		ret = oer_serialize_length(st->size, cb, app_key);
+		if(ret < 0) _ASN_ENCODE_FAILED;
+	}
+
+	if(st->size)
+		_ASN_CALLBACK(st->buf, st->size);
+	er.encoded = ret + st->size;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
 int
 OCTET_STRING_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	asn_app_consume_bytes_f *cb, void *app_key) {
@@ -1455,6 +1845,59 @@ OCTET_STRING_print_utf8(asn_TYPE_descriptor_t *td, const void *sptr,
 	}
 }
 
+int
+OCTET_STRING_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	const OCTET_STRING_t *a = (const OCTET_STRING_t *)struct_a;
+	const OCTET_STRING_t *b = (const OCTET_STRING_t *)struct_b;
+
+	(void)td;
+
+	return a->size == b->size
+		&& (a->size <= 0 || memcmp(a->buf, b->buf, a->size) == 0);
+}
+
+uint64_t
+OCTET_STRING_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	const OCTET_STRING_t *st = (const OCTET_STRING_t *)sptr;
+
+	(void)td;
+
+	return asn_hash__end(asn_hash__bytes(0, st->buf,
+		st->size > 0 ? st->size : 0));
+}
+
+int
+OCTET_STRING_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	asn_OCTET_STRING_specifics_t *specs = td->specifics
+				? (asn_OCTET_STRING_specifics_t *)td->specifics
+				: &asn_DEF_OCTET_STRING_specs;
+	const OCTET_STRING_t *src = (const OCTET_STRING_t *)struct_src;
+	OCTET_STRING_t *st;
+	size_t size = src->size > 0 ? src->size : 0;
+	uint8_t *buf = 0;
+
+	st = (OCTET_STRING_t *)asn_copy__struct(copy, struct_dst,
+		specs->struct_size);
+	if(!st) return -1;
+	if(src->buf) {
+		buf = (uint8_t *)asn_copy__alloc(copy, size + 1);
+		if(!buf) return -1;
+	}
+	if(ASN_COPY_MEASURING(copy))
+		return 0;
+
+	if(buf) memcpy(buf, src->buf, size);	/* '\0'-terminated */
+	st->buf = buf;
+	st->size = size;
+	if(specs->subvariant == _TT_BIT_STRING)
+		((BIT_STRING_t *)st)->bits_unused
+			= ((const BIT_STRING_t *)src)->bits_unused;
+
+	return 0;
+}
+
 void
 OCTET_STRING_free(asn_TYPE_descriptor_t *td, void *sptr, int contents_only) {
 	OCTET_STRING_t *st = (OCTET_STRING_t *)sptr;
@@ -50,7 +50,14 @@ asn_TYPE_descriptor_t asn_DEF_REAL = {
 	sizeof(asn_DEF_REAL_tags) / sizeof(asn_DEF_REAL_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	REAL_decode_jer,
+	REAL_encode_jer,
+	oer_decode_primitive,
+	REAL_encode_oer,
+	REAL_equals,
+	REAL_hash,
+	ASN__PRIMITIVE_TYPE_copy
 };
 
 typedef enum specialRealValue {
@@ -243,6 +250,57 @@ REAL_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	return (ret < 0) ? -1 : 0;
 }
 
+/*
+ * Compare the values of the REALs, whatever the bases of their encodings.
+ * The REALs which do not convert compare by their encodings.
+ */
+int
+REAL_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	double a, b;
+
+	if(asn_REAL2double((const REAL_t *)struct_a, &a)
+	|| asn_REAL2double((const REAL_t *)struct_b, &b))
+		return ASN__PRIMITIVE_TYPE_equals(td, struct_a, struct_b);
+
+	return REAL__same(a, b);
+}
+
+uint64_t
+REAL_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	double d;
+
+	if(asn_REAL2double((const REAL_t *)sptr, &d))
+		return ASN__PRIMITIVE_TYPE_hash(td, sptr);
+
+	return REAL__hash(d);
+}
+
+/*
+ * The NaNs are the same value here, and the zeroes of different signs
+ * are not, so the values may key the hash tables.
+ */
+int
+REAL__same(double a, double b) {
+	if(isnan(a) || isnan(b))
+		return isnan(a) && isnan(b);
+	return a == b && copysign(1.0, a) == copysign(1.0, b);
+}
+
+uint64_t
+REAL__hash(double d) {
+	uint64_t bits;
+
+	if(isnan(d)) {
+		bits = 0x7ff8000000000000ULL;	/* Any NaN */
+	} else {
+		assert(sizeof(d) == sizeof(bits));
+		memcpy(&bits, &d, sizeof(bits));
+	}
+
+	return asn_hash__end(asn_hash__value(0, bits));
+}
+
 asn_enc_rval_t
 REAL_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	int ilevel, enum xer_encoder_flags_e flags,
@@ -341,6 +399,201 @@ REAL_decode_xer(asn_codec_ctx_t *opt_codec_ctx,
 		buf_ptr, size, REAL__xer_body_decode);
 }
 
+/*
+ * JER represents the special values by the strings.
+ */
+static struct specialRealValue_s jerSpecialRealValue[] = {
+#define	SRV_SET(foo, val)	{ foo, sizeof(foo) - 1, val }
+	SRV_SET("NaN", 0),
+	SRV_SET("-INF", -1),
+	SRV_SET("INF", 1),
+	SRV_SET("-0", 2),
+#undef	SRV_SET
+};
+
+ssize_t
+REAL__dump_jer(double d, asn_app_consume_bytes_f *cb, void *app_key) {
+	char buf[40];	/* Enough for "%.17g" */
+	const char *special = 0;
+	double check;
+	char *p;
+	int ret;
+
+	if(isnan(d)) {
+		special = "\"NaN\"";
+	} else if(!finite(d)) {
+		special = (copysign(1.0, d) < 0.0) ? "\"-INF\"" : "\"INF\"";
+	} else if(ilogb(d) <= -INT_MAX) {
+		special = (copysign(1.0, d) < 0.0) ? "\"-0\"" : "0";
+	}
+	if(special) {
+		ret = strlen(special);
+		return (cb(special, ret, app_key) < 0) ? -1 : ret;
+	}
+
+	/*
+	 * Use the shortest of the two precisions which survives the trip back.
+	 */
+	ret = snprintf(buf, sizeof(buf), "%.15g", d);
+	if(ret > 0 && (size_t)ret < sizeof(buf)) {
+		check = strtod(buf, 0);
+		if(check != d)
+			ret = snprintf(buf, sizeof(buf), "%.17g", d);
+	}
+	if(ret <= 0 || (size_t)ret >= sizeof(buf)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Replace possible comma (locale-defined) */
+	for(p = buf; *p; p++) {
+		switch(*p) {
+		case 0x2b: case 0x2d: case 0x45: case 0x65:	/* + - E e */
+		case 0x30: case 0x31: case 0x32: case 0x33: case 0x34:
+		case 0x35: case 0x36: case 0x37: case 0x38: case 0x39:
+			continue;
+		default:
+			*p = 0x2e;
+		}
+	}
+
+	return (cb(buf, ret, app_key) < 0) ? -1 : ret;
+}
+
+asn_enc_rval_t
+REAL_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	REAL_t *st = (REAL_t *)sptr;
+	asn_enc_rval_t er;
+	double d;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || !st->buf || asn_REAL2double(st, &d))
+		_ASN_ENCODE_FAILED;
+
+	er.encoded = REAL__dump_jer(d, cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	_ASN_ENCODED_OK(er);
+}
+
+/*
+ * Decode the JSON number or the string with the special value.
+ */
+static enum xer_pbd_rval
+REAL__jer_body_decode(asn_TYPE_descriptor_t *td, void *sptr, const void *chunk_buf, size_t chunk_size) {
+	REAL_t *st = (REAL_t *)sptr;
+	const char *jerdata = (const char *)chunk_buf;
+	char local_buf[64];
+	char *b = local_buf;
+	char *endptr = 0;
+	double value;
+	size_t i;
+
+	(void)td;
+
+	if(!chunk_size) return XPBD_BROKEN_ENCODING;
+
+	for(i = 0; i < sizeof(jerSpecialRealValue)
+			/ sizeof(jerSpecialRealValue[0]); i++) {
+		struct specialRealValue_s *srv = &jerSpecialRealValue[i];
+		double dv;
+
+		if(srv->length != chunk_size
+		|| memcmp(srv->string, chunk_buf, chunk_size))
+			continue;
+
+		switch(srv->dv) {
+		case -1: dv = - INFINITY; break;
+		case 0: dv = NAN;	break;
+		case 1: dv = INFINITY;	break;
+		case 2: dv = copysign(0.0, -1.0); break;
+		default: return XPBD_SYSTEM_FAILURE;
+		}
+
+		if(asn_double2REAL(st, dv))
+			return XPBD_SYSTEM_FAILURE;
+
+		return XPBD_BODY_CONSUMED;
+	}
+
+	if(jerdata[0] != 0x2d && (jerdata[0] < 0x30 || jerdata[0] > 0x39)) {
+		ASN_DEBUG("Unknown JER special real value");
+		return XPBD_BROKEN_ENCODING;
+	}
+
+	/*
+	 * Copy chunk into the nul-terminated string, and run strtod.
+	 */
+	if(chunk_size >= sizeof(local_buf)) {
+		b = (char *)MALLOC(chunk_size + 1);
+		if(!b) return XPBD_SYSTEM_FAILURE;
+	}
+	memcpy(b, chunk_buf, chunk_size);
+	b[chunk_size] = 0;	/* nul-terminate */
+
+	value = strtod(b, &endptr);
+	i = endptr - b;
+	if(b != local_buf) FREEMEM(b);
+	if(i != chunk_size) return XPBD_BROKEN_ENCODING;
+
+	if(asn_double2REAL(st, value))
+		return XPBD_SYSTEM_FAILURE;
+
+	return XPBD_BODY_CONSUMED;
+}
+
+asn_dec_rval_t
+REAL_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+
+	return jer_decode_primitive(opt_codec_ctx, td,
+		sptr, sizeof(REAL_t), buf_ptr, size,
+		JPB_NUMBER | JPB_STRING, REAL__jer_body_decode);
+}
+
+/*
+ * X.696 #12: the contents octets of the DER encoding, length-prefixed.
+ * CANONICAL-OER requires the canonical form, which is rebuilt here.
+ */
+asn_enc_rval_t
+REAL_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	REAL_t *st = (REAL_t *)sptr;
+	asn_enc_rval_t er;
+	REAL_t tmp;
+	double d;
+
+	if(!st) _ASN_ENCODE_FAILED;
+
+	if(!(flags & OER_F_CANONICAL))
+		return oer_encode_primitive(td, constraints, sptr, flags,
+			cb, app_key);
+
+	if(asn_REAL2double(st, &d))
+		_ASN_ENCODE_FAILED;
+
+	/* Prepare a temporary clean structure */
+	memset(&tmp, 0, sizeof(tmp));
+	if(asn_double2REAL(&tmp, d))
+		_ASN_ENCODE_FAILED;
+
+	er = oer_encode_primitive(td, constraints, &tmp, flags, cb, app_key);
+	if(er.encoded == -1)
+		er.structure_ptr = sptr;
+
+	/* Free possibly allocated members of the temporary structure */
+	ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_REAL, &tmp);
+
+	return er;
+}
+
 
 int
 asn_REAL2double(const REAL_t *st, double *dbl_value) {
@@ -389,13 +642,31 @@ asn_REAL2double(const REAL_t *st, double *dbl_value) {
 		return -1;
 	case 0x00: {	/* X.690: 8.5.6 */
 		/*
-		 * Decimal. NR{1,2,3} format.
+		 * Decimal. NR{1,2,3} format, following the octet
+		 * which tells the form.
 		 */
+		char scratch[64];
+		char *source;
 		double d;
 
-		assert(st->buf[st->size - 1] == 0); /* Security, vashu mat' */
+		if(octv == 0 || (octv & 0x3C)) {
+			/* The other forms are reserved */
+			errno = EINVAL;
+			return -1;
+		}
+
+		/* The contents are not necessarily '\0'-terminated */
+		if((size_t)st->size <= sizeof(scratch)) {
+			source = scratch;
+		} else {
+			source = (char *)MALLOC(st->size);
+			if(!source) return -1;
+		}
+		memcpy(source, st->buf + 1, st->size - 1);
+		source[st->size - 1] = '\0';
 
-		d = strtod((char *)st->buf, 0);
+		d = strtod(source, 0);
+		if(source != scratch) FREEMEM(source);
 		if(finite(d)) {
 			*dbl_value = d;
 			return 0;
@@ -35,7 +35,14 @@ asn_TYPE_descriptor_t asn_DEF_RELATIVE_OID = {
 	    / sizeof(asn_DEF_RELATIVE_OID_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	RELATIVE_OID_decode_jer,
+	RELATIVE_OID_encode_jer,
+	oer_decode_primitive,
+	oer_encode_primitive,
+	ASN__PRIMITIVE_TYPE_equals,
+	ASN__PRIMITIVE_TYPE_hash,
+	ASN__PRIMITIVE_TYPE_copy
 };
 
 static ssize_t
@@ -161,6 +168,43 @@ RELATIVE_OID_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * JER represents the identifier by the string of dotted arcs.
+ */
+asn_dec_rval_t
+RELATIVE_OID_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+
+	return jer_decode_primitive(opt_codec_ctx, td,
+		sptr, sizeof(RELATIVE_OID_t), buf_ptr, size,
+			JPB_STRING, RELATIVE_OID__xer_body_decode);
+}
+
+asn_enc_rval_t
+RELATIVE_OID_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const RELATIVE_OID_t *st = (const RELATIVE_OID_t *)sptr;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || !st->buf)
+		_ASN_ENCODE_FAILED;
+
+	/* The arcs need no escaping */
+	if(cb("\"", 1, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+	er.encoded = RELATIVE_OID__dump_body(st, cb, app_key);
+	if(er.encoded < 0 || cb("\"", 1, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+	er.encoded += 2;
+
+	_ASN_ENCODED_OK(er);
+}
+
 int
 RELATIVE_OID_get_arcs(RELATIVE_OID_t *roid,
 	void *arcs, unsigned int arc_type_size, unsigned int arc_slots) {
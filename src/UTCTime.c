@@ -43,7 +43,14 @@ asn_TYPE_descriptor_t asn_DEF_UTCTime = {
 	  / sizeof(asn_DEF_UTCTime_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	OCTET_STRING_decode_jer_utf8,
+	OCTET_STRING_encode_jer_utf8,
+	OCTET_STRING_decode_oer,
+	OCTET_STRING_encode_oer,
+	OCTET_STRING_equals,
+	OCTET_STRING_hash,
+	OCTET_STRING_copy
 };
 
 #endif	/* __ASN_INTERNAL_TEST_MODE__ */
@@ -33,7 +33,14 @@ asn_TYPE_descriptor_t asn_DEF_UniversalString = {
 	  / sizeof(asn_DEF_UniversalString_tags[0]),
 	0,	/* No PER visible constraints */
 	0, 0,	/* No members */
-	0	/* No specifics */
+	0,	/* No specifics */
+	UniversalString_decode_jer,
+	UniversalString_encode_jer,
+	OCTET_STRING_decode_oer,
+	OCTET_STRING_encode_oer,
+	OCTET_STRING_equals,
+	OCTET_STRING_hash,
+	OCTET_STRING_copy
 };
 
 
@@ -96,6 +103,50 @@ UniversalString__dump(const UniversalString_t *st,
 	return wrote;
 }
 
+/*
+ * Convert the string decoded in UTF-8 format into UCS-4 in place.
+ */
+static int
+UniversalString__from_utf8(UTF8String_t *st) {
+	uint32_t *wcs;
+	size_t wcs_len;
+#ifndef	WORDS_BIGENDIAN
+	int little_endian = 1;
+#endif
+
+	assert(st->buf);
+	wcs_len = UTF8String_to_wcs(st, 0, 0);
+
+	wcs = (uint32_t *)MALLOC(4 * (wcs_len + 1));
+	if(wcs == 0 || UTF8String_to_wcs(st, wcs, wcs_len) != wcs_len) {
+		FREEMEM(wcs);
+		return -1;
+	} else {
+		wcs[wcs_len] = 0;	/* nul-terminate */
+	}
+
+#ifndef	WORDS_BIGENDIAN
+	if(*(char *)&little_endian) {
+		/* Swap byte order in encoding */
+		uint32_t *wc = wcs;
+		uint32_t *wc_end = wcs + wcs_len;
+		for(; wc < wc_end; wc++) {
+			/* *wc = htonl(*wc); */
+			uint32_t wch = *wc;
+			*((uint8_t *)wc + 0) = wch >> 24;
+			*((uint8_t *)wc + 1) = wch >> 16;
+			*((uint8_t *)wc + 2) = wch >> 8;
+			*((uint8_t *)wc + 3) = wch;
+		}
+	}
+#endif	/* WORDS_BIGENDIAN */
+
+	FREEMEM(st->buf);
+	st->buf = (uint8_t *)wcs;
+	st->size = 4 * wcs_len;
+	return 0;
+}
+
 asn_dec_rval_t
 UniversalString_decode_xer(asn_codec_ctx_t *opt_codec_ctx,
 	asn_TYPE_descriptor_t *td, void **sptr,
@@ -107,48 +158,12 @@ UniversalString_decode_xer(asn_codec_ctx_t *opt_codec_ctx,
 	if(rc.code == RC_OK) {
 		/*
 		 * Now we have a whole string in UTF-8 format.
-		 * Convert it into UCS-4.
 		 */
-		uint32_t *wcs;
-		size_t wcs_len;
-		UTF8String_t *st;
-#ifndef	WORDS_BIGENDIAN
-		int little_endian = 1;
-#endif
-
 		assert(*sptr);
-		st = (UTF8String_t *)*sptr;
-		assert(st->buf);
-		wcs_len = UTF8String_to_wcs(st, 0, 0);
-
-		wcs = (uint32_t *)MALLOC(4 * (wcs_len + 1));
-		if(wcs == 0 || UTF8String_to_wcs(st, wcs, wcs_len) != wcs_len) {
+		if(UniversalString__from_utf8((UTF8String_t *)*sptr)) {
 			rc.code = RC_FAIL;
 			rc.consumed = 0;
-			return rc;
-		} else {
-			wcs[wcs_len] = 0;	/* nul-terminate */
 		}
-
-#ifndef	WORDS_BIGENDIAN
-		if(*(char *)&little_endian) {
-			/* Swap byte order in encoding */
-			uint32_t *wc = wcs;
-			uint32_t *wc_end = wcs + wcs_len;
-			for(; wc < wc_end; wc++) {
-				/* *wc = htonl(*wc); */
-				uint32_t wch = *wc;
-				*((uint8_t *)wc + 0) = wch >> 24;
-				*((uint8_t *)wc + 1) = wch >> 16;
-				*((uint8_t *)wc + 2) = wch >> 8;
-				*((uint8_t *)wc + 3) = wch;
-			}
-		}
-#endif	/* WORDS_BIGENDIAN */
-
-		FREEMEM(st->buf);
-		st->buf = (uint8_t *)wcs;
-		st->size = 4 * wcs_len;
 	}
 	return rc;
 }
@@ -172,6 +187,51 @@ UniversalString_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	_ASN_ENCODED_OK(er);
 }
 
+asn_dec_rval_t
+UniversalString_decode_jer(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_dec_rval_t rc;
+
+	rc = OCTET_STRING_decode_jer_utf8(opt_codec_ctx, td, sptr,
+		buf_ptr, size);
+	if(rc.code == RC_OK) {
+		assert(*sptr);
+		if(UniversalString__from_utf8((UTF8String_t *)*sptr)) {
+			rc.code = RC_FAIL;
+			rc.consumed = 0;
+		}
+	}
+	return rc;
+}
+
+asn_enc_rval_t
+UniversalString_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	const UniversalString_t *st = (const UniversalString_t *)sptr;
+	jer_escape_arg_t arg;
+	asn_enc_rval_t er;
+
+	(void)ilevel;
+	(void)flags;
+
+	if(!st || !st->buf)
+		_ASN_ENCODE_FAILED;
+
+	/* Escape the UTF-8 produced by the printer */
+	arg.cb = cb;
+	arg.app_key = app_key;
+	arg.encoded = 0;
+	if(cb("\"", 1, app_key) < 0
+	|| UniversalString__dump(st, jer_escape_consume, &arg) < 0
+	|| cb("\"", 1, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+
+	er.encoded = arg.encoded + 2;
+	_ASN_ENCODED_OK(er);
+}
+
 int
 UniversalString_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 	asn_app_consume_bytes_f *cb, void *app_key) {
@@ -29,15 +29,27 @@ win32:INCLUDEPATH += ../../VsHeaders
 
 SOURCES += \
     ANY.c \
+    asn_application.c \
+    asn_codec_stats.c \
+    asn_codec_trace.c \
     asn_codecs_prim.c \
+    asn_compare.c \
+    asn_copy.c \
+    asn_dec_error.c \
+    asn_flat.c \
+    asn_memory.c \
+    asn_parallel.c \
     asn_SEQUENCE_OF.c \
     asn_SET_OF.c \
     ber_decoder.c \
+    ber_iterative.c \
+    ber_stream.c \
     ber_tlv_length.c \
     ber_tlv_tag.c \
     BIT_STRING.c \
     BMPString.c \
     BOOLEAN.c \
+    cer_encoder.c \
     constr_CHOICE.c \
     constr_SEQUENCE.c \
     constr_SEQUENCE_OF.c \
@@ -53,6 +65,9 @@ SOURCES += \
     IA5String.c \
     INTEGER.c \
     ISO646String.c \
+    jer_decoder.c \
+    jer_encoder.c \
+    jer_support.c \
     NativeEnumerated.c \
     NativeInteger.c \
     NativeReal.c \
@@ -61,6 +76,9 @@ SOURCES += \
     OBJECT_IDENTIFIER.c \
     ObjectDescriptor.c \
     OCTET_STRING.c \
+    oer_decoder.c \
+    oer_encoder.c \
+    oer_support.c \
     per_decoder.c \
     per_encoder.c \
     per_support.c \
@@ -81,19 +99,25 @@ SOURCES += \
 HEADERS += \
     ../include/ANY.h \
     ../include/asn_application.h \
+    ../include/asn_codec_stats.h \
+    ../include/asn_codec_trace.h \
     ../include/asn_codecs.h \
     ../include/asn_codecs_prim.h \
+    ../include/asn_flat.h \
     ../include/asn_internal.h \
+    ../include/asn_parallel.h \
     ../include/asn_SEQUENCE_OF.h \
     ../include/asn_SET_OF.h \
     ../include/asn_system.h \
     ../include/AsnRuntime.h \
     ../include/ber_decoder.h \
+    ../include/ber_stream.h \
     ../include/ber_tlv_length.h \
     ../include/ber_tlv_tag.h \
     ../include/BIT_STRING.h \
     ../include/BMPString.h \
     ../include/BOOLEAN.h \
+    ../include/cer_encoder.h \
     ../include/constr_CHOICE.h \
     ../include/constr_SEQUENCE.h \
     ../include/constr_SEQUENCE_OF.h \
@@ -109,6 +133,9 @@ HEADERS += \
     ../include/IA5String.h \
     ../include/INTEGER.h \
     ../include/ISO646String.h \
+    ../include/jer_decoder.h \
+    ../include/jer_encoder.h \
+    ../include/jer_support.h \
     ../include/NativeEnumerated.h \
     ../include/NativeInteger.h \
     ../include/NativeReal.h \
@@ -117,6 +144,9 @@ HEADERS += \
     ../include/OBJECT_IDENTIFIER.h \
     ../include/ObjectDescriptor.h \
     ../include/OCTET_STRING.h \
+    ../include/oer_decoder.h \
+    ../include/oer_encoder.h \
+    ../include/oer_support.h \
     ../include/per_decoder.h \
     ../include/per_encoder.h \
     ../include/per_support.h \
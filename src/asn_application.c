@@ -0,0 +1,247 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <cer_encoder.h>
+#include <jer_encoder.h>
+#include <jer_decoder.h>
+#include <oer_encoder.h>
+#include <oer_decoder.h>
+#include <per_encoder.h>
+#include <per_decoder.h>
+
+asn_enc_rval_t
+asn_encode(enum asn_transfer_syntax syntax,
+		asn_TYPE_descriptor_t *td, void *sptr,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+
+	switch(syntax) {
+	case ATS_BER:
+	case ATS_DER:
+		return der_encode(td, sptr, cb, app_key);
+	case ATS_CER:
+		return cer_encode(td, sptr, cb, app_key);
+	case ATS_BASIC_XER:
+		return xer_encode(td, sptr, XER_F_BASIC, cb, app_key);
+	case ATS_CANONICAL_XER:
+		return xer_encode(td, sptr, XER_F_CANONICAL, cb, app_key);
+	case ATS_BASIC_JER:
+		return jer_encode(td, sptr, JER_F_BASIC, cb, app_key);
+	case ATS_MINIFIED_JER:
+		return jer_encode(td, sptr, JER_F_MINIFIED, cb, app_key);
+	case ATS_BASIC_OER:
+		return oer_encode(td, sptr, OER_F_BASIC, cb, app_key);
+	case ATS_CANONICAL_OER:
+		return oer_encode(td, sptr, OER_F_CANONICAL, cb, app_key);
+	case ATS_UNALIGNED_PER:
+		er = uper_encode(td, sptr, cb, app_key);
+		if(er.encoded > 0)
+			er.encoded = (er.encoded + 7) >> 3;
+		return er;
+	}
+
+	_ASN_ENCODE_FAILED;
+}
+
+/*
+ * Argument type and callback necessary for asn_encode_to_buffer().
+ * The DER encoding starts with the tag and the length of the whole,
+ * which the encoder has measured before writing anything: once the buffer
+ * is full, the encoding is cut short and its size is read from these.
+ * The other encodings are counted to the end.
+ */
+typedef struct enc_to_buf_arg {
+	asn_enc_chain_t chain;
+	int der;		/* Cut the DER encoding short */
+	uint8_t head[32];	/* The first bytes of the encoding */
+	size_t head_size;
+	ssize_t der_size;	/* Size of the DER encoding, read from (head) */
+} enc_to_buf_arg;
+static int encode_to_buffer_cb(const void *buffer, size_t size, void *key) {
+	enc_to_buf_arg *arg = (enc_to_buf_arg *)key;
+	ber_tlv_tag_t tag;
+	ber_tlv_len_t len;
+	ssize_t tag_len, len_len;
+
+	if(arg->head_size < sizeof(arg->head)) {
+		size_t take = sizeof(arg->head) - arg->head_size;
+		if(take > size) take = size;
+		memcpy(arg->head + arg->head_size, buffer, take);
+		arg->head_size += take;
+	}
+
+	asn_enc_chain_cb(buffer, size, &arg->chain);
+	if(!arg->der || !arg->chain.overflow)
+		return 0;
+
+	tag_len = ber_fetch_tag(arg->head, arg->head_size, &tag);
+	if(tag_len <= 0)
+		return 0;	/* Count on */
+	len_len = ber_fetch_length(1, arg->head + tag_len,
+		arg->head_size - tag_len, &len);
+	if(len_len <= 0 || len < 0
+	|| (size_t)(tag_len + len_len + len) < arg->chain.total)
+		return 0;	/* Count on */
+
+	arg->der_size = tag_len + len_len + len;
+	return -1;	/* Stop the encoder */
+}
+
+asn_enc_rval_t
+asn_encode_to_buffer(enum asn_transfer_syntax syntax,
+		asn_TYPE_descriptor_t *td, void *sptr,
+		void *buffer, size_t buffer_size) {
+	enc_to_buf_arg arg;
+	asn_enc_rval_t er;
+
+	memset(&arg, 0, sizeof(arg));
+	arg.chain.buffer = (uint8_t *)buffer;
+	arg.chain.size = buffer ? buffer_size : 0;
+	arg.der = (syntax == ATS_BER || syntax == ATS_DER);
+
+	er = asn_encode(syntax, td, sptr, encode_to_buffer_cb, &arg);
+	if(er.encoded == -1 && arg.der_size) {
+		er.encoded = arg.der_size;
+		er.failed_type = 0;
+		er.structure_ptr = 0;
+	} else if(er.encoded != -1) {
+		assert(er.encoded == (ssize_t)arg.chain.total);
+		/* Return the size of the whole encoding */
+	}
+	return er;
+}
+
+int
+asn_enc_chain_cb(const void *buffer, size_t size, void *key) {
+	asn_enc_chain_t *chain = (asn_enc_chain_t *)key;
+	const uint8_t *p = (const uint8_t *)buffer;
+	size_t room;
+
+	chain->total += size;
+
+	while(size && !chain->overflow) {
+		room = chain->size - chain->used;
+		if(room == 0) {
+			if(!chain->next_buffer
+			|| chain->next_buffer(chain, chain->app_key) < 0
+			|| chain->used >= chain->size) {
+				chain->overflow = 1;	/* Count the rest */
+				break;
+			}
+			continue;
+		}
+		if(room > size) room = size;
+		memcpy(chain->buffer + chain->used, p, room);
+		chain->used += room;
+		p += room;
+		size -= room;
+	}
+
+	return 0;
+}
+
+asn_dec_rval_t
+asn_decode(asn_codec_ctx_t *opt_codec_ctx, enum asn_transfer_syntax syntax,
+		asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buffer, size_t size) {
+	asn_dec_rval_t rval;
+
+	switch(syntax) {
+	case ATS_BER:
+	case ATS_DER:
+	case ATS_CER:
+		return ber_decode(opt_codec_ctx, td, sptr, buffer, size);
+	case ATS_BASIC_XER:
+	case ATS_CANONICAL_XER:
+		return xer_decode(opt_codec_ctx, td, sptr, buffer, size);
+	case ATS_BASIC_JER:
+	case ATS_MINIFIED_JER:
+		return jer_decode(opt_codec_ctx, td, sptr, buffer, size);
+	case ATS_BASIC_OER:
+	case ATS_CANONICAL_OER:
+		return oer_decode(opt_codec_ctx, td, sptr, buffer, size);
+	case ATS_UNALIGNED_PER:
+		rval = uper_decode(opt_codec_ctx, td, sptr, buffer, size, 0, 0);
+		rval.consumed = (rval.consumed + 7) >> 3;
+		return rval;
+	}
+
+	/* The transfer syntax is not supported */
+	ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+	ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_UNSUPPORTED, 0);
+	ASN_DEC_ERROR_END(opt_codec_ctx, td, RC_FAIL, -1);
+	_ASN_DECODE_FAILED;
+}
+
+#ifdef	ASN_THREAD_LOCAL
+/* The options of the asn_decode_ext() call in progress in this thread */
+ASN_THREAD_LOCAL const asn_codec_ctx_t *asn_dec__opts_ctx;
+ASN_THREAD_LOCAL const asn_dec_opts_t *asn_dec__opts;
+#endif	/* ASN_THREAD_LOCAL */
+
+asn_dec_ext_rval_t
+asn_decode_ext(const asn_dec_opts_t *opt_opts, enum asn_transfer_syntax syntax,
+		asn_TYPE_descriptor_t *td, void **sptr,
+		const void *buffer, size_t size) {
+	asn_codec_ctx_t s_codec_ctx;	/* Carries the options down */
+	asn_mem_account_t account;
+	asn_dec_ext_rval_t ext;
+	asn_dec_rval_t rval;
+#ifdef	ASN_THREAD_LOCAL
+	const asn_codec_ctx_t *outer_ctx = asn_dec__opts_ctx;
+	const asn_dec_opts_t *outer_opts = asn_dec__opts;
+#endif	/* ASN_THREAD_LOCAL */
+
+	memset(&ext, 0, sizeof(ext));
+	memset(&s_codec_ctx, 0, sizeof(s_codec_ctx));
+	s_codec_ctx.max_stack_size = opt_opts
+		? opt_opts->max_stack_size : _ASN_DEFAULT_STACK_MAX;
+
+#ifdef	ASN_THREAD_LOCAL
+	if(opt_opts) {
+		asn_dec__opts_ctx = &s_codec_ctx;
+		asn_dec__opts = opt_opts;
+	}
+#else	/* !ASN_THREAD_LOCAL */
+	if(opt_opts && (opt_opts->max_depth || opt_opts->max_memory
+			|| opt_opts->element_cb || opt_opts->error
+			|| opt_opts->intern_oids)) {
+		ext.code = RC_FAIL;	/* The options can not be honored */
+		return ext;
+	}
+#endif	/* ASN_THREAD_LOCAL */
+
+	/* The decoders join the account of this call */
+	asn_mem__begin(&account, &s_codec_ctx, 1);
+	switch(syntax) {
+	case ATS_BER:
+	case ATS_DER:
+	case ATS_CER:
+		if(opt_opts && opt_opts->max_depth) {
+			rval = ber_decode_iterative(&s_codec_ctx, td, sptr,
+				buffer, size);
+			break;
+		}
+		/* Fall through */
+	default:
+		rval = asn_decode(&s_codec_ctx, syntax, td, sptr,
+			buffer, size);
+	}
+	asn_mem__end(&account);
+
+#ifdef	ASN_THREAD_LOCAL
+	asn_dec__opts_ctx = outer_ctx;
+	asn_dec__opts = outer_opts;
+#endif	/* ASN_THREAD_LOCAL */
+
+	ext.code = rval.code;
+	ext.consumed = rval.consumed;
+	ext.memory_exceeded = (rval.code == RC_FAIL && account.exceeded);
+	ext.allocations = account.allocations;
+	ext.allocated = account.allocated;
+	ext.peak = account.peak;
+	ext.retained = account.footprint;
+
+	return ext;
+}
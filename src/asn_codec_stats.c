@@ -0,0 +1,521 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <asn_codec_stats.h>
+
+static const char *asn_codec_slot_names[ASN_CODEC_SLOTS] = {
+	"ber_decoder",
+	"der_encoder",
+	"xer_decoder",
+	"xer_encoder",
+	"uper_decoder",
+	"uper_encoder"
+};
+
+const char *
+asn_codec_slot_name(enum asn_codec_slot_e slot) {
+	if((unsigned)slot < ASN_CODEC_SLOTS)
+		return asn_codec_slot_names[slot];
+	return "?";
+}
+
+#ifdef	ASN_CODEC_STATS
+
+#if	defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>	/* for __rdtsc() */
+#elif	!defined(WIN32) && !(defined(__GNUC__) \
+		&& (defined(__i386__) || defined(__x86_64__)))
+#include <time.h>	/* for clock_gettime(2) */
+#endif
+
+/*
+ * The counters of a thread: a hash of the types it has called.
+ * The entries are only ever added, under the registry lock, which
+ * the readers take as well. The counters themselves are updated
+ * by the owning thread alone, without locking.
+ */
+#define	ASN_CODEC_STATS_BUCKETS	256	/* Power of 2 */
+typedef struct asn_codec_stats__entry_s {
+	struct asn_codec_stats__entry_s *next;
+	asn_codec_stats_t stats;
+} asn_codec_stats__entry_t;
+typedef struct asn_codec_stats__table_s {
+	struct asn_codec_stats__table_s *next;	/* The next in the registry */
+	int orphaned;		/* The thread has exited */
+	size_t entries;		/* Number of the types in the hash */
+	/* Time of the nested calls made by the call in progress */
+	unsigned long long nested_ticks;
+	asn_codec_stats__entry_t *buckets[ASN_CODEC_STATS_BUCKETS];
+} asn_codec_stats__table_t;
+
+/*
+ * The tables of all threads. The tables of the exited threads keep
+ * their counters and are handed over to the threads started later.
+ */
+static asn_codec_stats__table_t *asn_codec_stats__registry;
+static asn_rwlock_t asn_codec_stats__lock = ASN_RWLOCK_INITIALIZER;
+
+ASN_THREAD_LOCAL unsigned long asn_codec_stats__allocations;
+static ASN_THREAD_LOCAL asn_codec_stats__table_t *asn_codec_stats__current;
+
+#ifndef	WIN32
+/* The thread-specific key releasing the table when the thread exits */
+static pthread_key_t asn_codec_stats__key;
+static pthread_once_t asn_codec_stats__once = PTHREAD_ONCE_INIT;
+static void
+asn_codec_stats__release(void *arg) {
+	asn_codec_stats__table_t *t = (asn_codec_stats__table_t *)arg;
+	asn_rwlock_wrlock(&asn_codec_stats__lock);
+	t->nested_ticks = 0;
+	t->orphaned = 1;
+	asn_rwlock_wrunlock(&asn_codec_stats__lock);
+}
+static void
+asn_codec_stats__key_create(void) {
+	(void)pthread_key_create(&asn_codec_stats__key,
+		asn_codec_stats__release);
+}
+#endif	/* !WIN32 */
+
+/*
+ * Find the table for the calling thread.
+ */
+static asn_codec_stats__table_t *
+asn_codec_stats__attach(void) {
+	unsigned long allocations = asn_codec_stats__allocations;
+	asn_codec_stats__table_t *t;
+
+#ifndef	WIN32
+	(void)pthread_once(&asn_codec_stats__once, asn_codec_stats__key_create);
+#endif
+
+	asn_rwlock_wrlock(&asn_codec_stats__lock);
+	for(t = asn_codec_stats__registry; t; t = t->next) {
+		if(t->orphaned) {
+			t->orphaned = 0;
+			break;
+		}
+	}
+	if(!t) {
+		t = (asn_codec_stats__table_t *)CALLOC(1, sizeof(*t));
+		if(t) {
+			t->next = asn_codec_stats__registry;
+			asn_codec_stats__registry = t;
+		}
+	}
+	asn_rwlock_wrunlock(&asn_codec_stats__lock);
+
+	/* The bookkeeping is not to be counted against the codecs */
+	asn_codec_stats__allocations = allocations;
+
+	if(t) {
+#ifndef	WIN32
+		(void)pthread_setspecific(asn_codec_stats__key, t);
+#endif
+		asn_codec_stats__current = t;
+	}
+	return t;
+}
+
+/*
+ * Find or add the entry for the type.
+ */
+static asn_codec_stats__entry_t *
+asn_codec_stats__entry(asn_codec_stats__table_t *t, asn_TYPE_descriptor_t *td) {
+	asn_codec_stats__entry_t **bucket;
+	asn_codec_stats__entry_t *e;
+	unsigned long allocations;
+
+	bucket = &t->buckets[((size_t)td >> 4) & (ASN_CODEC_STATS_BUCKETS - 1)];
+	for(e = *bucket; e; e = e->next)
+		if(e->stats.type == td) return e;
+
+	allocations = asn_codec_stats__allocations;
+	e = (asn_codec_stats__entry_t *)CALLOC(1, sizeof(*e));
+	asn_codec_stats__allocations = allocations;
+	if(!e) return 0;
+	e->stats.type = td;
+
+	asn_rwlock_wrlock(&asn_codec_stats__lock);
+	e->next = *bucket;
+	*bucket = e;
+	t->entries++;
+	asn_rwlock_wrunlock(&asn_codec_stats__lock);
+
+	return e;
+}
+
+static unsigned long long
+asn_codec_stats__ticks(void) {
+#if	defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return __builtin_ia32_rdtsc();
+#elif	defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	return __rdtsc();
+#elif	defined(WIN32)
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return now.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+/*
+ * The state of a call saved across it.
+ */
+typedef struct asn_codec_stats__call_s {
+	asn_codec_stats__table_t *table;
+	unsigned long long nested_ticks;	/* Those of the caller */
+	unsigned long allocations;
+	unsigned long long start;
+} asn_codec_stats__call_t;
+
+static void
+asn_codec_stats__enter(asn_codec_stats__call_t *call) {
+	asn_codec_stats__table_t *t = asn_codec_stats__current;
+	if(!t) t = asn_codec_stats__attach();
+	call->table = t;
+	if(t) {
+		call->nested_ticks = t->nested_ticks;
+		t->nested_ticks = 0;
+	}
+	call->allocations = asn_codec_stats__allocations;
+	call->start = asn_codec_stats__ticks();
+}
+
+static void
+asn_codec_stats__leave(asn_codec_stats__call_t *call,
+		asn_TYPE_descriptor_t *td, enum asn_codec_slot_e slot,
+		unsigned long long bytes, int failed) {
+	unsigned long long spent = asn_codec_stats__ticks() - call->start;
+	asn_codec_stats__table_t *t = call->table;
+	asn_codec_stats__entry_t *e;
+
+	if(!t) return;	/* Out of memory */
+
+	e = asn_codec_stats__entry(t, td);
+	if(e) {
+		asn_codec_counters_t *c = &e->stats.slot[slot];
+		c->calls++;
+		c->failures += (failed != 0);
+		c->bytes += bytes;
+		c->allocations += asn_codec_stats__allocations
+				- call->allocations;
+		c->ticks += spent;
+		c->self_ticks += spent - t->nested_ticks;
+	}
+
+	t->nested_ticks = call->nested_ticks + spent;
+}
+
+static int
+asn_codec_stats__by_type(const void *ap, const void *bp) {
+	const asn_codec_stats_t *a = (const asn_codec_stats_t *)ap;
+	const asn_codec_stats_t *b = (const asn_codec_stats_t *)bp;
+	if(a->type < b->type) return -1;
+	return a->type > b->type;
+}
+
+static unsigned long long
+asn_codec_stats__self_ticks(const asn_codec_stats_t *s) {
+	unsigned long long sum = 0;
+	int i;
+	for(i = 0; i < ASN_CODEC_SLOTS; i++)
+		sum += s->slot[i].self_ticks;
+	return sum;
+}
+
+static int
+asn_codec_stats__by_time(const void *ap, const void *bp) {
+	unsigned long long a = asn_codec_stats__self_ticks(
+		(const asn_codec_stats_t *)ap);
+	unsigned long long b = asn_codec_stats__self_ticks(
+		(const asn_codec_stats_t *)bp);
+	if(a > b) return -1;
+	return a < b;
+}
+
+asn_codec_stats_t *
+asn_codec_stats_snapshot(size_t *count) {
+	asn_codec_stats__table_t *t;
+	asn_codec_stats__entry_t *e;
+	asn_codec_stats_t *stats;
+	size_t entries = 0;
+	size_t n, i;
+	int b, s;
+
+	*count = 0;
+
+	asn_rwlock_rdlock(&asn_codec_stats__lock);
+	for(t = asn_codec_stats__registry; t; t = t->next)
+		entries += t->entries;
+	stats = entries ? (asn_codec_stats_t *)MALLOC(entries * sizeof(*stats))
+			: 0;
+	if(!stats) {
+		asn_rwlock_rdunlock(&asn_codec_stats__lock);
+		return 0;
+	}
+	n = 0;
+	for(t = asn_codec_stats__registry; t; t = t->next)
+		for(b = 0; b < ASN_CODEC_STATS_BUCKETS; b++)
+			for(e = t->buckets[b]; e; e = e->next)
+				stats[n++] = e->stats;
+	asn_rwlock_rdunlock(&asn_codec_stats__lock);
+
+	/* Merge the entries of the same type coming from different threads */
+	qsort(stats, n, sizeof(*stats), asn_codec_stats__by_type);
+	for(entries = 0, i = 0; i < n; i++) {
+		asn_codec_stats_t *to = &stats[entries];
+		if(entries && to[-1].type == stats[i].type) {
+			for(s = 0; s < ASN_CODEC_SLOTS; s++) {
+				asn_codec_counters_t *c = &to[-1].slot[s];
+				c->calls += stats[i].slot[s].calls;
+				c->failures += stats[i].slot[s].failures;
+				c->bytes += stats[i].slot[s].bytes;
+				c->allocations += stats[i].slot[s].allocations;
+				c->ticks += stats[i].slot[s].ticks;
+				c->self_ticks += stats[i].slot[s].self_ticks;
+			}
+		} else {
+			if(to != &stats[i]) *to = stats[i];
+			entries++;
+		}
+	}
+	for(i = 0; i < entries; i++) {
+		stats[i].slot[ASN_CODEC_UPER_DECODER].bytes >>= 3;
+		stats[i].slot[ASN_CODEC_UPER_ENCODER].bytes >>= 3;
+	}
+	qsort(stats, entries, sizeof(*stats), asn_codec_stats__by_time);
+
+	*count = entries;
+	return stats;
+}
+
+void
+asn_codec_stats_reset(void) {
+	asn_codec_stats__table_t *t;
+	asn_codec_stats__entry_t *e;
+	int b;
+
+	asn_rwlock_rdlock(&asn_codec_stats__lock);
+	for(t = asn_codec_stats__registry; t; t = t->next)
+		for(b = 0; b < ASN_CODEC_STATS_BUCKETS; b++)
+			for(e = t->buckets[b]; e; e = e->next)
+				memset(e->stats.slot, 0, sizeof(e->stats.slot));
+	asn_rwlock_rdunlock(&asn_codec_stats__lock);
+}
+
+#else	/* !ASN_CODEC_STATS */
+
+asn_codec_stats_t *
+asn_codec_stats_snapshot(size_t *count) {
+	*count = 0;
+	return 0;
+}
+
+void
+asn_codec_stats_reset(void) {
+}
+
+#endif	/* ASN_CODEC_STATS */
+
+#if	defined(ASN_CODEC_STATS) || defined(ASN_CODEC_TRACE)
+
+/*
+ * The trampolines called instead of the codecs, see ASN_CODEC().
+ * They update the statistics and record the trace events, whichever
+ * of them are compiled in.
+ */
+typedef struct asn_codec__call_s {
+#ifdef	ASN_CODEC_STATS
+	asn_codec_stats__call_t stats;
+#endif
+#ifdef	ASN_CODEC_TRACE
+	asn_trace__frame_t trace;
+#endif
+} asn_codec__call_t;
+
+#ifdef	ASN_CODEC_STATS
+#define	STATS_ENTER()	asn_codec_stats__enter(&call.stats)
+#define	STATS_LEAVE(slot, bytes, failed)	\
+	asn_codec_stats__leave(&call.stats, td, slot, bytes, failed)
+#else
+#define	STATS_ENTER()
+#define	STATS_LEAVE(slot, bytes, failed)
+#endif
+
+/* The (offset) is only evaluated while tracing */
+#ifdef	ASN_CODEC_TRACE
+#define	TRACE_BEGIN(slot, offset)	do {			\
+		call.trace.traced = 0;				\
+		if(asn_trace__enabled)				\
+			asn_trace__begin(&call.trace, td, slot, offset);\
+	} while(0)
+#define	TRACE_END(slot, code, size)	do {			\
+		if(call.trace.traced)				\
+			asn_trace__end(&call.trace, td, slot, code, size);\
+	} while(0)
+#else
+#define	TRACE_BEGIN(slot, offset)
+#define	TRACE_END(slot, code, size)
+#endif
+
+asn_dec_rval_t
+asn_codec__ber_decoder(asn_codec_ctx_t *opt_codec_ctx,
+		asn_TYPE_descriptor_t *td, void **struct_ptr,
+		const void *buf_ptr, size_t size, int tag_mode) {
+	asn_codec__call_t call;
+	asn_dec_rval_t rval;
+
+	TRACE_BEGIN(ASN_CODEC_BER_DECODER, asn_trace__offset(buf_ptr));
+	STATS_ENTER();
+	rval = td->ber_decoder(opt_codec_ctx, td, struct_ptr,
+		buf_ptr, size, tag_mode);
+	STATS_LEAVE(ASN_CODEC_BER_DECODER,
+		rval.consumed, rval.code == RC_FAIL);
+	TRACE_END(ASN_CODEC_BER_DECODER, rval.code, rval.consumed);
+
+	return rval;
+}
+
+asn_enc_rval_t
+asn_codec__der_encoder(asn_TYPE_descriptor_t *td, void *sptr,
+		int tag_mode, ber_tlv_tag_t tag,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_codec__call_t call;
+	asn_enc_rval_t erval;
+
+	TRACE_BEGIN(ASN_CODEC_DER_ENCODER, -1);
+	STATS_ENTER();
+	erval = td->der_encoder(td, sptr, tag_mode, tag, cb, app_key);
+	STATS_LEAVE(ASN_CODEC_DER_ENCODER,
+		erval.encoded < 0 ? 0 : erval.encoded, erval.encoded < 0);
+	TRACE_END(ASN_CODEC_DER_ENCODER, erval.encoded < 0 ? -1 : 0,
+		erval.encoded < 0 ? 0 : erval.encoded);
+
+	return erval;
+}
+
+asn_dec_rval_t
+asn_codec__xer_decoder(asn_codec_ctx_t *opt_codec_ctx,
+		asn_TYPE_descriptor_t *td, void **struct_ptr,
+		const char *opt_mname, const void *buf_ptr, size_t size) {
+	asn_codec__call_t call;
+	asn_dec_rval_t rval;
+
+	TRACE_BEGIN(ASN_CODEC_XER_DECODER, asn_trace__offset(buf_ptr));
+	STATS_ENTER();
+	rval = td->xer_decoder(opt_codec_ctx, td, struct_ptr, opt_mname,
+		buf_ptr, size);
+	STATS_LEAVE(ASN_CODEC_XER_DECODER,
+		rval.consumed, rval.code == RC_FAIL);
+	TRACE_END(ASN_CODEC_XER_DECODER, rval.code, rval.consumed);
+
+	return rval;
+}
+
+asn_enc_rval_t
+asn_codec__xer_encoder(asn_TYPE_descriptor_t *td, void *sptr,
+		int ilevel, enum xer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_codec__call_t call;
+	asn_enc_rval_t erval;
+
+	TRACE_BEGIN(ASN_CODEC_XER_ENCODER, -1);
+	STATS_ENTER();
+	erval = td->xer_encoder(td, sptr, ilevel, flags, cb, app_key);
+	STATS_LEAVE(ASN_CODEC_XER_ENCODER,
+		erval.encoded < 0 ? 0 : erval.encoded, erval.encoded < 0);
+	TRACE_END(ASN_CODEC_XER_ENCODER, erval.encoded < 0 ? -1 : 0,
+		erval.encoded < 0 ? 0 : erval.encoded);
+
+	return erval;
+}
+
+/*
+ * The PER codecs count the bits; asn_codec_stats_snapshot()
+ * turns them into bytes.
+ */
+
+asn_dec_rval_t
+asn_codec__uper_decoder(asn_codec_ctx_t *opt_codec_ctx,
+		asn_TYPE_descriptor_t *td, asn_per_constraints_t *constraints,
+		void **struct_ptr, asn_per_data_t *pd) {
+	size_t left = pd->nbits - pd->nboff;
+	asn_codec__call_t call;
+	asn_dec_rval_t rval;
+
+	TRACE_BEGIN(ASN_CODEC_UPER_DECODER,
+		(asn_trace__offset(pd->buffer) << 3) + (long)pd->nboff);
+	STATS_ENTER();
+	rval = td->uper_decoder(opt_codec_ctx, td, constraints,
+		struct_ptr, pd);
+	left -= pd->nbits - pd->nboff;
+	STATS_LEAVE(ASN_CODEC_UPER_DECODER, left, rval.code == RC_FAIL);
+	TRACE_END(ASN_CODEC_UPER_DECODER, rval.code, left);
+
+	return rval;
+}
+
+asn_enc_rval_t
+asn_codec__uper_encoder(asn_TYPE_descriptor_t *td,
+		asn_per_constraints_t *constraints, void *sptr,
+		asn_per_outp_t *po) {
+	size_t written = ((po->flushed_bytes + (po->buffer - po->tmpspace)) << 3)
+			+ po->nboff;
+	asn_codec__call_t call;
+	asn_enc_rval_t erval;
+
+	TRACE_BEGIN(ASN_CODEC_UPER_ENCODER, (long)written);
+	STATS_ENTER();
+	erval = td->uper_encoder(td, constraints, sptr, po);
+	written = ((po->flushed_bytes + (po->buffer - po->tmpspace)) << 3)
+			+ po->nboff - written;
+	STATS_LEAVE(ASN_CODEC_UPER_ENCODER, written, erval.encoded < 0);
+	TRACE_END(ASN_CODEC_UPER_ENCODER, erval.encoded < 0 ? -1 : 0,
+		written);
+
+	return erval;
+}
+
+#endif	/* ASN_CODEC_STATS || ASN_CODEC_TRACE */
+
+int
+asn_codec_stats_fprint(FILE *stream) {
+	asn_codec_stats_t *stats;
+	size_t count, i;
+	int s;
+
+	if(!stream) stream = stdout;
+
+	stats = asn_codec_stats_snapshot(&count);
+
+	if(fprintf(stream, "%-24s %-13s %10s %9s %12s %10s %16s %16s\n",
+			"type", "codec", "calls", "failures", "bytes",
+			"allocs", "ticks", "self ticks") < 0) {
+		FREEMEM(stats);
+		return -1;
+	}
+	for(i = 0; i < count; i++) {
+		for(s = 0; s < ASN_CODEC_SLOTS; s++) {
+			asn_codec_counters_t *c = &stats[i].slot[s];
+			if(!c->calls) continue;
+			if(fprintf(stream, "%-24s %-13s %10llu %9llu %12llu"
+					" %10llu %16llu %16llu\n",
+					stats[i].type->name,
+					asn_codec_slot_name(s),
+					c->calls, c->failures, c->bytes,
+					c->allocations, c->ticks,
+					c->self_ticks) < 0) {
+				FREEMEM(stats);
+				return -1;
+			}
+		}
+	}
+
+	FREEMEM(stats);
+	return (fflush(stream) == 0) ? 0 : -1;
+}
@@ -0,0 +1,519 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <asn_codec_trace.h>
+#include <stdarg.h>	/* for va_list */
+
+#ifdef	ASN_CODEC_TRACE
+
+#ifndef	WIN32
+#include <pthread.h>
+#include <time.h>	/* for clock_gettime(2) */
+#endif
+
+#define	ASN_TRACE_DEFAULT_EVENTS	4096
+
+/*
+ * The ring buffer of the events of a thread, along with the state
+ * of the calls in progress.
+ */
+typedef struct asn_trace__ring_s {
+	asn_trace_event_t *events;
+	size_t size;		/* Number of the (events) */
+	unsigned long long recorded;	/* Number of the events ever recorded */
+	int depth;		/* Number of the calls in progress */
+	const void *base;	/* The buffer of the outermost decoder */
+	long offset;		/* Offset of the innermost call */
+	asn_TYPE_descriptor_t *type;	/* Type of the innermost call */
+	long tid;		/* Number of the thread, for the export */
+} asn_trace__ring_t;
+
+int asn_trace__enabled;
+static size_t asn_trace__size = ASN_TRACE_DEFAULT_EVENTS;
+static volatile long asn_trace__threads;
+static ASN_THREAD_LOCAL asn_trace__ring_t *asn_trace__current;
+
+#ifndef	WIN32
+/* The thread-specific key freeing the ring when the thread exits */
+static pthread_key_t asn_trace__key;
+static pthread_once_t asn_trace__once = PTHREAD_ONCE_INIT;
+static void
+asn_trace__release(void *arg) {
+	asn_trace__ring_t *r = (asn_trace__ring_t *)arg;
+	FREEMEM(r->events);
+	FREEMEM(r);
+}
+static void
+asn_trace__key_create(void) {
+	(void)pthread_key_create(&asn_trace__key, asn_trace__release);
+}
+#endif	/* !WIN32 */
+
+/*
+ * Get the ring of the calling thread, allocating it as necessary.
+ */
+static asn_trace__ring_t *
+asn_trace__ring(void) {
+	asn_trace__ring_t *r = asn_trace__current;
+
+	if(r) return r;
+
+#ifndef	WIN32
+	(void)pthread_once(&asn_trace__once, asn_trace__key_create);
+#endif
+	r = (asn_trace__ring_t *)CALLOC(1, sizeof(*r));
+	if(!r) return 0;
+	r->size = asn_trace__size;
+	r->events = (asn_trace_event_t *)CALLOC(r->size, sizeof(r->events[0]));
+	if(!r->events) {
+		FREEMEM(r);
+		return 0;
+	}
+	r->offset = -1;
+#ifdef	ASN_ATOMIC_FETCH_INC
+	r->tid = ASN_ATOMIC_FETCH_INC(&asn_trace__threads) + 1;
+#else
+	r->tid = ++asn_trace__threads;	/* Only used to tell them apart */
+#endif
+#ifndef	WIN32
+	(void)pthread_setspecific(asn_trace__key, r);
+#endif
+	asn_trace__current = r;
+	return r;
+}
+
+static unsigned long long
+asn_trace__now(void) {
+#ifdef	WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER now;
+	if(!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&now);
+	return (unsigned long long)(now.QuadPart / frequency.QuadPart)
+		* 1000000000
+		+ (now.QuadPart % frequency.QuadPart) * 1000000000
+			/ frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+static asn_trace_event_t *
+asn_trace__record(asn_trace__ring_t *r, enum asn_trace_event_e kind,
+		asn_TYPE_descriptor_t *td, long offset) {
+	asn_trace_event_t *e = &r->events[r->recorded++ % r->size];
+	e->kind = kind;
+	e->slot = ASN_CODEC_SLOTS;
+	e->code = 0;
+	e->type = td;
+	e->offset = offset;
+	e->size = 0;
+	e->time = asn_trace__now();
+	e->file = 0;
+	e->line = 0;
+	e->text[0] = '\0';
+	return e;
+}
+
+long
+asn_trace__offset(const void *ptr) {
+	asn_trace__ring_t *r = asn_trace__ring();
+	if(!r) return -1;
+	if(r->depth == 0) r->base = ptr;
+	return (const char *)ptr - (const char *)r->base;
+}
+
+void
+asn_trace__begin(asn_trace__frame_t *frame, asn_TYPE_descriptor_t *td,
+		int slot, long offset) {
+	asn_trace__ring_t *r = asn_trace__ring();
+	asn_trace_event_t *e;
+
+	if(!r) return;
+
+	frame->traced = 1;
+	frame->offset = r->offset;
+	frame->type = r->type;
+	r->offset = offset;
+	r->type = td;
+	r->depth++;
+
+	e = asn_trace__record(r, ASN_TRACE_BEGIN, td, offset);
+	e->slot = (enum asn_codec_slot_e)slot;
+}
+
+void
+asn_trace__end(asn_trace__frame_t *frame, asn_TYPE_descriptor_t *td,
+		int slot, int code, size_t size) {
+	asn_trace__ring_t *r = asn_trace__current;
+	asn_trace_event_t *e;
+
+	e = asn_trace__record(r, ASN_TRACE_END, td, r->offset);
+	e->slot = (enum asn_codec_slot_e)slot;
+	e->code = code;
+	e->size = size;
+
+	r->depth--;
+	r->offset = frame->offset;
+	r->type = frame->type;
+}
+
+void
+asn_trace__phase(asn_TYPE_descriptor_t *td, int phase, size_t consumed) {
+	asn_trace__ring_t *r = asn_trace__ring();
+	asn_trace_event_t *e;
+
+	if(!r) return;
+
+	e = asn_trace__record(r, ASN_TRACE_PHASE, td,
+		r->offset < 0 ? -1 : r->offset + (long)consumed);
+	e->code = phase;
+}
+
+static void
+asn_trace__vmessage(const char *file, int line, const char *fmt, va_list ap) {
+	asn_trace__ring_t *r = asn_trace__ring();
+	asn_trace_event_t *e;
+
+	if(!r) return;
+
+	e = asn_trace__record(r, ASN_TRACE_MESSAGE, r->type, r->offset);
+	e->file = file;
+	e->line = line;
+	vsnprintf(e->text, sizeof(e->text), fmt, ap);
+}
+
+void
+asn_trace__message(const char *file, int line, const char *fmt, ...) {
+	va_list ap;
+	va_start(ap, fmt);
+	asn_trace__vmessage(file, line, fmt, ap);
+	va_end(ap);
+}
+
+/*
+ * The replacement of the ASN_DEBUG() macro
+ * for the compilers without the variable args macros.
+ */
+void
+asn_trace__message_f(const char *fmt, ...) {
+	va_list ap;
+	if(!asn_trace__enabled) return;
+	va_start(ap, fmt);
+	asn_trace__vmessage(0, 0, fmt, ap);
+	va_end(ap);
+}
+
+int
+asn_trace_enable(size_t events) {
+	asn_trace__size = events ? events : ASN_TRACE_DEFAULT_EVENTS;
+	asn_trace__enabled = 1;
+	return 0;
+}
+
+void
+asn_trace_disable(void) {
+	asn_trace__enabled = 0;
+}
+
+void
+asn_trace_clear(void) {
+	asn_trace__ring_t *r = asn_trace__current;
+	if(r) r->recorded = 0;
+}
+
+size_t
+asn_trace_snapshot(asn_trace_event_t *events, size_t max) {
+	asn_trace__ring_t *r = asn_trace__current;
+	unsigned long long start;
+	size_t n, i;
+
+	if(!r) return 0;
+
+	n = r->recorded < r->size ? (size_t)r->recorded : r->size;
+	if(n > max) n = max;
+	start = r->recorded - n;
+	for(i = 0; i < n; i++)
+		events[i] = r->events[(start + i) % r->size];
+
+	return n;
+}
+
+/* The number of the events kept for the calling thread */
+static size_t
+asn_trace__kept(long *tid) {
+	asn_trace__ring_t *r = asn_trace__current;
+	if(!r) return 0;
+	*tid = r->tid;
+	return r->recorded < r->size ? (size_t)r->recorded : r->size;
+}
+
+#else	/* !ASN_CODEC_TRACE */
+
+int
+asn_trace_enable(size_t events) {
+	(void)events;
+	return -1;
+}
+
+void
+asn_trace_disable(void) {
+}
+
+void
+asn_trace_clear(void) {
+}
+
+size_t
+asn_trace_snapshot(asn_trace_event_t *events, size_t max) {
+	(void)events;
+	(void)max;
+	return 0;
+}
+
+static size_t
+asn_trace__kept(long *tid) {
+	(void)tid;
+	return 0;
+}
+
+#endif	/* ASN_CODEC_TRACE */
+
+static const char *
+asn_trace__name(const asn_trace_event_t *e) {
+	return e->type ? e->type->name : "?";
+}
+
+static const char *
+asn_trace__code(const asn_trace_event_t *e) {
+	switch(e->slot) {
+	case ASN_CODEC_BER_DECODER:
+	case ASN_CODEC_XER_DECODER:
+	case ASN_CODEC_UPER_DECODER:
+		switch(e->code) {
+		case RC_OK:	return "OK";
+		case RC_WMORE:	return "WMORE";
+		default:	return "FAIL";
+		}
+	default:
+		return e->code < 0 ? "FAIL" : "OK";
+	}
+}
+
+static int
+asn_trace__fprint_text(FILE *stream, const asn_trace_event_t *events,
+		size_t n) {
+	int depth = 0;
+	size_t i;
+
+	for(i = 0; i < n; i++) {
+		const asn_trace_event_t *e = &events[i];
+		int ret = 0;
+
+		if(e->kind == ASN_TRACE_END && depth > 0) depth--;
+		if(fprintf(stream, "%12.3f %*s", (e->time - events[0].time) / 1e3,
+				2 * depth, "") < 0)
+			return -1;
+
+		switch(e->kind) {
+		case ASN_TRACE_BEGIN:
+			ret = fprintf(stream, "> %s %s at %ld\n",
+				asn_trace__name(e),
+				asn_codec_slot_name(e->slot), e->offset);
+			depth++;
+			break;
+		case ASN_TRACE_END:
+			ret = fprintf(stream, "< %s %s %s, %lu %s\n",
+				asn_trace__name(e),
+				asn_codec_slot_name(e->slot),
+				asn_trace__code(e), (unsigned long)e->size,
+				(e->slot == ASN_CODEC_UPER_DECODER
+				|| e->slot == ASN_CODEC_UPER_ENCODER)
+					? "bits" : "bytes");
+			break;
+		case ASN_TRACE_PHASE:
+			ret = fprintf(stream, "  %s phase %d at %ld\n",
+				asn_trace__name(e), e->code, e->offset);
+			break;
+		case ASN_TRACE_MESSAGE:
+			if(e->file)
+				ret = fprintf(stream, "  %s (%s:%d)\n",
+					e->text, e->file, e->line);
+			else
+				ret = fprintf(stream, "  %s\n", e->text);
+			break;
+		}
+		if(ret < 0) return -1;
+	}
+
+	return 0;
+}
+
+/* Print out the JSON string */
+static int
+asn_trace__fprint_string(FILE *stream, const char *s) {
+	if(putc('"', stream) == EOF) return -1;
+	for(; *s; s++) {
+		int ret;
+		if(*s == '"' || *s == '\\')
+			ret = fprintf(stream, "\\%c", *s);
+		else if((unsigned char)*s < 0x20)
+			ret = fprintf(stream, "\\u%04x", (unsigned char)*s);
+		else
+			ret = putc(*s, stream);
+		if(ret < 0) return -1;
+	}
+	return (putc('"', stream) == EOF) ? -1 : 0;
+}
+
+static int
+asn_trace__fprint_chrome(FILE *stream, const asn_trace_event_t *events,
+		size_t n, long tid) {
+	size_t i;
+
+	if(fprintf(stream, "{\"traceEvents\":[") < 0)
+		return -1;
+
+	for(i = 0; i < n; i++) {
+		const asn_trace_event_t *e = &events[i];
+		double ts = e->time / 1e3;	/* Microseconds */
+
+		if(fprintf(stream, "%s\n{\"name\":", i ? "," : "") < 0)
+			return -1;
+		switch(e->kind) {
+		case ASN_TRACE_BEGIN:
+		case ASN_TRACE_END:
+			if(asn_trace__fprint_string(stream, asn_trace__name(e))
+			|| fprintf(stream, ",\"cat\":\"%s\",\"ph\":\"%s\","
+					"\"ts\":%.3f,\"pid\":1,\"tid\":%ld,",
+					asn_codec_slot_name(e->slot),
+					e->kind == ASN_TRACE_BEGIN ? "B" : "E",
+					ts, tid) < 0)
+				return -1;
+			if(e->kind == ASN_TRACE_BEGIN) {
+				if(fprintf(stream, "\"args\":{\"offset\":%ld}}",
+						e->offset) < 0)
+					return -1;
+			} else {
+				if(fprintf(stream, "\"args\":{\"result\":\"%s\","
+						"\"size\":%lu}}",
+						asn_trace__code(e),
+						(unsigned long)e->size) < 0)
+					return -1;
+			}
+			break;
+		case ASN_TRACE_PHASE:
+			if(fprintf(stream, "\"phase %d\",\"cat\":\"phase\","
+					"\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+					"\"pid\":1,\"tid\":%ld,"
+					"\"args\":{\"type\":",
+					e->code, ts, tid) < 0
+			|| asn_trace__fprint_string(stream, asn_trace__name(e))
+			|| fprintf(stream, ",\"offset\":%ld}}", e->offset) < 0)
+				return -1;
+			break;
+		case ASN_TRACE_MESSAGE:
+			if(asn_trace__fprint_string(stream, e->text)
+			|| fprintf(stream, ",\"cat\":\"message\","
+					"\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+					"\"pid\":1,\"tid\":%ld,"
+					"\"args\":{\"type\":", ts, tid) < 0
+			|| asn_trace__fprint_string(stream, asn_trace__name(e))
+			|| fprintf(stream, ",\"source\":\"%s:%d\"}}",
+					e->file ? e->file : "", e->line) < 0)
+				return -1;
+			break;
+		}
+	}
+
+	return (fprintf(stream, "\n]}\n") < 0) ? -1 : 0;
+}
+
+static int
+asn_trace__fprint_folded(FILE *stream, const asn_trace_event_t *events,
+		size_t n) {
+	/* The calls in progress */
+	struct asn_trace_frame_s {
+		const asn_trace_event_t *begin;
+		unsigned long long nested;	/* Time of the nested calls */
+	} *stack;
+	int depth = 0;
+	size_t i;
+	int d;
+
+	stack = (struct asn_trace_frame_s *)MALLOC((n + 1) * sizeof(*stack));
+	if(!stack) return -1;
+
+	for(i = 0; i < n; i++) {
+		const asn_trace_event_t *e = &events[i];
+		unsigned long long spent;
+
+		switch(e->kind) {
+		case ASN_TRACE_BEGIN:
+			stack[depth].begin = e;
+			stack[depth].nested = 0;
+			depth++;
+			continue;
+		case ASN_TRACE_END:
+			if(depth == 0) continue;	/* Began before the ring */
+			break;
+		default:
+			continue;
+		}
+
+		spent = e->time - stack[depth - 1].begin->time;
+		if(fprintf(stream, "%s",
+				asn_codec_slot_name(stack[0].begin->slot)) < 0)
+			break;
+		for(d = 0; d < depth; d++)
+			if(fprintf(stream, ";%s",
+					asn_trace__name(stack[d].begin)) < 0)
+				break;
+		if(d < depth || fprintf(stream, " %llu\n",
+				spent - stack[depth - 1].nested) < 0)
+			break;
+
+		depth--;
+		if(depth > 0) stack[depth - 1].nested += spent;
+	}
+
+	FREEMEM(stack);
+	return (i == n) ? 0 : -1;
+}
+
+int
+asn_trace_fprint(FILE *stream, enum asn_trace_format_e format) {
+	asn_trace_event_t *events;
+	long tid = 0;
+	size_t n;
+	int ret;
+
+	if(!stream) stream = stdout;
+
+	n = asn_trace__kept(&tid);
+	events = (asn_trace_event_t *)MALLOC((n ? n : 1) * sizeof(*events));
+	if(!events) return -1;
+	n = asn_trace_snapshot(events, n);
+
+	switch(format) {
+	case ASN_TRACE_TEXT:
+		ret = asn_trace__fprint_text(stream, events, n);
+		break;
+	case ASN_TRACE_CHROME:
+		ret = asn_trace__fprint_chrome(stream, events, n, tid);
+		break;
+	case ASN_TRACE_FOLDED:
+		ret = asn_trace__fprint_folded(stream, events, n);
+		break;
+	default:
+		ret = -1;
+	}
+
+	FREEMEM(events);
+	if(ret == 0 && fflush(stream)) ret = -1;
+	return ret;
+}
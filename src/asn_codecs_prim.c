@@ -4,7 +4,9 @@
  */
 #include <asn_internal.h>
 #include <asn_codecs_prim.h>
+#include <jer_support.h>
 #include <errno.h>
+#include <limits.h>	/* for INT_MAX */
 
 /*
  * Decode an always-primitive type.
@@ -16,6 +18,7 @@ ber_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
 	ASN__PRIMITIVE_TYPE_t *st = (ASN__PRIMITIVE_TYPE_t *)*sptr;
 	asn_dec_rval_t rval;
 	ber_tlv_len_t length;
+	int eocs;
 
 	/*
 	 * If the structure is not there, allocate it.
@@ -32,8 +35,8 @@ ber_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
 	/*
 	 * Check tags and extract value length.
 	 */
-	rval = ber_check_tags(opt_codec_ctx, td, 0, buf_ptr, size,
-			tag_mode, 0, &length, 0);
+	rval = ber_check_tags_eocs(opt_codec_ctx, td, 0, buf_ptr, size,
+			tag_mode, 0, &length, 0, &eocs);
 	if(rval.code != RC_OK)
 		return rval;
 
@@ -49,6 +52,16 @@ ber_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
 		rval.consumed = 0;
 		return rval;
 	}
+	if(eocs) {
+		/* The outer tags of indefinite length are closed */
+		ssize_t skip = ber_skip_eocs((const char *)buf_ptr + length,
+			size - length, eocs);
+		if(skip <= 0) {
+			rval.code = skip ? RC_FAIL : RC_WMORE;
+			rval.consumed = 0;
+			return rval;
+		}
+	}
 
 	st->size = (int)length;
 	/* The following better be optimized away. */
@@ -68,7 +81,7 @@ ber_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
 	st->buf[length] = '\0';		/* Just in case */
 
 	rval.code = RC_OK;
-	rval.consumed += length;
+	rval.consumed += length + 2 * eocs;
 
 	ASN_DEBUG("Took %ld/%ld bytes to encode %s",
 		(long)rval.consumed,
@@ -131,6 +144,58 @@ ASN__PRIMITIVE_TYPE_free(asn_TYPE_descriptor_t *td, void *sptr,
 		FREEMEM(st);
 }
 
+/*
+ * Compare the encoding bytes of the primitive types.
+ */
+int
+ASN__PRIMITIVE_TYPE_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	const ASN__PRIMITIVE_TYPE_t *a = (const ASN__PRIMITIVE_TYPE_t *)struct_a;
+	const ASN__PRIMITIVE_TYPE_t *b = (const ASN__PRIMITIVE_TYPE_t *)struct_b;
+
+	(void)td;
+
+	return a->size == b->size
+		&& (a->size <= 0 || memcmp(a->buf, b->buf, a->size) == 0);
+}
+
+uint64_t
+ASN__PRIMITIVE_TYPE_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	const ASN__PRIMITIVE_TYPE_t *st = (const ASN__PRIMITIVE_TYPE_t *)sptr;
+
+	(void)td;
+
+	return asn_hash__end(asn_hash__bytes(0, st->buf,
+		st->size > 0 ? st->size : 0));
+}
+
+int
+ASN__PRIMITIVE_TYPE_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	const ASN__PRIMITIVE_TYPE_t *src = (const ASN__PRIMITIVE_TYPE_t *)struct_src;
+	ASN__PRIMITIVE_TYPE_t *st;
+	size_t size = src->size > 0 ? src->size : 0;
+	uint8_t *buf = 0;
+
+	(void)td;
+
+	st = (ASN__PRIMITIVE_TYPE_t *)asn_copy__struct(copy, struct_dst,
+		sizeof(ASN__PRIMITIVE_TYPE_t));
+	if(!st) return -1;
+	if(src->buf) {
+		buf = (uint8_t *)asn_copy__alloc(copy, size + 1);
+		if(!buf) return -1;
+	}
+	if(ASN_COPY_MEASURING(copy))
+		return 0;
+
+	if(buf) memcpy(buf, src->buf, size);
+	st->buf = buf;
+	st->size = size;
+
+	return 0;
+}
+
 
 /*
  * Local internal type passed around as an argument.
@@ -293,3 +358,157 @@ xer_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
 	return rc;
 }
 
+
+
+asn_dec_rval_t
+jer_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td,
+	void **sptr,
+	size_t struct_size,
+	const void *buf_ptr, size_t size,
+	int accepted_tokens,
+	xer_primitive_body_decoder_f *prim_body_decoder
+) {
+	char scratch[128];	/* Short escaped strings */
+	const char *text;
+	size_t text_size;
+	jer_token_t tok;
+	enum xer_pbd_rval bret;
+	asn_dec_rval_t rc;
+	size_t consumed;
+	int token_mask;
+
+	(void)opt_codec_ctx;
+
+	consumed = jer_next_token(buf_ptr, size, &tok);
+	switch(tok.type) {
+	case JT_MORE:
+		rc.code = RC_WMORE;
+		rc.consumed = 0;
+		return rc;
+	case JT_STRING:
+		token_mask = JPB_STRING;
+		break;
+	case JT_NUMBER:
+		token_mask = JPB_NUMBER;
+		break;
+	case JT_TRUE:
+	case JT_FALSE:
+	case JT_NULL:
+		token_mask = JPB_LITERAL;
+		break;
+	default:
+		token_mask = 0;
+	}
+	if(!(token_mask & accepted_tokens))
+		_ASN_DECODE_FAILED;
+
+	/*
+	 * Create the structure if does not exist.
+	 */
+	if(!*sptr) {
+		*sptr = CALLOC(1, struct_size);
+		if(!*sptr) _ASN_DECODE_FAILED;
+	}
+
+	text = tok.start;
+	text_size = tok.length;
+	if(tok.escaped) {
+		char *unesc = (tok.length <= sizeof(scratch))
+			? scratch : (char *)MALLOC(tok.length);
+		ssize_t ret;
+		if(!unesc) _ASN_DECODE_FAILED;
+		ret = jer_unescape(tok.start, tok.length, unesc);
+		if(ret < 0) {
+			if(unesc != scratch) FREEMEM(unesc);
+			_ASN_DECODE_FAILED;
+		}
+		text = unesc;
+		text_size = ret;
+	}
+
+	bret = prim_body_decoder(td, *sptr, text, text_size);
+	if(text != tok.start && text != scratch)
+		FREEMEM((void *)text);
+	if(bret != XPBD_BODY_CONSUMED)
+		_ASN_DECODE_FAILED;
+
+	rc.code = RC_OK;
+	rc.consumed = consumed;
+	return rc;
+}
+
+/*
+ * Decode the length-prefixed contents octets of the primitive type.
+ */
+asn_dec_rval_t
+oer_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints,
+	void **sptr, const void *buf_ptr, size_t size) {
+	ASN__PRIMITIVE_TYPE_t *st = (ASN__PRIMITIVE_TYPE_t *)*sptr;
+	asn_dec_rval_t rval;
+	size_t len;
+	ssize_t skip;
+
+	(void)opt_codec_ctx;
+	(void)constraints;
+
+	skip = oer_fetch_length(buf_ptr, size, &len);
+	if(skip < 0)
+		_ASN_DECODE_FAILED;
+	if(skip == 0 || size - skip < len) {
+		rval.code = RC_WMORE;
+		rval.consumed = 0;
+		return rval;
+	}
+	if(len > (size_t)INT_MAX)
+		_ASN_DECODE_FAILED;
+
+	if(st == NULL) {
+		st = (ASN__PRIMITIVE_TYPE_t *)CALLOC(1, sizeof(*st));
+		if(st == NULL) _ASN_DECODE_FAILED;
+		*sptr = (void *)st;
+	}
+
+	FREEMEM(st->buf);
+	st->buf = (uint8_t *)MALLOC(len + 1);
+	if(!st->buf) {
+		st->size = 0;
+		_ASN_DECODE_FAILED;
+	}
+	memcpy(st->buf, (const char *)buf_ptr + skip, len);
+	st->buf[len] = '\0';	/* Just in case */
+	st->size = (int)len;
+
+	rval.code = RC_OK;
+	rval.consumed = skip + len;
+	return rval;
+}
+
+/*
+ * Encode the contents octets of the primitive type prefixed by the length.
+ */
+asn_enc_rval_t
+oer_encode_primitive(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e oer_flags,
+	asn_app_consume_bytes_f *cb, void *app_key) {
+	ASN__PRIMITIVE_TYPE_t *st = (ASN__PRIMITIVE_TYPE_t *)sptr;
+	asn_enc_rval_t er;
+	ssize_t ret;
+
+	(void)constraints;
+	(void)oer_flags;
+
+	if(!st || st->size < 0 || (st->size && !st->buf))
+		_ASN_ENCODE_FAILED;
+
+	ret = oer_serialize_length(st->size, cb, app_key);
+	if(ret < 0
+	|| (st->size && cb(st->buf, st->size, app_key) < 0))
+		_ASN_ENCODE_FAILED;
+
+	er.encoded = ret + st->size;
+	_ASN_ENCODED_OK(er);
+}
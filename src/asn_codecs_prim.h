@@ -17,8 +17,13 @@ typedef struct ASN__PRIMITIVE_TYPE_s {
 } ASN__PRIMITIVE_TYPE_t;	/* Do not use this type directly! */
 
 asn_struct_free_f ASN__PRIMITIVE_TYPE_free;
+asn_struct_equals_f ASN__PRIMITIVE_TYPE_equals;
+asn_struct_hash_f ASN__PRIMITIVE_TYPE_hash;
+asn_struct_copy_f ASN__PRIMITIVE_TYPE_copy;
 ber_type_decoder_f ber_decode_primitive;
 der_type_encoder_f der_encode_primitive;
+oer_type_decoder_f oer_decode_primitive;
+oer_type_encoder_f oer_encode_primitive;
 
 /*
  * A callback specification for the xer_decode_primitive() function below.
@@ -46,6 +51,28 @@ asn_dec_rval_t xer_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
 	xer_primitive_body_decoder_f *prim_body_decoder
 );
 
+/*
+ * JSON tokens acceptable for the primitive type, see below.
+ */
+enum jer_pbd_tokens {
+	JPB_STRING	= 0x01,	/* Contents of the "string", unescaped */
+	JPB_NUMBER	= 0x02,	/* Number text as is */
+	JPB_LITERAL	= 0x04	/* true, false or null */
+};
+
+/*
+ * Specific function to decode simple primitive types from JER.
+ * The (prim_body_decoder) is invoked once on the text of the JSON token,
+ * so the textual XER body decoders may be shared where the syntax agrees.
+ */
+asn_dec_rval_t jer_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *type_descriptor,
+	void **struct_ptr, size_t struct_size,
+	const void *buf_ptr, size_t size,
+	int accepted_tokens,	/* Mask of enum jer_pbd_tokens */
+	xer_primitive_body_decoder_f *prim_body_decoder
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,178 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <asn_codecs_prim.h>
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <REAL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <BIT_STRING.h>
+#include <BMPString.h>
+#include <UniversalString.h>
+#include <UTF8String.h>
+#include <GeneralizedTime.h>
+#include <UTCTime.h>
+#include <OBJECT_IDENTIFIER.h>
+#include <RELATIVE-OID.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SET_OF.h>
+#include <constr_SEQUENCE_OF.h>
+
+/*
+ * The runtime's comparison and hashing matched by the printer of the type,
+ * and by its DER encoder (if given) where the printer is shared.
+ */
+static const struct {
+	asn_struct_print_f *print_struct;
+	der_type_encoder_f *der_encoder;
+	asn_struct_equals_f *equals_struct;
+	asn_struct_hash_f *hash_struct;
+} asn_comparators[] = {
+	{ INTEGER_print, 0,		INTEGER_equals, INTEGER_hash },
+	{ NativeInteger_print, 0,	NativeInteger_equals, NativeInteger_hash },
+	{ BOOLEAN_print, 0,		BOOLEAN_equals, BOOLEAN_hash },
+	{ NULL_print, 0,		NULL_equals, NULL_hash },
+	{ REAL_print, 0,		REAL_equals, REAL_hash },
+	{ NativeReal_print, 0,		NativeReal_equals, NativeReal_hash },
+	{ OCTET_STRING_print, 0,	OCTET_STRING_equals, OCTET_STRING_hash },
+	{ OCTET_STRING_print_utf8, 0,	OCTET_STRING_equals, OCTET_STRING_hash },
+	{ UTF8String_print, 0,		OCTET_STRING_equals, OCTET_STRING_hash },
+	{ BMPString_print, 0,		OCTET_STRING_equals, OCTET_STRING_hash },
+	{ UniversalString_print, 0,	OCTET_STRING_equals, OCTET_STRING_hash },
+	{ GeneralizedTime_print, 0,	OCTET_STRING_equals, OCTET_STRING_hash },
+	{ UTCTime_print, 0,		OCTET_STRING_equals, OCTET_STRING_hash },
+	{ BIT_STRING_print, 0,		BIT_STRING_equals, BIT_STRING_hash },
+	{ OBJECT_IDENTIFIER_print, 0,
+		ASN__PRIMITIVE_TYPE_equals, ASN__PRIMITIVE_TYPE_hash },
+	{ RELATIVE_OID_print, 0,
+		ASN__PRIMITIVE_TYPE_equals, ASN__PRIMITIVE_TYPE_hash },
+	{ SEQUENCE_print, 0,		SEQUENCE_equals, SEQUENCE_hash },
+	{ SET_print, 0,			SET_equals, SET_hash },
+	{ CHOICE_print, 0,		CHOICE_equals, CHOICE_hash },
+	{ SET_OF_print, SEQUENCE_OF_encode_der,
+		SEQUENCE_OF_equals, SEQUENCE_OF_hash },
+	{ SET_OF_print, 0,		SET_OF_equals, SET_OF_hash }
+};
+
+/*
+ * Find the entry of the type in the table above.
+ */
+static int
+_asn_comparator(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	do {
+		for(i = 0; i < sizeof(asn_comparators)
+				/ sizeof(asn_comparators[0]); i++) {
+			if(asn_comparators[i].print_struct == td->print_struct
+			&& (!asn_comparators[i].der_encoder
+			  || asn_comparators[i].der_encoder == td->der_encoder))
+				return i;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	return -1;
+}
+
+int
+asn_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	int i;
+
+	if(struct_a == struct_b)
+		return 1;
+	if(!td || !struct_a || !struct_b)
+		return 0;
+
+	if(td->equals_struct)
+		return td->equals_struct(td, struct_a, struct_b);
+
+	i = _asn_comparator(td);
+	if(i < 0) {
+		ASN_DEBUG("%s can not be compared", td->name);
+		return 0;
+	}
+
+	return asn_comparators[i].equals_struct(td, struct_a, struct_b);
+}
+
+uint64_t
+asn_hash(asn_TYPE_descriptor_t *td, const void *struct_ptr) {
+	int i;
+
+	if(!td || !struct_ptr)
+		return 0;	/* Absent */
+
+	if(td->hash_struct)
+		return td->hash_struct(td, struct_ptr);
+
+	i = _asn_comparator(td);
+	if(i < 0) {
+		ASN_DEBUG("%s can not be hashed", td->name);
+		return 0;
+	}
+
+	return asn_comparators[i].hash_struct(td, struct_ptr);
+}
+
+/*
+ * The 64-bit mixing of MurmurHash3, by Austin Appleby (public domain).
+ */
+#define	ASN_HASH_C1	0x87c37b91114253d5ULL
+#define	ASN_HASH_C2	0x4cf5ad432745937fULL
+#define	ASN_HASH_ROTL(x, r)	(((x) << (r)) | ((x) >> (64 - (r))))
+
+uint64_t
+asn_hash__value(uint64_t hash, uint64_t value) {
+	value *= ASN_HASH_C1;
+	value = ASN_HASH_ROTL(value, 31);
+	value *= ASN_HASH_C2;
+	hash ^= value;
+	hash = ASN_HASH_ROTL(hash, 27);
+	return hash * 5 + 0x52dce729;
+}
+
+uint64_t
+asn_hash__bytes(uint64_t hash, const void *ptr, size_t size) {
+	const uint8_t *p = (const uint8_t *)ptr;
+	const uint8_t *end = p + size;
+	uint64_t word;
+	int shift;
+
+	/* Little endian words, for the same hash on every platform */
+	for(; end - p >= 8; p += 8) {
+		word = (uint64_t)p[0]
+			| ((uint64_t)p[1] << 8)
+			| ((uint64_t)p[2] << 16)
+			| ((uint64_t)p[3] << 24)
+			| ((uint64_t)p[4] << 32)
+			| ((uint64_t)p[5] << 40)
+			| ((uint64_t)p[6] << 48)
+			| ((uint64_t)p[7] << 56);
+		hash = asn_hash__value(hash, word);
+	}
+
+	for(word = 0, shift = 0; p < end; p++, shift += 8)
+		word |= (uint64_t)*p << shift;
+	if(shift)
+		hash = asn_hash__value(hash, word);
+
+	/* Tell the trailing zeros apart */
+	return asn_hash__value(hash, size);
+}
+
+uint64_t
+asn_hash__end(uint64_t hash) {
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
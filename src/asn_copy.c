@@ -0,0 +1,278 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <asn_codecs_prim.h>
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <REAL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <BIT_STRING.h>
+#include <BMPString.h>
+#include <UniversalString.h>
+#include <UTF8String.h>
+#include <GeneralizedTime.h>
+#include <UTCTime.h>
+#include <OBJECT_IDENTIFIER.h>
+#include <RELATIVE-OID.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SET_OF.h>
+
+/*
+ * The runtime's copying matched by the printer of the type.
+ */
+static const struct {
+	asn_struct_print_f *print_struct;
+	asn_struct_copy_f *copy_struct;
+} asn_copiers[] = {
+	{ INTEGER_print,		ASN__PRIMITIVE_TYPE_copy },
+	{ NativeInteger_print,		NativeInteger_copy },
+	{ BOOLEAN_print,		BOOLEAN_copy },
+	{ NULL_print,			BOOLEAN_copy },
+	{ REAL_print,			ASN__PRIMITIVE_TYPE_copy },
+	{ NativeReal_print,		NativeReal_copy },
+	{ OCTET_STRING_print,		OCTET_STRING_copy },
+	{ OCTET_STRING_print_utf8,	OCTET_STRING_copy },
+	{ UTF8String_print,		OCTET_STRING_copy },
+	{ BMPString_print,		OCTET_STRING_copy },
+	{ UniversalString_print,	OCTET_STRING_copy },
+	{ GeneralizedTime_print,	OCTET_STRING_copy },
+	{ UTCTime_print,		OCTET_STRING_copy },
+	{ BIT_STRING_print,		OCTET_STRING_copy },
+	{ OBJECT_IDENTIFIER_print,	ASN__PRIMITIVE_TYPE_copy },
+	{ RELATIVE_OID_print,		ASN__PRIMITIVE_TYPE_copy },
+	{ SEQUENCE_print,		SEQUENCE_copy },
+	{ SET_print,			SET_copy },
+	{ CHOICE_print,			CHOICE_copy },
+	{ SET_OF_print,			SET_OF_copy }
+};
+
+/*
+ * Get the copy_struct of the type by its print_struct.
+ */
+asn_struct_copy_f *
+asn_copy__copier(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	if(td->copy_struct)
+		return td->copy_struct;
+
+	do {
+		for(i = 0; i < sizeof(asn_copiers)/sizeof(asn_copiers[0]); i++) {
+			if(asn_copiers[i].print_struct == td->print_struct)
+				return asn_copiers[i].copy_struct;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	ASN_DEBUG("%s can not be copied", td->name);
+	return 0;
+}
+
+size_t
+asn_copy__sizeof(asn_TYPE_descriptor_t *td) {
+	asn_struct_copy_f *copier = asn_copy__copier(td);
+
+	if(copier == BOOLEAN_copy) {
+		return sizeof(BOOLEAN_t);
+	} else if(copier == NativeInteger_copy) {
+		return sizeof(long);
+	} else if(copier == NativeReal_copy) {
+		return sizeof(double);
+	} else if(copier == ASN__PRIMITIVE_TYPE_copy) {
+		return sizeof(ASN__PRIMITIVE_TYPE_t);
+	} else if(copier == OCTET_STRING_copy) {
+		asn_OCTET_STRING_specifics_t *specs
+			= (asn_OCTET_STRING_specifics_t *)td->specifics;
+		return specs ? (size_t)specs->struct_size
+				: (size_t)sizeof(OCTET_STRING_t);
+	} else if(copier == SEQUENCE_copy) {
+		return ((asn_SEQUENCE_specifics_t *)td->specifics)
+				->struct_size;
+	} else if(copier == SET_copy) {
+		return ((asn_SET_specifics_t *)td->specifics)
+				->struct_size;
+	} else if(copier == CHOICE_copy) {
+		return ((asn_CHOICE_specifics_t *)td->specifics)
+				->struct_size;
+	} else if(copier == SET_OF_copy) {
+		return ((asn_SET_OF_specifics_t *)td->specifics)
+				->struct_size;
+	}
+
+	return 0;
+}
+
+void
+asn_copy__recycle(asn_TYPE_descriptor_t *td, void **struct_ptr) {
+	size_t size;
+
+	if(!*struct_ptr)
+		return;
+
+	size = asn_copy__sizeof(td);
+	if(size) {
+		ASN_STRUCT_FREE_CONTENTS_ONLY(*td, *struct_ptr);
+		memset(*struct_ptr, 0, size);
+	} else {
+		ASN_STRUCT_FREE(*td, *struct_ptr);
+		*struct_ptr = 0;
+	}
+}
+
+void *
+asn_clone(asn_TYPE_descriptor_t *td, const void *struct_ptr,
+		enum asn_clone_flags_e flags) {
+	asn_struct_copy_f *copier;
+	asn_copy_t copy;
+	void *block;
+	void *dst = 0;
+
+	if(!td || !struct_ptr)
+		return 0;
+	copier = asn_copy__copier(td);
+	if(!copier)
+		return 0;
+
+	memset(&copy, 0, sizeof(copy));
+
+	if(!(flags & ACF_COMPACT)) {
+		if(copier(td, &dst, struct_ptr, &copy)) {
+			if(dst) ASN_STRUCT_FREE(*td, dst);
+			return 0;
+		}
+		return dst;
+	}
+
+	/* Measure, then lay the copy out in a single block */
+	copy.measuring = 1;
+	if(copier(td, &dst, struct_ptr, &copy))
+		return 0;
+	block = CALLOC(1, copy.size);
+	if(!block)
+		return 0;
+	dst = asn_copy__compact(td, struct_ptr, block, copy.size);
+	if(!dst) {
+		FREEMEM(block);
+		return 0;
+	}
+
+	return dst;
+}
+
+void *
+asn_copy__compact(asn_TYPE_descriptor_t *td, const void *struct_ptr,
+		void *block, size_t size) {
+	asn_struct_copy_f *copier;
+	asn_copy_t copy;
+	void *dst = 0;
+
+	copier = asn_copy__copier(td);
+	if(!copier)
+		return 0;
+
+	memset(&copy, 0, sizeof(copy));
+	copy.next = (char *)block;
+	copy.end = (char *)block + size;
+	if(copier(td, &dst, struct_ptr, &copy) || dst != block)
+		return 0;
+	assert(copy.next == copy.end);
+
+	return dst;
+}
+
+size_t
+asn_clone_size(asn_TYPE_descriptor_t *td, const void *struct_ptr) {
+	asn_struct_copy_f *copier;
+	asn_copy_t copy;
+	void *dst = 0;
+
+	if(!td || !struct_ptr)
+		return 0;
+	copier = asn_copy__copier(td);
+	if(!copier)
+		return 0;
+
+	memset(&copy, 0, sizeof(copy));
+	copy.measuring = 1;
+	if(copier(td, &dst, struct_ptr, &copy))
+		return 0;
+
+	return copy.size;
+}
+
+void *
+asn_copy__alloc(asn_copy_t *copy, size_t size) {
+	void *ptr;
+
+	if(!copy->next && !copy->measuring)
+		return CALLOC(1, size ? size : 1);
+
+	size = ASN_COPY_ALIGN(size);
+	if(copy->measuring) {
+		copy->size += size;
+		return (void *)copy;	/* Not to be touched */
+	}
+
+	if(size > (size_t)(copy->end - copy->next))
+		return 0;	/* Does not match the measured size */
+	ptr = copy->next;
+	copy->next += size;
+
+	return ptr;
+}
+
+void *
+asn_copy__struct(asn_copy_t *copy, void **struct_dst, size_t size) {
+	void *ptr = *struct_dst;
+
+	if(ptr)
+		return ptr;	/* In place */
+
+	ptr = asn_copy__alloc(copy, size);
+	if(ptr && !copy->measuring)
+		*struct_dst = ptr;
+
+	return ptr;
+}
+
+/*
+ * Copy the member (elm) of the structure (src) into the structure (dst).
+ * The absent members are left zero. While measuring, (dst) is not used.
+ */
+int
+asn_copy__member(asn_copy_t *copy, asn_TYPE_member_t *elm,
+		void *dst, const void *src) {
+	asn_struct_copy_f *copier;
+	const void *memb_src;
+	void *memb_dst = 0;
+	void **memb_dst2;
+
+	copier = asn_copy__copier(elm->type);
+	if(!copier)
+		return -1;
+
+	if(elm->flags & ATF_POINTER) {
+		memb_src = *(const void * const *)((const char *)src
+			+ elm->memb_offset);
+		if(!memb_src)
+			return 0;	/* Absent */
+		if(copy->measuring)
+			memb_dst2 = &memb_dst;
+		else
+			memb_dst2 = (void **)((char *)dst + elm->memb_offset);
+	} else {
+		memb_src = (const void *)((const char *)src + elm->memb_offset);
+		if(copy->measuring)
+			memb_dst = (void *)memb_src;	/* In place, untouched */
+		else
+			memb_dst = (void *)((char *)dst + elm->memb_offset);
+		memb_dst2 = &memb_dst;
+	}
+
+	return copier(elm->type, memb_dst2, memb_src, copy);
+}
@@ -0,0 +1,125 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <stdarg.h>	/* for va_list */
+
+static const char *asn_dec_error__reasons[] = {
+	"no error",
+	"malformed value",
+	"unexpected tag",
+	"bad length",
+	"missing member",
+	"nesting too deep",
+	"out of memory",
+	"codec not supported"
+};
+
+const char *
+asn_dec_error_reason_name(enum asn_dec_error_reason_e reason) {
+	if((unsigned)reason < sizeof(asn_dec_error__reasons)
+			/ sizeof(asn_dec_error__reasons[0]))
+		return asn_dec_error__reasons[reason];
+	return "unknown error";
+}
+
+void
+asn_dec_error__begin(asn_dec_error_t *err) {
+	if(err->nesting++)
+		return;	/* Recorded for the outer call */
+	err->reason = ASN_DEC_ERROR_NONE;
+	err->type = 0;
+	err->offset = 0;
+	err->path[0] = '\0';
+	err->segments_count = 0;
+}
+
+void
+asn_dec_error__set(asn_dec_error_t *err, asn_TYPE_descriptor_t *td,
+		enum asn_dec_error_reason_e reason, long offset) {
+	if(err->reason != ASN_DEC_ERROR_NONE)
+		return;	/* The nested decoder knows better */
+	err->reason = reason;
+	err->type = td;
+	err->offset = offset;
+}
+
+void
+asn_dec_error__member(asn_dec_error_t *err, asn_TYPE_descriptor_t *td,
+		const char *name, long index, long offset) {
+	struct asn_dec_error_segment_s *seg;
+
+	if(err->reason == ASN_DEC_ERROR_NONE) {
+		/* The member has failed without telling why */
+		err->reason = ASN_DEC_ERROR_VALUE;
+		err->offset = 0;
+	}
+	if(!err->type)
+		err->type = td;
+	if(offset > 0)
+		err->offset += offset;
+
+	/* Keep the innermost segments, counting the others */
+	if(err->segments_count++ < ASN_DEC_ERROR_SEGMENTS) {
+		seg = &err->segments[err->segments_count - 1];
+		seg->name = name;
+		seg->index = index;
+	}
+}
+
+static void
+asn_dec_error__append(char **p, char *end, const char *fmt, ...) {
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = vsnprintf(*p, end - *p, fmt, ap);
+	va_end(ap);
+
+	if(ret < 0) return;
+	if(ret >= end - *p) ret = end - *p - 1;	/* Truncated */
+	*p += ret;
+}
+
+void
+asn_dec_error__end(asn_dec_error_t *err, asn_TYPE_descriptor_t *td,
+		enum asn_dec_rval_code_e code, long offset) {
+	char *p = err->path;
+	char *end = err->path + sizeof(err->path);
+	size_t i;
+
+	if(--err->nesting)
+		return;	/* The outer call will complete it */
+
+	if(code != RC_FAIL) {
+		/* Forget the failures the decoders have recovered from */
+		err->reason = ASN_DEC_ERROR_NONE;
+		err->type = 0;
+		err->offset = 0;
+		err->segments_count = 0;
+		return;
+	}
+
+	if(err->reason == ASN_DEC_ERROR_NONE)
+		err->reason = ASN_DEC_ERROR_VALUE;
+	if(!err->type)
+		err->type = td;
+	if(offset != -1)
+		err->offset = offset;
+
+	/* The path goes from the outermost type down */
+	asn_dec_error__append(&p, end, "%s", td->name);
+	i = err->segments_count;
+	if(i > ASN_DEC_ERROR_SEGMENTS) {
+		asn_dec_error__append(&p, end, "...");
+		i = ASN_DEC_ERROR_SEGMENTS;
+	}
+	while(i--) {
+		struct asn_dec_error_segment_s *seg = &err->segments[i];
+		if(seg->index >= 0)
+			asn_dec_error__append(&p, end, "[%ld]", seg->index);
+		else if(seg->name && *seg->name)
+			asn_dec_error__append(&p, end, ".%s", seg->name);
+	}
+	err->segments_count = 0;
+}
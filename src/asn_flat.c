@@ -0,0 +1,511 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <asn_flat.h>
+#include <asn_codecs_prim.h>
+#include <BOOLEAN.h>
+#include <NativeInteger.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SET_OF.h>
+#include <asn_SET_OF.h>
+#include <errno.h>
+#ifndef	WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif	/* WIN32 */
+
+#define	ASN_FLAT_MAGIC		"ASN1FLAT"
+#define	ASN_FLAT_VERSION	1
+#define	ASN_FLAT_BYTE_ORDER	0x01020304
+#define	ASN_FLAT_LAYOUT		(sizeof(void *)		\
+				| (sizeof(long) << 8)	\
+				| (sizeof(int) << 16)	\
+				| (sizeof(double) << 24))
+
+/*
+ * The header of the image, followed by the compact copy of the structure.
+ */
+typedef struct asn_flat_header_s {
+	uint8_t magic[8];	/* ASN_FLAT_MAGIC */
+	uint32_t version;	/* ASN_FLAT_VERSION */
+	uint32_t byte_order;	/* ASN_FLAT_BYTE_ORDER as written */
+	uint32_t layout;	/* ASN_FLAT_LAYOUT */
+	uint32_t reserved;
+	uint64_t size;		/* Size of the image */
+	uint64_t root;		/* Offset of the structure */
+	uint64_t type;		/* Hash of the type, see _flat_type() */
+} asn_flat_header_t;
+
+struct asn_flat_s {
+	asn_TYPE_descriptor_t *td;
+	const char *base;	/* The image */
+	size_t size;
+	int mapped;		/* Mapped by asn_flat_open() */
+};
+
+/*
+ * The layout of the structures, told by their copy_struct.
+ */
+enum asn_flat_kind_e {
+	AFK_NONE,	/* Unknown */
+	AFK_SCALAR,	/* No pointers */
+	AFK_BUFFER,	/* The (buf, size) of the ASN__PRIMITIVE_TYPE_t */
+	AFK_MEMBERS,	/* SEQUENCE and SET */
+	AFK_CHOICE,
+	AFK_LIST	/* SET OF and SEQUENCE OF */
+};
+
+static enum asn_flat_kind_e
+_flat_kind(asn_TYPE_descriptor_t *td, size_t *struct_size) {
+	asn_struct_copy_f *copier = asn_copy__copier(td);
+
+	*struct_size = asn_copy__sizeof(td);
+
+	if(copier == BOOLEAN_copy
+	|| copier == NativeInteger_copy
+	|| copier == NativeReal_copy)
+		return AFK_SCALAR;
+	else if(copier == ASN__PRIMITIVE_TYPE_copy
+	     || copier == OCTET_STRING_copy)
+		return AFK_BUFFER;
+	else if(copier == SEQUENCE_copy || copier == SET_copy)
+		return AFK_MEMBERS;
+	else if(copier == CHOICE_copy)
+		return AFK_CHOICE;
+	else if(copier == SET_OF_copy)
+		return AFK_LIST;
+
+	return AFK_NONE;
+}
+
+/*
+ * The hash of the type name and the size and the number of members
+ * of its structure, telling the image of another type.
+ */
+static uint64_t
+_flat_type(asn_TYPE_descriptor_t *td) {
+	uint64_t hash = 0;
+	size_t struct_size;
+
+	(void)_flat_kind(td, &struct_size);
+	hash = asn_hash__bytes(hash, td->name, strlen(td->name));
+	hash = asn_hash__value(hash, struct_size);
+	hash = asn_hash__value(hash, td->elements_count);
+
+	return asn_hash__end(hash);
+}
+
+/*
+ * The pointers are turned into offsets as the image is written,
+ * and back into pointers as it is thawed. The offsets point forward,
+ * for the copy_struct allocates the parts after their structure,
+ * so the image with a loop in it is rejected as corrupt.
+ */
+typedef struct asn_flat_walk_s {
+	int thaw;		/* Offsets into pointers */
+	char *block;		/* The compact copy */
+	size_t start;		/* Offset of the (block) in the image */
+	size_t size;		/* Size of the image */
+} asn_flat_walk_t;
+
+static int
+_flat_slot(asn_flat_walk_t *walk, void *slot, size_t size, char **target) {
+	size_t slot_off = (size_t)((char *)slot - walk->block) + walk->start;
+	char *ptr;
+	size_t off;
+
+	if(!walk->thaw) {
+		ptr = *(char **)slot;
+		*target = ptr;
+		if(ptr) {
+			off = (size_t)(ptr - walk->block) + walk->start;
+			assert(off > slot_off && off < walk->size);
+			*(void **)slot = (void *)(uintptr_t)off;
+		}
+		return 0;
+	}
+
+	off = (size_t)(uintptr_t)*(void **)slot;
+	if(!off) {
+		*target = 0;
+		return 0;
+	}
+	if(off <= slot_off || off >= walk->size
+	|| size > walk->size - off
+	|| ASN_COPY_ALIGN(off) != off) {
+		ASN_DEBUG("Corrupt flat image: offset %lu at %lu",
+			(unsigned long)off, (unsigned long)slot_off);
+		return -1;
+	}
+	ptr = walk->block + (off - walk->start);
+	*(void **)slot = ptr;
+	*target = ptr;
+
+	return 0;
+}
+
+static int
+_flat_walk(asn_flat_walk_t *walk, asn_TYPE_descriptor_t *td, void *sptr) {
+	enum asn_flat_kind_e kind;
+	size_t struct_size;
+	char *target;
+	int edx;
+
+	kind = _flat_kind(td, &struct_size);
+	switch(kind) {
+	case AFK_NONE:
+		ASN_DEBUG("%s can not be flattened", td->name);
+		return -1;
+	case AFK_SCALAR:
+		return 0;
+	case AFK_BUFFER: {
+		ASN__PRIMITIVE_TYPE_t *st = (ASN__PRIMITIVE_TYPE_t *)sptr;
+		if(st->size < 0) return -1;
+		return _flat_slot(walk, &st->buf, (size_t)st->size + 1,
+			&target);
+	  }
+	case AFK_MEMBERS:
+	case AFK_CHOICE:
+		for(edx = 0; edx < td->elements_count; edx++) {
+			asn_TYPE_member_t *elm = &td->elements[edx];
+			char *memb_ptr = (char *)sptr + elm->memb_offset;
+
+			if(kind == AFK_CHOICE
+			&& CHOICE_present(td, sptr) != edx + 1)
+				continue;
+
+			if(elm->flags & ATF_POINTER) {
+				size_t memb_size;
+				(void)_flat_kind(elm->type, &memb_size);
+				if(_flat_slot(walk, memb_ptr, memb_size, &target))
+					return -1;
+				if(!target) continue;	/* Absent */
+				memb_ptr = target;
+			}
+			if(_flat_walk(walk, elm->type, memb_ptr))
+				return -1;
+		}
+		return 0;
+	case AFK_LIST: {
+		asn_anonymous_set_ *list = _A_SET_FROM_VOID(sptr);
+		size_t memb_size;
+		char **array;
+		int i;
+
+		if(list->count < 0
+		|| (size_t)list->count > walk->size / sizeof(void *))
+			return -1;
+		if(_flat_slot(walk, &list->array,
+				list->count * sizeof(void *), &target))
+			return -1;
+		array = (char **)target;
+		if(!array) return list->count ? -1 : 0;
+
+		(void)_flat_kind(td->elements->type, &memb_size);
+		for(i = 0; i < list->count; i++) {
+			if(_flat_slot(walk, &array[i], memb_size, &target)
+			|| !target
+			|| _flat_walk(walk, td->elements->type, target))
+				return -1;
+		}
+		return 0;
+	  }
+	}
+
+	return -1;
+}
+
+int
+asn_flat_write(asn_TYPE_descriptor_t *td, const void *struct_ptr,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_flat_header_t *header;
+	asn_flat_walk_t walk;
+	size_t size;
+	char *image;
+	void *root;
+	int ret;
+
+	if(!td || !struct_ptr || !cb)
+		return -1;
+
+	size = asn_clone_size(td, struct_ptr);
+	if(!size)
+		return -1;
+	image = (char *)CALLOC(1, sizeof(*header) + size);
+	if(!image)
+		return -1;
+
+	root = asn_copy__compact(td, struct_ptr, image + sizeof(*header), size);
+	walk.thaw = 0;
+	walk.block = image + sizeof(*header);
+	walk.start = sizeof(*header);
+	walk.size = sizeof(*header) + size;
+	if(!root || _flat_walk(&walk, td, root)) {
+		FREEMEM(image);
+		return -1;
+	}
+
+	header = (asn_flat_header_t *)image;
+	memcpy(header->magic, ASN_FLAT_MAGIC, sizeof(header->magic));
+	header->version = ASN_FLAT_VERSION;
+	header->byte_order = ASN_FLAT_BYTE_ORDER;
+	header->layout = ASN_FLAT_LAYOUT;
+	header->size = walk.size;
+	header->root = sizeof(*header);
+	header->type = _flat_type(td);
+
+	ret = cb(image, walk.size, app_key) < 0 ? -1 : 0;
+	FREEMEM(image);
+
+	return ret;
+}
+
+asn_flat_t *
+asn_flat_view(asn_TYPE_descriptor_t *td, const void *image, size_t size) {
+	const asn_flat_header_t *header = (const asn_flat_header_t *)image;
+	size_t struct_size;
+	asn_flat_t *flat;
+
+	if(!td || !image || size < sizeof(*header)
+	|| ((uintptr_t)image % sizeof(asn_copy__align_t))
+	|| memcmp(header->magic, ASN_FLAT_MAGIC, sizeof(header->magic))
+	|| header->version != ASN_FLAT_VERSION
+	|| header->byte_order != ASN_FLAT_BYTE_ORDER
+	|| header->layout != ASN_FLAT_LAYOUT
+	|| header->size != size
+	|| header->root != sizeof(*header)
+	|| header->type != _flat_type(td)
+	|| _flat_kind(td, &struct_size) == AFK_NONE
+	|| struct_size > size - sizeof(*header)) {
+		ASN_DEBUG("Not a flat image of %s", td ? td->name : "?");
+		errno = EINVAL;
+		return 0;
+	}
+
+	flat = (asn_flat_t *)CALLOC(1, sizeof(*flat));
+	if(!flat)
+		return 0;
+	flat->td = td;
+	flat->base = (const char *)image;
+	flat->size = size;
+
+	return flat;
+}
+
+asn_flat_t *
+asn_flat_open(asn_TYPE_descriptor_t *td, const char *filename) {
+	asn_flat_t *flat;
+	void *image;
+	size_t size;
+#ifdef	WIN32
+	HANDLE file, mapping;
+	LARGE_INTEGER file_size;
+
+	file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+		return 0;
+	if(!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0
+	|| (uint64_t)file_size.QuadPart > (size_t)-1) {
+		CloseHandle(file);
+		errno = EINVAL;
+		return 0;
+	}
+	size = (size_t)file_size.QuadPart;
+	mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if(!mapping)
+		return 0;
+	image = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if(!image)
+		return 0;
+#else	/* !WIN32 */
+	struct stat st;
+	int fd;
+
+	fd = open(filename, O_RDONLY);
+	if(fd == -1)
+		return 0;
+	if(fstat(fd, &st) || st.st_size <= 0
+	|| (uint64_t)st.st_size > (size_t)-1) {
+		close(fd);
+		errno = EINVAL;
+		return 0;
+	}
+	size = (size_t)st.st_size;
+	image = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(image == MAP_FAILED)
+		return 0;
+#endif	/* WIN32 */
+
+	flat = asn_flat_view(td, image, size);
+	if(!flat) {
+#ifdef	WIN32
+		UnmapViewOfFile(image);
+#else
+		munmap(image, size);
+#endif
+		errno = EINVAL;
+		return 0;
+	}
+	flat->mapped = 1;
+
+	return flat;
+}
+
+void
+asn_flat_close(asn_flat_t *flat) {
+	if(!flat)
+		return;
+	if(flat->mapped) {
+#ifdef	WIN32
+		UnmapViewOfFile((void *)flat->base);
+#else
+		munmap((void *)flat->base, flat->size);
+#endif
+	}
+	FREEMEM(flat);
+}
+
+const void *
+asn_flat_root(const asn_flat_t *flat) {
+	return flat ? flat->base + sizeof(asn_flat_header_t) : 0;
+}
+
+/*
+ * The (size) bytes pointed to by the offset in the (slot) of the image.
+ */
+static const void *
+_flat_ptr(const asn_flat_t *flat, const void *slot, size_t size) {
+	size_t slot_off = (size_t)((const char *)slot - flat->base);
+	size_t off;
+
+	if(slot_off >= flat->size)
+		return 0;	/* Not in the image */
+	off = (size_t)(uintptr_t)*(const void * const *)slot;
+	if(off <= slot_off || off >= flat->size
+	|| size > flat->size - off
+	|| ASN_COPY_ALIGN(off) != off)
+		return 0;	/* Absent or corrupt */
+
+	return flat->base + off;
+}
+
+const void *
+asn_flat_member(const asn_flat_t *flat, asn_TYPE_descriptor_t *td,
+		const void *struct_ptr, int member) {
+	asn_TYPE_member_t *elm;
+	const char *memb_ptr;
+	size_t size;
+
+	if(!flat || !td || !struct_ptr)
+		return 0;
+
+	switch(_flat_kind(td, &size)) {
+	case AFK_CHOICE:
+		if(CHOICE_present(td, struct_ptr) != member + 1)
+			return 0;
+		/* Fall through */
+	case AFK_MEMBERS:
+		if(member < 0 || member >= td->elements_count)
+			return 0;
+		break;
+	default:
+		return 0;
+	}
+
+	elm = &td->elements[member];
+	memb_ptr = (const char *)struct_ptr + elm->memb_offset;
+	if(elm->flags & ATF_POINTER) {
+		if(_flat_kind(elm->type, &size) == AFK_NONE)
+			return 0;
+		return _flat_ptr(flat, memb_ptr, size);
+	}
+
+	return memb_ptr;
+}
+
+int
+asn_flat_count(const asn_flat_t *flat, asn_TYPE_descriptor_t *td,
+		const void *struct_ptr) {
+	const asn_anonymous_set_ *list = _A_CSET_FROM_VOID(struct_ptr);
+	size_t size;
+
+	if(!flat || !td || !struct_ptr
+	|| _flat_kind(td, &size) != AFK_LIST
+	|| list->count < 0)
+		return -1;
+
+	return list->count;
+}
+
+const void *
+asn_flat_element(const asn_flat_t *flat, asn_TYPE_descriptor_t *td,
+		const void *struct_ptr, int index) {
+	const asn_anonymous_set_ *list = _A_CSET_FROM_VOID(struct_ptr);
+	const void * const *array;
+	size_t size;
+
+	if(index < 0 || index >= asn_flat_count(flat, td, struct_ptr))
+		return 0;
+
+	array = (const void * const *)_flat_ptr(flat, &list->array,
+		list->count * sizeof(void *));
+	if(!array || _flat_kind(td->elements->type, &size) == AFK_NONE)
+		return 0;
+
+	return _flat_ptr(flat, &array[index], size);
+}
+
+const uint8_t *
+asn_flat_buffer(const asn_flat_t *flat, asn_TYPE_descriptor_t *td,
+		const void *struct_ptr, size_t *size) {
+	const ASN__PRIMITIVE_TYPE_t *st
+		= (const ASN__PRIMITIVE_TYPE_t *)struct_ptr;
+	const uint8_t *buf = 0;
+	size_t struct_size;
+
+	if(flat && td && st
+	&& _flat_kind(td, &struct_size) == AFK_BUFFER
+	&& st->size >= 0)
+		buf = (const uint8_t *)_flat_ptr(flat, &st->buf,
+			(size_t)st->size + 1);
+
+	if(size) *size = buf ? st->size : 0;
+	return buf;
+}
+
+void *
+asn_flat_thaw(const asn_flat_t *flat) {
+	asn_flat_walk_t walk;
+	char *block;
+
+	if(!flat)
+		return 0;
+
+	block = (char *)MALLOC(flat->size - sizeof(asn_flat_header_t));
+	if(!block)
+		return 0;
+	memcpy(block, flat->base + sizeof(asn_flat_header_t),
+		flat->size - sizeof(asn_flat_header_t));
+
+	walk.thaw = 1;
+	walk.block = block;
+	walk.start = sizeof(asn_flat_header_t);
+	walk.size = flat->size;
+	if(_flat_walk(&walk, flat->td, block)) {
+		FREEMEM(block);
+		return 0;
+	}
+
+	return block;
+}
@@ -0,0 +1,103 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_ASN_FLAT_H_
+#define	_ASN_FLAT_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * The flat image of a decoded structure: the compact copy made by asn_clone()
+ * preceded by a header, with the pointers replaced by the offsets from the
+ * start of the image. It may be mapped at any address, e.g., from a file
+ * shared by several processes, and read in place by the asn_flat_*()
+ * accessors below, which check each offset against the image as they go.
+ * The image is bound to the type and to the platform (sizes of the C types,
+ * byte order) it was written on; it is rejected elsewhere.
+ */
+typedef struct asn_flat_s asn_flat_t;
+
+/*
+ * Write the flat image of the structure via the callback.
+ * Returns 0, or -1 if the structure can not be copied or written.
+ */
+int asn_flat_write(struct asn_TYPE_descriptor_s *type_descriptor,
+	const void *struct_ptr,
+	asn_app_consume_bytes_f *consume_bytes_cb,
+	void *app_key		/* Arbitrary callback argument */
+	);
+
+/*
+ * Map the flat image of the type from the file, read-only.
+ * Returns NULL if the file can not be mapped or does not contain
+ * the image of the type (errno is set to EINVAL then).
+ */
+asn_flat_t *asn_flat_open(struct asn_TYPE_descriptor_s *type_descriptor,
+	const char *filename);
+
+/*
+ * Use the (size) bytes at (image), which must be aligned for any
+ * C type and remain unchanged until asn_flat_close().
+ */
+asn_flat_t *asn_flat_view(struct asn_TYPE_descriptor_s *type_descriptor,
+	const void *image, size_t size);
+
+/*
+ * Release the view, unmapping the file.
+ */
+void asn_flat_close(asn_flat_t *flat);
+
+/*
+ * The structure of the image, to be read by the accessors below with the
+ * type descriptors of its parts. Its scalars, such as the long of the
+ * NativeInteger or the (size) of the OCTET STRING, may be read directly;
+ * the pointers may not.
+ */
+const void *asn_flat_root(const asn_flat_t *flat);
+
+/*
+ * The member (counting from 0) of the SEQUENCE, SET or CHOICE structure.
+ * Returns NULL if it is absent or is not the present alternative.
+ */
+const void *asn_flat_member(const asn_flat_t *flat,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	const void *struct_ptr, int member);
+
+/*
+ * The number of elements of the SET OF or SEQUENCE OF structure
+ * and the element (counting from 0), or -1 and NULL if invalid.
+ */
+int asn_flat_count(const asn_flat_t *flat,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	const void *struct_ptr);
+const void *asn_flat_element(const asn_flat_t *flat,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	const void *struct_ptr, int index);
+
+/*
+ * The contents of the OCTET STRING, BIT STRING, INTEGER, REAL or
+ * OBJECT IDENTIFIER structure, or of the types derived from them.
+ * Returns NULL, with (*size) set to 0, if there are none.
+ */
+const uint8_t *asn_flat_buffer(const asn_flat_t *flat,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	const void *struct_ptr, size_t *size);
+
+/*
+ * The compact copy of the image's structure, as made by asn_clone(),
+ * with the pointers restored; it is released by a single free(3).
+ * Returns NULL if the image is corrupt or there is no memory.
+ */
+void *asn_flat_thaw(const asn_flat_t *flat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _ASN_FLAT_H_ */
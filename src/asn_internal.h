@@ -23,10 +23,237 @@ extern "C" {
 #define	ASN1C_ENVIRONMENT_VERSION	920	/* Compile-time version */
 int get_asn1c_environment_version(void);	/* Run-time version */
 
-#define	CALLOC(nmemb, size)	calloc(nmemb, size)
-#define	MALLOC(size)		malloc(size)
-#define	REALLOC(oldptr, size)	realloc(oldptr, size)
-#define	FREEMEM(ptr)		free(ptr)
+/*
+ * The options of the asn_decode_ext() call in progress in this thread,
+ * see asn_dec_opts_t. They apply to the decoders handed the codec context
+ * of that call (ctx), which ber_decode() and the like pass down as is,
+ * and to no other context, e.g. of a decoding nested in a callback.
+ */
+#ifdef	ASN_THREAD_LOCAL
+extern ASN_THREAD_LOCAL const asn_codec_ctx_t *asn_dec__opts_ctx;
+extern ASN_THREAD_LOCAL const asn_dec_opts_t *asn_dec__opts;
+#define	ASN_DEC_OPTS(ctx)						\
+	(((ctx) && (ctx) == asn_dec__opts_ctx)				\
+		? asn_dec__opts : (const asn_dec_opts_t *)0)
+#else	/* !ASN_THREAD_LOCAL */
+#define	ASN_DEC_OPTS(ctx)	((const asn_dec_opts_t *)0)
+#endif	/* ASN_THREAD_LOCAL */
+
+#ifdef	ASN_CODEC_STATS	/* Per-type codec statistics, see asn_codec_stats.h */
+#ifndef	ASN_THREAD_LOCAL
+#error	"ASN_CODEC_STATS requires the thread-local storage (ASN_THREAD_LOCAL)"
+#endif
+extern ASN_THREAD_LOCAL unsigned long asn_codec_stats__allocations;
+#define	_ASN_MEM_COUNT()	((void)asn_codec_stats__allocations++)
+#else	/* !ASN_CODEC_STATS */
+#define	_ASN_MEM_COUNT()	((void)0)
+#endif	/* ASN_CODEC_STATS */
+
+/*
+ * The accounting of the memory allocated by a decoding call,
+ * see (max_memory) of asn_dec_opts_t. While the decoder runs,
+ * the allocations of its thread go through the asn_mem__*() functions
+ * which keep track of the sizes of the blocks, and fail the ones
+ * which would exceed the budget.
+ */
+typedef struct asn_mem_account_s {
+	int active;		/* The account is in use by this call */
+	size_t budget;		/* 0 for no limit */
+	size_t footprint;	/* Bytes held, with ASN_MEM_BLOCK_OVERHEAD each */
+	size_t peak;		/* Maximum of the (footprint) */
+	size_t allocated;	/* Bytes allocated in total */
+	size_t allocations;	/* Number of the allocations */
+	int exceeded;		/* An allocation has been refused */
+	struct asn_mem_block_s {	/* Hash of the blocks allocated */
+		void *ptr;
+		size_t size;
+	} *blocks;
+	size_t blocks_count;
+	size_t blocks_size;	/* Power of 2 */
+	asn_dec_error_t *error;	/* Of the decoding options, see below */
+} asn_mem_account_t;
+#ifdef	ASN_THREAD_LOCAL
+extern ASN_THREAD_LOCAL asn_mem_account_t *asn_mem__account;
+void *asn_mem__calloc(size_t nmemb, size_t size);
+void *asn_mem__malloc(size_t size);
+void *asn_mem__realloc(void *ptr, size_t size);
+void asn_mem__free(void *ptr);
+#define	_ASN_MEM(plain, accounted)	(asn_mem__account ? (accounted) : (plain))
+#else	/* !ASN_THREAD_LOCAL */
+#define	_ASN_MEM(plain, accounted)	(plain)
+#endif	/* ASN_THREAD_LOCAL */
+
+/*
+ * Start accounting for the decoding call, if its options set a budget
+ * (or (force) is set) and no outer call is being accounted for already.
+ */
+void asn_mem__begin(asn_mem_account_t *account,
+	const asn_codec_ctx_t *opt_codec_ctx, int force);
+void asn_mem__end(asn_mem_account_t *account);
+
+#define	CALLOC(nmemb, size)	(_ASN_MEM_COUNT(),			\
+	_ASN_MEM(calloc(nmemb, size), asn_mem__calloc(nmemb, size)))
+#define	MALLOC(size)		(_ASN_MEM_COUNT(),			\
+	_ASN_MEM(malloc(size), asn_mem__malloc(size)))
+#define	REALLOC(oldptr, size)	(_ASN_MEM_COUNT(),			\
+	_ASN_MEM(realloc(oldptr, size), asn_mem__realloc(oldptr, size)))
+#define	FREEMEM(ptr)		_ASN_MEM(free(ptr), asn_mem__free(ptr))
+
+/*
+ * The recording of the decoding failures into the (error) of the decoding
+ * options of the codec context (ctx), see asn_dec_error_t.
+ * To be used on the failure branches only.
+ * ASN_DEC_ERROR() notes the (reason) the decoder of (td) fails for,
+ * (offset) into its encoding, unless a nested decoder did already.
+ * ASN_DEC_ERROR_MEMBER() adds the member (name) or the list element
+ * (index) of the type (td) which failed to decode, starting (offset)
+ * into the encoding of the constructed type, to the path of the failure.
+ * ASN_DEC_ERROR_BEGIN() and ASN_DEC_ERROR_END() enclose the outermost
+ * decoder call; the latter completes the record if the (code) is RC_FAIL,
+ * overriding the offset with (offset) unless it is -1.
+ */
+void asn_dec_error__set(asn_dec_error_t *, struct asn_TYPE_descriptor_s *,
+	enum asn_dec_error_reason_e reason, long offset);
+void asn_dec_error__member(asn_dec_error_t *, struct asn_TYPE_descriptor_s *,
+	const char *name, long index, long offset);
+void asn_dec_error__begin(asn_dec_error_t *);
+void asn_dec_error__end(asn_dec_error_t *, struct asn_TYPE_descriptor_s *,
+	enum asn_dec_rval_code_e code, long offset);
+#define	ASN_DEC_ERROR(ctx, td, reason, offset)	do {			\
+		const asn_dec_opts_t *_opts = ASN_DEC_OPTS(ctx);	\
+		if(_opts && _opts->error)				\
+			asn_dec_error__set(_opts->error, (td),		\
+				(reason), (offset));			\
+	} while(0)
+#define	ASN_DEC_ERROR_MEMBER(ctx, td, name, index, offset)	do {	\
+		const asn_dec_opts_t *_opts = ASN_DEC_OPTS(ctx);	\
+		if(_opts && _opts->error)				\
+			asn_dec_error__member(_opts->error, (td),	\
+				(name), (index), (offset));		\
+	} while(0)
+#define	ASN_DEC_ERROR_BEGIN(ctx)	do {				\
+		const asn_dec_opts_t *_opts = ASN_DEC_OPTS(ctx);	\
+		if(_opts && _opts->error)				\
+			asn_dec_error__begin(_opts->error);		\
+	} while(0)
+#define	ASN_DEC_ERROR_END(ctx, td, code, offset)	do {		\
+		const asn_dec_opts_t *_opts = ASN_DEC_OPTS(ctx);	\
+		if(_opts && _opts->error)				\
+			asn_dec_error__end(_opts->error, (td),		\
+				(code), (offset));			\
+	} while(0)
+
+/*
+ * The hashing of the values for asn_hash(). The hash_struct of a type
+ * starts with 0, mixes in the (size) bytes at (ptr) or a (value),
+ * such as the asn_hash() of a member, and returns asn_hash__end().
+ */
+uint64_t asn_hash__bytes(uint64_t hash, const void *ptr, size_t size);
+uint64_t asn_hash__value(uint64_t hash, uint64_t value);
+uint64_t asn_hash__end(uint64_t hash);
+
+/*
+ * The allocation of the copies made by asn_clone(). The copy_struct of
+ * a type allocates its structure by asn_copy__struct() and the buffers
+ * it points to by asn_copy__alloc(), zeroed, from the heap or from the
+ * single block of the compact copy. While the size of that block is
+ * being measured, the allocations return memory which must not be
+ * touched: the copy_struct returns 0 after allocating, if measuring.
+ * The members of the constructed types are copied by asn_copy__member(),
+ * which takes the structures containing them.
+ */
+typedef struct asn_copy_s {
+	int measuring;	/* Only add up the (size) of the allocations */
+	size_t size;	/* Size of the compact copy */
+	char *next;	/* Free space of the compact copy, 0 for the heap */
+	char *end;
+} asn_copy_t;
+void *asn_copy__alloc(asn_copy_t *copy, size_t size);
+void *asn_copy__struct(asn_copy_t *copy, void **struct_dst, size_t size);
+int asn_copy__member(asn_copy_t *copy, struct asn_TYPE_member_s *elm,
+	void *dst, const void *src);
+#define	ASN_COPY_MEASURING(copy)	((copy)->measuring)
+
+/*
+ * The allocations of the compact copy are aligned for any member.
+ */
+typedef union { long l; double d; void *p; } asn_copy__align_t;
+#define	ASN_COPY_ALIGN(size)	\
+	(((size) + sizeof(asn_copy__align_t) - 1)	\
+		& ~(sizeof(asn_copy__align_t) - 1))
+
+/*
+ * The copy_struct of the type, as resolved by asn_clone(); NULL if the type
+ * can not be copied. The compact copy of the (struct_ptr) made into the
+ * (size) zeroed bytes at (block), measured by asn_clone_size() before.
+ * Returns the copy, which starts the (block), or NULL.
+ */
+asn_struct_copy_f *asn_copy__copier(struct asn_TYPE_descriptor_s *td);
+void *asn_copy__compact(struct asn_TYPE_descriptor_s *td,
+	const void *struct_ptr, void *block, size_t size);
+
+/*
+ * The size of the structure of the type, as its copy_struct allocates it;
+ * 0 if the type can not be copied.
+ */
+size_t asn_copy__sizeof(struct asn_TYPE_descriptor_s *td);
+
+/*
+ * Empty the structure (*struct_ptr) to be decoded into again: its contents
+ * are freed and its allocation is kept, zeroed. The structure of the type
+ * of unknown size is freed and (*struct_ptr) is set to NULL instead.
+ */
+void asn_copy__recycle(struct asn_TYPE_descriptor_s *td, void **struct_ptr);
+
+/*
+ * The codec (slot) of the type (td), such as ASN_CODEC(td, ber_decoder),
+ * to be called with the same (td). With ASN_CODEC_STATS or ASN_CODEC_TRACE,
+ * the runtime calls the codecs through the functions counting the calls
+ * for the type or recording them into the trace.
+ */
+#if	defined(ASN_CODEC_STATS) || defined(ASN_CODEC_TRACE)
+#define	ASN_CODEC(td, slot)	(asn_codec__##slot)
+ber_type_decoder_f asn_codec__ber_decoder;
+der_type_encoder_f asn_codec__der_encoder;
+xer_type_decoder_f asn_codec__xer_decoder;
+xer_type_encoder_f asn_codec__xer_encoder;
+per_type_decoder_f asn_codec__uper_decoder;
+per_type_encoder_f asn_codec__uper_encoder;
+#else	/* !ASN_CODEC_STATS && !ASN_CODEC_TRACE */
+#define	ASN_CODEC(td, slot)	((td)->slot)
+#endif	/* ASN_CODEC_STATS || ASN_CODEC_TRACE */
+
+/*
+ * The recording of the trace events, see asn_codec_trace.h.
+ * ASN_TRACE_PHASE() marks the transition of the BER decoder of the type
+ * to the next (phase), (consumed) bytes into its encoding.
+ */
+#ifdef	ASN_CODEC_TRACE
+#ifndef	ASN_THREAD_LOCAL
+#error	"ASN_CODEC_TRACE requires the thread-local storage (ASN_THREAD_LOCAL)"
+#endif
+extern int asn_trace__enabled;
+typedef struct asn_trace__frame_s {
+	int traced;	/* The call has been recorded */
+	long offset;	/* Saved offset of the enclosing call */
+	struct asn_TYPE_descriptor_s *type;	/* Saved type of that call */
+} asn_trace__frame_t;
+long asn_trace__offset(const void *ptr);
+void asn_trace__begin(asn_trace__frame_t *, struct asn_TYPE_descriptor_s *,
+	int slot, long offset);
+void asn_trace__end(asn_trace__frame_t *, struct asn_TYPE_descriptor_s *,
+	int slot, int code, size_t size);
+void asn_trace__phase(struct asn_TYPE_descriptor_s *, int phase,
+	size_t consumed);
+void asn_trace__message(const char *file, int line, const char *fmt, ...);
+void asn_trace__message_f(const char *fmt, ...);
+#define	ASN_TRACE_PHASE(td, phase, consumed)	do {		\
+		if(asn_trace__enabled)				\
+			asn_trace__phase((td), (phase), (consumed));	\
+	} while(0)
+#else	/* !ASN_CODEC_TRACE */
+#define	ASN_TRACE_PHASE(td, phase, consumed)	do { } while(0)
+#endif	/* ASN_CODEC_TRACE */
 
 /*
  * A macro for debugging the ASN.1 internals.
@@ -44,6 +271,15 @@ int get_asn1c_environment_version(void);	/* Run-time version */
 void ASN_DEBUG_f(const char *fmt, ...);
 #define	ASN_DEBUG	ASN_DEBUG_f
 #endif	/* __GNUC__ */
+#elif	defined(ASN_CODEC_TRACE)	/* Into the trace, see asn_codec_trace.h */
+#ifdef	__GNUC__
+#define	ASN_DEBUG(fmt, args...)	do {				\
+		if(asn_trace__enabled)					\
+			asn_trace__message(__FILE__, __LINE__, fmt, ##args);\
+	} while(0)
+#else	/* !__GNUC__ */
+#define	ASN_DEBUG	asn_trace__message_f
+#endif	/* __GNUC__ */
 #else	/* EMIT_ASN_DEBUG != 1 */
 static inline void ASN_DEBUG(const char *fmt, ...) { (void)fmt; }
 #endif	/* EMIT_ASN_DEBUG */
@@ -65,27 +301,91 @@ static inline void ASN_DEBUG(const char *fmt, ...) { (void)fmt; }
 		|| __ASN_E_cbc(buf2, size2)				\
 		|| __ASN_E_cbc(buf3, size3))
 
+/*
+ * Indentation is emitted in chunks of up to 8 levels per callback.
+ */
+#define	_i_ASN_INDENT_SPACES	"\n                                "
 #define	_i_ASN_TEXT_INDENT(nl, level) do {				\
 	int __level = (level);						\
 	int __nl = ((nl) != 0);						\
-	int __i;							\
-	if(__nl) _ASN_CALLBACK("\n", 1);				\
-	for(__i = 0; __i < __level; __i++)				\
-		_ASN_CALLBACK("    ", 4);				\
+	int __left = __level > 0 ? 4 * __level : 0;			\
+	int __n = __left < 32 ? __left : 32;				\
+	if(__nl || __n)							\
+		_ASN_CALLBACK(_i_ASN_INDENT_SPACES + !__nl, __nl + __n);\
+	for(__left -= __n; __left > 0; __left -= __n) {			\
+		__n = __left < 32 ? __left : 32;			\
+		_ASN_CALLBACK(_i_ASN_INDENT_SPACES + 1, __n);		\
+	}								\
 	er.encoded += __nl + 4 * __level;				\
 } while(0)
 
 #define	_i_INDENT(nl)	do {						\
-	int __i;							\
-	if((nl) && cb("\n", 1, app_key) < 0) return -1;			\
-	for(__i = 0; __i < ilevel; __i++)				\
-		if(cb("    ", 4, app_key) < 0) return -1;		\
+	int __nl = ((nl) != 0);						\
+	int __left = ilevel > 0 ? 4 * ilevel : 0;			\
+	int __n = __left < 32 ? __left : 32;				\
+	if((__nl || __n) && cb(_i_ASN_INDENT_SPACES + !__nl,		\
+			__nl + __n, app_key) < 0)			\
+		return -1;						\
+	for(__left -= __n; __left > 0; __left -= __n) {			\
+		__n = __left < 32 ? __left : 32;			\
+		if(cb(_i_ASN_INDENT_SPACES + 1, __n, app_key) < 0)	\
+			return -1;					\
+	}								\
 } while(0)
 
+/*
+ * Reader-writer lock of the tables shared by the threads, initialized
+ * statically with ASN_RWLOCK_INITIALIZER.
+ */
+#ifdef	WIN32
+#ifndef	_MSC_VER	/* MSVS.Net has <windows.h> in asn_system.h */
+#include <windows.h>
+#endif
+typedef SRWLOCK asn_rwlock_t;
+#define	ASN_RWLOCK_INITIALIZER	SRWLOCK_INIT
+#define	asn_rwlock_rdlock(l)	AcquireSRWLockShared(l)
+#define	asn_rwlock_rdunlock(l)	ReleaseSRWLockShared(l)
+#define	asn_rwlock_wrlock(l)	AcquireSRWLockExclusive(l)
+#define	asn_rwlock_wrunlock(l)	ReleaseSRWLockExclusive(l)
+#else	/* !WIN32 */
+#include <pthread.h>
+typedef pthread_rwlock_t asn_rwlock_t;
+#define	ASN_RWLOCK_INITIALIZER	PTHREAD_RWLOCK_INITIALIZER
+#define	asn_rwlock_rdlock(l)	pthread_rwlock_rdlock(l)
+#define	asn_rwlock_rdunlock(l)	pthread_rwlock_unlock(l)
+#define	asn_rwlock_wrlock(l)	pthread_rwlock_wrlock(l)
+#define	asn_rwlock_wrunlock(l)	pthread_rwlock_unlock(l)
+#endif	/* WIN32 */
+
+/*
+ * Publishing of the lazily built, immutable tables through a pointer:
+ * the loads see either 0 or the completely built table.
+ * ASN_ATOMIC_FETCH_INC() increments the (volatile long) counter
+ * and returns its previous value; ASN_ATOMIC_LOAD_LONG() reads it.
+ */
+#if	defined(__clang__) \
+	|| (defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__) >= 407)
+#define	ASN_ATOMIC_LOAD_PTR(pp)	__atomic_load_n((pp), __ATOMIC_ACQUIRE)
+#define	ASN_ATOMIC_CAS_PTR(pp, oldp, newp)				\
+	__sync_bool_compare_and_swap((pp), (oldp), (newp))
+#define	ASN_ATOMIC_FETCH_INC(lp)	__sync_fetch_and_add((lp), 1)
+#define	ASN_ATOMIC_LOAD_LONG(lp)	__atomic_load_n((lp), __ATOMIC_ACQUIRE)
+#elif	defined(WIN32)
+#define	ASN_ATOMIC_LOAD_PTR(pp)	(*(void * volatile *)(pp))
+#define	ASN_ATOMIC_CAS_PTR(pp, oldp, newp)				\
+	(InterlockedCompareExchangePointer((PVOID volatile *)(pp),	\
+		(newp), (oldp)) == (oldp))
+#define	ASN_ATOMIC_FETCH_INC(lp)					\
+	(InterlockedIncrement((LONG volatile *)(lp)) - 1)
+#define	ASN_ATOMIC_LOAD_LONG(lp)					\
+	InterlockedCompareExchange((LONG volatile *)(lp), 0, 0)
+#endif
+
 /*
  * Check stack against overflow, if limit is set.
  */
 #define	_ASN_DEFAULT_STACK_MAX	(30000)
+#define	_ASN_DEFAULT_DEPTH_MAX	(1000)	/* Frames of ber_decode_iterative() */
 static inline int
 _ASN_STACK_OVERFLOW_CHECK(asn_codec_ctx_t *ctx) {
 	if(ctx && ctx->max_stack_size) {
@@ -98,6 +398,7 @@ _ASN_STACK_OVERFLOW_CHECK(asn_codec_ctx_t *ctx) {
 		if(usedstack < -(ptrdiff_t)ctx->max_stack_size) {
 			ASN_DEBUG("Stack limit %ld reached",
 				(long)ctx->max_stack_size);
+			ASN_DEC_ERROR(ctx, 0, ASN_DEC_ERROR_DEPTH, 0);
 			return -1;
 		}
 	}
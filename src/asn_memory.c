@@ -0,0 +1,270 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+
+#ifdef	ASN_THREAD_LOCAL
+
+/* The account of the decoding call in progress in this thread */
+ASN_THREAD_LOCAL asn_mem_account_t *asn_mem__account;
+
+/*
+ * The hash of the blocks is kept with the plain allocator,
+ * outside of the account.
+ */
+#define	ASN_MEM_BLOCKS_MIN	64
+#define	ASN_MEM_HASH(a, ptr)	\
+	((((size_t)(ptr) >> 4) * 2654435761u) & ((a)->blocks_size - 1))
+
+/*
+ * The memory each block costs besides its bytes, charged to the budget:
+ * its hash entry, in the table kept at most half full, and the header
+ * of the allocator.
+ */
+#define	ASN_MEM_BLOCK_OVERHEAD	\
+	(2 * sizeof(struct asn_mem_block_s) + 2 * sizeof(size_t))
+
+static struct asn_mem_block_s *
+asn_mem__find(asn_mem_account_t *a, void *ptr) {
+	size_t i;
+
+	if(!a->blocks_size) return 0;
+
+	for(i = ASN_MEM_HASH(a, ptr); a->blocks[i].ptr;
+			i = (i + 1) & (a->blocks_size - 1)) {
+		if(a->blocks[i].ptr == ptr)
+			return &a->blocks[i];
+	}
+
+	return 0;
+}
+
+/*
+ * Make room in the hash for one more block.
+ */
+static int
+asn_mem__reserve(asn_mem_account_t *a) {
+	size_t i;
+
+	if(2 * (a->blocks_count + 1) > a->blocks_size) {
+		struct asn_mem_block_s *old = a->blocks;
+		size_t old_size = a->blocks_size;
+		size_t new_size = old_size ? 2 * old_size : ASN_MEM_BLOCKS_MIN;
+		struct asn_mem_block_s *blocks;
+
+		blocks = (struct asn_mem_block_s *)calloc(new_size,
+			sizeof(blocks[0]));
+		if(!blocks) return -1;
+		a->blocks = blocks;
+		a->blocks_size = new_size;
+		for(i = 0; i < old_size; i++) {
+			size_t j;
+			if(!old[i].ptr) continue;
+			for(j = ASN_MEM_HASH(a, old[i].ptr); blocks[j].ptr;
+				j = (j + 1) & (new_size - 1));
+			blocks[j] = old[i];
+		}
+		free(old);
+	}
+
+	return 0;
+}
+
+/*
+ * Add the block to the hash, in the room made by asn_mem__reserve().
+ */
+static void
+asn_mem__insert(asn_mem_account_t *a, void *ptr, size_t size) {
+	size_t i;
+
+	for(i = ASN_MEM_HASH(a, ptr); a->blocks[i].ptr;
+		i = (i + 1) & (a->blocks_size - 1));
+	a->blocks[i].ptr = ptr;
+	a->blocks[i].size = size;
+	a->blocks_count++;
+}
+
+static void
+asn_mem__remove(asn_mem_account_t *a, struct asn_mem_block_s *b) {
+	size_t mask = a->blocks_size - 1;
+	size_t i = b - a->blocks;
+	size_t j = i;
+
+	/* Shift back the entries which would not be found past the hole */
+	for(;;) {
+		size_t k;
+		j = (j + 1) & mask;
+		if(!a->blocks[j].ptr) break;
+		k = ASN_MEM_HASH(a, a->blocks[j].ptr);
+		if(i <= j ? (i < k && k <= j) : (i < k || k <= j))
+			continue;
+		a->blocks[i] = a->blocks[j];
+		i = j;
+	}
+	a->blocks[i].ptr = 0;
+	a->blocks[i].size = 0;
+	a->blocks_count--;
+}
+
+/*
+ * Check that (grow) more bytes fit into the budget.
+ */
+static int
+asn_mem__admit(asn_mem_account_t *a, size_t grow) {
+	if(a->budget && (grow > a->budget || a->footprint > a->budget - grow)) {
+		ASN_DEBUG("Memory budget %lu exceeded by %lu more bytes",
+			(unsigned long)a->budget, (unsigned long)grow);
+		a->exceeded = 1;
+		if(a->error)
+			asn_dec_error__set(a->error, 0, ASN_DEC_ERROR_MEMORY, 0);
+		return -1;
+	}
+	return 0;
+}
+
+static void
+asn_mem__allocated(asn_mem_account_t *a, size_t size) {
+	a->allocations++;
+	a->allocated += size;
+	if(a->footprint > a->peak)
+		a->peak = a->footprint;
+}
+
+void *
+asn_mem__calloc(size_t nmemb, size_t size) {
+	asn_mem_account_t *a = asn_mem__account;
+	void *ptr;
+
+	if(size && nmemb > ((size_t)-1 - ASN_MEM_BLOCK_OVERHEAD) / size)
+		return 0;
+	if(asn_mem__admit(a, nmemb * size + ASN_MEM_BLOCK_OVERHEAD)
+	|| asn_mem__reserve(a))
+		return 0;
+
+	ptr = calloc(nmemb, size);
+	if(!ptr) return 0;
+	asn_mem__insert(a, ptr, nmemb * size);
+	a->footprint += nmemb * size + ASN_MEM_BLOCK_OVERHEAD;
+	asn_mem__allocated(a, nmemb * size);
+
+	return ptr;
+}
+
+void *
+asn_mem__malloc(size_t size) {
+	asn_mem_account_t *a = asn_mem__account;
+	void *ptr;
+
+	if(size > (size_t)-1 - ASN_MEM_BLOCK_OVERHEAD
+	|| asn_mem__admit(a, size + ASN_MEM_BLOCK_OVERHEAD)
+	|| asn_mem__reserve(a))
+		return 0;
+
+	ptr = malloc(size);
+	if(!ptr) return 0;
+	asn_mem__insert(a, ptr, size);
+	a->footprint += size + ASN_MEM_BLOCK_OVERHEAD;
+	asn_mem__allocated(a, size);
+
+	return ptr;
+}
+
+void *
+asn_mem__realloc(void *oldptr, size_t size) {
+	asn_mem_account_t *a = asn_mem__account;
+	struct asn_mem_block_s *b = oldptr ? asn_mem__find(a, oldptr) : 0;
+	/* The untracked ones count anew */
+	size_t old_size = b ? b->size + ASN_MEM_BLOCK_OVERHEAD : 0;
+	void *ptr;
+
+	if(size > (size_t)-1 - ASN_MEM_BLOCK_OVERHEAD)
+		return 0;
+	if(size + ASN_MEM_BLOCK_OVERHEAD > old_size
+	&& asn_mem__admit(a, size + ASN_MEM_BLOCK_OVERHEAD - old_size))
+		return 0;
+	/*
+	 * Make room for the new block before the old one is gone:
+	 * the failure after the realloc() would lose the block.
+	 */
+	if(!b && asn_mem__reserve(a))
+		return 0;
+
+	ptr = realloc(oldptr, size);
+	if(!ptr) {
+		if(!size && b) {	/* Freed by realloc(ptr, 0) */
+			a->footprint -= old_size;
+			asn_mem__remove(a, b);
+		}
+		return 0;
+	}
+
+	if(b) asn_mem__remove(a, b);
+	a->footprint = a->footprint - old_size
+			+ size + ASN_MEM_BLOCK_OVERHEAD;
+	asn_mem__insert(a, ptr, size);
+	asn_mem__allocated(a, size);
+
+	return ptr;
+}
+
+void
+asn_mem__free(void *ptr) {
+	asn_mem_account_t *a = asn_mem__account;
+	struct asn_mem_block_s *b;
+
+	if(!ptr) return;
+
+	b = asn_mem__find(a, ptr);
+	if(b) {
+		a->footprint -= b->size + ASN_MEM_BLOCK_OVERHEAD;
+		asn_mem__remove(a, b);
+	}
+	free(ptr);
+}
+
+void
+asn_mem__begin(asn_mem_account_t *a, const asn_codec_ctx_t *opt_codec_ctx,
+		int force) {
+	const asn_dec_opts_t *opts = ASN_DEC_OPTS(opt_codec_ctx);
+
+	memset(a, 0, sizeof(*a));
+
+	if(asn_mem__account)
+		return;	/* Accounted for by the outer call */
+	if(!force && !(opts && opts->max_memory))
+		return;
+
+	a->active = 1;
+	a->budget = opts ? opts->max_memory : 0;
+	a->error = opts ? opts->error : 0;
+	asn_mem__account = a;
+}
+
+void
+asn_mem__end(asn_mem_account_t *a) {
+	if(!a->active) return;
+	asn_mem__account = 0;
+	free(a->blocks);
+	a->blocks = 0;
+	a->blocks_count = 0;
+	a->blocks_size = 0;
+}
+
+#else	/* !ASN_THREAD_LOCAL */
+
+/* No accounting without the thread-local storage */
+
+void
+asn_mem__begin(asn_mem_account_t *a, const asn_codec_ctx_t *opt_codec_ctx,
+		int force) {
+	(void)opt_codec_ctx;
+	(void)force;
+	memset(a, 0, sizeof(*a));
+}
+
+void
+asn_mem__end(asn_mem_account_t *a) {
+	(void)a;
+}
+
+#endif	/* ASN_THREAD_LOCAL */
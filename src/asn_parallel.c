@@ -0,0 +1,719 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <asn_parallel.h>
+#include <asn_SET_OF.h>
+
+/*
+ * The threads and the synchronization primitives of the platform.
+ */
+#ifdef	WIN32
+typedef HANDLE asn_thread_t;
+typedef CRITICAL_SECTION asn_mutex_t;
+typedef CONDITION_VARIABLE asn_cond_t;
+typedef SRWLOCK asn_static_mutex_t;
+#define	ASN_STATIC_MUTEX_INITIALIZER	SRWLOCK_INIT
+#define	asn_static_mutex_lock(m)	AcquireSRWLockExclusive(m)
+#define	asn_static_mutex_unlock(m)	ReleaseSRWLockExclusive(m)
+#define	asn_mutex_init(m)	InitializeCriticalSection(m)
+#define	asn_mutex_destroy(m)	DeleteCriticalSection(m)
+#define	asn_mutex_lock(m)	EnterCriticalSection(m)
+#define	asn_mutex_unlock(m)	LeaveCriticalSection(m)
+#define	asn_cond_init(c)	InitializeConditionVariable(c)
+#define	asn_cond_destroy(c)	/* Nothing to destroy */
+#define	asn_cond_wait(c, m)	SleepConditionVariableCS((c), (m), INFINITE)
+#define	asn_cond_broadcast(c)	WakeAllConditionVariable(c)
+#define	ASN_THREAD_FUNC(name, arg)	static DWORD WINAPI name(LPVOID arg)
+#define	ASN_THREAD_RETURN	return 0
+#define	asn_thread_start(t, f, arg)	\
+	((*(t) = CreateThread(NULL, 0, (f), (arg), 0, NULL)) ? 0 : -1)
+#define	asn_thread_join(t)	do {			\
+		WaitForSingleObject((t), INFINITE);	\
+		CloseHandle(t);				\
+	} while(0)
+#else	/* !WIN32 */
+#include <pthread.h>
+typedef pthread_t asn_thread_t;
+typedef pthread_mutex_t asn_mutex_t;
+typedef pthread_cond_t asn_cond_t;
+typedef pthread_mutex_t asn_static_mutex_t;
+#define	ASN_STATIC_MUTEX_INITIALIZER	PTHREAD_MUTEX_INITIALIZER
+#define	asn_static_mutex_lock(m)	pthread_mutex_lock(m)
+#define	asn_static_mutex_unlock(m)	pthread_mutex_unlock(m)
+#define	asn_mutex_init(m)	pthread_mutex_init((m), 0)
+#define	asn_mutex_destroy(m)	pthread_mutex_destroy(m)
+#define	asn_mutex_lock(m)	pthread_mutex_lock(m)
+#define	asn_mutex_unlock(m)	pthread_mutex_unlock(m)
+#define	asn_cond_init(c)	pthread_cond_init((c), 0)
+#define	asn_cond_destroy(c)	pthread_cond_destroy(c)
+#define	asn_cond_wait(c, m)	pthread_cond_wait((c), (m))
+#define	asn_cond_broadcast(c)	pthread_cond_broadcast(c)
+#define	ASN_THREAD_FUNC(name, arg)	static void *name(void *arg)
+#define	ASN_THREAD_RETURN	return 0
+#define	asn_thread_start(t, f, arg)	pthread_create((t), 0, (f), (arg))
+#define	asn_thread_join(t)	pthread_join((t), 0)
+#endif	/* WIN32 */
+
+/*
+ * The range of the batch items dealt out to a worker.
+ * Kept on a cache line of its own, as it is updated all the time.
+ */
+typedef union asn_parallel_range_u {
+	struct {
+		volatile long next;	/* The next item to take */
+		long end;		/* The end of the range */
+		long succeeded;		/* Items processed successfully */
+	} r;
+	char cache_line[64];
+} asn_parallel_range_t;
+
+typedef struct asn_parallel_worker_s {
+	struct asn_parallel_s *pool;
+	unsigned self;		/* Index of the worker's own range */
+	asn_thread_t thread;
+} asn_parallel_worker_t;
+
+struct asn_parallel_s {
+	asn_mutex_t lock;
+	asn_cond_t start;	/* Signals the new batch to the workers */
+	asn_cond_t done;	/* Signals the end of the batch */
+
+	unsigned nthreads;	/* Including the calling thread */
+	asn_parallel_worker_t *workers;
+	asn_parallel_range_t *ranges;
+
+	unsigned long generation;	/* Number of batches so far */
+	unsigned running;	/* Threads yet to finish the batch */
+	int busy;		/* A batch is being processed */
+	int stop;		/* The threads have to exit */
+
+	/*
+	 * The job being processed: (func) is invoked for each item.
+	 */
+	int (*func)(void *arg, size_t i);
+	void *arg;
+};
+
+#ifdef	ASN_THREAD_LOCAL
+/* The pool of der_encode_parallel() in progress in this thread */
+static ASN_THREAD_LOCAL asn_parallel_t *asn_parallel__current;
+#endif
+
+/*
+ * The descriptors of the derived types take over the functions of their
+ * base types on the first use (see asn_TYPE_resolve()). It is done here
+ * for the whole tree of the type, once, before the threads get to use
+ * the descriptors, which they only read afterwards.
+ */
+static asn_static_mutex_t asn_parallel__resolving
+	= ASN_STATIC_MUTEX_INITIALIZER;
+static asn_TYPE_descriptor_t *asn_parallel__resolved;	/* The last one */
+
+typedef struct asn_parallel_seen_s {
+	asn_TYPE_descriptor_t **types;
+	size_t count;
+	size_t size;
+} asn_parallel_seen_t;
+
+static int
+asn_parallel__resolve_tree(asn_TYPE_descriptor_t *td,
+		asn_parallel_seen_t *seen) {
+	size_t i;
+	int j;
+
+	for(i = 0; i < seen->count; i++)
+		if(seen->types[i] == td) return 0;
+	if(seen->count == seen->size) {
+		size_t new_size = seen->size ? 2 * seen->size : 32;
+		void *p = REALLOC(seen->types, new_size * sizeof(td));
+		if(!p) return -1;
+		seen->types = (asn_TYPE_descriptor_t **)p;
+		seen->size = new_size;
+	}
+	seen->types[seen->count++] = td;
+
+	(void)asn_TYPE_resolve(td);
+
+	for(j = 0; j < td->elements_count; j++) {
+		if(asn_parallel__resolve_tree(td->elements[j].type, seen))
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+asn_parallel__resolve(asn_TYPE_descriptor_t *td) {
+	asn_parallel_seen_t seen;
+	int ret = 0;
+
+	asn_static_mutex_lock(&asn_parallel__resolving);
+	if(asn_parallel__resolved != td) {
+		memset(&seen, 0, sizeof(seen));
+		ret = asn_parallel__resolve_tree(td, &seen);
+		FREEMEM(seen.types);
+		if(ret == 0) asn_parallel__resolved = td;
+	}
+	asn_static_mutex_unlock(&asn_parallel__resolving);
+
+	return ret;
+}
+
+/*
+ * Process the batch on the pool's threads, or in the calling thread
+ * if the descriptors could not be resolved for want of memory.
+ */
+static size_t
+asn_parallel__batch(asn_parallel_t *pool, asn_TYPE_descriptor_t *td,
+		size_t count, int (*func)(void *arg, size_t i), void *arg) {
+	size_t succeeded = 0;
+	size_t i;
+
+	if(asn_parallel__resolve(td) == 0)
+		return asn_parallel_for(pool, count, func, arg);
+
+	for(i = 0; i < count; i++)
+		succeeded += !!func(arg, i);
+	return succeeded;
+}
+
+/*
+ * Append the encoding to the item's buffer, growing it as needed.
+ */
+typedef struct asn_parallel_output_s {
+	asn_enc_batch_item_t *item;
+	size_t length;
+} asn_parallel_output_t;
+static int
+asn_parallel__append(const void *buffer, size_t size, void *key) {
+	asn_parallel_output_t *out = (asn_parallel_output_t *)key;
+	asn_enc_batch_item_t *item = out->item;
+
+	if(item->allocated - out->length < size) {
+		size_t new_size = item->allocated ? item->allocated : 256;
+		uint8_t *p;
+		while(new_size - out->length < size) {
+			if(new_size > ((size_t)-1) / 2)
+				return -1;
+			new_size <<= 1;
+		}
+		p = (uint8_t *)REALLOC(item->buffer, new_size);
+		if(!p) return -1;
+		item->buffer = p;
+		item->allocated = new_size;
+	}
+
+	memcpy(item->buffer + out->length, buffer, size);
+	out->length += size;
+	return 0;
+}
+
+/*
+ * The batch of asn_parallel_encode() or asn_parallel_decode().
+ */
+typedef struct asn_parallel_batch_s {
+	enum asn_transfer_syntax syntax;
+	asn_TYPE_descriptor_t *td;
+	void *items;
+} asn_parallel_batch_t;
+
+static int
+asn_parallel__encode_item(void *arg, size_t i) {
+	asn_parallel_batch_t *batch = (asn_parallel_batch_t *)arg;
+	asn_enc_batch_item_t *item = &((asn_enc_batch_item_t *)batch->items)[i];
+	asn_parallel_output_t out;
+
+	out.item = item;
+	out.length = 0;
+	item->result = asn_encode(batch->syntax, batch->td, item->structure,
+		asn_parallel__append, &out);
+	if(item->result.encoded == -1)
+		return 0;
+	item->result.encoded = out.length;
+	return 1;
+}
+
+static int
+asn_parallel__decode_item(void *arg, size_t i) {
+	asn_parallel_batch_t *batch = (asn_parallel_batch_t *)arg;
+	asn_dec_batch_item_t *item = &((asn_dec_batch_item_t *)batch->items)[i];
+
+	asn_copy__recycle(batch->td, &item->structure);
+	item->result = asn_decode(0, batch->syntax, batch->td,
+		&item->structure, item->buffer, item->size);
+	if(item->result.code == RC_OK)
+		return 1;
+	asn_copy__recycle(batch->td, &item->structure);
+	return 0;
+}
+
+/*
+ * Go through the own range first, then help with the other ones.
+ */
+static void
+asn_parallel__work(asn_parallel_t *pool, unsigned self) {
+	unsigned n = pool->nthreads;
+	long succeeded = 0;
+	unsigned k;
+
+	for(k = 0; k < n; k++) {
+		asn_parallel_range_t *range = &pool->ranges[(self + k) % n];
+		for(;;) {
+#ifdef	ASN_ATOMIC_FETCH_INC
+			long i = ASN_ATOMIC_FETCH_INC(&range->r.next);
+#else	/* A single thread */
+			long i = range->r.next++;
+#endif
+			if(i >= range->r.end) break;
+			succeeded += pool->func(pool->arg, i);
+		}
+	}
+
+	pool->ranges[self].r.succeeded = succeeded;
+}
+
+ASN_THREAD_FUNC(asn_parallel__thread, arg) {
+	asn_parallel_worker_t *worker = (asn_parallel_worker_t *)arg;
+	asn_parallel_t *pool = worker->pool;
+	unsigned long seen = 0;
+
+	asn_mutex_lock(&pool->lock);
+	for(;;) {
+		while(pool->generation == seen && !pool->stop)
+			asn_cond_wait(&pool->start, &pool->lock);
+		if(pool->stop) break;
+		seen = pool->generation;
+		asn_mutex_unlock(&pool->lock);
+
+		asn_parallel__work(pool, worker->self);
+
+		asn_mutex_lock(&pool->lock);
+		if(--pool->running == 0)
+			asn_cond_broadcast(&pool->done);
+	}
+	asn_mutex_unlock(&pool->lock);
+
+	ASN_THREAD_RETURN;
+}
+
+asn_parallel_t *
+asn_parallel_new(unsigned nthreads) {
+	asn_parallel_t *pool;
+
+#ifndef	ASN_ATOMIC_FETCH_INC
+	nthreads = 1;	/* The ranges can not be shared */
+#endif
+	if(nthreads < 1) nthreads = 1;
+
+	pool = (asn_parallel_t *)CALLOC(1, sizeof(*pool));
+	if(!pool) return NULL;
+	pool->workers = (asn_parallel_worker_t *)CALLOC(nthreads,
+		sizeof(pool->workers[0]));
+	pool->ranges = (asn_parallel_range_t *)CALLOC(nthreads,
+		sizeof(pool->ranges[0]));
+	if(!pool->workers || !pool->ranges) {
+		FREEMEM(pool->workers);
+		FREEMEM(pool->ranges);
+		FREEMEM(pool);
+		return NULL;
+	}
+
+	asn_mutex_init(&pool->lock);
+	asn_cond_init(&pool->start);
+	asn_cond_init(&pool->done);
+
+	/* Worker 0 is the calling thread */
+	for(pool->nthreads = 1; pool->nthreads < nthreads; pool->nthreads++) {
+		asn_parallel_worker_t *worker = &pool->workers[pool->nthreads];
+		worker->pool = pool;
+		worker->self = pool->nthreads;
+		if(asn_thread_start(&worker->thread,
+				asn_parallel__thread, worker)) {
+			asn_parallel_free(pool);
+			return NULL;
+		}
+	}
+
+	return pool;
+}
+
+void
+asn_parallel_free(asn_parallel_t *pool) {
+	unsigned i;
+
+	if(!pool) return;
+
+	asn_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	asn_cond_broadcast(&pool->start);
+	asn_mutex_unlock(&pool->lock);
+
+	for(i = 1; i < pool->nthreads; i++)
+		asn_thread_join(pool->workers[i].thread);
+
+	asn_cond_destroy(&pool->done);
+	asn_cond_destroy(&pool->start);
+	asn_mutex_destroy(&pool->lock);
+	FREEMEM(pool->workers);
+	FREEMEM(pool->ranges);
+	FREEMEM(pool);
+}
+
+size_t
+asn_parallel_for(asn_parallel_t *pool, size_t count,
+		int (*func)(void *arg, size_t i), void *arg) {
+	unsigned n = pool->nthreads;
+	size_t succeeded = 0;
+	size_t start = 0;
+	unsigned i;
+#ifdef	ASN_THREAD_LOCAL
+	asn_parallel_t *current = asn_parallel__current;
+#endif
+
+	if((long)count < 0) return 0;	/* Too many for the counters */
+
+	asn_mutex_lock(&pool->lock);
+	while(pool->busy)	/* One job at a time */
+		asn_cond_wait(&pool->done, &pool->lock);
+	pool->busy = 1;
+
+	pool->func = func;
+	pool->arg = arg;
+	for(i = 0; i < n; i++) {
+		size_t share = count / n + (i < count % n);
+		pool->ranges[i].r.next = start;
+		pool->ranges[i].r.end = start + share;
+		pool->ranges[i].r.succeeded = 0;
+		start += share;
+	}
+
+	pool->running = n - 1;
+	pool->generation++;
+	asn_cond_broadcast(&pool->start);
+	asn_mutex_unlock(&pool->lock);
+
+#ifdef	ASN_THREAD_LOCAL
+	asn_parallel__current = 0;	/* The pool is busy with this job */
+#endif
+	asn_parallel__work(pool, 0);
+#ifdef	ASN_THREAD_LOCAL
+	asn_parallel__current = current;
+#endif
+
+	asn_mutex_lock(&pool->lock);
+	while(pool->running)
+		asn_cond_wait(&pool->done, &pool->lock);
+	for(i = 0; i < n; i++)
+		succeeded += pool->ranges[i].r.succeeded;
+	pool->func = 0;
+	pool->arg = 0;
+	pool->busy = 0;
+	asn_cond_broadcast(&pool->done);
+	asn_mutex_unlock(&pool->lock);
+
+	return succeeded;
+}
+
+size_t
+asn_parallel_decode(asn_parallel_t *pool, enum asn_transfer_syntax syntax,
+		asn_TYPE_descriptor_t *td,
+		asn_dec_batch_item_t *items, size_t count) {
+	asn_parallel_batch_t batch;
+
+	batch.syntax = syntax;
+	batch.td = td;
+	batch.items = items;
+	return asn_parallel__batch(pool, td, count,
+		asn_parallel__decode_item, &batch);
+}
+
+size_t
+asn_parallel_encode(asn_parallel_t *pool, enum asn_transfer_syntax syntax,
+		asn_TYPE_descriptor_t *td,
+		asn_enc_batch_item_t *items, size_t count) {
+	asn_parallel_batch_t batch;
+
+	batch.syntax = syntax;
+	batch.td = td;
+	batch.items = items;
+	return asn_parallel__batch(pool, td, count,
+		asn_parallel__encode_item, &batch);
+}
+
+asn_enc_rval_t
+der_encode_parallel(asn_parallel_t *pool,
+		asn_TYPE_descriptor_t *td, void *sptr,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+#ifdef	ASN_THREAD_LOCAL
+	asn_parallel_t *current = asn_parallel__current;
+	asn_enc_rval_t er;
+
+	if(asn_parallel__resolve(td))
+		return der_encode(td, sptr, cb, app_key);	/* No threads */
+
+	asn_parallel__current = pool;
+	er = der_encode(td, sptr, cb, app_key);
+	asn_parallel__current = current;
+
+	return er;
+#else	/* !ASN_THREAD_LOCAL */
+	(void)pool;
+	return der_encode(td, sptr, cb, app_key);
+#endif	/* ASN_THREAD_LOCAL */
+}
+
+asn_parallel_t *
+asn_parallel_current(void) {
+#ifdef	ASN_THREAD_LOCAL
+	return asn_parallel__current;
+#else
+	return 0;
+#endif
+}
+
+/*
+ * A chunk of the SEQUENCE OF or SET OF elements encoded by a worker.
+ */
+typedef struct asn_parallel_chunk_s {
+	int from;		/* The first element of the chunk */
+	int to;			/* The one past the last element */
+	uint8_t *buf;		/* The encodings, one after another */
+	size_t length;		/* Their total length */
+	size_t size;		/* The size of the (buf) */
+	struct asn_parallel_el_s {
+		size_t offset;	/* The encoding of the element in (buf) */
+		size_t length;
+		const uint8_t *ptr;	/* Set once (buf) is complete */
+	} *els;			/* The SET OF elements, sorted */
+	int nels;
+	asn_enc_rval_t erval;	/* The failure, if any */
+} asn_parallel_chunk_t;
+
+typedef struct asn_parallel_list_s {
+	asn_TYPE_member_t *elm;
+	asn_anonymous_set_ *list;
+	asn_parallel_chunk_t *chunks;
+	int encode;		/* Encode, not just measure */
+	int sorted;		/* SET OF */
+} asn_parallel_list_t;
+
+static int
+asn_parallel__chunk_bytes(const void *buffer, size_t size, void *key) {
+	asn_parallel_chunk_t *chunk = (asn_parallel_chunk_t *)key;
+
+	if(chunk->size - chunk->length < size) {
+		size_t new_size = chunk->size ? chunk->size : 4096;
+		uint8_t *p;
+		while(new_size - chunk->length < size) {
+			if(new_size > ((size_t)-1) / 2)
+				return -1;
+			new_size <<= 1;
+		}
+		p = (uint8_t *)REALLOC(chunk->buf, new_size);
+		if(!p) return -1;
+		chunk->buf = p;
+		chunk->size = new_size;
+	}
+
+	memcpy(chunk->buf + chunk->length, buffer, size);
+	chunk->length += size;
+	return 0;
+}
+
+static int
+asn_parallel__el_cmp(const void *ap, const void *bp) {
+	const struct asn_parallel_el_s *a = (const struct asn_parallel_el_s *)ap;
+	const struct asn_parallel_el_s *b = (const struct asn_parallel_el_s *)bp;
+	size_t common_len = a->length < b->length ? a->length : b->length;
+	int ret;
+
+	ret = memcmp(a->ptr, b->ptr, common_len);
+	if(ret == 0) {
+		if(a->length < b->length)
+			ret = -1;
+		else if(a->length > b->length)
+			ret = 1;
+	}
+
+	return ret;
+}
+
+static int
+asn_parallel__list_chunk(void *arg, size_t i) {
+	asn_parallel_list_t *job = (asn_parallel_list_t *)arg;
+	asn_parallel_chunk_t *chunk = &job->chunks[i];
+	asn_TYPE_member_t *elm = job->elm;
+	der_type_encoder_f *der_encoder = ASN_CODEC(elm->type, der_encoder);
+	int edx;
+
+	if(job->sorted) {
+		chunk->els = (struct asn_parallel_el_s *)MALLOC(
+			(chunk->to - chunk->from) * sizeof(chunk->els[0]));
+		if(!chunk->els) {
+			chunk->erval.encoded = -1;
+			chunk->erval.failed_type = elm->type;
+			chunk->erval.structure_ptr = 0;
+			return 0;
+		}
+	}
+
+	for(edx = chunk->from; edx < chunk->to; edx++) {
+		void *memb_ptr = job->list->array[edx];
+		size_t offset = chunk->length;
+		asn_enc_rval_t erval;
+
+		if(!memb_ptr) continue;
+
+		erval = der_encoder(elm->type, memb_ptr, 0, elm->tag,
+			job->encode ? asn_parallel__chunk_bytes : 0, chunk);
+		if(erval.encoded == -1) {
+			chunk->erval = erval;
+			return 0;
+		}
+		if(!job->encode)
+			chunk->length += erval.encoded;
+
+		if(job->sorted) {
+			chunk->els[chunk->nels].offset = offset;
+			chunk->els[chunk->nels].length = chunk->length - offset;
+			chunk->nels++;
+		}
+	}
+
+	if(job->sorted && job->encode) {
+		for(edx = 0; edx < chunk->nels; edx++)
+			chunk->els[edx].ptr = chunk->buf + chunk->els[edx].offset;
+		qsort(chunk->els, chunk->nels, sizeof(chunk->els[0]),
+			asn_parallel__el_cmp);
+	}
+
+	return 1;
+}
+
+/*
+ * Report the sorted runs of the chunks to the application merged.
+ */
+static int
+asn_parallel__merge(asn_parallel_chunk_t *chunks, int nchunks,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	int *heads;
+	int i;
+
+	heads = (int *)CALLOC(nchunks, sizeof(heads[0]));
+	if(!heads) return -1;
+
+	for(;;) {
+		struct asn_parallel_el_s *min_el = 0;
+		int min_chunk = -1;
+		for(i = 0; i < nchunks; i++) {
+			struct asn_parallel_el_s *el;
+			if(heads[i] >= chunks[i].nels) continue;
+			el = &chunks[i].els[heads[i]];
+			if(!min_el || asn_parallel__el_cmp(el, min_el) < 0) {
+				min_el = el;
+				min_chunk = i;
+			}
+		}
+		if(!min_el) break;
+		if(cb(min_el->ptr, min_el->length, app_key) < 0) {
+			FREEMEM(heads);
+			return -1;
+		}
+		heads[min_chunk]++;
+	}
+
+	FREEMEM(heads);
+	return 0;
+}
+
+asn_enc_rval_t
+asn_parallel_der_list(asn_parallel_t *pool,
+		asn_TYPE_descriptor_t *td, void *sptr,
+		int tag_mode, ber_tlv_tag_t tag, int sorted,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_anonymous_set_ *list = _A_SET_FROM_VOID(sptr);
+	asn_parallel_list_t job;
+	asn_enc_rval_t erval;
+	size_t computed_size = 0;
+	ssize_t encoding_size;
+	int nchunks;
+	int per_chunk;
+	int i;
+
+	/* Enough chunks to keep all the threads busy till the end */
+	nchunks = 8 * pool->nthreads;
+	if(nchunks > (list->count + 63) / 64)
+		nchunks = (list->count + 63) / 64;
+	if(nchunks < 1) nchunks = 1;
+	per_chunk = (list->count + nchunks - 1) / nchunks;
+
+	job.elm = td->elements;
+	job.list = list;
+	job.encode = (cb != 0);
+	job.sorted = sorted;
+	job.chunks = (asn_parallel_chunk_t *)CALLOC(nchunks,
+		sizeof(job.chunks[0]));
+	if(!job.chunks) _ASN_ENCODE_FAILED;
+	for(i = 0; i < nchunks; i++) {
+		job.chunks[i].from = i * per_chunk;
+		job.chunks[i].to = (i + 1) * per_chunk;
+		if(job.chunks[i].to > list->count)
+			job.chunks[i].to = list->count;
+		if(job.chunks[i].from > job.chunks[i].to)
+			job.chunks[i].from = job.chunks[i].to;
+	}
+
+	ASN_DEBUG("Encoding %d elements of %s in %d chunks",
+		list->count, td->name, nchunks);
+
+	if(asn_parallel_for(pool, nchunks, asn_parallel__list_chunk, &job)
+			!= (size_t)nchunks) {
+		for(i = 0; i < nchunks; i++) {
+			if(job.chunks[i].erval.encoded == -1) {
+				erval = job.chunks[i].erval;
+				goto done;
+			}
+		}
+		goto failed;
+	}
+
+	for(i = 0; i < nchunks; i++)
+		computed_size += job.chunks[i].length;
+
+	encoding_size = der_write_tags(td, computed_size, tag_mode, 1, tag,
+		cb, app_key);
+	if(encoding_size == -1)
+		goto failed;
+	erval.encoded = computed_size + encoding_size;
+
+	if(cb) {
+		if(sorted) {
+			if(asn_parallel__merge(job.chunks, nchunks,
+					cb, app_key))
+				goto failed;
+		} else {
+			for(i = 0; i < nchunks; i++) {
+				if(job.chunks[i].length
+				&& cb(job.chunks[i].buf, job.chunks[i].length,
+						app_key) < 0)
+					goto failed;
+			}
+		}
+	}
+
+	erval.failed_type = 0;
+	erval.structure_ptr = 0;
+	goto done;
+failed:
+	erval.encoded = -1;
+	erval.failed_type = td;
+	erval.structure_ptr = sptr;
+done:
+	for(i = 0; i < nchunks; i++) {
+		FREEMEM(job.chunks[i].buf);
+		FREEMEM(job.chunks[i].els);
+	}
+	FREEMEM(job.chunks);
+	return erval;
+}
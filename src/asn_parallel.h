@@ -0,0 +1,120 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_ASN_PARALLEL_H_
+#define	_ASN_PARALLEL_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * The pool of worker threads encoding or decoding the batches of
+ * independent PDUs. The items of a batch are dealt out to the workers
+ * in contiguous ranges; a worker done with its own range takes over
+ * the remaining items of the others. The results are placed into the
+ * items themselves, so they come back in the input order.
+ * The calling thread works on the batch as well.
+ *
+ * The runtime keeps no shared mutable state on the codec paths.
+ * The descriptors of the derived types, which get the functions of their
+ * base types copied into them on the first use, are resolved so by the
+ * calling thread, under a lock, before the batch is handed to the threads.
+ */
+typedef struct asn_parallel_s asn_parallel_t;
+
+/*
+ * Start the pool of (nthreads) threads, counting in the calling one.
+ * Values below 2 make a pool processing the batches in the calling thread.
+ * Returns NULL if the threads could not be started.
+ */
+asn_parallel_t *asn_parallel_new(unsigned nthreads);
+
+/*
+ * Stop the threads and release the pool.
+ */
+void asn_parallel_free(asn_parallel_t *pool);
+
+/*
+ * Decode the (count) PDUs according to the (syntax), as asn_decode() does,
+ * each into its item's (structure); see asn_dec_batch_item_t.
+ * The structures of the failed items are emptied.
+ * Returns the number of items decoded successfully.
+ */
+size_t asn_parallel_decode(asn_parallel_t *pool,
+	enum asn_transfer_syntax syntax,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	asn_dec_batch_item_t *items,
+	size_t count
+	);
+
+/*
+ * Encode the (count) structures according to the (syntax), as asn_encode()
+ * does, each into its item's (buffer); see asn_enc_batch_item_t.
+ * Returns the number of items encoded successfully.
+ */
+size_t asn_parallel_encode(asn_parallel_t *pool,
+	enum asn_transfer_syntax syntax,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	asn_enc_batch_item_t *items,
+	size_t count
+	);
+
+/*
+ * The DER encoder of any type, as der_encode(), but with the SEQUENCE OF
+ * and SET OF lists of ASN_PARALLEL_DER_MIN elements or more encoded by
+ * the pool's threads: each thread encodes a chunk of the list into
+ * a buffer of its own (and sorts it, for SET OF), then the chunks are
+ * written out in order (merged, for SET OF).
+ * The lists nested in the elements of such a list are encoded as usual.
+ */
+asn_enc_rval_t der_encode_parallel(asn_parallel_t *pool,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void *struct_ptr,	/* Structure to be encoded */
+	asn_app_consume_bytes_f *consume_bytes_cb,
+	void *app_key		/* Arbitrary callback argument */
+	);
+#ifndef	ASN_PARALLEL_DER_MIN
+#define	ASN_PARALLEL_DER_MIN	1024
+#endif
+
+
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * Invoke the (func) for each of the (count) items on the pool's threads.
+ * Returns the number of invocations which returned non-zero.
+ */
+size_t asn_parallel_for(asn_parallel_t *pool, size_t count,
+	int (*func)(void *arg, size_t i), void *arg);
+
+/*
+ * The pool of the der_encode_parallel() in progress in the calling thread,
+ * if it is not busy already. NULL otherwise.
+ */
+asn_parallel_t *asn_parallel_current(void);
+
+/*
+ * The DER encoder of the SEQUENCE OF and SET OF (sorted) types
+ * using the pool's threads.
+ */
+asn_enc_rval_t asn_parallel_der_list(asn_parallel_t *pool,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void *struct_ptr,
+	int tag_mode, ber_tlv_tag_t tag,
+	int sorted,		/* SET OF */
+	asn_app_consume_bytes_f *consume_bytes_cb,
+	void *app_key
+	);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _ASN_PARALLEL_H_ */
@@ -22,6 +22,11 @@
 			rval.consumed = 0;	/* Context-free */	\
 		return rval;						\
 	} while(0)
+#undef	RETURN_FAIL
+#define	RETURN_FAIL(reason)	do {					\
+		ASN_DEC_ERROR(opt_codec_ctx, td, reason, consumed_myself);\
+		RETURN(RC_FAIL);					\
+	} while(0)
 
 /*
  * The BER decoder of any type.
@@ -31,13 +36,16 @@ ber_decode(asn_codec_ctx_t *opt_codec_ctx,
 	asn_TYPE_descriptor_t *type_descriptor,
 	void **struct_ptr, const void *ptr, size_t size) {
 	asn_codec_ctx_t s_codec_ctx;
+	asn_mem_account_t account;
+	asn_dec_rval_t rval;
 
 	/*
 	 * Stack checker requires that the codec context
 	 * must be allocated on the stack.
 	 */
 	if(opt_codec_ctx) {
-		if(opt_codec_ctx->max_stack_size) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
 			s_codec_ctx = *opt_codec_ctx;
 			opt_codec_ctx = &s_codec_ctx;
 		}
@@ -51,11 +59,62 @@ ber_decode(asn_codec_ctx_t *opt_codec_ctx,
 	/*
 	 * Invoke type-specific decoder.
 	 */
-	return type_descriptor->ber_decoder(opt_codec_ctx, type_descriptor,
+	ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+	asn_mem__begin(&account, opt_codec_ctx, 0);
+	rval = ASN_CODEC(type_descriptor, ber_decoder)(opt_codec_ctx,
+		type_descriptor,
 		struct_ptr,	/* Pointer to the destination structure */
 		ptr, size,	/* Buffer and its size */
 		0		/* Default tag mode is 0 */
 		);
+	asn_mem__end(&account);
+	ASN_DEC_ERROR_END(opt_codec_ctx, type_descriptor, rval.code, -1);
+
+	return rval;
+}
+
+size_t
+ber_decode_batch(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *td,
+	asn_dec_batch_item_t *items, size_t count) {
+	asn_codec_ctx_t s_codec_ctx;
+	ber_type_decoder_f *decoder = ASN_CODEC(td, ber_decoder);
+	size_t decoded = 0;
+	size_t i;
+
+	/* The same stack base serves all the items */
+	if(opt_codec_ctx) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
+			s_codec_ctx = *opt_codec_ctx;
+			opt_codec_ctx = &s_codec_ctx;
+		}
+	} else {
+		memset(&s_codec_ctx, 0, sizeof(s_codec_ctx));
+		s_codec_ctx.max_stack_size = _ASN_DEFAULT_STACK_MAX;
+		opt_codec_ctx = &s_codec_ctx;
+	}
+
+	for(i = 0; i < count; i++) {
+		asn_dec_batch_item_t *item = &items[i];
+		asn_mem_account_t account;	/* Budget is per item */
+
+		/* The structure of the previous batch is decoded into */
+		asn_copy__recycle(td, &item->structure);
+
+		ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+		asn_mem__begin(&account, opt_codec_ctx, 0);
+		item->result = decoder(opt_codec_ctx, td,
+			&item->structure, item->buffer, item->size, 0);
+		ASN_DEC_ERROR_END(opt_codec_ctx, td, item->result.code, -1);
+		if(item->result.code == RC_OK)
+			decoded++;
+		else
+			asn_copy__recycle(td, &item->structure);
+		asn_mem__end(&account);
+	}
+
+	return decoded;
 }
 
 /*
@@ -66,6 +125,15 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 		asn_TYPE_descriptor_t *td, asn_struct_ctx_t *opt_ctx,
 		const void *ptr, size_t size, int tag_mode, int last_tag_form,
 		ber_tlv_len_t *last_length, int *opt_tlv_form) {
+	return ber_check_tags_eocs(opt_codec_ctx, td, opt_ctx, ptr, size,
+		tag_mode, last_tag_form, last_length, opt_tlv_form, 0);
+}
+
+asn_dec_rval_t
+ber_check_tags_eocs(asn_codec_ctx_t *opt_codec_ctx,
+		asn_TYPE_descriptor_t *td, asn_struct_ctx_t *opt_ctx,
+		const void *ptr, size_t size, int tag_mode, int last_tag_form,
+		ber_tlv_len_t *last_length, int *opt_tlv_form, int *opt_eocs) {
 	ssize_t consumed_myself = 0;
 	ssize_t tag_len;
 	ssize_t len_len;
@@ -120,14 +188,14 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 		 */
 		tag_len = ber_fetch_tag(ptr, size, &tlv_tag);
 		switch(tag_len) {
-		case -1: RETURN(RC_FAIL);
+		case -1: RETURN_FAIL(ASN_DEC_ERROR_TAG);
 		case 0: RETURN(RC_WMORE);
 		}
 		tlv_constr = BER_TLV_CONSTRUCTED(ptr);
 		len_len = ber_fetch_length(tlv_constr,
 			(const char *)ptr + tag_len, size - tag_len, &tlv_len);
 		switch(len_len) {
-		case -1: RETURN(RC_FAIL);
+		case -1: RETURN_FAIL(ASN_DEC_ERROR_LENGTH);
 		case 0: RETURN(RC_WMORE);
 		}
 		ASN_DEBUG("Advancing %ld in ANY case",
@@ -148,7 +216,7 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 				(long)tag_len, step, tagno,
 				ber_tlv_tag_string(tlv_tag));
 		switch(tag_len) {
-		case -1: RETURN(RC_FAIL);
+		case -1: RETURN_FAIL(ASN_DEC_ERROR_TAG);
 		case 0: RETURN(RC_WMORE);
 		}
 
@@ -175,7 +243,7 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 				ber_tlv_tag_string(td->tags[tagno]),
 				tagno, tag_mode
 			);
-			RETURN(RC_FAIL);
+			RETURN_FAIL(ASN_DEC_ERROR_TAG);
 		    }
 		}
 
@@ -190,14 +258,14 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 			if(tlv_constr == 0) {
 				ASN_DEBUG("tlv_constr = %d, expfail",
 					tlv_constr);
-				RETURN(RC_FAIL);
+				RETURN_FAIL(ASN_DEC_ERROR_TAG);
 			}
 		} else {
 			if(last_tag_form != tlv_constr
 			&& last_tag_form != -1) {
 				ASN_DEBUG("last_tag_form %d != %d",
 					last_tag_form, tlv_constr);
-				RETURN(RC_FAIL);
+				RETURN_FAIL(ASN_DEC_ERROR_TAG);
 			}
 		}
 
@@ -208,7 +276,7 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 			(const char *)ptr + tag_len, size - tag_len, &tlv_len);
 		ASN_DEBUG("Fetchinig len = %ld", (long)len_len);
 		switch(len_len) {
-		case -1: RETURN(RC_FAIL);
+		case -1: RETURN_FAIL(ASN_DEC_ERROR_LENGTH);
 		case 0: RETURN(RC_WMORE);
 		}
 
@@ -217,7 +285,8 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 		 * As of today, the chain of tags
 		 * must either contain several indefinite length TLVs,
 		 * or several definite length ones.
-		 * No mixing is allowed.
+		 * No mixing is allowed, except for the primitive value
+		 * within the indefinite length tags, if (opt_eocs) is given.
 		 */
 		if(tlv_len == -1) {
 			/*
@@ -228,15 +297,17 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 			} else {
 				ASN_DEBUG("Unexpected indefinite length "
 					"in a chain of definite lengths");
-				RETURN(RC_FAIL);
+				RETURN_FAIL(ASN_DEC_ERROR_LENGTH);
 			}
 			ADVANCE(tag_len + len_len);
 			continue;
 		} else {
-			if(expect_00_terminators) {
+			if(expect_00_terminators
+			&& !(opt_eocs && !tlv_constr
+				&& tagno == td->tags_count - 1)) {
 				ASN_DEBUG("Unexpected definite length "
 					"in a chain of indefinite lengths");
-				RETURN(RC_FAIL);
+				RETURN_FAIL(ASN_DEC_ERROR_LENGTH);
 			}
 		}
 
@@ -248,7 +319,7 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 			limit_len    = tlv_len + tag_len + len_len;
 			if(limit_len < 0) {
 				/* Too great tlv_len value? */
-				RETURN(RC_FAIL);
+				RETURN_FAIL(ASN_DEC_ERROR_LENGTH);
 			}
 		} else if(limit_len != tlv_len + tag_len + len_len) {
 			/*
@@ -257,7 +328,7 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 			 */
 			ASN_DEBUG("Outer TLV is %ld and inner is %ld",
 				(long)limit_len, (long)tlv_len);
-			RETURN(RC_FAIL);
+			RETURN_FAIL(ASN_DEC_ERROR_LENGTH);
 		}
 
 		ADVANCE(tag_len + len_len);
@@ -274,10 +345,30 @@ ber_check_tags(asn_codec_ctx_t *opt_codec_ctx,
 
 	if(opt_tlv_form)
 		*opt_tlv_form = tlv_constr;
-	if(expect_00_terminators)
+	if(opt_eocs)
+		*opt_eocs = 0;
+	if(expect_00_terminators && tlv_len == -1) {
 		*last_length = -expect_00_terminators;
-	else
+	} else {
 		*last_length = tlv_len;
+		if(opt_eocs)
+			*opt_eocs = expect_00_terminators;
+	}
 
 	RETURN(RC_OK);
 }
+
+ssize_t
+ber_skip_eocs(const void *ptr, size_t size, int eocs) {
+	const uint8_t *buf = (const uint8_t *)ptr;
+	size_t need = 2 * eocs;
+	size_t i;
+
+	if(size < need)
+		return 0;	/* Want more */
+
+	for(i = 0; i < need; i++)
+		if(buf[i]) return -1;
+
+	return need;
+}
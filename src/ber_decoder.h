@@ -25,6 +25,39 @@ asn_dec_rval_t ber_decode(struct asn_codec_ctx_s *opt_codec_ctx,
 	size_t size		/* Size of that buffer */
 	);
 
+/*
+ * Decode the (count) independent PDUs of the same type, each of them
+ * expected to be complete: the partial ones fail with RC_WMORE.
+ * The codec context is set up once for the whole batch.
+ * Returns the number of items decoded successfully; the outcome
+ * of each one is placed into its (result).
+ */
+size_t ber_decode_batch(struct asn_codec_ctx_s *opt_codec_ctx,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	asn_dec_batch_item_t *items,	/* Input spans and output slots */
+	size_t count			/* Number of items */
+	);
+
+/*
+ * The BER decoder of any type which walks the nested SEQUENCE, SET, CHOICE,
+ * SEQUENCE OF and SET OF types iteratively, keeping a frame per level
+ * on the heap instead of recursing on the C stack. The nesting depth is
+ * limited rather than by the stack size, so deep structures may be decoded
+ * on the small stacks of the coroutines. The limit is 1000 levels, or the
+ * (max_depth) of asn_dec_opts_t when called by asn_decode_ext().
+ * The primitive members are handed over to their own decoders.
+ * Unlike ber_decode(), the buffer is expected to hold the complete PDU:
+ * RC_WMORE tells that it does not, and the decoding is not resumable;
+ * the partially decoded structure is to be freed and the decoding
+ * started over once more data is available.
+ */
+asn_dec_rval_t ber_decode_iterative(struct asn_codec_ctx_s *opt_codec_ctx,
+	struct asn_TYPE_descriptor_s *type_descriptor,
+	void **struct_ptr,	/* Pointer to a target structure's pointer */
+	const void *buffer,	/* Data to be decoded */
+	size_t size		/* Size of that buffer */
+	);
+
 /*
  * Type of generic function which decodes the byte stream into the structure.
  */
@@ -56,6 +89,32 @@ asn_dec_rval_t ber_check_tags(
 		int *opt_tlv_form	/* optional tag form */
 	);
 
+/*
+ * A variant of ber_check_tags() which also accepts the primitive value
+ * of definite length within the outer tags of indefinite length, the way
+ * CER encodes [1] EXPLICIT INTEGER and the like. In that case (*opt_eocs)
+ * receives the number of the end-of-contents pairs which follow the value;
+ * the caller is supposed to skip them with ber_skip_eocs().
+ */
+asn_dec_rval_t ber_check_tags_eocs(
+		struct asn_codec_ctx_s *opt_codec_ctx,	/* codec options */
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		asn_struct_ctx_t *opt_ctx,	/* saved decoding context */
+		const void *ptr, size_t size,
+		int tag_mode,		/* {-1,0,1}: IMPLICIT, no, EXPLICIT */
+		int last_tag_form,	/* {-1,0:1}: any, primitive, constr */
+		ber_tlv_len_t *last_length,
+		int *opt_tlv_form,	/* optional tag form */
+		int *opt_eocs		/* end-of-contents pairs to follow */
+	);
+
+/*
+ * Skip the (eocs) end-of-contents pairs.
+ * Returns the number of bytes skipped, 0 if more data is expected
+ * or -1 if they are not there.
+ */
+ssize_t ber_skip_eocs(const void *ptr, size_t size, int eocs);
+
 #ifdef __cplusplus
 }
 #endif
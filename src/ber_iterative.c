@@ -0,0 +1,842 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SET_OF.h>
+#include <asn_SET_OF.h>
+
+#ifndef	WIN32
+#include <netinet/in.h>	/* for ntohl() */
+#else
+#include <winsock2.h>	/* for ntohl() */
+#endif
+
+/*
+ * The constructed types walked by the engine itself.
+ * The rest are decoded by their own ber_decoder.
+ */
+enum bi_kind {
+	BI_LEAF,
+	BI_SEQUENCE,
+	BI_SET,
+	BI_CHOICE,
+	BI_SET_OF	/* Also SEQUENCE OF */
+};
+
+/*
+ * The state of a single constructed type being decoded.
+ */
+typedef struct bi_frame_s {
+	asn_TYPE_descriptor_t *td;
+	enum bi_kind kind;
+	void *st;		/* The structure being filled in */
+	size_t end;		/* End of the definite length value, or -1 */
+	size_t limit;		/* End of the bytes available to the frame */
+	int limited;		/* The (limit) is set by a definite length */
+	int eocs;		/* Number of the end-of-contents pairs left */
+	int edx;		/* The member being decoded */
+	int phase;		/* 0: members, 1: leftovers and EOCs */
+} bi_frame_t;
+
+typedef struct bi_engine_s {
+	asn_codec_ctx_t *codec_ctx;
+	const asn_dec_opts_t *opts;	/* Of the codec_ctx, if any */
+	const uint8_t *buf;
+	size_t size;
+	size_t pos;		/* Bytes consumed so far */
+	bi_frame_t *frames;	/* The frame stack */
+	size_t depth;		/* Frames in use */
+	size_t allocated;	/* Frames allocated */
+	size_t max_depth;
+	int frame_failed;	/* The top frame has failed, not its member */
+} bi_engine_t;
+
+#define	BI_INDEFINITE	((size_t)-1)
+#define	BI_TOP(e)	(&(e)->frames[(e)->depth - 1])
+#define	BI_LEFT(e, f)	((f)->limit - (e)->pos)
+#define	BI_AT(e)	((e)->buf + (e)->pos)
+
+/*
+ * Running out of data is fatal within the definite length,
+ * and means the PDU is incomplete otherwise (see SIZE_VIOLATION).
+ */
+#define	BI_MORE(f)	((f)->limited ? RC_FAIL : RC_WMORE)
+
+/*
+ * Fail the top frame for the (reason), see bi_failed().
+ */
+#define	BI_FAILED(e, td, reason)	do {				\
+		ASN_DEC_ERROR((e)->codec_ctx, (td), (reason), 0);	\
+		(e)->frame_failed = 1;					\
+		return RC_FAIL;						\
+	} while(0)
+
+/*
+ * Check whether we are inside the extensions group.
+ */
+#define	IN_EXTENSION_GROUP(specs, memb_idx)	\
+	( ((memb_idx) > (specs)->ext_after)	\
+	&&((memb_idx) < (specs)->ext_before))
+
+/*
+ * Whether the SET OF elements are to be handed to the application
+ * (see asn_dec_opts_t and SET_OF_decode_ber()).
+ */
+#define	BI_STREAMED(opts, td)					\
+	((opts) && (opts)->element_cb				\
+	&& ((opts)->stream_type == (td)				\
+		|| (opts)->stream_type == (td)->elements->type))
+
+static enum asn_dec_rval_code_e bi_member(bi_engine_t *e,
+	asn_TYPE_descriptor_t *td, void **memb_ptr2, int tag_mode);
+
+/*
+ * Tags are canonically sorted in the tag2element map.
+ */
+static int
+bi_t2e_cmp(const void *ap, const void *bp) {
+	const asn_TYPE_tag2member_t *a = (const asn_TYPE_tag2member_t *)ap;
+	const asn_TYPE_tag2member_t *b = (const asn_TYPE_tag2member_t *)bp;
+
+	int a_class = BER_TAG_CLASS(a->el_tag);
+	int b_class = BER_TAG_CLASS(b->el_tag);
+
+	if(a_class == b_class) {
+		ber_tlv_tag_t a_value = BER_TAG_VALUE(a->el_tag);
+		ber_tlv_tag_t b_value = BER_TAG_VALUE(b->el_tag);
+
+		if(a_value == b_value)
+			return 0;
+		else if(a_value < b_value)
+			return -1;
+		else
+			return 1;
+	} else if(a_class < b_class) {
+		return -1;
+	} else {
+		return 1;
+	}
+}
+
+static asn_TYPE_tag2member_t *
+bi_search4tag(asn_TYPE_tag2member_t *tag2el, int count, ber_tlv_tag_t tag) {
+	asn_TYPE_tag2member_t key;
+	key.el_tag = tag;
+	key.el_no = 0;
+	return (asn_TYPE_tag2member_t *)bsearch(&key, tag2el, count,
+		sizeof(tag2el[0]), bi_t2e_cmp);
+}
+
+/*
+ * Figure out which of the constructed types the type is.
+ */
+static enum bi_kind
+bi_kind_of(asn_TYPE_descriptor_t *td) {
+	ber_type_decoder_f *decoder;
+
+	do {
+		decoder = td->ber_decoder;
+		if(decoder == SEQUENCE_decode_ber) return BI_SEQUENCE;
+		if(decoder == SET_decode_ber) return BI_SET;
+		if(decoder == CHOICE_decode_ber) return BI_CHOICE;
+		if(decoder == SET_OF_decode_ber) return BI_SET_OF;
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	return BI_LEAF;
+}
+
+/*
+ * Skip the leftovers of the structure (unknown extensions, if allowed)
+ * and read in its end-of-contents pairs.
+ */
+static enum asn_dec_rval_code_e
+bi_leftovers(bi_engine_t *e, bi_frame_t *f, int extensible) {
+	int eoc_seen = 0;
+
+	for(;;) {
+		ber_tlv_tag_t tlv_tag;
+		ssize_t tl, ll;
+
+		if(f->end == BI_INDEFINITE ? f->eocs == 0 : e->pos == f->end)
+			return RC_OK;
+
+		tl = ber_fetch_tag(BI_AT(e), BI_LEFT(e, f), &tlv_tag);
+		switch(tl) {
+		case 0: return BI_MORE(f);
+		case -1: return RC_FAIL;
+		}
+
+		if(f->end == BI_INDEFINITE && BI_AT(e)[0] == 0) {
+			if(BI_LEFT(e, f) < 2)
+				return BI_MORE(f);
+			if(BI_AT(e)[1] == 0) {
+				/* Correctly finished with <0><0> */
+				e->pos += 2;
+				f->eocs--;
+				eoc_seen = 1;
+				continue;
+			}
+		}
+
+		if(!extensible || eoc_seen) {
+			ASN_DEBUG("Unexpected continuation of %s: %s",
+				f->td->name, ber_tlv_tag_string(tlv_tag));
+			BI_FAILED(e, f->td, ASN_DEC_ERROR_TAG);
+		}
+
+		ll = ber_skip_length(e->codec_ctx, BER_TLV_CONSTRUCTED(BI_AT(e)),
+			BI_AT(e) + tl, BI_LEFT(e, f) - tl);
+		switch(ll) {
+		case 0: return BI_MORE(f);
+		case -1: return RC_FAIL;
+		}
+
+		e->pos += tl + ll;
+	}
+}
+
+/*
+ * Skip the unknown TLV of the extension.
+ */
+static enum asn_dec_rval_code_e
+bi_skip(bi_engine_t *e, bi_frame_t *f, ssize_t tag_len) {
+	ssize_t skip;
+
+	skip = ber_skip_length(e->codec_ctx, BER_TLV_CONSTRUCTED(BI_AT(e)),
+		BI_AT(e) + tag_len, BI_LEFT(e, f) - tag_len);
+	switch(skip) {
+	case 0: return BI_MORE(f);
+	case -1: return RC_FAIL;
+	}
+
+	e->pos += tag_len + skip;
+	return RC_OK;
+}
+
+/*
+ * Check that all mandatory elements of the SET are present.
+ */
+static int
+bi_set_populated(asn_TYPE_descriptor_t *td, void *st) {
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	int edx;
+
+	for(edx = 0; edx < td->elements_count;
+		edx += (8 * sizeof(specs->_mandatory_elements[0]))) {
+		unsigned int midx, pres, must;
+
+		midx = edx/(8 * sizeof(specs->_mandatory_elements[0]));
+		pres = ((unsigned int *)((char *)st+specs->pres_offset))[midx];
+		must = ntohl(specs->_mandatory_elements[midx]);
+
+		if((pres & must) != must) {
+			ASN_DEBUG("One or more mandatory elements "
+				"of a SET %s are not present", td->name);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static void
+bi_set_present_idx(void *st, int pres_offset, int pres_size, int present) {
+	void *present_ptr = ((char *)st) + pres_offset;
+
+	switch(pres_size) {
+	case sizeof(int):	*(int *)present_ptr   = present; break;
+	case sizeof(short):	*(short *)present_ptr = present; break;
+	case sizeof(char):	*(char *)present_ptr  = present; break;
+	default:
+		/* ANSI C mandates enum to be equivalent to integer */
+		assert(pres_size != sizeof(int));
+	}
+}
+
+/*
+ * Account for the member of the top frame having been decoded.
+ */
+static enum asn_dec_rval_code_e
+bi_member_done(bi_engine_t *e) {
+	bi_frame_t *f;
+
+	if(e->depth == 0)
+		return RC_OK;	/* The outermost type */
+
+	f = BI_TOP(e);
+	switch(f->kind) {
+	case BI_SEQUENCE:
+		f->edx++;
+		break;
+	case BI_SET: {
+		asn_SET_specifics_t *specs
+			= (asn_SET_specifics_t *)f->td->specifics;
+		ASN_SET_MKPRESENT((char *)f->st + specs->pres_offset, f->edx);
+		}
+		break;
+	case BI_CHOICE:
+		f->phase = 1;
+		break;
+	case BI_SET_OF: {
+		asn_SET_OF_specifics_t *specs
+			= (asn_SET_OF_specifics_t *)f->td->specifics;
+		asn_struct_ctx_t *ctx = (asn_struct_ctx_t *)
+			((char *)f->st + specs->ctx_offset);
+		if(BI_STREAMED(e->opts, f->td)) {
+			/* Hand the element over instead of keeping it */
+			int ret = e->opts->element_cb(f->td,
+				ctx->ptr, e->opts->cb_key);
+			if(ret != 1)
+				ASN_STRUCT_FREE(*f->td->elements->type,
+					ctx->ptr);
+			ctx->ptr = 0;
+			if(ret < 0)
+				return RC_FAIL;
+		} else {
+			asn_anonymous_set_ *list = _A_SET_FROM_VOID(f->st);
+			if(ASN_SET_ADD(list, ctx->ptr) != 0)
+				return RC_FAIL;
+			ctx->ptr = 0;
+		}
+		}
+		break;
+	case BI_LEAF:
+		assert(f->kind != BI_LEAF);
+		return RC_FAIL;
+	}
+
+	return RC_OK;
+}
+
+/*
+ * The top frame is complete.
+ */
+static enum asn_dec_rval_code_e
+bi_pop(bi_engine_t *e) {
+	e->depth--;
+	return bi_member_done(e);
+}
+
+/*
+ * Open the frame of the constructed type: allocate the structure
+ * and check its tags.
+ */
+static enum asn_dec_rval_code_e
+bi_push(bi_engine_t *e, asn_TYPE_descriptor_t *td, enum bi_kind kind,
+		void **struct_ptr, int tag_mode) {
+	size_t limit = e->depth ? BI_TOP(e)->limit : e->size;
+	int limited = e->depth ? BI_TOP(e)->limited : 0;
+	bi_frame_t *f;
+	int struct_size;
+	void *st;
+
+	if(e->depth >= e->max_depth) {
+		ASN_DEBUG("%s is nested too deep (%ld)",
+			td->name, (long)e->depth);
+		ASN_DEC_ERROR(e->codec_ctx, td, ASN_DEC_ERROR_DEPTH, 0);
+		return RC_FAIL;
+	}
+
+	if(e->depth == e->allocated) {
+		size_t allocated = e->allocated ? 2 * e->allocated : 16;
+		void *p = REALLOC(e->frames, allocated * sizeof(e->frames[0]));
+		if(!p) return RC_FAIL;
+		e->frames = (bi_frame_t *)p;
+		e->allocated = allocated;
+	}
+
+	switch(kind) {
+	case BI_SEQUENCE: struct_size = ((asn_SEQUENCE_specifics_t *)
+			td->specifics)->struct_size; break;
+	case BI_SET: struct_size = ((asn_SET_specifics_t *)
+			td->specifics)->struct_size; break;
+	case BI_CHOICE: struct_size = ((asn_CHOICE_specifics_t *)
+			td->specifics)->struct_size; break;
+	case BI_SET_OF: struct_size = ((asn_SET_OF_specifics_t *)
+			td->specifics)->struct_size; break;
+	default:
+		return RC_FAIL;
+	}
+
+	/*
+	 * Create the target structure if it is not present already.
+	 */
+	st = *struct_ptr;
+	if(st == 0) {
+		st = *struct_ptr = CALLOC(1, struct_size);
+		if(st == 0) return RC_FAIL;
+	}
+
+	f = &e->frames[e->depth];
+	f->td = td;
+	f->kind = kind;
+	f->st = st;
+	f->edx = 0;
+	f->phase = 0;
+	f->eocs = 0;
+	f->end = BI_INDEFINITE;
+	f->limit = limit;
+	f->limited = limited;
+
+	if(kind == BI_CHOICE && !(tag_mode || td->tags_count)) {
+		/*
+		 * The untagged CHOICE has no length of its own;
+		 * it ends with its member.
+		 */
+	} else {
+		ber_tlv_len_t length;
+		asn_dec_rval_t rval;
+
+		rval = ber_check_tags(e->codec_ctx, td, 0, BI_AT(e),
+			limit - e->pos, tag_mode,
+			kind == BI_CHOICE ? -1 : 1, &length, 0);
+		switch(rval.code) {
+		case RC_OK: break;
+		case RC_WMORE: if(!limited) return RC_WMORE;
+			/* Fall through */
+		default:
+			ASN_DEBUG("%s tagging check failed: %d",
+				td->name, rval.code);
+			return RC_FAIL;
+		}
+		e->pos += rval.consumed;
+
+		if(length < 0) {
+			f->eocs = -length;
+		} else if((size_t)length <= limit - e->pos) {
+			f->end = e->pos + length;
+			f->limit = f->end;
+			f->limited = 1;
+		} else if(limited) {
+			ASN_DEBUG("%s exceeds the enclosing length", td->name);
+			return RC_FAIL;
+		} else {
+			/* The buffer ends before the value does */
+			f->end = e->pos + length;
+		}
+	}
+
+	e->depth++;
+	return RC_OK;
+}
+
+static enum asn_dec_rval_code_e
+bi_sequence(bi_engine_t *e, bi_frame_t *f) {
+	asn_TYPE_descriptor_t *td = f->td;
+	asn_SEQUENCE_specifics_t *specs = (asn_SEQUENCE_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elements = td->elements;
+	ber_tlv_tag_t tlv_tag;
+	ssize_t tag_len;
+	void *memb_ptr;
+	void **memb_ptr2;
+	int edx = f->edx;
+	int may_end;
+	int opt_edx_end;
+	int use_bsearch;
+	int n;
+
+	if(f->phase == 1 || edx >= td->elements_count) {
+		enum asn_dec_rval_code_e code;
+		code = bi_leftovers(e, f,
+			IN_EXTENSION_GROUP(specs, td->elements_count));
+		if(code != RC_OK) return code;
+		return bi_pop(e);
+	}
+
+	may_end = (edx + elements[edx].optional == td->elements_count)
+		|| (IN_EXTENSION_GROUP(specs, edx)
+			&& specs->ext_before > td->elements_count);
+
+	if(e->pos == f->end && may_end) {
+		f->phase = 1;
+		return RC_OK;
+	}
+
+	/*
+	 * Fetch the T from TLV.
+	 */
+	tag_len = ber_fetch_tag(BI_AT(e), BI_LEFT(e, f), &tlv_tag);
+	switch(tag_len) {
+	case 0:
+		if(f->limited && e->pos == f->end)	/* Before the mandatory */
+			BI_FAILED(e, td, ASN_DEC_ERROR_MISSING);
+		return BI_MORE(f);
+	case -1: return RC_FAIL;
+	}
+
+	if(f->end == BI_INDEFINITE && BI_AT(e)[0] == 0) {
+		if(BI_LEFT(e, f) < 2)
+			return BI_MORE(f);
+		if(BI_AT(e)[1] == 0 && may_end) {
+			f->phase = 1;
+			return RC_OK;
+		}
+	}
+
+	/*
+	 * Find the next available type with this tag.
+	 */
+	use_bsearch = 0;
+	opt_edx_end = edx + elements[edx].optional + 1;
+	if(opt_edx_end > td->elements_count)
+		opt_edx_end = td->elements_count;	/* Cap */
+	else if(opt_edx_end - edx > 8) {
+		/* Limit the scope of linear search... */
+		opt_edx_end = edx + 8;
+		use_bsearch = 1;
+		/* ... and resort to bsearch() */
+	}
+	for(n = edx; n < opt_edx_end; n++) {
+		if(BER_TAGS_EQUAL(tlv_tag, elements[n].tag)
+		|| (elements[n].flags & ATF_OPEN_TYPE))
+			goto found;
+		if(elements[n].tag == (ber_tlv_tag_t)-1) {
+			use_bsearch = 1;
+			break;
+		}
+	}
+	if(use_bsearch) {
+		asn_TYPE_tag2member_t *t2m;
+		t2m = bi_search4tag(specs->tag2el, specs->tag2el_count, tlv_tag);
+		if(t2m) {
+			asn_TYPE_tag2member_t *best = 0;
+			asn_TYPE_tag2member_t *t2m_f, *t2m_l;
+			int edx_max = edx + elements[edx].optional;
+			t2m_f = t2m + t2m->toff_first;
+			t2m_l = t2m + t2m->toff_last;
+			for(t2m = t2m_f; t2m <= t2m_l; t2m++) {
+				if(t2m->el_no > edx_max) break;
+				if(t2m->el_no < edx) continue;
+				best = t2m;
+			}
+			if(best) {
+				n = best->el_no;
+				goto found;
+			}
+		}
+	}
+
+	/*
+	 * The tag is either unknown (thus, incorrect) or an extension.
+	 */
+	if(!IN_EXTENSION_GROUP(specs, edx)) {
+		ASN_DEBUG("Unexpected tag %s in %s",
+			ber_tlv_tag_string(tlv_tag), td->name);
+		BI_FAILED(e, td, ASN_DEC_ERROR_TAG);
+	}
+	return bi_skip(e, f, tag_len);
+
+found:
+	f->edx = n;
+	if(elements[n].flags & ATF_POINTER) {
+		memb_ptr2 = (void **)((char *)f->st + elements[n].memb_offset);
+	} else {
+		memb_ptr = (char *)f->st + elements[n].memb_offset;
+		memb_ptr2 = &memb_ptr;
+	}
+	return bi_member(e, elements[n].type, memb_ptr2,
+		elements[n].tag_mode);
+}
+
+static enum asn_dec_rval_code_e
+bi_set(bi_engine_t *e, bi_frame_t *f) {
+	asn_TYPE_descriptor_t *td = f->td;
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elements = td->elements;
+	asn_TYPE_tag2member_t *t2m;
+	ber_tlv_tag_t tlv_tag;
+	ssize_t tag_len;
+	void *memb_ptr;
+	void **memb_ptr2;
+	int edx;
+
+	if(f->phase == 1) {
+		enum asn_dec_rval_code_e code;
+		code = bi_leftovers(e, f, specs->extensible);
+		if(code != RC_OK) return code;
+		if(!bi_set_populated(td, f->st))
+			BI_FAILED(e, td, ASN_DEC_ERROR_MISSING);
+		return bi_pop(e);
+	}
+
+	if(e->pos == f->end) {
+		f->phase = 1;
+		return RC_OK;
+	}
+
+	tag_len = ber_fetch_tag(BI_AT(e), BI_LEFT(e, f), &tlv_tag);
+	switch(tag_len) {
+	case 0: return BI_MORE(f);
+	case -1: return RC_FAIL;
+	}
+
+	if(f->end == BI_INDEFINITE && BI_AT(e)[0] == 0) {
+		if(BI_LEFT(e, f) < 2)
+			return BI_MORE(f);
+		if(BI_AT(e)[1] == 0) {
+			f->phase = 1;
+			return RC_OK;
+		}
+	}
+
+	t2m = bi_search4tag(specs->tag2el, specs->tag2el_count, tlv_tag);
+	if(!t2m) {
+		if(specs->extensible == 0) {
+			ASN_DEBUG("Unexpected tag %s in non-extensible SET %s",
+				ber_tlv_tag_string(tlv_tag), td->name);
+			BI_FAILED(e, td, ASN_DEC_ERROR_TAG);
+		}
+		return bi_skip(e, f, tag_len);
+	}
+
+	/*
+	 * Must not overwrite already decoded elements.
+	 */
+	edx = t2m->el_no;
+	if(ASN_SET_ISPRESENT2((char *)f->st + specs->pres_offset, edx)) {
+		ASN_DEBUG("SET %s: Duplicate element %s (%d)",
+			td->name, elements[edx].name, edx);
+		BI_FAILED(e, td, ASN_DEC_ERROR_TAG);
+	}
+
+	f->edx = edx;
+	if(elements[edx].flags & ATF_POINTER) {
+		memb_ptr2 = (void **)((char *)f->st + elements[edx].memb_offset);
+	} else {
+		memb_ptr = (char *)f->st + elements[edx].memb_offset;
+		memb_ptr2 = &memb_ptr;
+	}
+	return bi_member(e, elements[edx].type, memb_ptr2,
+		elements[edx].tag_mode);
+}
+
+static enum asn_dec_rval_code_e
+bi_choice(bi_engine_t *e, bi_frame_t *f) {
+	asn_TYPE_descriptor_t *td = f->td;
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elm;
+	asn_TYPE_tag2member_t *t2m;
+	ber_tlv_tag_t tlv_tag;
+	ssize_t tag_len;
+	void *memb_ptr;
+	void **memb_ptr2;
+
+	if(f->phase == 1) {
+		enum asn_dec_rval_code_e code;
+		code = bi_leftovers(e, f, 0);
+		if(code != RC_OK) return code;
+		return bi_pop(e);
+	}
+
+	tag_len = ber_fetch_tag(BI_AT(e), BI_LEFT(e, f), &tlv_tag);
+	switch(tag_len) {
+	case 0: return BI_MORE(f);
+	case -1: return RC_FAIL;
+	}
+
+	t2m = bi_search4tag(specs->tag2el, specs->tag2el_count, tlv_tag);
+	if(!t2m) {
+		enum asn_dec_rval_code_e code;
+		if(specs->ext_start == -1) {
+			ASN_DEBUG("Unexpected tag %s in non-extensible CHOICE %s",
+				ber_tlv_tag_string(tlv_tag), td->name);
+			BI_FAILED(e, td, ASN_DEC_ERROR_TAG);
+		}
+		/* The unknown extension leaves the CHOICE empty */
+		code = bi_skip(e, f, tag_len);
+		if(code != RC_OK) return code;
+		return bi_pop(e);
+	}
+
+	f->edx = t2m->el_no;
+	elm = &td->elements[f->edx];
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr2 = (void **)((char *)f->st + elm->memb_offset);
+	} else {
+		memb_ptr = (char *)f->st + elm->memb_offset;
+		memb_ptr2 = &memb_ptr;
+	}
+	/* Set presence to be able to free it properly at any time */
+	bi_set_present_idx(f->st, specs->pres_offset, specs->pres_size,
+		f->edx + 1);
+	return bi_member(e, elm->type, memb_ptr2, elm->tag_mode);
+}
+
+static enum asn_dec_rval_code_e
+bi_set_of(bi_engine_t *e, bi_frame_t *f) {
+	asn_TYPE_descriptor_t *td = f->td;
+	asn_SET_OF_specifics_t *specs = (asn_SET_OF_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elm = td->elements;	/* Single one */
+	asn_struct_ctx_t *ctx;
+	ber_tlv_tag_t tlv_tag;
+	ssize_t tag_len;
+
+	if(f->phase == 1) {
+		enum asn_dec_rval_code_e code;
+		code = bi_leftovers(e, f, 0);
+		if(code != RC_OK) return code;
+		return bi_pop(e);
+	}
+
+	if(e->pos == f->end) {
+		f->phase = 1;
+		return RC_OK;
+	}
+
+	tag_len = ber_fetch_tag(BI_AT(e), BI_LEFT(e, f), &tlv_tag);
+	switch(tag_len) {
+	case 0: return BI_MORE(f);
+	case -1: return RC_FAIL;
+	}
+
+	if(f->end == BI_INDEFINITE && BI_AT(e)[0] == 0) {
+		if(BI_LEFT(e, f) < 2)
+			return BI_MORE(f);
+		if(BI_AT(e)[1] == 0) {
+			f->phase = 1;
+			return RC_OK;
+		}
+	}
+
+	/* Outmost tag may be unknown and cannot be fetched/compared */
+	if(elm->tag != (ber_tlv_tag_t)-1
+	&& !BER_TAGS_EQUAL(tlv_tag, elm->tag)) {
+		ASN_DEBUG("Unexpected tag %s in %s, expected %s",
+			ber_tlv_tag_string(tlv_tag), td->name,
+			ber_tlv_tag_string(elm->tag));
+		BI_FAILED(e, td, ASN_DEC_ERROR_TAG);
+	}
+
+	/* The element being decoded is kept where SET_OF_free() sees it */
+	ctx = (asn_struct_ctx_t *)((char *)f->st + specs->ctx_offset);
+	return bi_member(e, elm->type, &ctx->ptr, 0);
+}
+
+/*
+ * Decode the member of the top frame (or the outermost type):
+ * the primitive one right away, the constructed one by opening its frame.
+ */
+static enum asn_dec_rval_code_e
+bi_member(bi_engine_t *e, asn_TYPE_descriptor_t *td,
+		void **memb_ptr2, int tag_mode) {
+	enum bi_kind kind = bi_kind_of(td);
+	asn_dec_rval_t rval;
+
+	if(kind != BI_LEAF)
+		return bi_push(e, td, kind, memb_ptr2, tag_mode);
+
+	rval = ASN_CODEC(td, ber_decoder)(e->codec_ctx, td, memb_ptr2, BI_AT(e),
+		(e->depth ? BI_TOP(e)->limit : e->size) - e->pos, tag_mode);
+	switch(rval.code) {
+	case RC_OK:
+		e->pos += rval.consumed;
+		return bi_member_done(e);
+	case RC_WMORE:
+		if(e->depth && BI_TOP(e)->limited) {
+			/* Overruns the enclosing length */
+			ASN_DEC_ERROR(e->codec_ctx, td, ASN_DEC_ERROR_LENGTH, 0);
+			return RC_FAIL;
+		}
+		return RC_WMORE;
+	default:
+		return RC_FAIL;
+	}
+}
+
+/*
+ * Record the path of the failure from the members being decoded
+ * by the frames, the innermost first. The failure occurred at (pos),
+ * within the top frame or its member being decoded.
+ */
+static void
+bi_failed(bi_engine_t *e) {
+	long offset = (long)e->pos;
+	size_t i = e->depth;
+
+	if(i && e->frame_failed) {
+		/* The path ends with the type of the frame */
+		e->opts->error->offset += offset;
+		offset = 0;
+		i--;
+	}
+
+	for(; i-- > 0; offset = 0) {
+		bi_frame_t *f = &e->frames[i];
+		asn_TYPE_member_t *elm;
+
+		if(f->kind == BI_SET_OF) {
+			ASN_DEC_ERROR_MEMBER(e->codec_ctx, f->td->elements->type,
+				0, _A_CSET_FROM_VOID(f->st)->count, offset);
+		} else if(f->edx >= 0 && f->edx < f->td->elements_count) {
+			elm = &f->td->elements[f->edx];
+			ASN_DEC_ERROR_MEMBER(e->codec_ctx, elm->type,
+				elm->name, -1, offset);
+		}
+	}
+}
+
+asn_dec_rval_t
+ber_decode_iterative(asn_codec_ctx_t *opt_codec_ctx,
+	asn_TYPE_descriptor_t *type_descriptor,
+	void **struct_ptr, const void *ptr, size_t size) {
+	asn_codec_ctx_t s_codec_ctx;
+	asn_mem_account_t account;
+	enum asn_dec_rval_code_e code;
+	asn_dec_rval_t rval;
+	bi_engine_t e;
+
+	/*
+	 * The primitive types are decoded by their own decoders,
+	 * which are still subject to the stack checks.
+	 */
+	if(opt_codec_ctx) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
+			s_codec_ctx = *opt_codec_ctx;
+			opt_codec_ctx = &s_codec_ctx;
+		}
+	} else {
+		memset(&s_codec_ctx, 0, sizeof(s_codec_ctx));
+		s_codec_ctx.max_stack_size = _ASN_DEFAULT_STACK_MAX;
+		opt_codec_ctx = &s_codec_ctx;
+	}
+
+	memset(&e, 0, sizeof(e));
+	e.codec_ctx = opt_codec_ctx;
+	e.opts = ASN_DEC_OPTS(opt_codec_ctx);
+	e.buf = (const uint8_t *)ptr;
+	e.size = size;
+	e.max_depth = (e.opts && e.opts->max_depth)
+		? e.opts->max_depth : _ASN_DEFAULT_DEPTH_MAX;
+
+	ASN_DEBUG("Iterative BER decoder invoked for %s",
+		type_descriptor->name);
+
+	ASN_DEC_ERROR_BEGIN(e.codec_ctx);
+	asn_mem__begin(&account, opt_codec_ctx, 0);
+	code = bi_member(&e, type_descriptor, struct_ptr, 0);
+	while(code == RC_OK && e.depth) {
+		bi_frame_t *f = BI_TOP(&e);
+		switch(f->kind) {
+		case BI_SEQUENCE: code = bi_sequence(&e, f); break;
+		case BI_SET: code = bi_set(&e, f); break;
+		case BI_CHOICE: code = bi_choice(&e, f); break;
+		case BI_SET_OF: code = bi_set_of(&e, f); break;
+		default: code = RC_FAIL;
+		}
+	}
+
+	if(code == RC_FAIL && e.opts && e.opts->error)
+		bi_failed(&e);
+
+	FREEMEM(e.frames);
+	asn_mem__end(&account);
+	ASN_DEC_ERROR_END(e.codec_ctx, type_descriptor, code, -1);
+
+	rval.code = code;
+	rval.consumed = (code == RC_WMORE) ? 0 : e.pos;
+	return rval;
+}
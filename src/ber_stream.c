@@ -0,0 +1,186 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <ber_stream.h>
+
+void
+ber_stream_init(ber_stream_t *bs, size_t max_pdu_size) {
+	memset(bs, 0, sizeof(*bs));
+	bs->max_pdu_size = max_pdu_size;
+}
+
+void
+ber_stream_free(ber_stream_t *bs) {
+	size_t max_pdu_size = bs->max_pdu_size;
+	FREEMEM(bs->buffer);
+	ber_stream_init(bs, max_pdu_size);
+}
+
+void *
+ber_stream_space(ber_stream_t *bs, size_t min_size, size_t *avail) {
+
+	if(bs->allocated - bs->end < min_size || !bs->buffer) {
+		size_t pending = bs->end - bs->start;
+
+		if(bs->allocated - pending >= min_size
+		&& pending < bs->allocated / 2) {
+			/* Move the incomplete tail to the front */
+			memmove(bs->buffer, bs->buffer + bs->start, pending);
+		} else {
+			size_t new_size = bs->allocated ? bs->allocated : 4096;
+			uint8_t *p;
+			while(new_size - pending < min_size) {
+				if(new_size > ((size_t)-1) / 2)
+					return NULL;
+				new_size <<= 1;
+			}
+			p = (uint8_t *)MALLOC(new_size);
+			if(!p) return NULL;
+			if(pending)
+				memcpy(p, bs->buffer + bs->start, pending);
+			FREEMEM(bs->buffer);
+			bs->buffer = p;
+			bs->allocated = new_size;
+		}
+		bs->start = 0;
+		bs->end = pending;
+	}
+
+	*avail = bs->allocated - bs->end;
+	return bs->buffer + bs->end;
+}
+
+void
+ber_stream_commit(ber_stream_t *bs, size_t size) {
+	assert(size <= bs->allocated - bs->end);
+	bs->end += size;
+}
+
+int
+ber_stream_feed(ber_stream_t *bs, const void *data, size_t size) {
+	size_t avail;
+	void *p;
+
+	if(!size) return 0;	/* Nothing to append */
+
+	p = ber_stream_space(bs, size, &avail);
+	if(!p) return -1;
+
+	memcpy(p, data, size);
+	bs->end += size;
+	return 0;
+}
+
+/*
+ * Scan the pending PDU of the indefinite length through
+ * for its end-of-content octets, from where the previous call stopped.
+ * Returns 1 with (bs->pdu_size) set, 0 if more data is needed, or -1.
+ */
+static int
+ber_stream__scan(ber_stream_t *bs, const uint8_t *ptr, size_t size) {
+	ber_tlv_len_t vlen;
+	ber_tlv_tag_t tag;
+	ssize_t tl, ll;
+
+	while(bs->scan_depth) {
+		const uint8_t *tlv = ptr + bs->scan_offset;
+		size_t left;
+
+		if(bs->scan_offset >= size)
+			return 0;	/* Want more */
+		left = size - bs->scan_offset;
+
+		tl = ber_fetch_tag(tlv, left, &tag);
+		if(tl <= 0) return tl;
+		ll = ber_fetch_length(BER_TLV_CONSTRUCTED(tlv),
+			tlv + tl, left - tl, &vlen);
+		if(ll <= 0) return ll;
+
+		if(vlen < 0) {
+			bs->scan_depth++;
+			vlen = 0;
+		} else if(tlv[0] == 0 && tlv[1] == 0) {
+			bs->scan_depth--;	/* End-of-content */
+		} else if((size_t)vlen > ((size_t)-1 >> 1)
+				- bs->scan_offset - tl - ll) {
+			return -1;
+		}
+
+		/* The contents of the definite length are skipped */
+		bs->scan_offset += tl + ll + vlen;
+	}
+
+	bs->pdu_size = bs->scan_offset;
+	bs->scan_offset = 0;
+	return 1;
+}
+
+int
+ber_stream_next(ber_stream_t *bs, const void **pdu_ptr, size_t *pdu_size) {
+	const uint8_t *ptr = bs->buffer + bs->start;
+	size_t size = bs->end - bs->start;
+	ber_tlv_len_t vlen;
+	ber_tlv_tag_t tag;
+	ssize_t tl, ll;
+
+	if(!bs->pdu_size) {
+		if(!bs->scan_depth) {
+			tl = ber_fetch_tag(ptr, size, &tag);
+			if(tl <= 0) return tl;
+			ll = ber_fetch_length(BER_TLV_CONSTRUCTED(ptr),
+				ptr + tl, size - tl, &vlen);
+			if(ll <= 0) return ll;
+
+			if(vlen >= 0) {
+				if((size_t)vlen > ((size_t)-1 >> 1) - tl - ll)
+					return -1;
+				bs->pdu_size = tl + ll + vlen;
+			} else {
+				/*
+				 * Indefinite length: the PDU has to be
+				 * scanned through for its end-of-content
+				 * octets, as far as the data goes each time.
+				 */
+				bs->scan_offset = tl + ll;
+				bs->scan_depth = 1;
+			}
+		}
+
+		if(bs->scan_depth) {
+			switch(ber_stream__scan(bs, ptr, size)) {
+			case 1:
+				break;
+			case 0:
+				if(!bs->max_pdu_size
+				|| (size <= bs->max_pdu_size
+				  && bs->scan_offset <= bs->max_pdu_size))
+					return 0;	/* Want more */
+				/* Fall through */
+			default:
+				bs->scan_offset = 0;
+				bs->scan_depth = 0;
+				return -1;
+			}
+		}
+
+		if(bs->max_pdu_size && bs->pdu_size > bs->max_pdu_size) {
+			ASN_DEBUG("PDU of %ld bytes exceeds the limit of %ld",
+				(long)bs->pdu_size, (long)bs->max_pdu_size);
+			bs->pdu_size = 0;
+			return -1;
+		}
+	}
+
+	if(size < bs->pdu_size)
+		return 0;	/* Want more */
+
+	*pdu_ptr = ptr;
+	*pdu_size = bs->pdu_size;
+	bs->start += bs->pdu_size;
+	bs->pdu_size = 0;
+	if(bs->start == bs->end)
+		bs->start = bs->end = 0;	/* Start over for free */
+
+	return 1;
+}
@@ -0,0 +1,107 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_BER_STREAM_H_
+#define	_BER_STREAM_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The framer splitting a byte stream (a TCP connection, a file)
+ * into the consecutive BER encoded PDUs.
+ * The PDU boundaries are found from the TLV headers, with the definite
+ * and the indefinite lengths alike; the complete PDUs are handed out
+ * in place, as spans of the stream's own buffer, ready for ber_decode().
+ * The consumed PDUs are never moved; the incomplete tail is moved
+ * to the front of the buffer only when there is no more room after it.
+ *
+ *	ber_stream_t bs;
+ *	ber_stream_init(&bs, 0);
+ *	while((buf = ber_stream_space(&bs, 4096, &avail))
+ *	   && (n = read(fd, buf, avail)) > 0) {
+ *		ber_stream_commit(&bs, n);
+ *		while(ber_stream_next(&bs, &pdu, &pdu_size) == 1)
+ *			ber_decode(0, &asn_DEF_PDU, &ptr, pdu, pdu_size);
+ *	}
+ *	ber_stream_free(&bs);
+ */
+typedef struct ber_stream_s {
+	uint8_t *buffer;	/* The data being framed */
+	size_t allocated;	/* The buffer size */
+	size_t start;		/* The beginning of the pending data */
+	size_t end;		/* The end of the pending data */
+
+	/*
+	 * The size of the pending PDU, once figured out from its
+	 * definite length, so it is not parsed again until it is complete.
+	 */
+	size_t pdu_size;
+	/*
+	 * The progress of scanning the pending PDU of the indefinite length
+	 * for its end: the offset of the next TLV and the number of the
+	 * constructs still open, so the data is not scanned again.
+	 */
+	size_t scan_offset;
+	size_t scan_depth;
+
+	size_t max_pdu_size;	/* The PDU size limit, 0 for none */
+} ber_stream_t;
+
+/*
+ * Initialize the framer. The PDUs larger than (max_pdu_size)
+ * are treated as the broken framing, 0 disables the check.
+ */
+void ber_stream_init(ber_stream_t *bs, size_t max_pdu_size);
+
+/*
+ * Release the buffer. The framer may be initialized again afterwards.
+ */
+void ber_stream_free(ber_stream_t *bs);
+
+/*
+ * Get the room for at least (min_size) bytes at the end of the data,
+ * to read() into directly. The actual room is returned in (*avail).
+ * Invalidates the PDU spans given out before.
+ * Returns NULL if out of memory.
+ */
+void *ber_stream_space(ber_stream_t *bs, size_t min_size, size_t *avail);
+
+/*
+ * Append the (size) bytes just written into the room given
+ * by ber_stream_space().
+ */
+void ber_stream_commit(ber_stream_t *bs, size_t size);
+
+/*
+ * Append the (size) bytes copied from (data).
+ * Invalidates the PDU spans given out before.
+ * Returns 0 or -1 if out of memory.
+ */
+int ber_stream_feed(ber_stream_t *bs, const void *data, size_t size);
+
+/*
+ * Take the next complete PDU off the stream.
+ * The span stays valid until the next ber_stream_space(),
+ * ber_stream_feed() or ber_stream_free() call.
+ * RETURN VALUES:
+ *	 1:	The PDU is placed in (*pdu_ptr) and (*pdu_size).
+ *	 0:	More data expected.
+ *	-1:	The stream does not hold the valid BER framing
+ *		or the PDU exceeds the size limit.
+ */
+int ber_stream_next(ber_stream_t *bs, const void **pdu_ptr, size_t *pdu_size);
+
+/*
+ * The number of bytes received but not yet handed out.
+ */
+#define	ber_stream_pending(bs)	((bs)->end - (bs)->start)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _BER_STREAM_H_ */
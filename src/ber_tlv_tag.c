@@ -92,7 +92,12 @@ ber_tlv_tag_snprint(ber_tlv_tag_t tag, char *buf, size_t size) {
 
 char *
 ber_tlv_tag_string(ber_tlv_tag_t tag) {
+#ifdef	ASN_THREAD_LOCAL
+	/* Each thread gets its own buffer */
+	static ASN_THREAD_LOCAL char buf[sizeof("[APPLICATION ]") + 32];
+#else
 	static char buf[sizeof("[APPLICATION ]") + 32];
+#endif
 
 	(void)ber_tlv_tag_snprint(tag, buf, sizeof(buf));
 
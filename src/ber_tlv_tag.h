@@ -30,6 +30,8 @@ typedef unsigned ber_tlv_tag_t;	/* BER TAG from Tag-Length-Value */
  * Several functions for printing the TAG in the canonical form
  * (i.e. "[PRIVATE 0]").
  * Return values correspond to their libc counterparts (if any).
+ * The ber_tlv_tag_string() result lives in a static buffer, overwritten
+ * by the next call; the buffer is per-thread where ASN_THREAD_LOCAL is known.
  */
 ssize_t ber_tlv_tag_snprint(ber_tlv_tag_t tag, char *buf, size_t buflen);
 ssize_t ber_tlv_tag_fwrite(ber_tlv_tag_t tag, FILE *);
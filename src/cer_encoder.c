@@ -0,0 +1,259 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <errno.h>
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <GeneralizedTime.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SEQUENCE_OF.h>
+#include <constr_SET_OF.h>
+
+/*
+ * The runtime's CER encoders matched by the DER encoder of the type.
+ */
+static const struct {
+	der_type_encoder_f *der_encoder;
+	cer_type_encoder_f *cer_encoder;
+} cer_encoders[] = {
+	{ OCTET_STRING_encode_der,	OCTET_STRING_encode_cer },
+	{ SEQUENCE_encode_der,		SEQUENCE_encode_cer },
+	{ SET_encode_der,		SET_encode_cer },
+	{ CHOICE_encode_der,		CHOICE_encode_cer },
+	{ SEQUENCE_OF_encode_der,	SEQUENCE_OF_encode_cer },
+	{ SET_OF_encode_der,		SET_OF_encode_cer },
+	/* CER and DER encodings of the primitive types are the same */
+	{ der_encode_primitive,		cer_encode_via_der },
+	{ INTEGER_encode_der,		cer_encode_via_der },
+	{ NativeInteger_encode_der,	cer_encode_via_der },
+	{ BOOLEAN_encode_der,		cer_encode_via_der },
+	{ NULL_encode_der,		cer_encode_via_der },
+	{ NativeReal_encode_der,	cer_encode_via_der },
+	{ GeneralizedTime_encode_der,	cer_encode_via_der }
+};
+
+cer_type_encoder_f *
+cer_type_encoder(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	do {
+		for(i = 0; i < sizeof(cer_encoders)/sizeof(cer_encoders[0]); i++) {
+			if(cer_encoders[i].der_encoder == td->der_encoder)
+				return cer_encoders[i].cer_encoder;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	/* Unknown types are supposed to be primitive */
+	return cer_encode_via_der;
+}
+
+/*
+ * The CER encoder of any type. May be invoked by the application.
+ */
+asn_enc_rval_t
+cer_encode(asn_TYPE_descriptor_t *td, void *sptr,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_output_buffer_t ob;
+	asn_enc_rval_t er;
+
+	if(!td || !sptr || !cb) _ASN_ENCODE_FAILED;
+
+	ASN_DEBUG("CER encoder invoked for %s", td->name);
+
+	/* Coalesce the small pieces as xer_encode() does */
+	asn_output_buffer_init(&ob, cb, app_key);
+	er = cer_type_encoder(td)(td, sptr, 0, 0,
+		asn_output_buffer_consume, &ob);
+	if(er.encoded == -1) {
+		(void)asn_output_buffer_flush(&ob);
+		return er;
+	}
+	if(asn_output_buffer_flush(&ob))
+		_ASN_ENCODE_FAILED;
+
+	return er;
+}
+
+/*
+ * The number of tags written for the type, as der_write_tags() counts them.
+ */
+static int
+cer__tags_count(asn_TYPE_descriptor_t *td, int tag_mode) {
+	if(tag_mode)
+		return td->tags_count + 1
+			- ((tag_mode == -1) && td->tags_count);
+	return td->tags_count;
+}
+
+ssize_t
+cer_write_tags(asn_TYPE_descriptor_t *sd,
+		size_t struct_length,
+		int tag_mode, int last_tag_form,
+		ber_tlv_tag_t tag,	/* EXPLICIT or IMPLICIT tag */
+		asn_app_consume_bytes_f *cb,
+		void *app_key) {
+	int tags_count = cer__tags_count(sd, tag_mode);
+	size_t overall_length = 0;
+	int i;
+
+	for(i = 0; i < tags_count; i++) {
+		ber_tlv_tag_t t;
+		uint8_t buf[32];
+		ssize_t tsize;
+		ssize_t lsize;
+
+		/* The given tag replaces or precedes those of the type */
+		if(tag_mode && i == 0)
+			t = tag;
+		else
+			t = sd->tags[i - (tag_mode == 1
+				|| (tag_mode == -1 && !sd->tags_count))];
+
+		tsize = ber_tlv_tag_serialize(t, buf, sizeof(buf));
+		if(tsize == -1 || tsize >= (ssize_t)sizeof(buf))
+			return -1;
+
+		if(last_tag_form || i < tags_count - 1) {
+			buf[0] |= 0x20;		/* Constructed */
+			buf[tsize] = 0x80;	/* Indefinite length */
+			lsize = 1;
+		} else {
+			lsize = der_tlv_length_serialize(struct_length,
+				buf + tsize, sizeof(buf) - tsize);
+			if(lsize == -1 || lsize > (ssize_t)sizeof(buf) - tsize)
+				return -1;
+		}
+
+		if(cb(buf, tsize + lsize, app_key) < 0)
+			return -1;
+		overall_length += tsize + lsize;
+	}
+
+	return overall_length;
+}
+
+ssize_t
+cer_write_eocs(asn_TYPE_descriptor_t *sd,
+		int tag_mode, int last_tag_form,
+		asn_app_consume_bytes_f *cb,
+		void *app_key) {
+	static const uint8_t eocs[16];
+	int tags_count = cer__tags_count(sd, tag_mode);
+	size_t size;
+	size_t left;
+
+	if(tags_count && !last_tag_form)
+		tags_count--;	/* The last one is not indefinite */
+
+	size = 2 * tags_count;
+	for(left = size; left; ) {
+		size_t n = left < sizeof(eocs) ? left : sizeof(eocs);
+		if(cb(eocs, n, app_key) < 0)
+			return -1;
+		left -= n;
+	}
+
+	return size;
+}
+
+/*
+ * Argument type and callback necessary for cer_encode_via_der().
+ */
+typedef struct enc_to_buf_arg {
+	void *buffer;
+	size_t left;
+} enc_to_buf_arg;
+static int encode_to_buffer_cb(const void *buffer, size_t size, void *key) {
+	enc_to_buf_arg *arg = (enc_to_buf_arg *)key;
+
+	if(arg->left < size)
+		return -1;	/* Data exceeds the available buffer size */
+
+	memcpy(arg->buffer, buffer, size);
+	arg->buffer = ((char *)arg->buffer) + size;
+	arg->left -= size;
+
+	return 0;
+}
+
+asn_enc_rval_t
+cer_encode_via_der(asn_TYPE_descriptor_t *td, void *sptr,
+		int tag_mode, ber_tlv_tag_t tag,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	int outer = cer__tags_count(td, tag_mode) - 1;
+	uint8_t scratch[64];
+	enc_to_buf_arg arg;
+	asn_enc_rval_t er;
+	const uint8_t *p;
+	uint8_t *buf;
+	size_t left;
+	ssize_t ret;
+	int i;
+
+	/* A single tag is written the same way by both */
+	if(outer <= 0)
+		return ASN_CODEC(td, der_encoder)(td, sptr, tag_mode, tag,
+			cb, app_key);
+
+	/*
+	 * Have the DER encoding of the value at hand,
+	 * then rewrite its outer lengths as indefinite ones.
+	 */
+	er = ASN_CODEC(td, der_encoder)(td, sptr, tag_mode, tag, 0, 0);
+	if(er.encoded == -1)
+		return er;
+	if((size_t)er.encoded <= sizeof(scratch)) {
+		buf = scratch;
+	} else {
+		buf = (uint8_t *)MALLOC(er.encoded);
+		if(!buf) _ASN_ENCODE_FAILED;
+	}
+	arg.buffer = buf;
+	arg.left = er.encoded;
+	er = ASN_CODEC(td, der_encoder)(td, sptr, tag_mode, tag,
+		encode_to_buffer_cb, &arg);
+	if(er.encoded == -1) {
+		if(buf != scratch) FREEMEM(buf);
+		return er;
+	}
+
+	p = buf;
+	left = er.encoded - arg.left;
+	er.encoded = 0;
+	for(i = 0; i < outer; i++) {
+		ber_tlv_tag_t t;
+		ber_tlv_len_t len;
+		ssize_t tsize;
+		ssize_t lsize;
+
+		tsize = ber_fetch_tag(p, left, &t);
+		if(tsize <= 0) goto cb_failed;
+		lsize = ber_fetch_length(1, p + tsize, left - tsize, &len);
+		if(lsize <= 0) goto cb_failed;
+
+		_ASN_CALLBACK2(p, tsize, "\200", 1);
+		er.encoded += tsize + 1;
+		p += tsize + lsize;
+		left -= tsize + lsize;
+	}
+
+	_ASN_CALLBACK(p, left);
+	er.encoded += left;
+
+	ret = cer_write_eocs(td, tag_mode, 0, cb, app_key);
+	if(ret == -1) goto cb_failed;
+	er.encoded += ret;
+
+	if(buf != scratch) FREEMEM(buf);
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	if(buf != scratch) FREEMEM(buf);
+	_ASN_ENCODE_FAILED;
+}
@@ -0,0 +1,93 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_CER_ENCODER_H_
+#define	_CER_ENCODER_H_
+
+#include <asn_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/*
+ * The CER (Canonical Encoding Rules) encoder of any type.
+ * May be invoked by the application.
+ * The constructed encodings use the indefinite length form and the strings
+ * longer than 1000 octets are split into 1000-octet segments (X.690 #9),
+ * so nothing is measured up front and the output is streamed as it goes.
+ * The SET OF elements still have to be encoded and sorted beforehand.
+ */
+asn_enc_rval_t cer_encode(struct asn_TYPE_descriptor_s *type_descriptor,
+		void *struct_ptr,	/* Structure to be encoded */
+		asn_app_consume_bytes_f *consume_bytes_cb,
+		void *app_key		/* Arbitrary callback argument */
+	);
+
+/*
+ * Type of the generic CER encoder; the arguments are those of the DER one.
+ * Unlike the DER encoders, the CER ones never estimate: (cb) is mandatory.
+ */
+typedef asn_enc_rval_t (cer_type_encoder_f)(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		void *struct_ptr,	/* Structure to be encoded */
+		int tag_mode,		/* {-1,0,1}: IMPLICIT, no, EXPLICIT */
+		ber_tlv_tag_t tag,
+		asn_app_consume_bytes_f *consume_bytes_cb,	/* Callback */
+		void *app_key		/* Arbitrary callback argument */
+	);
+
+
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * Get the CER encoder of the type, matched by its DER encoder.
+ * The types whose CER and DER encodings coincide (the primitive ones)
+ * are served by cer_encode_via_der().
+ */
+cer_type_encoder_f *cer_type_encoder(struct asn_TYPE_descriptor_s *td);
+
+/*
+ * Encode the type with its DER encoder, turning its outer EXPLICIT tags
+ * into the constructed indefinite length form.
+ */
+cer_type_encoder_f cer_encode_via_der;
+
+/*
+ * Write out the leading tags according to the type definition, all of them
+ * in the constructed indefinite length form, except for the last one
+ * if (last_tag_form) is 0: that one is primitive of the (struct_length).
+ * Returns the number of bytes written or -1.
+ */
+ssize_t cer_write_tags(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		size_t struct_length,
+		int tag_mode,		/* {-1,0,1}: IMPLICIT, no, EXPLICIT */
+		int last_tag_form,	/* {0,!0}: prim, constructed */
+		ber_tlv_tag_t tag,
+		asn_app_consume_bytes_f *consume_bytes_cb,
+		void *app_key
+	);
+
+/*
+ * Write out the end-of-contents octets closing the indefinite lengths
+ * opened by cer_write_tags() invoked with the same arguments.
+ * Returns the number of bytes written or -1.
+ */
+ssize_t cer_write_eocs(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		int tag_mode,		/* {-1,0,1}: IMPLICIT, no, EXPLICIT */
+		int last_tag_form,	/* {0,!0}: prim, constructed */
+		asn_app_consume_bytes_f *consume_bytes_cb,
+		void *app_key
+	);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _CER_ENCODER_H_ */
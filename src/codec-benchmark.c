@@ -0,0 +1,489 @@
+/*
+ * Benchmark of the runtime codecs over a few representative PDUs.
+ * Redistribution and modifications are permitted subject to BSD license.
+ *
+ * The types are built by hand in codec-samples.h, the way asn1c would
+ * generate them, so the benchmark needs nothing but the runtime library:
+ *
+ * cc -O2 -I../include -o codec-benchmark codec-benchmark.c -L<dir> -lasn1 -lm
+ *
+ * Every PDU is measured with the BER decoder, the DER encoder and the
+ * round-trips (encoding followed by decoding) of the other rules.
+ * Reported are the time and the throughput per PDU, the number of heap
+ * allocations per PDU and the peak resident set size of the process.
+ * The -j option prints one JSON object per line instead of the table,
+ * for the results to be collected and compared over time.
+ * The -c option replays the regression corpus of codec-fuzzer.c instead,
+ * measuring the decoding of each input the same way.
+ */
+#ifdef	HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <stdio.h>
+#include <sys/types.h>
+#include <stdlib.h>	/* for atoi(3) */
+#include <unistd.h>	/* for getopt(3) */
+#include <string.h>	/* for strstr(3) */
+#include <sysexits.h>	/* for EX_* exit codes */
+#include <time.h>	/* for clock_gettime(2) */
+#include <dirent.h>	/* for opendir(3) */
+#ifdef	_WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>	/* for getrusage(2) */
+#endif
+
+#include "codec-samples.h"
+#include <asn_internal.h>	/* for _ASN_DEFAULT_STACK_MAX */
+
+/*
+ * Count the heap allocations by interposing the allocator,
+ * which the GNU C library explicitly supports.
+ */
+#if	defined(__GLIBC__) && !defined(BENCH_NO_ALLOC_COUNT)
+#define	BENCH_ALLOC_COUNT
+static unsigned long allocations;
+extern void *__libc_malloc(size_t);
+extern void *__libc_calloc(size_t, size_t);
+extern void *__libc_realloc(void *, size_t);
+extern void __libc_free(void *);
+void *malloc(size_t size) {
+	allocations++;
+	return __libc_malloc(size);
+}
+void *calloc(size_t nmemb, size_t size) {
+	allocations++;
+	return __libc_calloc(nmemb, size);
+}
+void *realloc(void *ptr, size_t size) {
+	allocations++;
+	return __libc_realloc(ptr, size);
+}
+void free(void *ptr) {
+	__libc_free(ptr);
+}
+#endif
+
+/*
+ * The operations measured over each PDU.
+ */
+static const struct bench_op {
+	const char *name;
+	enum bench_op_kind {
+		BOP_DECODE,	/* Decoding of the prepared encoding */
+		BOP_ENCODE,	/* Encoding into the reused buffer */
+		BOP_ROUNDTRIP,	/* Encoding followed by decoding */
+		BOP_REPLAY	/* Decoding of a corpus input, failing or not */
+	} kind;
+	enum asn_transfer_syntax syntax;
+} bench_ops[] = {
+	{ "ber-decode",		BOP_DECODE,	ATS_BER },
+	{ "der-encode",		BOP_ENCODE,	ATS_DER },
+	{ "cer-roundtrip",	BOP_ROUNDTRIP,	ATS_CER },
+	{ "xer-roundtrip",	BOP_ROUNDTRIP,	ATS_BASIC_XER },
+	{ "jer-roundtrip",	BOP_ROUNDTRIP,	ATS_MINIFIED_JER },
+	{ "oer-roundtrip",	BOP_ROUNDTRIP,	ATS_BASIC_OER },
+	{ "uper-roundtrip",	BOP_ROUNDTRIP,	ATS_UNALIGNED_PER }
+};
+
+/*
+ * The growing buffer collecting the encoding.
+ */
+typedef struct bench_buffer {
+	uint8_t *buf;
+	size_t size;
+	size_t allocated;
+} bench_buffer_t;
+
+static int
+bench_buffer_consume(const void *buffer, size_t size, void *key) {
+	bench_buffer_t *bb = (bench_buffer_t *)key;
+
+	if(bb->size + size > bb->allocated) {
+		size_t allocated = bb->allocated ? bb->allocated : 4096;
+		void *p;
+		while(allocated < bb->size + size)
+			allocated <<= 1;
+		p = realloc(bb->buf, allocated);
+		if(!p) return -1;
+		bb->buf = (uint8_t *)p;
+		bb->allocated = allocated;
+	}
+
+	memcpy(bb->buf + bb->size, buffer, size);
+	bb->size += size;
+	return 0;
+}
+
+static double
+bench_now(void) {
+#ifdef	_WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double)count.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+/*
+ * Peak resident set size in kilobytes, or -1 if unknown.
+ */
+static long
+bench_peak_rss(void) {
+#ifdef	_WIN32
+	return -1;
+#else
+	struct rusage ru;
+	if(getrusage(RUSAGE_SELF, &ru))
+		return -1;
+#ifdef	__APPLE__
+	return ru.ru_maxrss / 1024;	/* Reported in bytes */
+#else
+	return ru.ru_maxrss;
+#endif
+#endif
+}
+
+#define	BENCH_REPLAY_MEMORY	(256 * 1024 * 1024)
+
+/*
+ * A single run of the operation over the PDU.
+ * Returns the size of the encoding involved or -1.
+ */
+static ssize_t
+bench_run_once(const struct bench_op *op, asn_TYPE_descriptor_t *td,
+		void *pdu, bench_buffer_t *encoded, bench_buffer_t *scratch) {
+	asn_dec_opts_t opts;
+	asn_enc_rval_t er;
+	asn_dec_rval_t rval;
+	void *decoded = 0;
+
+	switch(op->kind) {
+	case BOP_DECODE:
+		rval = asn_decode(0, op->syntax, td, &decoded,
+			encoded->buf, encoded->size);
+		ASN_STRUCT_FREE(*td, decoded);
+		if(rval.code != RC_OK) return -1;
+		return encoded->size;
+	case BOP_ENCODE:
+		scratch->size = 0;
+		er = asn_encode(op->syntax, td, pdu,
+			bench_buffer_consume, scratch);
+		if(er.encoded == -1) return -1;
+		return scratch->size;
+	case BOP_ROUNDTRIP:
+		scratch->size = 0;
+		er = asn_encode(op->syntax, td, pdu,
+			bench_buffer_consume, scratch);
+		if(er.encoded == -1) return -1;
+		rval = asn_decode(0, op->syntax, td, &decoded,
+			scratch->buf, scratch->size);
+		ASN_STRUCT_FREE(*td, decoded);
+		if(rval.code != RC_OK) return -1;
+		return scratch->size;
+	case BOP_REPLAY:
+		/* The inputs are hostile, so the limits are on */
+		memset(&opts, 0, sizeof(opts));
+		opts.max_stack_size = _ASN_DEFAULT_STACK_MAX;
+		opts.max_memory = BENCH_REPLAY_MEMORY;
+		(void)asn_decode_ext(&opts, op->syntax, td, &decoded,
+			encoded->buf, encoded->size);
+		ASN_STRUCT_FREE(*td, decoded);
+		return encoded->size;
+	}
+
+	return -1;
+}
+
+static int opt_json;		/* -j: JSON lines output */
+static double opt_time = 200;	/* -t: milliseconds per measurement */
+static int opt_width = 16;	/* Width of the case column */
+
+static void
+bench_report(const char *case_name, const struct bench_op *op,
+		ssize_t size, unsigned long iterations,
+		double elapsed, double allocs) {
+	double ns = iterations ? elapsed / iterations : 0;
+	double mbps = elapsed > 0
+		? ((double)size * iterations / (1024.0 * 1024.0))
+			/ (elapsed / 1e9) : 0;
+
+	if(opt_json) {
+		if(size < 0) {
+			printf("{\"case\":\"%s\",\"op\":\"%s\","
+				"\"status\":\"unsupported\"}\n",
+				case_name, op->name);
+			return;
+		}
+		printf("{\"case\":\"%s\",\"op\":\"%s\",\"status\":\"ok\","
+			"\"bytes\":%ld,\"iterations\":%lu,"
+			"\"ns_per_pdu\":%.1f,\"mb_per_s\":%.2f,",
+			case_name, op->name, (long)size, iterations, ns, mbps);
+		if(allocs < 0)
+			printf("\"allocs_per_pdu\":null,");
+		else
+			printf("\"allocs_per_pdu\":%.2f,", allocs);
+		printf("\"peak_rss_kb\":%ld}\n", bench_peak_rss());
+	} else {
+		if(size < 0) {
+			printf("%-*s%-16s%10s\n", opt_width, case_name, op->name,
+				"unsupported");
+			return;
+		}
+		printf("%-*s%-16s%10ld%14.1f%10.2f",
+			opt_width, case_name, op->name, (long)size, ns, mbps);
+		if(allocs < 0)
+			printf("%12s\n", "n/a");
+		else
+			printf("%12.2f\n", allocs);
+	}
+}
+
+static void
+bench_measure(const struct codec_sample *bc, const struct bench_op *op,
+		void *pdu, bench_buffer_t *der, bench_buffer_t *scratch) {
+	unsigned long iterations = 0;
+#ifdef	BENCH_ALLOC_COUNT
+	unsigned long allocs;
+#endif
+	double start, elapsed;
+	ssize_t size;
+
+	/* Warm up and check the operation is supported at all */
+	size = bench_run_once(op, bc->td, pdu, der, scratch);
+	if(size < 0) {
+		bench_report(bc->name, op, -1, 0, 0, 0);
+		return;
+	}
+
+#ifdef	BENCH_ALLOC_COUNT
+	allocs = allocations;
+#endif
+	start = bench_now();
+	do {
+		(void)bench_run_once(op, bc->td, pdu, der, scratch);
+		iterations++;
+		elapsed = bench_now() - start;
+	} while(elapsed < opt_time * 1e6);
+#ifdef	BENCH_ALLOC_COUNT
+	allocs = allocations - allocs;
+#endif
+
+	bench_report(bc->name, op, size, iterations, elapsed,
+#ifdef	BENCH_ALLOC_COUNT
+		(double)allocs / iterations
+#else
+		-1
+#endif
+		);
+}
+
+static int
+bench_name_cmp(const void *a, const void *b) {
+	return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/*
+ * Replay the corpus of the inputs which codec-fuzzer found to take
+ * pathological time or memory to decode, named after the sample and
+ * the syntax, as in "slow-deep-nesting-ber-<hash>".
+ */
+static void
+bench_replay(const char *dirname, int ac, char *av[],
+		bench_buffer_t *input, bench_buffer_t *scratch) {
+	char **names = 0;
+	size_t names_count = 0;
+	struct dirent *de;
+	DIR *dir;
+	size_t n, i, j;
+
+	dir = opendir(dirname);
+	if(!dir) {
+		perror(dirname);
+		exit(EX_NOINPUT);
+	}
+	while((de = readdir(dir))) {
+		char **p;
+		if(de->d_name[0] == '.') continue;
+		p = (char **)realloc(names, (names_count + 1) * sizeof(*names));
+		if(!p || !(p[names_count] = strdup(de->d_name))) {
+			perror("realloc");
+			exit(EX_OSERR);
+		}
+		names = p;
+		names_count++;
+	}
+	closedir(dir);
+	if(names_count)
+		qsort(names, names_count, sizeof(*names), bench_name_cmp);
+
+	for(n = 0; n < names_count; n++) {
+		const struct codec_sample *sample = 0;
+		const struct codec_syntax *syntax = 0;
+		struct codec_sample replay_case;
+		struct bench_op replay_op;
+		char path[512];
+		char op_name[32];
+		char buf[4096];
+		size_t got;
+		FILE *fp;
+
+		for(i = 0; !sample && i < CODEC_SAMPLES_COUNT; i++)
+		for(j = 0; j < CODEC_SYNTAXES_COUNT; j++) {
+			char pattern[64];
+			snprintf(pattern, sizeof(pattern), "-%s-%s-",
+				codec_samples[i].name, codec_syntaxes[j].name);
+			if(strstr(names[n], pattern)) {
+				sample = &codec_samples[i];
+				syntax = &codec_syntaxes[j];
+				break;
+			}
+		}
+		if(!sample) continue;	/* Not an input */
+
+		if(ac) {
+			int k;
+			for(k = 0; k < ac; k++)
+				if(strstr(names[n], av[k])) break;
+			if(k == ac) continue;
+		}
+
+		snprintf(path, sizeof(path), "%s/%s", dirname, names[n]);
+		fp = fopen(path, "rb");
+		if(!fp) {
+			perror(path);
+			exit(EX_NOINPUT);
+		}
+		input->size = 0;
+		while((got = fread(buf, 1, sizeof(buf), fp)))
+			if(bench_buffer_consume(buf, got, input)) {
+				perror(path);
+				exit(EX_OSERR);
+			}
+		fclose(fp);
+
+		replay_case = *sample;
+		replay_case.name = names[n];
+		snprintf(op_name, sizeof(op_name), "%s-replay", syntax->name);
+		replay_op.name = op_name;
+		replay_op.kind = BOP_REPLAY;
+		replay_op.syntax = syntax->syntax;
+		bench_measure(&replay_case, &replay_op, 0, input, scratch);
+	}
+
+	for(n = 0; n < names_count; n++)
+		free(names[n]);
+	free(names);
+}
+
+static void
+usage(const char *av0) {
+	fprintf(stderr,
+"Usage: %s [options] [case ...]\n"
+"Options:\n"
+"  -j           Print the results as JSON lines\n"
+"  -t <ms>      Time to spend on each measurement (default %g)\n"
+"  -l           List the cases and the operations\n"
+"  -c <dir>     Replay the corpus of codec-fuzzer instead of the cases\n"
+"The cases (or the corpus files) are selected by the substrings\n"
+"of their names.\n",
+	av0, opt_time);
+	exit(EX_USAGE);
+}
+
+int
+main(int ac, char *av[]) {
+	bench_buffer_t der;
+	bench_buffer_t scratch;
+	const char *corpus = 0;
+	size_t i, j;
+	int ch;
+
+	while((ch = getopt(ac, av, "c:jlt:h")) != -1)
+	switch(ch) {
+	case 'c':
+		corpus = optarg;
+		opt_width = 44;	/* Fits "<kind>-<sample>-<syntax>-<hash>" */
+		break;
+	case 'j':
+		opt_json = 1;
+		break;
+	case 'l':
+		for(i = 0; i < CODEC_SAMPLES_COUNT; i++)
+			printf("case %s (%s)\n", codec_samples[i].name,
+				codec_samples[i].td->name);
+		for(i = 0; i < sizeof(bench_ops)/sizeof(bench_ops[0]); i++)
+			printf("op %s\n", bench_ops[i].name);
+		exit(0);
+	case 't':
+		opt_time = atof(optarg);
+		if(opt_time <= 0) {
+			fprintf(stderr, "-t %s: positive number expected\n",
+				optarg);
+			exit(EX_USAGE);
+		}
+		break;
+	case 'h':
+	default:
+		usage(av[0]);
+	}
+	ac -= optind;
+	av += optind;
+
+	memset(&der, 0, sizeof(der));
+	memset(&scratch, 0, sizeof(scratch));
+
+	if(!opt_json)
+		printf("%-*s%-16s%10s%14s%10s%12s\n", opt_width, "case", "op",
+			"bytes", "ns/PDU", "MB/s", "allocs/PDU");
+
+	if(corpus)
+		bench_replay(corpus, ac, av, &der, &scratch);
+
+	for(i = 0; !corpus && i < CODEC_SAMPLES_COUNT; i++) {
+		const struct codec_sample *bc = &codec_samples[i];
+		asn_enc_rval_t er;
+		void *pdu;
+
+		if(ac) {
+			int k;
+			for(k = 0; k < ac; k++)
+				if(strstr(bc->name, av[k])) break;
+			if(k == ac) continue;
+		}
+
+		pdu = bc->build();
+		if(!pdu) {
+			fprintf(stderr, "%s: cannot build the PDU\n", bc->name);
+			exit(EX_OSERR);
+		}
+
+		/* The input for the decoders */
+		der.size = 0;
+		er = asn_encode(ATS_DER, bc->td, pdu,
+			bench_buffer_consume, &der);
+		if(er.encoded == -1) {
+			fprintf(stderr, "%s: cannot encode the PDU\n", bc->name);
+			exit(EX_SOFTWARE);
+		}
+
+		for(j = 0; j < sizeof(bench_ops)/sizeof(bench_ops[0]); j++)
+			bench_measure(bc, &bench_ops[j], pdu, &der, &scratch);
+
+		ASN_STRUCT_FREE(*bc->td, pdu);
+	}
+
+	if(opt_json)
+		printf("{\"peak_rss_kb\":%ld}\n", bench_peak_rss());
+	else
+		printf("Peak RSS: %ld kB\n", bench_peak_rss());
+
+	free(der.buf);
+	free(scratch.buf);
+
+	return 0;
+}
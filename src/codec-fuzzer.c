@@ -0,0 +1,736 @@
+/*
+ * Fuzzing of the runtime decoders for crashes and pathological inputs.
+ * Redistribution and modifications are permitted subject to BSD license.
+ *
+ * The sample types of codec-samples.h are encoded and the encodings are
+ * mutated the way libFuzzer does (bit flips, interesting bytes, insertion,
+ * deletion, duplication and repetition of the chunks, splicing of the
+ * other seeds), to be fed to ber_decode(), xer_decode(), uper_decode()
+ * and the other decoders through asn_decode_ext(). It is best built with
+ * the sanitizers:
+ *
+ * cc -g -O1 -fsanitize=address,undefined -I../include \
+ *	-o codec-fuzzer codec-fuzzer.c -L<dir> -lasn1 -lm
+ *
+ * Three kinds of inputs are saved into the output directory (-o), named
+ * "<kind>-<sample>-<syntax>-<hash>":
+ *   crash	the input the process died on, written from the signal
+ *		handler (or the sanitizer's death callback);
+ *   slow	the input taking (-f) times longer per byte to decode than
+ *		the seed, plus (-F) milliseconds;
+ *   memory	the input making the decoder hold (-f) times more memory
+ *		per byte than the seed, plus (-m) kilobytes, at once.
+ * The slow and memory inputs are minimized first. Kept together, they
+ * make the regression corpus replayed by "codec-benchmark -c <dir>".
+ *
+ * Built with -DCODEC_FUZZER_LIBFUZZER and -fsanitize=fuzzer, the program
+ * is the target of libFuzzer instead, taking the sample and the syntax
+ * from the first byte of the input; "codec-fuzzer -w <dir>" writes the
+ * seed corpus for it.
+ */
+#ifdef	HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <stdio.h>
+#include <sys/types.h>
+#include <stdlib.h>	/* for atoi(3) */
+#include <unistd.h>	/* for getopt(3) */
+#include <string.h>	/* for strstr(3) */
+#include <sysexits.h>	/* for EX_* exit codes */
+#include <time.h>	/* for clock_gettime(2) */
+#include <fcntl.h>	/* for open(2) */
+#include <signal.h>	/* for sigaction(2) */
+#ifdef	_WIN32
+#include <windows.h>
+#endif
+
+#include "codec-samples.h"
+#include <asn_internal.h>	/* for _ASN_DEFAULT_STACK_MAX */
+
+/*
+ * The pair of the sample and the syntax being fuzzed.
+ */
+#define	FUZZ_POOL_SIZE	16
+typedef struct fuzz_target {
+	const struct codec_sample *sample;
+	const struct codec_syntax *syntax;
+	uint8_t *seed;		/* Encoding of the sample */
+	size_t seed_size;
+	double ns_per_byte;	/* Decoding time of the seed */
+	double peak_per_byte;	/* Memory held by the decoder of the seed */
+	/*
+	 * The inputs to mutate: the seed, and then the ones which
+	 * took the longest to decode per byte so far.
+	 */
+	struct fuzz_input {
+		uint8_t *buf;
+		size_t size;
+		double score;
+	} pool[FUZZ_POOL_SIZE];
+	size_t pool_count;
+} fuzz_target_t;
+
+enum fuzz_finding {
+	FF_NONE,	/* Nothing unusual */
+	FF_SLOW,	/* Decoding took too long */
+	FF_MEMORY	/* Decoding needed too much memory */
+};
+static const char *fuzz_finding_names[] = { "none", "slow", "memory" };
+
+static size_t opt_stack = _ASN_DEFAULT_STACK_MAX;	/* -S */
+
+static double
+fuzz_now(void) {
+#ifdef	_WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double)count.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+/*
+ * The input being decoded, for it to be saved if the decoder crashes.
+ */
+static struct {
+	const fuzz_target_t *target;
+	const uint8_t *buf;
+	size_t size;
+} fuzz_current;
+
+/*
+ * A single decoding of the input, freeing the result.
+ * Returns the time it took, in nanoseconds.
+ */
+static double
+fuzz_decode(const fuzz_target_t *t, const uint8_t *buf, size_t size,
+		size_t max_memory, asn_dec_ext_rval_t *ext) {
+	asn_dec_opts_t opts;
+	void *structure = 0;
+	double start;
+
+	memset(&opts, 0, sizeof(opts));
+	opts.max_stack_size = opt_stack;
+	opts.max_memory = max_memory;
+
+	fuzz_current.target = t;
+	fuzz_current.buf = buf;
+	fuzz_current.size = size;
+
+	start = fuzz_now();
+	*ext = asn_decode_ext(&opts, t->syntax->syntax, t->sample->td,
+		&structure, buf, size);
+	ASN_STRUCT_FREE(*t->sample->td, structure);
+
+	fuzz_current.target = 0;
+
+	return fuzz_now() - start;
+}
+
+#ifdef	CODEC_FUZZER_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	fuzz_target_t t;
+	asn_dec_ext_rval_t ext;
+
+	if(size < 1) return 0;
+
+	memset(&t, 0, sizeof(t));
+	t.sample = &codec_samples[data[0] % CODEC_SAMPLES_COUNT];
+	t.syntax = &codec_syntaxes[(data[0] / CODEC_SAMPLES_COUNT)
+		% CODEC_SYNTAXES_COUNT];
+
+	/* libFuzzer watches the time and the memory by itself */
+	(void)fuzz_decode(&t, data + 1, size - 1, 0, &ext);
+
+	return 0;
+}
+
+#else	/* !CODEC_FUZZER_LIBFUZZER */
+
+static const char *opt_outdir = ".";	/* -o: findings directory */
+static double opt_factor = 10;		/* -f: allowance over the seed */
+static double opt_floor_ms = 1;		/* -F: time allowance */
+static size_t opt_floor_kb = 1024;	/* -m: memory allowance */
+static size_t opt_max_len = 65536;	/* -l: maximum input length */
+static int opt_verbose;			/* -v: progress reports */
+
+/*
+ * The pseudo-random sequence, reproducible with the -s option.
+ */
+static unsigned long long fuzz_state = 88172645463325252ULL;
+
+static unsigned long
+fuzz_random(unsigned long range) {
+	fuzz_state ^= fuzz_state << 13;
+	fuzz_state ^= fuzz_state >> 7;
+	fuzz_state ^= fuzz_state << 17;
+	return range ? (unsigned long)(fuzz_state % range) : 0;
+}
+
+/*
+ * FNV-1a hash naming the saved inputs; safe to call from a signal handler.
+ */
+static unsigned long long
+fuzz_hash(const uint8_t *buf, size_t size) {
+	unsigned long long hash = 14695981039346656037ULL;
+	size_t i;
+	for(i = 0; i < size; i++) {
+		hash ^= buf[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static void
+fuzz_save_crash(void) {
+	static const char hex[] = "0123456789abcdef";
+	const fuzz_target_t *t = fuzz_current.target;
+	const char *parts[5];
+	char path[512];
+	unsigned long long hash;
+	size_t len = 0;
+	int fd, i;
+
+	if(!t) return;
+	fuzz_current.target = 0;	/* Save once */
+
+	/* Only the async-signal-safe functions below */
+	parts[0] = opt_outdir;
+	parts[1] = "/crash-";
+	parts[2] = t->sample->name;
+	parts[3] = "-";
+	parts[4] = t->syntax->name;
+	for(i = 0; i < 5; i++) {
+		const char *p;
+		for(p = parts[i]; *p && len < sizeof(path) - 18; p++)
+			path[len++] = *p;
+	}
+	path[len++] = '-';
+	hash = fuzz_hash(fuzz_current.buf, fuzz_current.size);
+	for(i = 60; i >= 0; i -= 4)
+		path[len++] = hex[(hash >> i) & 0x0f];
+	path[len] = '\0';
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fd != -1) {
+		const uint8_t *p = fuzz_current.buf;
+		size_t left = fuzz_current.size;
+		while(left) {
+			ssize_t wrote = write(fd, p, left);
+			if(wrote <= 0) break;
+			p += wrote;
+			left -= wrote;
+		}
+		close(fd);
+	}
+	path[len++] = '\n';
+	if(write(2, path, len) != (ssize_t)len)
+		return;
+}
+
+#ifndef	_WIN32
+static void
+fuzz_signal(int sig) {
+	fuzz_save_crash();
+	signal(sig, SIG_DFL);
+	raise(sig);
+}
+#endif
+
+/*
+ * The sanitizers report and exit without raising a signal,
+ * but call back before that.
+ */
+#if	defined(__SANITIZE_ADDRESS__)
+#define	FUZZ_SANITIZER
+#elif	defined(__has_feature)
+#if	__has_feature(address_sanitizer)
+#define	FUZZ_SANITIZER
+#endif
+#endif
+#ifdef	FUZZ_SANITIZER
+extern void __sanitizer_set_death_callback(void (*)(void));
+#endif
+
+static void
+fuzz_catch_crashes(void) {
+#ifndef	_WIN32
+	static const int signals[] = {
+		SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT
+	};
+	static char altstack[65536];	/* For the stack overflows */
+	struct sigaction sa;
+	stack_t ss;
+	size_t i;
+
+	ss.ss_sp = altstack;
+	ss.ss_size = sizeof(altstack);
+	ss.ss_flags = 0;
+	(void)sigaltstack(&ss, 0);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = fuzz_signal;
+	sa.sa_flags = SA_ONSTACK;
+	sigemptyset(&sa.sa_mask);
+	for(i = 0; i < sizeof(signals)/sizeof(signals[0]); i++)
+		(void)sigaction(signals[i], &sa, 0);
+#endif
+#ifdef	FUZZ_SANITIZER
+	__sanitizer_set_death_callback(fuzz_save_crash);
+#endif
+}
+
+/*
+ * Decode the input and tell whether it is pathological.
+ */
+static enum fuzz_finding
+fuzz_check(const fuzz_target_t *t, const uint8_t *buf, size_t size,
+		double *elapsed) {
+	double time_limit = opt_factor * t->ns_per_byte * size
+		+ opt_floor_ms * 1e6;
+	size_t memory_limit = (size_t)(opt_factor * t->peak_per_byte * size)
+		+ opt_floor_kb * 1024;
+	asn_dec_ext_rval_t ext;
+	int tries;
+
+	*elapsed = fuzz_decode(t, buf, size, memory_limit, &ext);
+	if(ext.memory_exceeded)
+		return FF_MEMORY;
+
+	/* The time is confirmed by the fastest of three tries */
+	for(tries = 1; *elapsed > time_limit; tries++) {
+		double again;
+		if(tries == 3) return FF_SLOW;
+		again = fuzz_decode(t, buf, size, memory_limit, &ext);
+		if(again < *elapsed) *elapsed = again;
+	}
+
+	return FF_NONE;
+}
+
+/*
+ * Open (len) bytes at (pos), up to the (max_size).
+ * Returns the number of bytes opened.
+ */
+static size_t
+fuzz_open_gap(uint8_t *buf, size_t *size, size_t max_size,
+		size_t pos, size_t len) {
+	if(len > max_size - *size)
+		len = max_size - *size;
+	memmove(buf + pos + len, buf + pos, *size - pos);
+	*size += len;
+	return len;
+}
+
+static void
+fuzz_mutate(const fuzz_target_t *targets, size_t targets_count,
+		const fuzz_target_t *t, uint8_t *buf, size_t *size,
+		size_t max_size) {
+	static const uint8_t interesting[] = {
+		0x00, 0x01, 0x02, 0x04, 0x05, 0x0c, 0x1f, 0x20, 0x24, 0x30,
+		0x31, 0x3c, 0x3e, 0x7f, 0x80, 0x81, 0x82, 0x84, 0xa0, 0xa3,
+		0xfe, 0xff
+	};
+	int mutations = 1 + fuzz_random(5);
+
+	while(mutations--) {
+		size_t pos = fuzz_random(*size + 1);	/* May be at the end */
+		size_t at = pos < *size ? pos : (*size ? *size - 1 : 0);
+		size_t len, i;
+		uint8_t chunk[256];
+
+		switch(fuzz_random(9)) {
+		case 0:	/* Flip a bit */
+			if(!*size) break;
+			buf[at] ^= 1 << fuzz_random(8);
+			break;
+		case 1:	/* Set a random byte */
+			if(!*size) break;
+			buf[at] = fuzz_random(256);
+			break;
+		case 2:	/* Set an interesting byte */
+			if(!*size) break;
+			buf[at] = interesting[fuzz_random(sizeof(interesting))];
+			break;
+		case 3:	/* Add to a byte, e.g. to a length */
+			if(!*size) break;
+			buf[at] += (int)fuzz_random(71) - 35;
+			break;
+		case 4:	/* Insert random bytes */
+			len = fuzz_open_gap(buf, size, max_size, pos,
+				1 + fuzz_random(8));
+			for(i = 0; i < len; i++)
+				buf[pos + i] = fuzz_random(256);
+			break;
+		case 5:	/* Delete a chunk */
+			if(!*size) break;
+			len = 1 + fuzz_random((*size - at + 3) / 4);
+			memmove(buf + at, buf + at + len, *size - at - len);
+			*size -= len;
+			break;
+		case 6:	/* Duplicate a chunk, nesting the encodings */
+			if(!*size) break;
+			len = 1 + fuzz_random(*size - at);
+			if(len > sizeof(chunk)) len = sizeof(chunk);
+			memcpy(chunk, buf + at, len);
+			i = fuzz_random(*size + 1);
+			len = fuzz_open_gap(buf, size, max_size, i, len);
+			memcpy(buf + i, chunk, len);
+			break;
+		case 7:	/* Repeat a short chunk many times */
+			if(!*size) break;
+			len = 1 + fuzz_random(8);
+			if(len > *size - at) len = *size - at;
+			memcpy(chunk, buf + at, len);
+			i = len * (2 + fuzz_random(1 << (1 + fuzz_random(10))));
+			i = fuzz_open_gap(buf, size, max_size, pos, i);
+			for(; i; i--)
+				buf[pos + i - 1] = chunk[(i - 1) % len];
+			break;
+		case 8:	/* Splice a chunk of another seed of this syntax */
+		    {
+			const fuzz_target_t *o = &targets[fuzz_random(targets_count)];
+			size_t from;
+			if(o->syntax != t->syntax || !o->seed_size) break;
+			from = fuzz_random(o->seed_size);
+			len = 1 + fuzz_random(o->seed_size - from);
+			len = fuzz_open_gap(buf, size, max_size, pos, len);
+			memcpy(buf + pos, o->seed + from, len);
+		    }
+			break;
+		}
+	}
+}
+
+/*
+ * Keep the input for the further mutations if it took longer
+ * to decode per byte than the ones kept already.
+ */
+static void
+fuzz_pool_offer(fuzz_target_t *t, const uint8_t *buf, size_t size,
+		double elapsed) {
+	double score = elapsed / (size + 64);
+	struct fuzz_input *in;
+	uint8_t *copy;
+	size_t i;
+
+	if(t->pool_count < FUZZ_POOL_SIZE) {
+		in = &t->pool[t->pool_count];
+		in->buf = 0;
+	} else {
+		/* Replace the lowest score, but never the seed */
+		in = &t->pool[1];
+		for(i = 2; i < FUZZ_POOL_SIZE; i++)
+			if(t->pool[i].score < in->score)
+				in = &t->pool[i];
+		if(in->score >= score) return;
+	}
+
+	copy = (uint8_t *)realloc(in->buf, size ? size : 1);
+	if(!copy) return;
+	memcpy(copy, buf, size);
+	in->buf = copy;
+	in->size = size;
+	in->score = score;
+	if(in == &t->pool[t->pool_count]) t->pool_count++;
+}
+
+/*
+ * Drop the chunks of the input while it stays pathological the same way.
+ */
+#define	FUZZ_MINIMIZE_RUNS	2048
+static void
+fuzz_minimize(const fuzz_target_t *t, enum fuzz_finding kind,
+		uint8_t *buf, size_t *size) {
+	uint8_t *tmp = (uint8_t *)malloc(*size ? *size : 1);
+	size_t chunk, off;
+	int runs = 0;
+
+	if(!tmp) return;
+
+	for(chunk = *size / 2; chunk; chunk /= 2) {
+		for(off = 0; off + chunk <= *size; ) {
+			double elapsed;
+			if(runs++ == FUZZ_MINIMIZE_RUNS) goto done;
+			memcpy(tmp, buf, off);
+			memcpy(tmp + off, buf + off + chunk,
+				*size - off - chunk);
+			if(fuzz_check(t, tmp, *size - chunk, &elapsed) == kind) {
+				*size -= chunk;
+				memcpy(buf, tmp, *size);
+			} else {
+				off += chunk;
+			}
+		}
+	}
+
+done:
+	free(tmp);
+}
+
+static int
+fuzz_save(const char *kind, const fuzz_target_t *t, const char *dir,
+		const uint8_t *buf, size_t size) {
+	char path[512];
+	FILE *fp;
+
+	snprintf(path, sizeof(path), "%s/%s-%s-%s-%016llx", dir, kind,
+		t->sample->name, t->syntax->name, fuzz_hash(buf, size));
+	fp = fopen(path, "wb");
+	if(!fp || fwrite(buf, 1, size, fp) != size) {
+		perror(path);
+		if(fp) fclose(fp);
+		return -1;
+	}
+	fclose(fp);
+	printf("Saved %s (%ld bytes)\n", path, (long)size);
+	return 0;
+}
+
+static int
+fuzz_consume(const void *buffer, size_t size, void *key) {
+	fuzz_target_t *t = (fuzz_target_t *)key;
+	uint8_t *p = (uint8_t *)realloc(t->seed, t->seed_size + size);
+	if(!p) return -1;
+	memcpy(p + t->seed_size, buffer, size);
+	t->seed = p;
+	t->seed_size += size;
+	return 0;
+}
+
+/*
+ * Encode the seed and measure its decoding.
+ * Returns -1 if the syntax is not supported by the type.
+ */
+static int
+fuzz_target_init(fuzz_target_t *t, void *pdu) {
+	asn_dec_ext_rval_t ext;
+	asn_enc_rval_t er;
+	double best = 0;
+	int i;
+
+	er = asn_encode(t->syntax->syntax, t->sample->td, pdu,
+		fuzz_consume, t);
+	if(er.encoded == -1 || !t->seed_size)
+		return -1;
+
+	for(i = 0; i < 5; i++) {
+		double elapsed = fuzz_decode(t, t->seed, t->seed_size, 0, &ext);
+		if(ext.code != RC_OK) return -1;
+		if(!i || elapsed < best) best = elapsed;
+	}
+	t->ns_per_byte = best / t->seed_size;
+	t->peak_per_byte = (double)ext.peak / t->seed_size;
+
+	t->pool[0].buf = t->seed;
+	t->pool[0].size = t->seed_size;
+	t->pool_count = 1;
+
+	return 0;
+}
+
+
+static void
+usage(const char *av0) {
+	fprintf(stderr,
+"Usage: %s [options] [target ...]\n"
+"Options:\n"
+"  -n <runs>    Number of the inputs to try (default 100000, 0 is unlimited)\n"
+"  -s <seed>    Seed of the random mutations (default is the time)\n"
+"  -o <dir>     Directory to save the findings into (default .)\n"
+"  -f <factor>  Allowance over the seed's time and memory (default %g)\n"
+"  -F <ms>      Additional time allowance (default %g)\n"
+"  -m <kB>      Additional memory allowance (default %ld)\n"
+"  -l <bytes>   Maximum length of the inputs (default %ld)\n"
+"  -S <bytes>   Stack limit of the decoders, 0 is none (default %ld)\n"
+"  -w <dir>     Write the seeds for libFuzzer into the directory and exit\n"
+"  -L           List the targets\n"
+"  -v           Report the progress\n"
+"The targets, such as \"deep-nesting-ber\", are selected by the substrings\n"
+"of their names.\n",
+	av0, opt_factor, opt_floor_ms, (long)opt_floor_kb,
+	(long)opt_max_len, (long)opt_stack);
+	exit(EX_USAGE);
+}
+
+int
+main(int ac, char *av[]) {
+	fuzz_target_t targets[CODEC_SAMPLES_COUNT * CODEC_SYNTAXES_COUNT];
+	size_t targets_count = 0;
+	unsigned long runs = 100000;
+	unsigned long findings[3] = { 0, 0, 0 };
+	unsigned long long seed = time(0);
+	const char *seeds_dir = 0;
+	size_t max_size;
+	uint8_t *work;
+	unsigned long n;
+	double start, reported;
+	size_t i, j;
+	int list = 0;
+	int ch;
+
+	while((ch = getopt(ac, av, "n:s:o:f:F:m:l:S:w:Lvh")) != -1)
+	switch(ch) {
+	case 'n':
+		runs = strtoul(optarg, 0, 10);
+		break;
+	case 's':
+		seed = strtoull(optarg, 0, 10);
+		break;
+	case 'o':
+		opt_outdir = optarg;
+		break;
+	case 'f':
+		opt_factor = atof(optarg);
+		if(opt_factor < 1) {
+			fprintf(stderr, "-f %s: 1 or more expected\n", optarg);
+			exit(EX_USAGE);
+		}
+		break;
+	case 'F':
+		opt_floor_ms = atof(optarg);
+		break;
+	case 'm':
+		opt_floor_kb = strtoul(optarg, 0, 10);
+		break;
+	case 'l':
+		opt_max_len = strtoul(optarg, 0, 10);
+		break;
+	case 'S':
+		opt_stack = strtoul(optarg, 0, 10);
+		break;
+	case 'w':
+		seeds_dir = optarg;
+		break;
+	case 'L':
+		list = 1;
+		break;
+	case 'v':
+		opt_verbose = 1;
+		break;
+	case 'h':
+	default:
+		usage(av[0]);
+	}
+	ac -= optind;
+	av += optind;
+
+	/* A zero state would stay zero */
+	fuzz_state ^= seed * 0x9e3779b97f4a7c15ULL;
+	if(!fuzz_state) fuzz_state = 1;
+
+	memset(targets, 0, sizeof(targets));
+	max_size = opt_max_len;
+	for(i = 0; i < CODEC_SAMPLES_COUNT; i++) {
+		void *pdu = codec_samples[i].build();
+		if(!pdu) {
+			fprintf(stderr, "%s: cannot build the PDU\n",
+				codec_samples[i].name);
+			exit(EX_OSERR);
+		}
+		for(j = 0; j < CODEC_SYNTAXES_COUNT; j++) {
+			fuzz_target_t *t = &targets[targets_count];
+			char name[64];
+			int k;
+
+			t->sample = &codec_samples[i];
+			t->syntax = &codec_syntaxes[j];
+			snprintf(name, sizeof(name), "%s-%s",
+				t->sample->name, t->syntax->name);
+			for(k = 0; k < ac; k++)
+				if(strstr(name, av[k])) break;
+			if(ac && k == ac) continue;
+
+			if(fuzz_target_init(t, pdu)) {
+				free(t->seed);
+				memset(t, 0, sizeof(*t));
+				continue;
+			}
+			if(list)
+				printf("%s (%ld bytes, %.1f ns/byte)\n", name,
+					(long)t->seed_size, t->ns_per_byte);
+			if(seeds_dir) {
+				/* The first byte selects the target */
+				uint8_t *p = (uint8_t *)malloc(t->seed_size + 1);
+				if(!p) exit(EX_OSERR);
+				p[0] = i + j * CODEC_SAMPLES_COUNT;
+				memcpy(p + 1, t->seed, t->seed_size);
+				if(fuzz_save("seed", t, seeds_dir, p,
+						t->seed_size + 1))
+					exit(EX_CANTCREAT);
+				free(p);
+			}
+			if(max_size < t->seed_size)
+				max_size = t->seed_size;
+			targets_count++;
+		}
+		ASN_STRUCT_FREE(*codec_samples[i].td, pdu);
+	}
+	if(list || seeds_dir)
+		exit(0);
+	if(!targets_count) {
+		fprintf(stderr, "No targets to fuzz\n");
+		exit(EX_USAGE);
+	}
+
+	work = (uint8_t *)malloc(max_size);
+	if(!work) exit(EX_OSERR);
+
+	fuzz_catch_crashes();
+	printf("Fuzzing %ld targets with -s %llu\n", (long)targets_count, seed);
+
+	start = reported = fuzz_now();
+	for(n = 0; !runs || n < runs; n++) {
+		fuzz_target_t *t = &targets[fuzz_random(targets_count)];
+		struct fuzz_input *in = &t->pool[fuzz_random(t->pool_count)];
+		enum fuzz_finding kind;
+		double elapsed;
+		size_t size;
+
+		memcpy(work, in->buf, in->size);
+		size = in->size;
+		fuzz_mutate(targets, targets_count, t, work, &size, max_size);
+
+		kind = fuzz_check(t, work, size, &elapsed);
+		if(kind == FF_NONE) {
+			fuzz_pool_offer(t, work, size, elapsed);
+		} else {
+			findings[kind]++;
+			fuzz_minimize(t, kind, work, &size);
+			if(fuzz_save(fuzz_finding_names[kind], t, opt_outdir,
+					work, size))
+				exit(EX_CANTCREAT);
+		}
+
+		if(opt_verbose && fuzz_now() - reported > 5e9) {
+			reported = fuzz_now();
+			printf("#%lu: %.0f runs/s, %lu slow, %lu memory\n",
+				n, n / ((reported - start) / 1e9),
+				findings[FF_SLOW], findings[FF_MEMORY]);
+			fflush(stdout);
+		}
+	}
+
+	printf("Done %lu runs in %.1f s: %lu slow, %lu memory\n", n,
+		(fuzz_now() - start) / 1e9,
+		findings[FF_SLOW], findings[FF_MEMORY]);
+
+	free(work);
+	for(i = 0; i < targets_count; i++) {
+		for(j = 1; j < targets[i].pool_count; j++)
+			free(targets[i].pool[j].buf);
+		free(targets[i].seed);
+	}
+
+	return (findings[FF_SLOW] || findings[FF_MEMORY]) ? 1 : 0;
+}
+
+#endif	/* CODEC_FUZZER_LIBFUZZER */
@@ -0,0 +1,615 @@
+/*
+ * The sample types and values shared by codec-benchmark.c and codec-fuzzer.c.
+ * Redistribution and modifications are permitted subject to BSD license.
+ *
+ * The types are built in here by hand, the way asn1c would generate them,
+ * so the programs need nothing but the runtime library. The definitions
+ * are not static, so include this file into a single source of a program.
+ */
+#ifndef	_CODEC_SAMPLES_H_
+#define	_CODEC_SAMPLES_H_
+
+#include <asn_application.h>
+#include <NativeInteger.h>
+#include <NativeReal.h>
+#include <INTEGER.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <OCTET_STRING.h>
+#include <UTF8String.h>
+#include <BIT_STRING.h>
+#include <constr_SEQUENCE.h>
+#include <constr_CHOICE.h>
+#include <constr_SEQUENCE_OF.h>
+#include <constr_SET_OF.h>
+#include <asn_SEQUENCE_OF.h>
+#include <asn_SET_OF.h>
+
+#define	CTX_TAG(n)	(ASN_TAG_CLASS_CONTEXT | ((n) << 2))
+
+static ber_tlv_tag_t asn_DEF_SEQUENCE_tags[] = {
+	(ASN_TAG_CLASS_UNIVERSAL | (16 << 2))
+};
+static ber_tlv_tag_t asn_DEF_SET_OF_tags[] = {
+	(ASN_TAG_CLASS_UNIVERSAL | (17 << 2))
+};
+
+/*
+ * Flat ::= SEQUENCE {
+ *	id	[0] INTEGER,
+ *	big	[1] INTEGER,
+ *	flag	[2] BOOLEAN,
+ *	data	[3] OCTET STRING,
+ *	bits	[4] BIT STRING,
+ *	opt	[5] INTEGER OPTIONAL
+ * }
+ */
+typedef struct Flat {
+	long id;
+	INTEGER_t big;
+	BOOLEAN_t flag;
+	OCTET_STRING_t data;
+	BIT_STRING_t bits;
+	long *opt;
+	asn_struct_ctx_t _asn_ctx;
+} Flat_t;
+static asn_TYPE_member_t asn_MBR_Flat[] = {
+	{ ATF_NOFLAGS, 0, offsetof(Flat_t, id), CTX_TAG(0), -1,
+		&asn_DEF_NativeInteger, 0, 0, 0, "id" },
+	{ ATF_NOFLAGS, 0, offsetof(Flat_t, big), CTX_TAG(1), -1,
+		&asn_DEF_INTEGER, 0, 0, 0, "big" },
+	{ ATF_NOFLAGS, 0, offsetof(Flat_t, flag), CTX_TAG(2), -1,
+		&asn_DEF_BOOLEAN, 0, 0, 0, "flag" },
+	{ ATF_NOFLAGS, 0, offsetof(Flat_t, data), CTX_TAG(3), -1,
+		&asn_DEF_OCTET_STRING, 0, 0, 0, "data" },
+	{ ATF_NOFLAGS, 0, offsetof(Flat_t, bits), CTX_TAG(4), -1,
+		&asn_DEF_BIT_STRING, 0, 0, 0, "bits" },
+	{ ATF_POINTER, 1, offsetof(Flat_t, opt), CTX_TAG(5), -1,
+		&asn_DEF_NativeInteger, 0, 0, 0, "opt" },
+};
+static asn_TYPE_tag2member_t asn_MAP_Flat_tag2el[] = {
+	{ CTX_TAG(0), 0, 0, 0 }, { CTX_TAG(1), 1, 0, 0 },
+	{ CTX_TAG(2), 2, 0, 0 }, { CTX_TAG(3), 3, 0, 0 },
+	{ CTX_TAG(4), 4, 0, 0 }, { CTX_TAG(5), 5, 0, 0 }
+};
+static int asn_MAP_Flat_oms[] = { 5 };
+static asn_SEQUENCE_specifics_t asn_SPC_Flat_specs = {
+	sizeof(struct Flat), offsetof(struct Flat, _asn_ctx),
+	asn_MAP_Flat_tag2el, 6,
+	asn_MAP_Flat_oms, 1, 0,
+	-1, -1
+};
+asn_TYPE_descriptor_t asn_DEF_Flat = {
+	"Flat", "Flat",
+	SEQUENCE_free, SEQUENCE_print, SEQUENCE_constraint,
+	SEQUENCE_decode_ber, SEQUENCE_encode_der,
+	SEQUENCE_decode_xer, SEQUENCE_encode_xer,
+	SEQUENCE_decode_uper, SEQUENCE_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Flat, 6, &asn_SPC_Flat_specs,
+	SEQUENCE_decode_jer, SEQUENCE_encode_jer,
+	SEQUENCE_decode_oer, SEQUENCE_encode_oer
+};
+
+/*
+ * Node ::= SEQUENCE {
+ *	value	[0] INTEGER,
+ *	next	[1] Node OPTIONAL
+ * }
+ */
+typedef struct Node {
+	long value;
+	struct Node *next;
+	asn_struct_ctx_t _asn_ctx;
+} Node_t;
+extern asn_TYPE_descriptor_t asn_DEF_Node;
+static asn_TYPE_member_t asn_MBR_Node[] = {
+	{ ATF_NOFLAGS, 0, offsetof(Node_t, value), CTX_TAG(0), -1,
+		&asn_DEF_NativeInteger, 0, 0, 0, "value" },
+	{ ATF_POINTER, 1, offsetof(Node_t, next), CTX_TAG(1), -1,
+		&asn_DEF_Node, 0, 0, 0, "next" },
+};
+static asn_TYPE_tag2member_t asn_MAP_Node_tag2el[] = {
+	{ CTX_TAG(0), 0, 0, 0 }, { CTX_TAG(1), 1, 0, 0 }
+};
+static int asn_MAP_Node_oms[] = { 1 };
+static asn_SEQUENCE_specifics_t asn_SPC_Node_specs = {
+	sizeof(struct Node), offsetof(struct Node, _asn_ctx),
+	asn_MAP_Node_tag2el, 2,
+	asn_MAP_Node_oms, 1, 0,
+	-1, -1
+};
+asn_TYPE_descriptor_t asn_DEF_Node = {
+	"Node", "Node",
+	SEQUENCE_free, SEQUENCE_print, SEQUENCE_constraint,
+	SEQUENCE_decode_ber, SEQUENCE_encode_der,
+	SEQUENCE_decode_xer, SEQUENCE_encode_xer,
+	SEQUENCE_decode_uper, SEQUENCE_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Node, 2, &asn_SPC_Node_specs,
+	SEQUENCE_decode_jer, SEQUENCE_encode_jer,
+	SEQUENCE_decode_oer, SEQUENCE_encode_oer
+};
+
+/*
+ * Numbers ::= SET OF INTEGER
+ */
+typedef struct Numbers {
+	A_SET_OF(long) list;
+	asn_struct_ctx_t _asn_ctx;
+} Numbers_t;
+static asn_TYPE_member_t asn_MBR_Numbers[] = {
+	{ ATF_POINTER, 0, 0, (ASN_TAG_CLASS_UNIVERSAL | (2 << 2)), 0,
+		&asn_DEF_NativeInteger, 0, 0, 0, "" },
+};
+static asn_SET_OF_specifics_t asn_SPC_Numbers_specs = {
+	sizeof(struct Numbers), offsetof(struct Numbers, _asn_ctx), 0
+};
+asn_TYPE_descriptor_t asn_DEF_Numbers = {
+	"Numbers", "Numbers",
+	SET_OF_free, SET_OF_print, SET_OF_constraint,
+	SET_OF_decode_ber, SET_OF_encode_der,
+	SET_OF_decode_xer, SET_OF_encode_xer,
+	SET_OF_decode_uper, 0,	/* No PER encoder of SET OF */
+	0,
+	asn_DEF_SET_OF_tags, 1, asn_DEF_SET_OF_tags, 1,
+	0, asn_MBR_Numbers, 1, &asn_SPC_Numbers_specs,
+	SET_OF_decode_jer, SET_OF_encode_jer,
+	SET_OF_decode_oer, SET_OF_encode_oer
+};
+
+/*
+ * Alternative ::= CHOICE {
+ *	number	[0] INTEGER,
+ *	text	[1] OCTET STRING,
+ *	flag	[2] BOOLEAN,
+ *	none	[3] NULL
+ * }
+ * Alternatives ::= SEQUENCE OF Alternative
+ */
+typedef enum Alternative_PR {
+	Alternative_PR_NOTHING,
+	Alternative_PR_number,
+	Alternative_PR_text,
+	Alternative_PR_flag,
+	Alternative_PR_none
+} Alternative_PR;
+typedef struct Alternative {
+	Alternative_PR present;
+	union Alternative_u {
+		long number;
+		OCTET_STRING_t text;
+		BOOLEAN_t flag;
+		NULL_t none;
+	} choice;
+	asn_struct_ctx_t _asn_ctx;
+} Alternative_t;
+static asn_TYPE_member_t asn_MBR_Alternative[] = {
+	{ ATF_NOFLAGS, 0, offsetof(Alternative_t, choice.number), CTX_TAG(0),
+		-1, &asn_DEF_NativeInteger, 0, 0, 0, "number" },
+	{ ATF_NOFLAGS, 0, offsetof(Alternative_t, choice.text), CTX_TAG(1),
+		-1, &asn_DEF_OCTET_STRING, 0, 0, 0, "text" },
+	{ ATF_NOFLAGS, 0, offsetof(Alternative_t, choice.flag), CTX_TAG(2),
+		-1, &asn_DEF_BOOLEAN, 0, 0, 0, "flag" },
+	{ ATF_NOFLAGS, 0, offsetof(Alternative_t, choice.none), CTX_TAG(3),
+		-1, &asn_DEF_NULL, 0, 0, 0, "none" },
+};
+static asn_TYPE_tag2member_t asn_MAP_Alternative_tag2el[] = {
+	{ CTX_TAG(0), 0, 0, 0 }, { CTX_TAG(1), 1, 0, 0 },
+	{ CTX_TAG(2), 2, 0, 0 }, { CTX_TAG(3), 3, 0, 0 }
+};
+static asn_per_constraints_t asn_PER_Alternative_constr = {
+	{ APC_CONSTRAINED, 2, 2, 0, 3 },	/* (0..3) */
+	{ APC_UNCONSTRAINED, -1, -1, 0, 0 }
+};
+static asn_CHOICE_specifics_t asn_SPC_Alternative_specs = {
+	sizeof(struct Alternative), offsetof(struct Alternative, _asn_ctx),
+	offsetof(struct Alternative, present),
+	sizeof(((struct Alternative *)0)->present),
+	asn_MAP_Alternative_tag2el, 4,
+	0,
+	-1	/* Not extensible */
+};
+asn_TYPE_descriptor_t asn_DEF_Alternative = {
+	"Alternative", "Alternative",
+	CHOICE_free, CHOICE_print, CHOICE_constraint,
+	CHOICE_decode_ber, CHOICE_encode_der,
+	CHOICE_decode_xer, CHOICE_encode_xer,
+	CHOICE_decode_uper, CHOICE_encode_uper,
+	CHOICE_outmost_tag,
+	0, 0, 0, 0,
+	&asn_PER_Alternative_constr,
+	asn_MBR_Alternative, 4, &asn_SPC_Alternative_specs,
+	CHOICE_decode_jer, CHOICE_encode_jer,
+	CHOICE_decode_oer, CHOICE_encode_oer
+};
+
+typedef struct Alternatives {
+	A_SEQUENCE_OF(Alternative_t) list;
+	asn_struct_ctx_t _asn_ctx;
+} Alternatives_t;
+static asn_TYPE_member_t asn_MBR_Alternatives[] = {
+	{ ATF_POINTER, 0, 0, -1 /* Ambiguous tag (CHOICE?) */, 0,
+		&asn_DEF_Alternative, 0, 0, 0, "" },
+};
+static asn_SET_OF_specifics_t asn_SPC_Alternatives_specs = {
+	sizeof(struct Alternatives), offsetof(struct Alternatives, _asn_ctx), 0
+};
+asn_TYPE_descriptor_t asn_DEF_Alternatives = {
+	"Alternatives", "Alternatives",
+	SEQUENCE_OF_free, SEQUENCE_OF_print, SEQUENCE_OF_constraint,
+	SEQUENCE_OF_decode_ber, SEQUENCE_OF_encode_der,
+	SEQUENCE_OF_decode_xer, SEQUENCE_OF_encode_xer,
+	SEQUENCE_OF_decode_uper, SEQUENCE_OF_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Alternatives, 1, &asn_SPC_Alternatives_specs,
+	SEQUENCE_OF_decode_jer, SEQUENCE_OF_encode_jer,
+	SEQUENCE_OF_decode_oer, SEQUENCE_OF_encode_oer
+};
+
+/*
+ * Texts ::= SEQUENCE OF UTF8String
+ */
+typedef struct Texts {
+	A_SEQUENCE_OF(UTF8String_t) list;
+	asn_struct_ctx_t _asn_ctx;
+} Texts_t;
+static asn_TYPE_member_t asn_MBR_Texts[] = {
+	{ ATF_POINTER, 0, 0, (ASN_TAG_CLASS_UNIVERSAL | (12 << 2)), 0,
+		&asn_DEF_UTF8String, 0, 0, 0, "" },
+};
+static asn_SET_OF_specifics_t asn_SPC_Texts_specs = {
+	sizeof(struct Texts), offsetof(struct Texts, _asn_ctx), 0
+};
+asn_TYPE_descriptor_t asn_DEF_Texts = {
+	"Texts", "Texts",
+	SEQUENCE_OF_free, SEQUENCE_OF_print, SEQUENCE_OF_constraint,
+	SEQUENCE_OF_decode_ber, SEQUENCE_OF_encode_der,
+	SEQUENCE_OF_decode_xer, SEQUENCE_OF_encode_xer,
+	SEQUENCE_OF_decode_uper, SEQUENCE_OF_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Texts, 1, &asn_SPC_Texts_specs,
+	SEQUENCE_OF_decode_jer, SEQUENCE_OF_encode_jer,
+	SEQUENCE_OF_decode_oer, SEQUENCE_OF_encode_oer
+};
+
+/*
+ * Reals ::= SEQUENCE OF REAL
+ */
+typedef struct Reals {
+	A_SEQUENCE_OF(double) list;
+	asn_struct_ctx_t _asn_ctx;
+} Reals_t;
+static asn_TYPE_member_t asn_MBR_Reals[] = {
+	{ ATF_POINTER, 0, 0, (ASN_TAG_CLASS_UNIVERSAL | (9 << 2)), 0,
+		&asn_DEF_NativeReal, 0, 0, 0, "" },
+};
+static asn_SET_OF_specifics_t asn_SPC_Reals_specs = {
+	sizeof(struct Reals), offsetof(struct Reals, _asn_ctx), 0
+};
+asn_TYPE_descriptor_t asn_DEF_Reals = {
+	"Reals", "Reals",
+	SEQUENCE_OF_free, SEQUENCE_OF_print, SEQUENCE_OF_constraint,
+	SEQUENCE_OF_decode_ber, SEQUENCE_OF_encode_der,
+	SEQUENCE_OF_decode_xer, SEQUENCE_OF_encode_xer,
+	SEQUENCE_OF_decode_uper, SEQUENCE_OF_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Reals, 1, &asn_SPC_Reals_specs,
+	SEQUENCE_OF_decode_jer, SEQUENCE_OF_encode_jer,
+	SEQUENCE_OF_decode_oer, SEQUENCE_OF_encode_oer
+};
+
+/*
+ * Record ::= SEQUENCE {
+ *	id	[0] INTEGER (0..65535),
+ *	flag	[1] BOOLEAN,
+ *	data	[2] OCTET STRING (SIZE(0..64)),
+ *	values	[3] SEQUENCE (SIZE(0..255)) OF INTEGER (-1000..1000)
+ * }
+ * Records ::= SEQUENCE OF Record
+ * The types PER is defined for, with the constraints it makes use of.
+ */
+static asn_per_constraints_t asn_PER_Record_id_constr = {
+	{ APC_CONSTRAINED, 16, 16, 0, 65535 },	/* (0..65535) */
+	{ APC_UNCONSTRAINED, -1, -1, 0, 0 }
+};
+static asn_per_constraints_t asn_PER_Record_data_constr = {
+	{ APC_UNCONSTRAINED, -1, -1, 0, 0 },
+	{ APC_CONSTRAINED, 7, 7, 0, 64 }	/* (SIZE(0..64)) */
+};
+static asn_per_constraints_t asn_PER_Record_value_constr = {
+	{ APC_CONSTRAINED, 11, 11, -1000, 1000 },	/* (-1000..1000) */
+	{ APC_UNCONSTRAINED, -1, -1, 0, 0 }
+};
+static asn_per_constraints_t asn_PER_Record_values_constr = {
+	{ APC_UNCONSTRAINED, -1, -1, 0, 0 },
+	{ APC_CONSTRAINED, 8, 8, 0, 255 }	/* (SIZE(0..255)) */
+};
+
+typedef struct Record_values {
+	A_SEQUENCE_OF(long) list;
+	asn_struct_ctx_t _asn_ctx;
+} Record_values_t;
+static asn_TYPE_member_t asn_MBR_Record_values[] = {
+	{ ATF_POINTER, 0, 0, (ASN_TAG_CLASS_UNIVERSAL | (2 << 2)), 0,
+		&asn_DEF_NativeInteger, 0, &asn_PER_Record_value_constr,
+		0, "" },
+};
+static asn_SET_OF_specifics_t asn_SPC_Record_values_specs = {
+	sizeof(struct Record_values),
+	offsetof(struct Record_values, _asn_ctx), 0
+};
+asn_TYPE_descriptor_t asn_DEF_Record_values = {
+	"values", "values",
+	SEQUENCE_OF_free, SEQUENCE_OF_print, SEQUENCE_OF_constraint,
+	SEQUENCE_OF_decode_ber, SEQUENCE_OF_encode_der,
+	SEQUENCE_OF_decode_xer, SEQUENCE_OF_encode_xer,
+	SEQUENCE_OF_decode_uper, SEQUENCE_OF_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	&asn_PER_Record_values_constr,
+	asn_MBR_Record_values, 1, &asn_SPC_Record_values_specs,
+	SEQUENCE_OF_decode_jer, SEQUENCE_OF_encode_jer,
+	SEQUENCE_OF_decode_oer, SEQUENCE_OF_encode_oer
+};
+
+typedef struct Record {
+	long id;
+	BOOLEAN_t flag;
+	OCTET_STRING_t data;
+	Record_values_t values;
+	asn_struct_ctx_t _asn_ctx;
+} Record_t;
+static asn_TYPE_member_t asn_MBR_Record[] = {
+	{ ATF_NOFLAGS, 0, offsetof(Record_t, id), CTX_TAG(0), -1,
+		&asn_DEF_NativeInteger, 0, &asn_PER_Record_id_constr,
+		0, "id" },
+	{ ATF_NOFLAGS, 0, offsetof(Record_t, flag), CTX_TAG(1), -1,
+		&asn_DEF_BOOLEAN, 0, 0, 0, "flag" },
+	{ ATF_NOFLAGS, 0, offsetof(Record_t, data), CTX_TAG(2), -1,
+		&asn_DEF_OCTET_STRING, 0, &asn_PER_Record_data_constr,
+		0, "data" },
+	{ ATF_NOFLAGS, 0, offsetof(Record_t, values), CTX_TAG(3), -1,
+		&asn_DEF_Record_values, 0, &asn_PER_Record_values_constr,
+		0, "values" },
+};
+static asn_TYPE_tag2member_t asn_MAP_Record_tag2el[] = {
+	{ CTX_TAG(0), 0, 0, 0 }, { CTX_TAG(1), 1, 0, 0 },
+	{ CTX_TAG(2), 2, 0, 0 }, { CTX_TAG(3), 3, 0, 0 }
+};
+static asn_SEQUENCE_specifics_t asn_SPC_Record_specs = {
+	sizeof(struct Record), offsetof(struct Record, _asn_ctx),
+	asn_MAP_Record_tag2el, 4,
+	0, 0, 0,
+	-1, -1
+};
+asn_TYPE_descriptor_t asn_DEF_Record = {
+	"Record", "Record",
+	SEQUENCE_free, SEQUENCE_print, SEQUENCE_constraint,
+	SEQUENCE_decode_ber, SEQUENCE_encode_der,
+	SEQUENCE_decode_xer, SEQUENCE_encode_xer,
+	SEQUENCE_decode_uper, SEQUENCE_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Record, 4, &asn_SPC_Record_specs,
+	SEQUENCE_decode_jer, SEQUENCE_encode_jer,
+	SEQUENCE_decode_oer, SEQUENCE_encode_oer
+};
+
+typedef struct Records {
+	A_SEQUENCE_OF(Record_t) list;
+	asn_struct_ctx_t _asn_ctx;
+} Records_t;
+static asn_TYPE_member_t asn_MBR_Records[] = {
+	{ ATF_POINTER, 0, 0, (ASN_TAG_CLASS_UNIVERSAL | (16 << 2)), 0,
+		&asn_DEF_Record, 0, 0, 0, "" },
+};
+static asn_SET_OF_specifics_t asn_SPC_Records_specs = {
+	sizeof(struct Records), offsetof(struct Records, _asn_ctx), 0
+};
+asn_TYPE_descriptor_t asn_DEF_Records = {
+	"Records", "Records",
+	SEQUENCE_OF_free, SEQUENCE_OF_print, SEQUENCE_OF_constraint,
+	SEQUENCE_OF_decode_ber, SEQUENCE_OF_encode_der,
+	SEQUENCE_OF_decode_xer, SEQUENCE_OF_encode_xer,
+	SEQUENCE_OF_decode_uper, SEQUENCE_OF_encode_uper,
+	0,
+	asn_DEF_SEQUENCE_tags, 1, asn_DEF_SEQUENCE_tags, 1,
+	0, asn_MBR_Records, 1, &asn_SPC_Records_specs,
+	SEQUENCE_OF_decode_jer, SEQUENCE_OF_encode_jer,
+	SEQUENCE_OF_decode_oer, SEQUENCE_OF_encode_oer
+};
+
+/*
+ * The sample values.
+ */
+static void *
+build_flat(void) {
+	static const uint8_t bits[] = { 0xa5, 0x5a, 0xf0 };
+	Flat_t *flat = (Flat_t *)calloc(1, sizeof(*flat));
+	if(!flat) return 0;
+	flat->id = 1234567;
+	flat->flag = 1;
+	if(asn_long2INTEGER(&flat->big, -987654321L)
+	|| OCTET_STRING_fromString(&flat->data, "A sample octet string"))
+		return 0;
+	flat->bits.buf = (uint8_t *)malloc(sizeof(bits));
+	if(!flat->bits.buf) return 0;
+	memcpy(flat->bits.buf, bits, sizeof(bits));
+	flat->bits.size = sizeof(bits);
+	flat->bits.bits_unused = 4;
+	flat->opt = (long *)malloc(sizeof(long));
+	if(!flat->opt) return 0;
+	*flat->opt = -42;
+	return flat;
+}
+
+static void *
+build_deep(void) {
+	Node_t *head = 0;
+	int i;
+
+	for(i = 0; i < 32; i++) {
+		Node_t *node = (Node_t *)calloc(1, sizeof(*node));
+		if(!node) return 0;
+		node->value = i * 1000;
+		node->next = head;
+		head = node;
+	}
+
+	return head;
+}
+
+static void *
+build_numbers(void) {
+	Numbers_t *numbers = (Numbers_t *)calloc(1, sizeof(*numbers));
+	int i;
+
+	if(!numbers) return 0;
+	for(i = 0; i < 4096; i++) {
+		long *value = (long *)malloc(sizeof(long));
+		if(!value) return 0;
+		*value = ((i * 7919L) % 100003) - 50000;
+		if(ASN_SET_ADD(&numbers->list, value)) return 0;
+	}
+
+	return numbers;
+}
+
+static void *
+build_alternatives(void) {
+	Alternatives_t *alts = (Alternatives_t *)calloc(1, sizeof(*alts));
+	int i;
+
+	if(!alts) return 0;
+	for(i = 0; i < 1024; i++) {
+		Alternative_t *alt = (Alternative_t *)calloc(1, sizeof(*alt));
+		if(!alt) return 0;
+		switch(i % 4) {
+		case 0:
+			alt->present = Alternative_PR_number;
+			alt->choice.number = i * 31;
+			break;
+		case 1:
+			alt->present = Alternative_PR_text;
+			if(OCTET_STRING_fromString(&alt->choice.text, "choice"))
+				return 0;
+			break;
+		case 2:
+			alt->present = Alternative_PR_flag;
+			alt->choice.flag = i & 8;
+			break;
+		case 3:
+			alt->present = Alternative_PR_none;
+			break;
+		}
+		if(ASN_SEQUENCE_ADD(&alts->list, alt)) return 0;
+	}
+
+	return alts;
+}
+
+static void *
+build_texts(void) {
+	Texts_t *texts = (Texts_t *)calloc(1, sizeof(*texts));
+	char buf[64];
+	int i;
+
+	if(!texts) return 0;
+	for(i = 0; i < 256; i++) {
+		UTF8String_t *text;
+		snprintf(buf, sizeof(buf),
+			"Text number %d, \xc3\xa9t\xc3\xa9 & <\xe2\x82\xac> %08x",
+			i, i * 2654435761U);
+		text = OCTET_STRING_new_fromBuf(&asn_DEF_UTF8String, buf, -1);
+		if(!text || ASN_SEQUENCE_ADD(&texts->list, text)) return 0;
+	}
+
+	return texts;
+}
+
+static void *
+build_reals(void) {
+	Reals_t *reals = (Reals_t *)calloc(1, sizeof(*reals));
+	int i;
+
+	if(!reals) return 0;
+	for(i = 0; i < 1024; i++) {
+		double *value = (double *)malloc(sizeof(double));
+		if(!value) return 0;
+		*value = (i - 512) * 3.14159265358979 / 7.0;
+		if(ASN_SEQUENCE_ADD(&reals->list, value)) return 0;
+	}
+
+	return reals;
+}
+
+static void *
+build_records(void) {
+	Records_t *records = (Records_t *)calloc(1, sizeof(*records));
+	char buf[64];
+	int i, j;
+
+	if(!records) return 0;
+	for(i = 0; i < 256; i++) {
+		Record_t *record = (Record_t *)calloc(1, sizeof(*record));
+		if(!record) return 0;
+		record->id = (i * 7919L) % 65536;
+		record->flag = i & 1;
+		snprintf(buf, sizeof(buf), "Record number %d", i);
+		if(OCTET_STRING_fromString(&record->data, buf))
+			return 0;
+		for(j = 0; j < i % 16; j++) {
+			long *value = (long *)malloc(sizeof(long));
+			if(!value) return 0;
+			*value = ((i * 31L + j * 97L) % 2001) - 1000;
+			if(ASN_SEQUENCE_ADD(&record->values.list, value))
+				return 0;
+		}
+		if(ASN_SEQUENCE_ADD(&records->list, record)) return 0;
+	}
+
+	return records;
+}
+
+/*
+ * The samples, each a type along with the builder of its value.
+ */
+static const struct codec_sample {
+	const char *name;
+	asn_TYPE_descriptor_t *td;
+	void *(*build)(void);
+} codec_samples[] = {
+	{ "flat-sequence",	&asn_DEF_Flat,		build_flat },
+	{ "deep-nesting",	&asn_DEF_Node,		build_deep },
+	{ "large-set-of",	&asn_DEF_Numbers,	build_numbers },
+	{ "choice-heavy",	&asn_DEF_Alternatives,	build_alternatives },
+	{ "string-heavy",	&asn_DEF_Texts,		build_texts },
+	{ "real-array",		&asn_DEF_Reals,		build_reals },
+	{ "per-records",	&asn_DEF_Records,	build_records }
+};
+#define	CODEC_SAMPLES_COUNT	(sizeof(codec_samples)/sizeof(codec_samples[0]))
+
+/*
+ * The transfer syntaxes the samples are decoded from, and their names
+ * in the names of the corpus files, "<kind>-<sample>-<syntax>-<hash>".
+ */
+static const struct codec_syntax {
+	const char *name;
+	enum asn_transfer_syntax syntax;
+} codec_syntaxes[] = {
+	{ "ber",	ATS_BER },
+	{ "xer",	ATS_BASIC_XER },
+	{ "uper",	ATS_UNALIGNED_PER },
+	{ "jer",	ATS_MINIFIED_JER },
+	{ "oer",	ATS_BASIC_OER }
+};
+#define	CODEC_SYNTAXES_COUNT	\
+	(sizeof(codec_syntaxes)/sizeof(codec_syntaxes[0]))
+
+#endif	/* _CODEC_SAMPLES_H_ */
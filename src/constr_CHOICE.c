@@ -5,6 +5,7 @@
  */
 #include <asn_internal.h>
 #include <constr_CHOICE.h>
+#include <jer_support.h>	/* JSON tokenizer */
 
 /*
  * Number of bytes left for this structure.
@@ -47,6 +48,7 @@
 #define	NEXT_PHASE(ctx)	do {			\
 		ctx->phase++;			\
 		ctx->step = 0;			\
+		ASN_TRACE_PHASE(td, ctx->phase, consumed_myself);\
 	} while(0)
 
 /*
@@ -200,6 +202,8 @@ CHOICE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				ASN_DEBUG("Unexpected tag %s "
 					"in non-extensible CHOICE %s",
 					ber_tlv_tag_string(tlv_tag), td->name);
+				ASN_DEC_ERROR(opt_codec_ctx, td,
+					ASN_DEC_ERROR_TAG, consumed_myself);
 				RETURN(RC_FAIL);
 			} else {
 				/* Skip this tag */
@@ -258,8 +262,8 @@ CHOICE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		/*
 		 * Invoke the member fetch routine according to member's type
 		 */
-		rval = elm->type->ber_decoder(opt_codec_ctx, elm->type,
-				memb_ptr2, ptr, LEFT, elm->tag_mode);
+		rval = ASN_CODEC(elm->type, ber_decoder)(opt_codec_ctx,
+				elm->type, memb_ptr2, ptr, LEFT, elm->tag_mode);
 		switch(rval.code) {
 		case RC_OK:
 			break;
@@ -268,8 +272,14 @@ CHOICE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				ADVANCE(rval.consumed);
 				RETURN(RC_WMORE);
 			}
+			ASN_DEC_ERROR(opt_codec_ctx, elm->type,
+				ASN_DEC_ERROR_LENGTH, 0);
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+				elm->name, -1, consumed_myself);
 			RETURN(RC_FAIL);
 		case RC_FAIL: /* Fatal error */
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+				elm->name, -1, consumed_myself);
 			RETURN(rval.code);
 		} /* switch(rval) */
 		
@@ -334,13 +344,11 @@ CHOICE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 					ctx->left++;
 					continue;
 				}
-			} else {
-				ASN_DEBUG("Unexpected continuation in %s",
-					td->name);
-				RETURN(RC_FAIL);
 			}
 
-			/* UNREACHABLE */
+			/* Neither <0><0> nor the incomplete one */
+			ASN_DEBUG("Unexpected continuation in %s", td->name);
+			RETURN(RC_FAIL);
 		}
 
 		NEXT_PHASE(ctx);
@@ -414,7 +422,7 @@ CHOICE_encode_der(asn_TYPE_descriptor_t *td, void *sptr,
 		ssize_t ret;
 
 		/* Encode member with its tag */
-		erval = elm->type->der_encoder(elm->type, memb_ptr,
+		erval = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			elm->tag_mode, elm->tag, 0, 0);
 		if(erval.encoded == -1)
 			return erval;
@@ -430,7 +438,7 @@ CHOICE_encode_der(asn_TYPE_descriptor_t *td, void *sptr,
 	/*
 	 * Encode the single underlying member.
 	 */
-	erval = elm->type->der_encoder(elm->type, memb_ptr,
+	erval = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 		elm->tag_mode, elm->tag, cb, app_key);
 	if(erval.encoded == -1)
 		return erval;
@@ -443,6 +451,74 @@ CHOICE_encode_der(asn_TYPE_descriptor_t *td, void *sptr,
 	return erval;
 }
 
+asn_enc_rval_t
+CHOICE_encode_cer(asn_TYPE_descriptor_t *td, void *sptr,
+		int tag_mode, ber_tlv_tag_t tag,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elm;	/* CHOICE element */
+	asn_enc_rval_t erval;
+	void *memb_ptr;
+	int tagged = (tag_mode == 1 || td->tags_count);
+	ssize_t ret = 0;
+	int present;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+
+	ASN_DEBUG("Encoding %s as CHOICE (CER)", td->name);
+
+	present = _fetch_present_idx(sptr,
+		specs->pres_offset, specs->pres_size);
+	if(present <= 0 || present > td->elements_count) {
+		if(present == 0 && td->elements_count == 0) {
+			/* The CHOICE is empty?! */
+			erval.encoded = 0;
+			_ASN_ENCODED_OK(erval);
+		}
+		_ASN_ENCODE_FAILED;
+	}
+
+	elm = &td->elements[present-1];
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+		if(memb_ptr == 0) {
+			if(elm->optional) {
+				erval.encoded = 0;
+				_ASN_ENCODED_OK(erval);
+			}
+			/* Mandatory element absent */
+			_ASN_ENCODE_FAILED;
+		}
+	} else {
+		memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+	}
+
+	/*
+	 * Unlike DER, the tags of the CHOICE itself do not need
+	 * the member to be measured first.
+	 */
+	if(tagged) {
+		ret = cer_write_tags(td, 0, tag_mode, 1, tag, cb, app_key);
+		if(ret == -1)
+			_ASN_ENCODE_FAILED;
+	}
+
+	erval = cer_type_encoder(elm->type)(elm->type, memb_ptr,
+		elm->tag_mode, elm->tag, cb, app_key);
+	if(erval.encoded == -1)
+		return erval;
+	erval.encoded += ret;
+
+	if(tagged) {
+		ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+		if(ret == -1)
+			_ASN_ENCODE_FAILED;
+		erval.encoded += ret;
+	}
+
+	return erval;
+}
+
 ber_tlv_tag_t
 CHOICE_outmost_tag(asn_TYPE_descriptor_t *td, const void *ptr, int tag_mode, ber_tlv_tag_t tag) {
 	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
@@ -611,20 +687,22 @@ CHOICE_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				memb_ptr2 = &memb_ptr;
 			}
 
+			/* Set presence to be able to free it properly at any time */
+			_set_present_idx(st,
+				specs->pres_offset, specs->pres_size, edx + 1);
+
 			/* Start/Continue decoding the inner member */
-			tmprval = elm->type->xer_decoder(opt_codec_ctx,
-					elm->type, memb_ptr2, elm->name,
-					buf_ptr, size);
+			tmprval = ASN_CODEC(elm->type, xer_decoder)(
+					opt_codec_ctx, elm->type, memb_ptr2,
+					elm->name, buf_ptr, size);
+			if(tmprval.code == RC_FAIL)
+				ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+					elm->name, -1, consumed_myself);
 			XER_ADVANCE(tmprval.consumed);
 			ASN_DEBUG("XER/CHOICE: itdf: [%s] code=%d",
 				elm->type->name, tmprval.code);
 			if(tmprval.code != RC_OK)
 				RETURN(tmprval.code);
-			assert(_fetch_present_idx(st,
-				specs->pres_offset, specs->pres_size) == 0);
-			/* Record what we've got */
-			_set_present_idx(st,
-				specs->pres_offset, specs->pres_size, edx + 1);
 			ctx->phase = 3;
 			/* Fall through */
 		}
@@ -707,29 +785,16 @@ CHOICE_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			/*
 			 * Search which inner member corresponds to this tag.
 			 */
-			for(edx = 0; edx < td->elements_count; edx++) {
-				elm = &td->elements[edx];
-				tcv = xer_check_tag(buf_ptr,ch_size,elm->name);
-				switch(tcv) {
-				case XCT_BOTH:
-				case XCT_OPENING:
-					/*
-					 * Process this member.
-					 */
-					ctx->step = edx;
-					ctx->phase = 2;
-					break;
-				case XCT_UNKNOWN_OP:
-				case XCT_UNKNOWN_BO:
-					continue;
-				default:
-					edx = td->elements_count;
-					break;	/* Phase out */
-				}
-				break;
-			}
-			if(edx != td->elements_count)
+			edx = xer_find_member(&specs->xer_index, td,
+				buf_ptr, ch_size);
+			if(edx >= 0) {
+				/*
+				 * Process this member.
+				 */
+				ctx->step = edx;
+				ctx->phase = 2;
 				continue;
+			}
 
 			/* It is expected extension */
 			if(specs->ext_start != -1) {
@@ -792,8 +857,10 @@ CHOICE_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 		asn_enc_rval_t tmper;
 		asn_TYPE_member_t *elm = &td->elements[present-1];
 		void *memb_ptr;
+		const xer_member_tags_t *tags
+			= xer_member_tags(&specs->xer_index, td, present - 1);
 		const char *mname = elm->name;
-		unsigned int mlen = strlen(mname);
+		unsigned int mlen = tags ? tags->name_len : strlen(mname);
 
 		if(elm->flags & ATF_POINTER) {
 			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
@@ -805,13 +872,15 @@ CHOICE_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 		er.encoded = 0;
 
                 if(!(flags & XER_F_CANONICAL)) _i_ASN_TEXT_INDENT(1, ilevel);
-		_ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
+		if(tags) _ASN_CALLBACK(tags->open, mlen + 2);
+		else _ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
 
-		tmper = elm->type->xer_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, xer_encoder)(elm->type, memb_ptr,
 				ilevel + 1, flags, cb, app_key);
 		if(tmper.encoded == -1) return tmper;
 
-		_ASN_CALLBACK3("</", 2, mname, mlen, ">", 1);
+		if(tags) _ASN_CALLBACK(tags->close, mlen + 3);
+		else _ASN_CALLBACK3("</", 2, mname, mlen, ">", 1);
 
 		er.encoded += 5 + (2 * mlen) + tmper.encoded;
 	}
@@ -823,6 +892,164 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * JER represents CHOICE by the object with the single member.
+ */
+asn_enc_rval_t
+CHOICE_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_CHOICE_specifics_t *specs=(asn_CHOICE_specifics_t *)td->specifics;
+	asn_enc_rval_t er, tmper;
+	asn_TYPE_member_t *elm;
+	jer_type_encoder_f *encoder;
+	int pretty = !(flags & JER_F_MINIFIED);
+	void *memb_ptr;
+	size_t mlen;
+	int present;
+
+	if(!sptr)
+		_ASN_ENCODE_FAILED;
+
+	/*
+	 * Figure out which CHOICE element is encoded.
+	 */
+	present = _fetch_present_idx(sptr, specs->pres_offset,specs->pres_size);
+	if(present <= 0 || present > td->elements_count)
+		_ASN_ENCODE_FAILED;
+
+	elm = &td->elements[present-1];
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+		if(!memb_ptr) _ASN_ENCODE_FAILED;
+	} else {
+		memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+	}
+
+	encoder = jer_type_encoder(elm->type);
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	er.encoded = 0;
+	_ASN_CALLBACK("{", 1);
+	if(pretty) _i_ASN_TEXT_INDENT(1, ilevel + 1);
+	mlen = strlen(elm->name);
+	_ASN_CALLBACK3("\"", 1, elm->name, mlen, "\": ", pretty ? 3 : 2);
+
+	tmper = encoder(elm->type, memb_ptr, ilevel + 1, flags, cb, app_key);
+	if(tmper.encoded == -1) return tmper;
+
+	if(pretty) _i_ASN_TEXT_INDENT(1, ilevel);
+	_ASN_CALLBACK("}", 1);
+
+	er.encoded += mlen + (pretty ? 4 : 3) + 2 + tmper.encoded;
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
+/*
+ * Decode the JER object holding the chosen member.
+ * The value is complete: jer_decode() has delimited it already.
+ */
+asn_dec_rval_t
+CHOICE_decode_jer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	void **struct_ptr, const void *buf_ptr, size_t size) {
+	asn_CHOICE_specifics_t *specs=(asn_CHOICE_specifics_t *)td->specifics;
+	const char *buf = (const char *)buf_ptr;
+	void *st = *struct_ptr;	/* Target structure. */
+	asn_TYPE_member_t *elm;
+	jer_type_decoder_f *decoder;
+	void *memb_ptr;		/* Pointer to the member */
+	void **memb_ptr2;	/* Pointer to that pointer */
+	asn_dec_rval_t rval;
+	jer_token_t tok;
+	size_t consumed = 0;
+	char name[64];
+	const char *key;
+	ssize_t klen;
+	int edx;
+
+#define	JER_NEXT_TOKEN()	do {					\
+		size_t __n = jer_next_token(buf + consumed,		\
+			size - consumed, &tok);				\
+		if(tok.type == JT_MORE) goto want_more;			\
+		consumed += __n;					\
+	} while(0)
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	JER_NEXT_TOKEN();
+	if(tok.type != JT_OBJECT_START)
+		_ASN_DECODE_FAILED;
+
+	/*
+	 * Create the target structure if it is not present already.
+	 */
+	if(st == 0) {
+		st = *struct_ptr = CALLOC(1, specs->struct_size);
+		if(st == 0) _ASN_DECODE_FAILED;
+	}
+
+	JER_NEXT_TOKEN();
+	if(tok.type != JT_STRING) _ASN_DECODE_FAILED;
+	key = tok.start;
+	klen = tok.length;
+	if(tok.escaped) {
+		if(tok.length > sizeof(name)) _ASN_DECODE_FAILED;
+		klen = jer_unescape(tok.start, tok.length, name);
+		if(klen < 0) _ASN_DECODE_FAILED;
+		key = name;
+	}
+
+	JER_NEXT_TOKEN();
+	if(tok.type != JT_COLON) _ASN_DECODE_FAILED;
+
+	edx = xer_find_member_name(&specs->xer_index, td, key, klen);
+	if(edx < 0 || _fetch_present_idx(st,
+			specs->pres_offset, specs->pres_size)) {
+		/* The unknown extension can not be represented */
+		ASN_DEBUG("CHOICE %s: unexpected or extra member", td->name);
+		_ASN_DECODE_FAILED;
+	}
+
+	elm = &td->elements[edx];
+	if(elm->flags & ATF_POINTER) {
+		/* Member is a pointer to another structure */
+		memb_ptr2 = (void **)((char *)st + elm->memb_offset);
+	} else {
+		memb_ptr = (char *)st + elm->memb_offset;
+		memb_ptr2 = &memb_ptr;
+	}
+
+	decoder = jer_type_decoder(elm->type);
+	if(!decoder) _ASN_DECODE_FAILED;
+	/* Set presence before the decoding so the value is freed anyway */
+	_set_present_idx(st, specs->pres_offset, specs->pres_size, edx + 1);
+	rval = decoder(opt_codec_ctx, elm->type, memb_ptr2,
+		buf + consumed, size - consumed);
+	if(rval.code != RC_OK) {
+		ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+			elm->name, -1, consumed);
+		rval.consumed = 0;
+		return rval;
+	}
+	consumed += rval.consumed;
+
+	JER_NEXT_TOKEN();
+	if(tok.type != JT_OBJECT_END) _ASN_DECODE_FAILED;
+#undef	JER_NEXT_TOKEN
+
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+
+want_more:
+	rval.code = RC_WMORE;
+	rval.consumed = 0;
+	return rval;
+}
+
 asn_dec_rval_t
 CHOICE_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 	asn_per_constraints_t *constraints, void **sptr, asn_per_data_t *pd) {
@@ -892,11 +1119,22 @@ CHOICE_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 	}
 	ASN_DEBUG("Discovered CHOICE %s encodes %s", td->name, elm->name);
 
-	rv = elm->type->uper_decoder(opt_codec_ctx, elm->type,
-			elm->per_constraints, memb_ptr2, pd);
-	if(rv.code != RC_OK)
+	if(!elm->type->uper_decoder) {
+		/* No PER support for the member */
+		ASN_DEC_ERROR(opt_codec_ctx, elm->type,
+			ASN_DEC_ERROR_UNSUPPORTED, 0);
+		ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+			elm->name, -1, 0);
+		_ASN_DECODE_FAILED;
+	}
+	rv = ASN_CODEC(elm->type, uper_decoder)(opt_codec_ctx,
+			elm->type, elm->per_constraints, memb_ptr2, pd);
+	if(rv.code != RC_OK) {
 		ASN_DEBUG("Failed to decode %s in %s (CHOICE)",
 			elm->name, td->name);
+		ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+			elm->name, -1, 0);
+	}
 	return rv;
 }
    
@@ -972,8 +1210,149 @@ CHOICE_encode_uper(asn_TYPE_descriptor_t *td,
 		memb_ptr = (char *)sptr + elm->memb_offset;
 	}
 
-	return elm->type->uper_encoder(elm->type, elm->per_constraints,
-			memb_ptr, po);
+	if(!elm->type->uper_encoder)
+		_ASN_ENCODE_FAILED;	/* No PER support for the member */
+	return ASN_CODEC(elm->type, uper_encoder)(elm->type,
+			elm->per_constraints, memb_ptr, po);
+}
+
+/*
+ * X.696 #20: the tag of the alternative followed by its encoding;
+ * the extension alternatives are wrapped into the open type.
+ */
+asn_dec_rval_t
+CHOICE_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	asn_TYPE_tag2member_t key;
+	asn_TYPE_tag2member_t *t2m;
+	asn_TYPE_member_t *elm;
+	void *memb_ptr;		/* Pointer to the member */
+	void **memb_ptr2;	/* Pointer to that pointer */
+	void *st = *sptr;
+	asn_dec_rval_t rv;
+	ssize_t skip;
+	int edx;
+
+	(void)constraints;
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	skip = oer_fetch_tag(buf_ptr, size, &key.el_tag);
+	if(skip < 0) _ASN_DECODE_FAILED;
+	if(skip == 0) {
+		rv.code = RC_WMORE;
+		rv.consumed = 0;
+		return rv;
+	}
+
+	t2m = (asn_TYPE_tag2member_t *)bsearch(&key,
+			specs->tag2el, specs->tag2el_count,
+			sizeof(specs->tag2el[0]), _search4tag);
+	if(!t2m) {
+		/* The unknown extension can not be represented */
+		ASN_DEBUG("Unexpected tag %s in CHOICE %s",
+			ber_tlv_tag_string(key.el_tag), td->name);
+		_ASN_DECODE_FAILED;
+	}
+	edx = t2m->el_no;
+
+	if(!st) {
+		st = *sptr = CALLOC(1, specs->struct_size);
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	elm = &td->elements[edx];
+	if(elm->flags & ATF_POINTER) {
+		/* Member is a pointer to another structure */
+		memb_ptr2 = (void **)((char *)st + elm->memb_offset);
+	} else {
+		memb_ptr = (char *)st + elm->memb_offset;
+		memb_ptr2 = &memb_ptr;
+	}
+
+	/* Set presence before the decoding so the value is freed anyway */
+	_set_present_idx(st, specs->pres_offset, specs->pres_size, edx + 1);
+
+	ASN_DEBUG("Discovered CHOICE %s encodes %s", td->name, elm->name);
+
+	if(specs->ext_start != -1 && edx >= specs->ext_start) {
+		rv = oer_open_type_get(opt_codec_ctx, elm->type,
+			elm->per_constraints, memb_ptr2,
+			(const char *)buf_ptr + skip, size - skip);
+	} else {
+		oer_type_decoder_f *decoder = oer_type_decoder(elm->type);
+		if(!decoder) _ASN_DECODE_FAILED;
+		rv = decoder(opt_codec_ctx, elm->type, elm->per_constraints,
+			memb_ptr2, (const char *)buf_ptr + skip, size - skip);
+	}
+	if(rv.code == RC_OK)
+		rv.consumed += skip;
+	else
+		ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+			elm->name, -1, skip);
+	return rv;
+}
+
+asn_enc_rval_t
+CHOICE_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elm;	/* CHOICE's element */
+	asn_enc_rval_t er;
+	void *memb_ptr;
+	ssize_t ret;
+	int present;
+
+	(void)constraints;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+
+	ASN_DEBUG("Encoding %s as CHOICE (OER)", td->name);
+
+	present = _fetch_present_idx(sptr,
+		specs->pres_offset, specs->pres_size);
+
+	/*
+	 * If the structure was not initialized properly, it cannot be encoded:
+	 * can't deduce what to encode in the choice type.
+	 */
+	if(present <= 0 || present > td->elements_count)
+		_ASN_ENCODE_FAILED;
+	else
+		present--;
+
+	elm = &td->elements[present];
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+		if(!memb_ptr) _ASN_ENCODE_FAILED;
+	} else {
+		memb_ptr = (char *)sptr + elm->memb_offset;
+	}
+
+	/* The untagged CHOICE alternative repeats the tag of its own */
+	ret = oer_serialize_tag(asn_TYPE_outmost_tag(elm->type, memb_ptr,
+		elm->tag_mode, elm->tag), cb, app_key);
+	if(ret < 0) _ASN_ENCODE_FAILED;
+
+	if(specs->ext_start != -1 && present >= specs->ext_start) {
+		er = oer_open_type_put(elm->type, elm->per_constraints,
+			memb_ptr, flags, cb, app_key);
+	} else {
+		oer_type_encoder_f *encoder = oer_type_encoder(elm->type);
+		if(!encoder) _ASN_ENCODE_FAILED;
+		er = encoder(elm->type, elm->per_constraints, memb_ptr,
+			flags, cb, app_key);
+	}
+	if(er.encoded == -1)
+		return er;
+	er.encoded += ret;
+
+	_ASN_ENCODED_OK(er);
 }
    
 
@@ -1055,6 +1434,93 @@ CHOICE_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 	}
 }
 
+/*
+ * Fetch the pointer to the present member.
+ */
+static const void *
+_CHOICE_compared_member(asn_TYPE_member_t *elm, const void *sptr) {
+	if(elm->flags & ATF_POINTER)
+		return *(const void * const *)((const char *)sptr
+			+ elm->memb_offset);
+	else
+		return (const void *)((const char *)sptr + elm->memb_offset);
+}
+
+int
+CHOICE_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elm;
+	int present;
+
+	present = _fetch_present_idx(struct_a,
+		specs->pres_offset, specs->pres_size);
+	if(present != _fetch_present_idx(struct_b,
+			specs->pres_offset, specs->pres_size))
+		return 0;
+	if(present <= 0 || present > td->elements_count)
+		return 1;	/* Neither has an element */
+
+	elm = &td->elements[present-1];
+	return asn_equals(elm->type,
+		_CHOICE_compared_member(elm, struct_a),
+		_CHOICE_compared_member(elm, struct_b));
+}
+
+uint64_t
+CHOICE_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	asn_TYPE_member_t *elm;
+	uint64_t hash;
+	int present;
+
+	present = _fetch_present_idx(sptr, specs->pres_offset, specs->pres_size);
+	if(present <= 0 || present > td->elements_count)
+		return asn_hash__end(0);
+
+	elm = &td->elements[present-1];
+	hash = asn_hash__value(0, present);
+	hash = asn_hash__value(hash, asn_hash(elm->type,
+		_CHOICE_compared_member(elm, sptr)));
+
+	return asn_hash__end(hash);
+}
+
+int
+CHOICE_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	void *st;
+	int present;
+
+	st = asn_copy__struct(copy, struct_dst, specs->struct_size);
+	if(!st) return -1;
+
+	present = _fetch_present_idx(struct_src,
+		specs->pres_offset, specs->pres_size);
+	if(present <= 0 || present > td->elements_count)
+		return 0;	/* Nothing is present */
+	if(!ASN_COPY_MEASURING(copy))
+		_set_present_idx(st, specs->pres_offset,
+			specs->pres_size, present);
+
+	return asn_copy__member(copy, &td->elements[present-1],
+		st, struct_src);
+}
+
+int
+CHOICE_present(asn_TYPE_descriptor_t *td, const void *struct_ptr) {
+	asn_CHOICE_specifics_t *specs = (asn_CHOICE_specifics_t *)td->specifics;
+	int present;
+
+	present = _fetch_present_idx(struct_ptr,
+		specs->pres_offset, specs->pres_size);
+	if(present <= 0 || present > td->elements_count)
+		return 0;
+
+	return present;
+}
+
 
 /*
  * The following functions functions offer protection against -fshort-enums,
@@ -34,6 +34,11 @@ typedef struct asn_CHOICE_specifics_s {
 	 * Extensions-related stuff.
 	 */
 	int ext_start;		/* First member of extensions, or -1 */
+
+	/*
+	 * Member lookup by XML tag name, built by the XER decoder.
+	 */
+	struct asn_xer_member_index_s *xer_index;
 } asn_CHOICE_specifics_t;
 
 /*
@@ -44,12 +49,25 @@ asn_struct_print_f CHOICE_print;
 asn_constr_check_f CHOICE_constraint;
 ber_type_decoder_f CHOICE_decode_ber;
 der_type_encoder_f CHOICE_encode_der;
+cer_type_encoder_f CHOICE_encode_cer;
 xer_type_decoder_f CHOICE_decode_xer;
 xer_type_encoder_f CHOICE_encode_xer;
+jer_type_decoder_f CHOICE_decode_jer;
+jer_type_encoder_f CHOICE_encode_jer;
 per_type_decoder_f CHOICE_decode_uper;
 per_type_encoder_f CHOICE_encode_uper;
+oer_type_decoder_f CHOICE_decode_oer;
+oer_type_encoder_f CHOICE_encode_oer;
+asn_struct_equals_f CHOICE_equals;
+asn_struct_hash_f CHOICE_hash;
+asn_struct_copy_f CHOICE_copy;
 asn_outmost_tag_f CHOICE_outmost_tag;
 
+/*
+ * The number of the present alternative, counting from 1; 0 if none.
+ */
+int CHOICE_present(struct asn_TYPE_descriptor_s *td, const void *struct_ptr);
+
 #ifdef __cplusplus
 }
 #endif
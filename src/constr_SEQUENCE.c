@@ -5,6 +5,7 @@
  */
 #include <asn_internal.h>
 #include <constr_SEQUENCE.h>
+#include <jer_support.h>	/* JSON tokenizer */
 
 /*
  * Number of bytes left for this structure.
@@ -48,8 +49,12 @@
 #define	NEXT_PHASE(ctx)	do {			\
 		ctx->phase++;			\
 		ctx->step = 0;			\
+		ASN_TRACE_PHASE(td, ctx->phase, consumed_myself);\
+	} while(0)
+#define	PHASE_OUT(ctx)	do {			\
+		ctx->phase = 10;		\
+		ASN_TRACE_PHASE(td, ctx->phase, consumed_myself);\
 	} while(0)
-#define	PHASE_OUT(ctx)	do { ctx->phase = 10; } while(0)
 
 /*
  * Return a standardized complex structure.
@@ -136,6 +141,8 @@ SEQUENCE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 	if(st == 0) {
 		st = *struct_ptr = CALLOC(1, specs->struct_size);
 		if(st == 0) {
+			ASN_DEC_ERROR(opt_codec_ctx, td,
+				ASN_DEC_ERROR_MEMORY, 0);
 			RETURN(RC_FAIL);
 		}
 	}
@@ -236,7 +243,12 @@ SEQUENCE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		switch(tag_len) {
 		case 0: if(!SIZE_VIOLATION) RETURN(RC_WMORE);
 			/* Fall through */
-		case -1: RETURN(RC_FAIL);
+		case -1:
+			/* Out of the data before the end of the mandatory ones */
+			ASN_DEC_ERROR(opt_codec_ctx, td, ctx->left
+				? ASN_DEC_ERROR_TAG : ASN_DEC_ERROR_MISSING,
+				consumed_myself);
+			RETURN(RC_FAIL);
 		}
 
 		if(ctx->left < 0 && ((const uint8_t *)ptr)[0] == 0) {
@@ -354,6 +366,8 @@ SEQUENCE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 					elements[edx].name,
 					elements[edx].optional
 						?" or alternatives":"");
+				ASN_DEC_ERROR(opt_codec_ctx, td,
+					ASN_DEC_ERROR_TAG, consumed_myself);
 				RETURN(RC_FAIL);
 			} else {
 				/* Skip this tag */
@@ -404,7 +418,7 @@ SEQUENCE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		/*
 		 * Invoke the member fetch routine according to member's type
 		 */
-		rval = elements[edx].type->ber_decoder(opt_codec_ctx,
+		rval = ASN_CODEC(elements[edx].type, ber_decoder)(opt_codec_ctx,
 				elements[edx].type,
 				memb_ptr2, ptr, LEFT,
 				elements[edx].tag_mode);
@@ -422,8 +436,12 @@ SEQUENCE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			}
 			ASN_DEBUG("Size violation (c->l=%ld <= s=%ld)",
 				(long)ctx->left, (long)size);
+			ASN_DEC_ERROR(opt_codec_ctx, elements[edx].type,
+				ASN_DEC_ERROR_LENGTH, 0);
 			/* Fall through */
 		case RC_FAIL: /* Fatal error */
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elements[edx].type,
+				elements[edx].name, -1, consumed_myself);
 			RETURN(RC_FAIL);
 		} /* switch(rval) */
 		
@@ -479,6 +497,8 @@ SEQUENCE_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 					"%s (SEQUENCE): %s",
 					td->name,
 					ber_tlv_tag_string(tlv_tag));
+				ASN_DEC_ERROR(opt_codec_ctx, td,
+					ASN_DEC_ERROR_TAG, consumed_myself);
 				RETURN(RC_FAIL);
 			}
 
@@ -532,7 +552,7 @@ SEQUENCE_encode_der(asn_TYPE_descriptor_t *td,
 		} else {
 			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
 		}
-		erval = elm->type->der_encoder(elm->type, memb_ptr,
+		erval = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			elm->tag_mode, elm->tag,
 			0, 0);
 		if(erval.encoded == -1)
@@ -567,7 +587,7 @@ SEQUENCE_encode_der(asn_TYPE_descriptor_t *td,
 		} else {
 			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
 		}
-		tmperval = elm->type->der_encoder(elm->type, memb_ptr,
+		tmperval = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			elm->tag_mode, elm->tag,
 			cb, app_key);
 		if(tmperval.encoded == -1)
@@ -586,6 +606,56 @@ SEQUENCE_encode_der(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(erval);
 }
 
+/*
+ * The CER encoder of the SEQUENCE type: the members are streamed out
+ * within the indefinite length, without measuring them first.
+ */
+asn_enc_rval_t
+SEQUENCE_encode_cer(asn_TYPE_descriptor_t *td,
+	void *sptr, int tag_mode, ber_tlv_tag_t tag,
+	asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t erval;
+	ssize_t ret;
+	int edx;
+
+	ASN_DEBUG("Encoding %s as SEQUENCE (CER)", td->name);
+
+	ret = cer_write_tags(td, 0, tag_mode, 1, tag, cb, app_key);
+	if(ret == -1)
+		_ASN_ENCODE_FAILED;
+	erval.encoded = ret;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		asn_enc_rval_t tmperval;
+		void *memb_ptr;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+			if(!memb_ptr) {
+				if(elm->optional) continue;
+				/* Mandatory element is missing */
+				_ASN_ENCODE_FAILED;
+			}
+		} else {
+			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+		}
+		tmperval = cer_type_encoder(elm->type)(elm->type, memb_ptr,
+			elm->tag_mode, elm->tag,
+			cb, app_key);
+		if(tmperval.encoded == -1)
+			return tmperval;
+		erval.encoded += tmperval.encoded;
+	}
+
+	ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+	if(ret == -1)
+		_ASN_ENCODE_FAILED;
+	erval.encoded += ret;
+
+	_ASN_ENCODED_OK(erval);
+}
+
 
 #undef	XER_ADVANCE
 #define	XER_ADVANCE(num_bytes)	do {			\
@@ -670,9 +740,12 @@ SEQUENCE_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			}
 
 			/* Invoke the inner type decoder, m.b. multiple times */
-			tmprval = elm->type->xer_decoder(opt_codec_ctx,
-					elm->type, memb_ptr2, elm->name,
-					buf_ptr, size);
+			tmprval = ASN_CODEC(elm->type, xer_decoder)(
+					opt_codec_ctx, elm->type, memb_ptr2,
+					elm->name, buf_ptr, size);
+			if(tmprval.code == RC_FAIL)
+				ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+					elm->name, -1, consumed_myself);
 			XER_ADVANCE(tmprval.consumed);
 			if(tmprval.code != RC_OK)
 				RETURN(tmprval.code);
@@ -775,30 +848,16 @@ SEQUENCE_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				edx_end = edx + elements[edx].optional + 1;
 				if(edx_end > td->elements_count)
 					edx_end = td->elements_count;
-				for(n = edx; n < edx_end; n++) {
-					elm = &td->elements[n];
-					tcv = xer_check_tag(buf_ptr,
-						ch_size, elm->name);
-					switch(tcv) {
-					case XCT_BOTH:
-					case XCT_OPENING:
-						/*
-						 * Process this member.
-						 */
-						ctx->step = edx = n;
-						ctx->phase = 2;
-						break;
-					case XCT_UNKNOWN_OP:
-					case XCT_UNKNOWN_BO:
-						continue;
-					default:
-						n = edx_end;
-						break;	/* Phase out */
-					}
-					break;
-				}
-				if(n != edx_end)
+				n = xer_find_member(&specs->xer_index, td,
+					buf_ptr, ch_size);
+				if(n >= edx && n < edx_end) {
+					/*
+					 * Process this member.
+					 */
+					ctx->step = edx = n;
+					ctx->phase = 2;
 					continue;
+				}
 			} else {
 				ASN_DEBUG("Out of defined members: %d/%d",
 					edx, td->elements_count);
@@ -848,6 +907,8 @@ asn_enc_rval_t
 SEQUENCE_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	int ilevel, enum xer_encoder_flags_e flags,
 		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_SEQUENCE_specifics_t *specs
+		= (asn_SEQUENCE_specifics_t *)td->specifics;
 	asn_enc_rval_t er;
 	int xcan = (flags & XER_F_CANONICAL);
 	int edx;
@@ -861,8 +922,10 @@ SEQUENCE_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 		asn_enc_rval_t tmper;
 		asn_TYPE_member_t *elm = &td->elements[edx];
 		void *memb_ptr;
+		const xer_member_tags_t *tags
+			= xer_member_tags(&specs->xer_index, td, edx);
 		const char *mname = elm->name;
-		unsigned int mlen = strlen(mname);
+		unsigned int mlen = tags ? tags->name_len : strlen(mname);
 
 		if(elm->flags & ATF_POINTER) {
 			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
@@ -877,14 +940,16 @@ SEQUENCE_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 		}
 
 		if(!xcan) _i_ASN_TEXT_INDENT(1, ilevel);
-		_ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
+		if(tags) _ASN_CALLBACK(tags->open, mlen + 2);
+		else _ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
 
 		/* Print the member itself */
-		tmper = elm->type->xer_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, xer_encoder)(elm->type, memb_ptr,
 			ilevel + 1, flags, cb, app_key);
 		if(tmper.encoded == -1) return tmper;
 
-		_ASN_CALLBACK3("</", 2, mname, mlen, ">", 1);
+		if(tags) _ASN_CALLBACK(tags->close, mlen + 3);
+		else _ASN_CALLBACK3("</", 2, mname, mlen, ">", 1);
 		er.encoded += 5 + (2 * mlen) + tmper.encoded;
 	}
 
@@ -895,6 +960,221 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * JER represents SEQUENCE by the object keyed by the member names.
+ */
+asn_enc_rval_t
+SEQUENCE_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+	int pretty = !(flags & JER_F_MINIFIED);
+	int members = 0;
+	int edx;
+
+	if(!sptr)
+		_ASN_ENCODE_FAILED;
+
+	_ASN_CALLBACK("{", 1);
+	er.encoded = 1;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_enc_rval_t tmper;
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		jer_type_encoder_f *encoder;
+		void *memb_ptr;
+		size_t mlen;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+			if(!memb_ptr) {
+				if(elm->optional)
+					continue;
+				/* Mandatory element is missing */
+				_ASN_ENCODE_FAILED;
+			}
+		} else {
+			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+		}
+
+		encoder = jer_type_encoder(elm->type);
+		if(!encoder) _ASN_ENCODE_FAILED;
+
+		if(members++) {
+			_ASN_CALLBACK(",", 1);
+			er.encoded++;
+		}
+		if(pretty) _i_ASN_TEXT_INDENT(1, ilevel + 1);
+		mlen = strlen(elm->name);
+		_ASN_CALLBACK3("\"", 1, elm->name, mlen,
+			"\": ", pretty ? 3 : 2);
+		er.encoded += mlen + (pretty ? 4 : 3);
+
+		/* Print the member itself */
+		tmper = encoder(elm->type, memb_ptr,
+			ilevel + 1, flags, cb, app_key);
+		if(tmper.encoded == -1) return tmper;
+		er.encoded += tmper.encoded;
+	}
+
+	if(pretty && members) _i_ASN_TEXT_INDENT(1, ilevel);
+	_ASN_CALLBACK("}", 1);
+	er.encoded++;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
+/*
+ * Decode the JER object of SEQUENCE members, in any order.
+ * The value is complete: jer_decode() has delimited it already.
+ */
+asn_dec_rval_t
+SEQUENCE_decode_jer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	void **struct_ptr, const void *buf_ptr, size_t size) {
+	asn_SEQUENCE_specifics_t *specs
+		= (asn_SEQUENCE_specifics_t *)td->specifics;
+	const char *buf = (const char *)buf_ptr;
+	void *st = *struct_ptr;	/* Target structure. */
+	uint8_t seen_local[32];	/* Members met so far */
+	uint8_t *seen = seen_local;
+	asn_dec_rval_t rval;
+	jer_token_t tok;
+	size_t consumed = 0;
+	int first = 1;
+	int edx;
+
+#define	JER_NEXT_TOKEN()	do {					\
+		size_t __n = jer_next_token(buf + consumed,		\
+			size - consumed, &tok);				\
+		if(tok.type == JT_MORE) goto want_more;			\
+		consumed += __n;					\
+	} while(0)
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	JER_NEXT_TOKEN();
+	if(tok.type != JT_OBJECT_START)
+		_ASN_DECODE_FAILED;
+
+	/*
+	 * Create the target structure if it is not present already.
+	 */
+	if(st == 0) {
+		st = *struct_ptr = CALLOC(1, specs->struct_size);
+		if(st == 0) _ASN_DECODE_FAILED;
+	}
+
+	if((size_t)td->elements_count > 8 * sizeof(seen_local)) {
+		seen = (uint8_t *)CALLOC(1, (td->elements_count + 7) / 8);
+		if(!seen) _ASN_DECODE_FAILED;
+	} else {
+		memset(seen_local, 0, sizeof(seen_local));
+	}
+
+	for(;;) {
+		asn_TYPE_member_t *elm;
+		jer_type_decoder_f *decoder;
+		void *memb_ptr;		/* Pointer to the member */
+		void **memb_ptr2;	/* Pointer to that pointer */
+		char name[64];
+		const char *key;
+		ssize_t klen;
+
+		JER_NEXT_TOKEN();
+		if(tok.type == JT_OBJECT_END && first)
+			break;	/* {} */
+		first = 0;
+		if(tok.type != JT_STRING) goto failed;
+		key = tok.start;
+		klen = tok.length;
+		if(tok.escaped) {
+			if(tok.length > sizeof(name)) goto failed;
+			klen = jer_unescape(tok.start, tok.length, name);
+			if(klen < 0) goto failed;
+			key = name;
+		}
+
+		JER_NEXT_TOKEN();
+		if(tok.type != JT_COLON) goto failed;
+
+		edx = xer_find_member_name(&specs->xer_index, td, key, klen);
+		if(edx < 0) {
+			ssize_t vlen;
+			/* Extensions unknown to us are skipped */
+			if(!IN_EXTENSION_GROUP(specs, td->elements_count))
+				goto failed;
+			vlen = jer_value_length(buf + consumed,
+				size - consumed, 0);
+			if(vlen == 0) goto want_more;
+			if(vlen < 0) goto failed;
+			consumed += vlen;
+		} else {
+			if(seen[edx >> 3] & (1 << (edx & 7)))
+				goto failed;	/* Duplicate member */
+			seen[edx >> 3] |= 1 << (edx & 7);
+
+			elm = &td->elements[edx];
+			if(elm->flags & ATF_POINTER) {
+				/* Member is a pointer to another structure */
+				memb_ptr2 = (void **)((char *)st
+					+ elm->memb_offset);
+			} else {
+				memb_ptr = (char *)st + elm->memb_offset;
+				memb_ptr2 = &memb_ptr;
+			}
+
+			decoder = jer_type_decoder(elm->type);
+			if(!decoder) goto failed;
+			rval = decoder(opt_codec_ctx, elm->type, memb_ptr2,
+				buf + consumed, size - consumed);
+			if(rval.code != RC_OK) {
+				ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+					elm->name, -1, consumed);
+				if(seen != seen_local) FREEMEM(seen);
+				rval.consumed = 0;
+				return rval;
+			}
+			consumed += rval.consumed;
+		}
+
+		JER_NEXT_TOKEN();
+		if(tok.type == JT_OBJECT_END) break;
+		if(tok.type != JT_COMMA) goto failed;
+	}
+#undef	JER_NEXT_TOKEN
+
+	/*
+	 * Check that the mandatory members are all there.
+	 */
+	for(edx = 0; edx < td->elements_count; edx++) {
+		if(seen[edx >> 3] & (1 << (edx & 7)))
+			continue;
+		if(td->elements[edx].optional
+		|| IN_EXTENSION_GROUP(specs, edx))
+			continue;
+		ASN_DEBUG("JER/SEQUENCE %s: missing member %s",
+			td->name, td->elements[edx].name);
+		goto failed;
+	}
+
+	if(seen != seen_local) FREEMEM(seen);
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+
+want_more:
+	if(seen != seen_local) FREEMEM(seen);
+	rval.code = RC_WMORE;
+	rval.consumed = 0;
+	return rval;
+failed:
+	if(seen != seen_local) FREEMEM(seen);
+	_ASN_DECODE_FAILED;
+}
+
 int
 SEQUENCE_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 		asn_app_consume_bytes_f *cb, void *app_key) {
@@ -970,6 +1250,77 @@ SEQUENCE_free(asn_TYPE_descriptor_t *td, void *sptr, int contents_only) {
 	}
 }
 
+/*
+ * Fetch the member to be compared or hashed: 0 if it is absent
+ * or has its DEFAULT value, so either way compares the same.
+ */
+static void *
+_SEQUENCE_compared_member(asn_TYPE_member_t *elm, const void *sptr) {
+	void *memb_ptr;
+
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr = *(void * const *)((const char *)sptr + elm->memb_offset);
+		if(!memb_ptr) return 0;
+	} else {
+		memb_ptr = (void *)((const char *)sptr + elm->memb_offset);
+	}
+
+	if(elm->default_value && elm->default_value(0, &memb_ptr) == 1)
+		return 0;
+
+	return memb_ptr;
+}
+
+int
+SEQUENCE_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	int edx;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		if(!asn_equals(elm->type,
+				_SEQUENCE_compared_member(elm, struct_a),
+				_SEQUENCE_compared_member(elm, struct_b)))
+			return 0;
+	}
+
+	return 1;
+}
+
+uint64_t
+SEQUENCE_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	uint64_t hash = 0;
+	int edx;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		void *memb_ptr = _SEQUENCE_compared_member(elm, sptr);
+		if(!memb_ptr) continue;
+		hash = asn_hash__value(hash, edx);
+		hash = asn_hash__value(hash, asn_hash(elm->type, memb_ptr));
+	}
+
+	return asn_hash__end(hash);
+}
+
+int
+SEQUENCE_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	asn_SEQUENCE_specifics_t *specs = (asn_SEQUENCE_specifics_t *)td->specifics;
+	void *st;
+	int edx;
+
+	st = asn_copy__struct(copy, struct_dst, specs->struct_size);
+	if(!st) return -1;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		if(asn_copy__member(copy, &td->elements[edx], st, struct_src))
+			return -1;
+	}
+
+	return 0;
+}
+
 int
 SEQUENCE_constraint(asn_TYPE_descriptor_t *td, const void *sptr,
 		asn_app_constraint_failed_f *ctfailcb, void *app_key) {
@@ -1110,11 +1461,21 @@ SEQUENCE_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 
 		/* Fetch the member from the stream */
 		ASN_DEBUG("Decoding member %s in %s", elm->name, td->name);
-		rv = elm->type->uper_decoder(opt_codec_ctx, elm->type,
-			elm->per_constraints, memb_ptr2, pd);
+		if(!elm->type->uper_decoder) {
+			/* No PER support for the member */
+			ASN_DEC_ERROR(opt_codec_ctx, elm->type,
+				ASN_DEC_ERROR_UNSUPPORTED, 0);
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+				elm->name, -1, 0);
+			_ASN_DECODE_FAILED;
+		}
+		rv = ASN_CODEC(elm->type, uper_decoder)(opt_codec_ctx,
+			elm->type, elm->per_constraints, memb_ptr2, pd);
 		if(rv.code != RC_OK) {
 			ASN_DEBUG("Failed decode %s in %s",
 				elm->name, td->name);
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+				elm->name, -1, 0);
 			FREEMEM(opres);
 			return rv;
 		}
@@ -1240,8 +1601,10 @@ SEQUENCE_encode_uper(asn_TYPE_descriptor_t *td,
 		if(elm->default_value && elm->default_value(0, memb_ptr2) == 1)
 			continue;
 
-		er = elm->type->uper_encoder(elm->type, elm->per_constraints,
-			*memb_ptr2, po);
+		if(!elm->type->uper_encoder)
+			_ASN_ENCODE_FAILED;	/* No PER support for the member */
+		er = ASN_CODEC(elm->type, uper_encoder)(elm->type,
+			elm->per_constraints, *memb_ptr2, po);
 		if(er.encoded == -1)
 			return er;
 	}
@@ -1249,3 +1612,355 @@ SEQUENCE_encode_uper(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(er);
 }
 
+
+/*
+ * Fetch the member for the OER encoding.
+ * Returns 1 if it is to be encoded, 0 if it is absent or has the DEFAULT
+ * value, and -1 if the mandatory member is missing.
+ */
+static int
+SEQUENCE__oer_member(asn_TYPE_member_t *elm, void *sptr, void **memb_ptr_r) {
+	void *memb_ptr;
+
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+		if(!memb_ptr)
+			return elm->optional ? 0 : -1;
+	} else {
+		memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+	}
+	*memb_ptr_r = memb_ptr;
+
+	/* Eliminate default values */
+	if(elm->default_value && elm->default_value(0, &memb_ptr) == 1)
+		return 0;
+
+	return 1;
+}
+
+asn_dec_rval_t
+SEQUENCE_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_SEQUENCE_specifics_t *specs = (asn_SEQUENCE_specifics_t *)td->specifics;
+	const uint8_t *buf = (const uint8_t *)buf_ptr;
+	const uint8_t *opres;	/* Presence of optional root members */
+	void *st = *sptr;	/* Target structure. */
+	int extensible = (specs->ext_before >= 0);
+	int ext_end = (specs->ext_before < td->elements_count)
+		? specs->ext_before : td->elements_count;
+	int extpresent = 0;	/* Extension additions are present */
+	size_t consumed;
+	size_t nbits;
+	asn_dec_rval_t rv;
+	int edx;
+
+	(void)constraints;
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	ASN_DEBUG("Decoding %s as SEQUENCE (OER)", td->name);
+
+	/* X.696 #16.2: the preamble */
+	nbits = extensible;
+	for(edx = 0; edx < td->elements_count; edx++)
+		if(td->elements[edx].optional
+		&& !IN_EXTENSION_GROUP(specs, edx))
+			nbits++;
+	consumed = (nbits + 7) >> 3;
+	if(size < consumed) {
+		rv.code = RC_WMORE;
+		rv.consumed = 0;
+		return rv;
+	}
+	opres = buf;
+	nbits = extensible;
+	if(extensible)
+		extpresent = OER_BITMAP_GET(opres, 0);
+
+	if(!st) {
+		st = *sptr = CALLOC(1, specs->struct_size);
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	/*
+	 * Get the sequence ROOT elements.
+	 */
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		oer_type_decoder_f *decoder;
+		void *memb_ptr;		/* Pointer to the member */
+		void **memb_ptr2;	/* Pointer to that pointer */
+
+		if(IN_EXTENSION_GROUP(specs, edx))
+			continue;
+
+		/* Fetch the pointer to this member */
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr2 = (void **)((char *)st + elm->memb_offset);
+		} else {
+			memb_ptr = (char *)st + elm->memb_offset;
+			memb_ptr2 = &memb_ptr;
+		}
+
+		/* Deal with optionality */
+		if(elm->optional) {
+			int present = OER_BITMAP_GET(opres, nbits);
+			nbits++;
+			if(!present) {
+				/* Fill-in DEFAULT */
+				if(elm->default_value
+				&& elm->default_value(1, memb_ptr2))
+					_ASN_DECODE_FAILED;
+				continue;
+			}
+		}
+
+		decoder = oer_type_decoder(elm->type);
+		if(!decoder) _ASN_DECODE_FAILED;
+		rv = decoder(opt_codec_ctx, elm->type, elm->per_constraints,
+			memb_ptr2, buf + consumed, size - consumed);
+		if(rv.code != RC_OK) {
+			ASN_DEBUG("Failed decode %s in %s",
+				elm->name, td->name);
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+				elm->name, -1, consumed);
+			return rv;
+		}
+		consumed += rv.consumed;
+	}
+
+	/*
+	 * X.696 #16.4: the extension additions, each in the open type.
+	 */
+	if(extpresent) {
+		const uint8_t *emap;
+		size_t len;
+		ssize_t skip;
+		size_t i;
+
+		skip = oer_fetch_length(buf + consumed, size - consumed, &len);
+		if(skip < 0 || (skip && len == 0)) _ASN_DECODE_FAILED;
+		if(skip == 0 || size - consumed - skip < len) {
+			rv.code = RC_WMORE;
+			rv.consumed = 0;
+			return rv;
+		}
+		emap = buf + consumed + skip;
+		if(emap[0] > 7 || (len == 1 && emap[0]))
+			_ASN_DECODE_FAILED;
+		nbits = (len - 1) * 8 - emap[0];
+		emap++;
+		consumed += skip + len;
+
+		for(i = 0; i < nbits; i++) {
+			asn_TYPE_member_t *elm;
+			void *memb_ptr;
+			void **memb_ptr2;
+
+			edx = specs->ext_after + 1 + i;
+			if(edx >= ext_end) {
+				/* The additions unknown to us are skipped */
+				if(!OER_BITMAP_GET(emap, i)) continue;
+				skip = oer_open_type_skip(buf + consumed,
+					size - consumed);
+				if(skip < 0) _ASN_DECODE_FAILED;
+				if(skip == 0) {
+					rv.code = RC_WMORE;
+					rv.consumed = 0;
+					return rv;
+				}
+				consumed += skip;
+				continue;
+			}
+
+			elm = &td->elements[edx];
+			if(elm->flags & ATF_POINTER) {
+				memb_ptr2 = (void **)((char *)st
+					+ elm->memb_offset);
+			} else {
+				memb_ptr = (char *)st + elm->memb_offset;
+				memb_ptr2 = &memb_ptr;
+			}
+
+			if(!OER_BITMAP_GET(emap, i)) {
+				if(elm->default_value
+				&& elm->default_value(1, memb_ptr2))
+					_ASN_DECODE_FAILED;
+				continue;
+			}
+
+			rv = oer_open_type_get(opt_codec_ctx, elm->type,
+				elm->per_constraints, memb_ptr2,
+				buf + consumed, size - consumed);
+			if(rv.code != RC_OK) {
+				ASN_DEBUG("Failed decode %s in %s",
+					elm->name, td->name);
+				return rv;
+			}
+			consumed += rv.consumed;
+		}
+		edx = specs->ext_after + 1 + nbits;
+	} else {
+		edx = specs->ext_after + 1;
+	}
+
+	/* Set the DEFAULT values of the missing additions */
+	for(; extensible && edx < ext_end; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		void *memb_ptr;
+		void **memb_ptr2;
+
+		if(!elm->default_value) continue;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr2 = (void **)((char *)st + elm->memb_offset);
+		} else {
+			memb_ptr = (char *)st + elm->memb_offset;
+			memb_ptr2 = &memb_ptr;
+		}
+		if(elm->default_value(1, memb_ptr2))
+			_ASN_DECODE_FAILED;
+	}
+
+	rv.code = RC_OK;
+	rv.consumed = consumed;
+	return rv;
+}
+
+asn_enc_rval_t
+SEQUENCE_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_SEQUENCE_specifics_t *specs
+		= (asn_SEQUENCE_specifics_t *)td->specifics;
+	int extensible = (specs->ext_before >= 0);
+	int ext_end = (specs->ext_before < td->elements_count)
+		? specs->ext_before : td->elements_count;
+	int additions = extensible ? ext_end - (specs->ext_after + 1) : 0;
+	uint8_t scratch[16];	/* Bitmaps of up to 128 members */
+	uint8_t *map = scratch;
+	size_t map_size;
+	size_t nbits;
+	int extpresent = 0;
+	asn_enc_rval_t er;
+	void *memb_ptr;
+	int edx;
+
+	(void)constraints;
+
+	if(!sptr)
+		_ASN_ENCODE_FAILED;
+
+	ASN_DEBUG("Encoding %s as SEQUENCE (OER)", td->name);
+
+	/* The preamble and the additions bitmap share the space */
+	nbits = extensible;
+	for(edx = 0; edx < td->elements_count; edx++)
+		if(td->elements[edx].optional
+		&& !IN_EXTENSION_GROUP(specs, edx))
+			nbits++;
+	map_size = (nbits + 7) >> 3;
+	if(additions < 0) additions = 0;
+	if(map_size < (size_t)((additions + 7) >> 3))
+		map_size = (additions + 7) >> 3;
+	if(map_size > sizeof(scratch)) {
+		map = (uint8_t *)MALLOC(map_size);
+		if(!map) _ASN_ENCODE_FAILED;
+	}
+	memset(map, 0, map_size);
+
+	/* X.696 #16.2: the preamble */
+	nbits = extensible;
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		int present = SEQUENCE__oer_member(elm, sptr, &memb_ptr);
+
+		if(IN_EXTENSION_GROUP(specs, edx)) {
+			extpresent |= (present == 1);
+		} else if(present < 0) {
+			ASN_DEBUG("Mandatory element %s missing", elm->name);
+			goto failed;
+		} else if(elm->optional) {
+			if(present) OER_BITMAP_SET(map, nbits);
+			nbits++;
+		}
+	}
+	if(extpresent)
+		OER_BITMAP_SET(map, 0);
+	nbits = (nbits + 7) >> 3;
+	if(nbits && cb(map, nbits, app_key) < 0)
+		goto failed;
+	er.encoded = nbits;
+
+	/*
+	 * Encode the sequence ROOT elements.
+	 */
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		oer_type_encoder_f *encoder;
+		asn_enc_rval_t tmper;
+
+		if(IN_EXTENSION_GROUP(specs, edx)
+		|| SEQUENCE__oer_member(elm, sptr, &memb_ptr) != 1)
+			continue;
+
+		encoder = oer_type_encoder(elm->type);
+		if(!encoder) goto failed;
+		tmper = encoder(elm->type, elm->per_constraints, memb_ptr,
+			flags, cb, app_key);
+		if(tmper.encoded == -1) {
+			if(map != scratch) FREEMEM(map);
+			return tmper;
+		}
+		er.encoded += tmper.encoded;
+	}
+
+	/*
+	 * X.696 #16.4: the extension additions, each in the open type.
+	 */
+	if(extpresent) {
+		uint8_t unused = ((additions + 7) & ~7) - additions;
+		ssize_t ret;
+
+		memset(map, 0, map_size);
+		for(edx = 0; edx < additions; edx++) {
+			asn_TYPE_member_t *elm
+				= &td->elements[specs->ext_after + 1 + edx];
+			if(SEQUENCE__oer_member(elm, sptr, &memb_ptr) == 1)
+				OER_BITMAP_SET(map, edx);
+		}
+		nbits = (additions + 7) >> 3;
+		ret = oer_serialize_length(1 + nbits, cb, app_key);
+		if(ret < 0
+		|| cb(&unused, 1, app_key) < 0
+		|| cb(map, nbits, app_key) < 0)
+			goto failed;
+		er.encoded += ret + 1 + nbits;
+
+		for(edx = specs->ext_after + 1; edx < ext_end; edx++) {
+			asn_TYPE_member_t *elm = &td->elements[edx];
+			asn_enc_rval_t tmper;
+
+			if(SEQUENCE__oer_member(elm, sptr, &memb_ptr) != 1)
+				continue;
+
+			tmper = oer_open_type_put(elm->type,
+				elm->per_constraints, memb_ptr,
+				flags, cb, app_key);
+			if(tmper.encoded == -1) {
+				if(map != scratch) FREEMEM(map);
+				return tmper;
+			}
+			er.encoded += tmper.encoded;
+		}
+	}
+
+	if(map != scratch) FREEMEM(map);
+	_ASN_ENCODED_OK(er);
+failed:
+	if(map != scratch) FREEMEM(map);
+	_ASN_ENCODE_FAILED;
+}
@@ -37,6 +37,11 @@ typedef struct asn_SEQUENCE_specifics_s {
 	 */
 	int ext_after;		/* Extensions start after this member */
 	int ext_before;		/* Extensions stop before this member */
+
+	/*
+	 * Member lookup by XML tag name, built by the XER decoder.
+	 */
+	struct asn_xer_member_index_s *xer_index;
 } asn_SEQUENCE_specifics_t;
 
 
@@ -48,10 +53,18 @@ asn_struct_print_f SEQUENCE_print;
 asn_constr_check_f SEQUENCE_constraint;
 ber_type_decoder_f SEQUENCE_decode_ber;
 der_type_encoder_f SEQUENCE_encode_der;
+cer_type_encoder_f SEQUENCE_encode_cer;
 xer_type_decoder_f SEQUENCE_decode_xer;
 xer_type_encoder_f SEQUENCE_encode_xer;
+jer_type_decoder_f SEQUENCE_decode_jer;
+jer_type_encoder_f SEQUENCE_encode_jer;
 per_type_decoder_f SEQUENCE_decode_uper;
 per_type_encoder_f SEQUENCE_encode_uper;
+oer_type_decoder_f SEQUENCE_decode_oer;
+oer_type_encoder_f SEQUENCE_encode_oer;
+asn_struct_equals_f SEQUENCE_equals;
+asn_struct_hash_f SEQUENCE_hash;
+asn_struct_copy_f SEQUENCE_copy;
 
 #ifdef __cplusplus
 }
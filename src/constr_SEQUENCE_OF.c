@@ -6,6 +6,7 @@
 #include <asn_internal.h>
 #include <constr_SEQUENCE_OF.h>
 #include <asn_SEQUENCE_OF.h>
+#include <asn_parallel.h>	/* Parallel DER encoding */
 
 /*
  * The DER encoder of the SEQUENCE OF type.
@@ -19,8 +20,15 @@ SEQUENCE_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	size_t computed_size = 0;
 	ssize_t encoding_size = 0;
 	asn_enc_rval_t erval;
+	asn_parallel_t *pool;
 	int edx;
 
+	/* Large lists are spread over the threads, if asked to */
+	if(list->count >= ASN_PARALLEL_DER_MIN
+	&& (pool = asn_parallel_current()))
+		return asn_parallel_der_list(pool, td, ptr, tag_mode, tag, 0,
+			cb, app_key);
+
 	ASN_DEBUG("Estimating size of SEQUENCE OF %s", td->name);
 
 	/*
@@ -29,7 +37,7 @@ SEQUENCE_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	for(edx = 0; edx < list->count; edx++) {
 		void *memb_ptr = list->array[edx];
 		if(!memb_ptr) continue;
-		erval = elm->type->der_encoder(elm->type, memb_ptr,
+		erval = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			0, elm->tag,
 			0, 0);
 		if(erval.encoded == -1)
@@ -63,7 +71,7 @@ SEQUENCE_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	for(edx = 0; edx < list->count; edx++) {
 		void *memb_ptr = list->array[edx];
 		if(!memb_ptr) continue;
-		erval = elm->type->der_encoder(elm->type, memb_ptr,
+		erval = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			0, elm->tag,
 			cb, app_key);
 		if(erval.encoded == -1)
@@ -87,6 +95,58 @@ SEQUENCE_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	return erval;
 }
 
+/*
+ * The CER encoder of the SEQUENCE OF type: the elements are streamed out
+ * within the indefinite length, without measuring them first.
+ */
+asn_enc_rval_t
+SEQUENCE_OF_encode_cer(asn_TYPE_descriptor_t *td, void *ptr,
+	int tag_mode, ber_tlv_tag_t tag,
+	asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_TYPE_member_t *elm = td->elements;
+	asn_anonymous_sequence_ *list = _A_SEQUENCE_FROM_VOID(ptr);
+	cer_type_encoder_f *cer_encoder = cer_type_encoder(elm->type);
+	asn_enc_rval_t erval;
+	ssize_t ret;
+	int edx;
+
+	ASN_DEBUG("Encoding SEQUENCE OF %s (CER)", td->name);
+
+	ret = cer_write_tags(td, 0, tag_mode, 1, tag, cb, app_key);
+	if(ret == -1) {
+		erval.encoded = -1;
+		erval.failed_type = td;
+		erval.structure_ptr = ptr;
+		return erval;
+	}
+	erval.encoded = ret;
+
+	for(edx = 0; edx < list->count; edx++) {
+		void *memb_ptr = list->array[edx];
+		asn_enc_rval_t tmperval;
+		if(!memb_ptr) continue;
+		tmperval = cer_encoder(elm->type, memb_ptr,
+			0, elm->tag,
+			cb, app_key);
+		if(tmperval.encoded == -1)
+			return tmperval;
+		erval.encoded += tmperval.encoded;
+	}
+
+	ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+	if(ret == -1) {
+		erval.encoded = -1;
+		erval.failed_type = td;
+		erval.structure_ptr = ptr;
+		return erval;
+	}
+	erval.encoded += ret;
+
+	erval.structure_ptr = 0;
+	erval.failed_type = 0;
+	return erval;
+}
+
 asn_enc_rval_t
 SEQUENCE_OF_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 	int ilevel, enum xer_encoder_flags_e flags,
@@ -115,7 +175,7 @@ SEQUENCE_OF_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 			_ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
 		}
 
-		tmper = elm->type->xer_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, xer_encoder)(elm->type, memb_ptr,
 				ilevel + 1, flags, cb, app_key);
 		if(tmper.encoded == -1) return tmper;
                 if(tmper.encoded == 0 && specs->as_XMLValueList) {
@@ -195,8 +255,9 @@ SEQUENCE_OF_encode_uper(asn_TYPE_descriptor_t *td,
 
 		while(mayEncode--) {
 			void *memb_ptr = list->array[seq++];
-			if(!memb_ptr) _ASN_ENCODE_FAILED;
-			er = elm->type->uper_encoder(elm->type,
+			if(!memb_ptr || !elm->type->uper_encoder)
+				_ASN_ENCODE_FAILED;
+			er = ASN_CODEC(elm->type, uper_encoder)(elm->type,
 				elm->per_constraints, memb_ptr, po);
 			if(er.encoded == -1)
 				_ASN_ENCODE_FAILED;
@@ -206,3 +267,38 @@ SEQUENCE_OF_encode_uper(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(er);
 }
 
+
+/*
+ * The SEQUENCE OF lists are equal if their elements are, in order.
+ */
+int
+SEQUENCE_OF_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	asn_TYPE_descriptor_t *elm_type = td->elements->type;
+	const asn_anonymous_sequence_ *a = _A_CSEQUENCE_FROM_VOID(struct_a);
+	const asn_anonymous_sequence_ *b = _A_CSEQUENCE_FROM_VOID(struct_b);
+	int i;
+
+	if(a->count != b->count)
+		return 0;
+
+	for(i = 0; i < a->count; i++) {
+		if(!asn_equals(elm_type, a->array[i], b->array[i]))
+			return 0;
+	}
+
+	return 1;
+}
+
+uint64_t
+SEQUENCE_OF_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	asn_TYPE_descriptor_t *elm_type = td->elements->type;
+	const asn_anonymous_sequence_ *list = _A_CSEQUENCE_FROM_VOID(sptr);
+	uint64_t hash = 0;
+	int i;
+
+	for(i = 0; i < list->count; i++)
+		hash = asn_hash__value(hash, asn_hash(elm_type, list->array[i]));
+
+	return asn_hash__end(asn_hash__value(hash, list->count));
+}
@@ -17,14 +17,22 @@ extern "C" {
  * Generally implemented using SET OF.
  */
 #define	SEQUENCE_OF_free	SET_OF_free
+#define	SEQUENCE_OF_copy	SET_OF_copy
 #define	SEQUENCE_OF_print	SET_OF_print
 #define	SEQUENCE_OF_constraint	SET_OF_constraint
 #define	SEQUENCE_OF_decode_ber	SET_OF_decode_ber
 #define	SEQUENCE_OF_decode_xer	SET_OF_decode_xer
 #define	SEQUENCE_OF_decode_uper	SET_OF_decode_uper
+#define	SEQUENCE_OF_decode_jer	SET_OF_decode_jer
+#define	SEQUENCE_OF_encode_jer	SET_OF_encode_jer
+#define	SEQUENCE_OF_decode_oer	SET_OF_decode_oer
+#define	SEQUENCE_OF_encode_oer	SET_OF_encode_oer
 der_type_encoder_f SEQUENCE_OF_encode_der;
+cer_type_encoder_f SEQUENCE_OF_encode_cer;
 xer_type_encoder_f SEQUENCE_OF_encode_xer;
 per_type_encoder_f SEQUENCE_OF_encode_uper;
+asn_struct_equals_f SEQUENCE_OF_equals;
+asn_struct_hash_f SEQUENCE_OF_hash;
 
 #ifdef __cplusplus
 }
@@ -5,6 +5,7 @@
  */
 #include <asn_internal.h>
 #include <constr_SET.h>
+#include <jer_support.h>	/* JSON tokenizer */
 
 #ifndef	WIN32
 #include <netinet/in.h>	/* for ntohl() */
@@ -14,6 +15,7 @@
 
 /* Check that all the mandatory members are present */
 static int _SET_is_populated(asn_TYPE_descriptor_t *td, void *st);
+static void SET__canonical_order(asn_TYPE_descriptor_t *td, int *order);
 
 /*
  * Number of bytes left for this structure.
@@ -56,6 +58,7 @@ static int _SET_is_populated(asn_TYPE_descriptor_t *td, void *st);
 #define	NEXT_PHASE(ctx)	do {			\
 		ctx->phase++;			\
 		ctx->step = 0;			\
+		ASN_TRACE_PHASE(td, ctx->phase, consumed_myself);\
 	} while(0)
 
 /*
@@ -246,6 +249,8 @@ SET_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			ASN_DEBUG("Unexpected tag %s "
 				"in non-extensible SET %s",
 				ber_tlv_tag_string(tlv_tag), td->name);
+			ASN_DEC_ERROR(opt_codec_ctx, td,
+				ASN_DEC_ERROR_TAG, consumed_myself);
 			RETURN(RC_FAIL);
 		} else {
 			/* Skip this tag */
@@ -280,6 +285,8 @@ SET_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		if(ASN_SET_ISPRESENT2((char *)st + specs->pres_offset, edx)) {
 			ASN_DEBUG("SET %s: Duplicate element %s (%d)",
 				td->name, elements[edx].name, edx);
+			ASN_DEC_ERROR(opt_codec_ctx, td,
+				ASN_DEC_ERROR_TAG, consumed_myself);
 			RETURN(RC_FAIL);
 		}
 		
@@ -302,7 +309,7 @@ SET_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		/*
 		 * Invoke the member fetch routine according to member's type
 		 */
-		rval = elements[edx].type->ber_decoder(opt_codec_ctx,
+		rval = ASN_CODEC(elements[edx].type, ber_decoder)(opt_codec_ctx,
 				elements[edx].type,
 				memb_ptr2, ptr, LEFT,
 				elements[edx].tag_mode);
@@ -315,8 +322,12 @@ SET_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				ADVANCE(rval.consumed);
 				RETURN(RC_WMORE);
 			}
+			ASN_DEC_ERROR(opt_codec_ctx, elements[edx].type,
+				ASN_DEC_ERROR_LENGTH, 0);
 			/* Fail through */
 		case RC_FAIL: /* Fatal error */
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elements[edx].type,
+				elements[edx].name, -1, consumed_myself);
 			RETURN(RC_FAIL);
 		} /* switch(rval) */
 		
@@ -388,8 +399,11 @@ SET_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		ctx->phase = 5;
 	case 5:
 		/* Check that all mandatory elements are present. */
-		if(!_SET_is_populated(td, st))
+		if(!_SET_is_populated(td, st)) {
+			ASN_DEC_ERROR(opt_codec_ctx, td,
+				ASN_DEC_ERROR_MISSING, 0);
 			RETURN(RC_FAIL);
+		}
 
 		NEXT_PHASE(ctx);
 	}
@@ -494,7 +508,7 @@ SET_encode_der(asn_TYPE_descriptor_t *td,
 		} else {
 			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
 		}
-		tmper = elm->type->der_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			elm->tag_mode, elm->tag,
 			0, 0);
 		if(tmper.encoded == -1)
@@ -558,7 +572,7 @@ SET_encode_der(asn_TYPE_descriptor_t *td,
 		} else {
 			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
 		}
-		tmper = elm->type->der_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, der_encoder)(elm->type, memb_ptr,
 			elm->tag_mode, elm->tag,
 			cb, app_key);
 		if(tmper.encoded == -1)
@@ -576,6 +590,60 @@ SET_encode_der(asn_TYPE_descriptor_t *td,
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * The CER encoder of the SET type. The members go in the canonical order
+ * of their tags (X.690 #9.3), streamed within the indefinite length.
+ */
+asn_enc_rval_t
+SET_encode_cer(asn_TYPE_descriptor_t *td,
+	void *sptr, int tag_mode, ber_tlv_tag_t tag,
+	asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+	ssize_t ret;
+	int *order;
+	int i;
+
+	ASN_DEBUG("Encoding %s as SET (CER)", td->name);
+
+	order = (int *)alloca((td->elements_count + 1) * sizeof(order[0]));
+	if(!order) _ASN_ENCODE_FAILED;	/* There are such platforms */
+	SET__canonical_order(td, order);
+
+	ret = cer_write_tags(td, 0, tag_mode, 1, tag, cb, app_key);
+	if(ret == -1) _ASN_ENCODE_FAILED;
+	er.encoded = ret;
+
+	for(i = 0; i < td->elements_count; i++) {
+		asn_TYPE_member_t *elm = &td->elements[order[i]];
+		asn_enc_rval_t tmper;
+		void *memb_ptr;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+			if(!memb_ptr) {
+				if(!elm->optional)
+					/* Mandatory elements missing */
+					_ASN_ENCODE_FAILED;
+				continue;
+			}
+		} else {
+			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+		}
+		tmper = cer_type_encoder(elm->type)(elm->type, memb_ptr,
+			elm->tag_mode, elm->tag,
+			cb, app_key);
+		if(tmper.encoded == -1)
+			return tmper;
+		er.encoded += tmper.encoded;
+	}
+
+	ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+	if(ret == -1) _ASN_ENCODE_FAILED;
+	er.encoded += ret;
+
+	_ASN_ENCODED_OK(er);
+}
+
 #undef	XER_ADVANCE
 #define	XER_ADVANCE(num_bytes)	do {			\
 		size_t num = num_bytes;			\
@@ -662,9 +730,12 @@ SET_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			}
 
 			/* Invoke the inner type decoder, m.b. multiple times */
-			tmprval = elm->type->xer_decoder(opt_codec_ctx,
-					elm->type, memb_ptr2, elm->name,
-					buf_ptr, size);
+			tmprval = ASN_CODEC(elm->type, xer_decoder)(
+					opt_codec_ctx, elm->type, memb_ptr2,
+					elm->name, buf_ptr, size);
+			if(tmprval.code == RC_FAIL)
+				ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+					elm->name, -1, consumed_myself);
 			XER_ADVANCE(tmprval.consumed);
 			if(tmprval.code != RC_OK)
 				RETURN(tmprval.code);
@@ -748,28 +819,16 @@ SET_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			/*
 			 * Search which member corresponds to this tag.
 			 */
-			for(edx = 0; edx < td->elements_count; edx++) {
-				switch(xer_check_tag(buf_ptr, ch_size,
-					elements[edx].name)) {
-				case XCT_BOTH:
-				case XCT_OPENING:
-					/*
-					 * Process this member.
-					 */
-					ctx->step = edx;
-					ctx->phase = 2;
-					break;
-				case XCT_UNKNOWN_OP:
-				case XCT_UNKNOWN_BO:
-					continue;
-				default:
-					edx = td->elements_count;
-					break;	/* Phase out */
-				}
-				break;
-			}
-			if(edx != td->elements_count)
+			edx = xer_find_member(&specs->xer_index, td,
+				buf_ptr, ch_size);
+			if(edx >= 0) {
+				/*
+				 * Process this member.
+				 */
+				ctx->step = edx;
+				ctx->phase = 2;
 				continue;
+			}
 
 			/* It is expected extension */
 			if(specs->extensible) {
@@ -825,12 +884,14 @@ SET_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 		asn_enc_rval_t tmper;
 		asn_TYPE_member_t *elm;
 		void *memb_ptr;
+		const xer_member_tags_t *tags;
 		const char *mname;
 		unsigned int mlen;
 
 		elm = &td->elements[t2m[edx].el_no];
+		tags = xer_member_tags(&specs->xer_index, td, t2m[edx].el_no);
 		mname = elm->name;
-		mlen = strlen(elm->name);
+		mlen = tags ? tags->name_len : strlen(mname);
 
 		if(elm->flags & ATF_POINTER) {
 			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
@@ -846,14 +907,16 @@ SET_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 
 		if(!xcan)
 			_i_ASN_TEXT_INDENT(1, ilevel);
-		_ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
+		if(tags) _ASN_CALLBACK(tags->open, mlen + 2);
+		else _ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
 
 		/* Print the member itself */
-		tmper = elm->type->xer_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, xer_encoder)(elm->type, memb_ptr,
 				ilevel + 1, flags, cb, app_key);
 		if(tmper.encoded == -1) return tmper;
 
-		_ASN_CALLBACK3("</", 2, mname, mlen, ">", 1);
+		if(tags) _ASN_CALLBACK(tags->close, mlen + 3);
+		else _ASN_CALLBACK3("</", 2, mname, mlen, ">", 1);
 
 		er.encoded += 5 + (2 * mlen) + tmper.encoded;
 	}
@@ -865,6 +928,204 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * JER represents SET by the object keyed by the member names,
+ * in the order of definition.
+ */
+asn_enc_rval_t
+SET_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_enc_rval_t er;
+	int pretty = !(flags & JER_F_MINIFIED);
+	int members = 0;
+	int edx;
+
+	if(!sptr)
+		_ASN_ENCODE_FAILED;
+
+	_ASN_CALLBACK("{", 1);
+	er.encoded = 1;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_enc_rval_t tmper;
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		jer_type_encoder_f *encoder;
+		void *memb_ptr;
+		size_t mlen;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+			if(!memb_ptr) {
+				if(elm->optional)
+					continue;
+				/* Mandatory element missing */
+				_ASN_ENCODE_FAILED;
+			}
+		} else {
+			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+		}
+
+		encoder = jer_type_encoder(elm->type);
+		if(!encoder) _ASN_ENCODE_FAILED;
+
+		if(members++) {
+			_ASN_CALLBACK(",", 1);
+			er.encoded++;
+		}
+		if(pretty) _i_ASN_TEXT_INDENT(1, ilevel + 1);
+		mlen = strlen(elm->name);
+		_ASN_CALLBACK3("\"", 1, elm->name, mlen,
+			"\": ", pretty ? 3 : 2);
+		er.encoded += mlen + (pretty ? 4 : 3);
+
+		/* Print the member itself */
+		tmper = encoder(elm->type, memb_ptr,
+			ilevel + 1, flags, cb, app_key);
+		if(tmper.encoded == -1) return tmper;
+		er.encoded += tmper.encoded;
+	}
+
+	if(pretty && members) _i_ASN_TEXT_INDENT(1, ilevel);
+	_ASN_CALLBACK("}", 1);
+	er.encoded++;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
+/*
+ * Decode the JER object of SET members.
+ * The value is complete: jer_decode() has delimited it already.
+ */
+asn_dec_rval_t
+SET_decode_jer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	void **struct_ptr, const void *buf_ptr, size_t size) {
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	const char *buf = (const char *)buf_ptr;
+	void *st = *struct_ptr;	/* Target structure. */
+	asn_dec_rval_t rval;
+	jer_token_t tok;
+	size_t consumed = 0;
+	int first = 1;
+	int edx;
+
+#define	JER_NEXT_TOKEN()	do {					\
+		size_t __n = jer_next_token(buf + consumed,		\
+			size - consumed, &tok);				\
+		if(tok.type == JT_MORE) goto want_more;			\
+		consumed += __n;					\
+	} while(0)
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	JER_NEXT_TOKEN();
+	if(tok.type != JT_OBJECT_START)
+		_ASN_DECODE_FAILED;
+
+	/*
+	 * Create the target structure if it is not present already.
+	 */
+	if(st == 0) {
+		st = *struct_ptr = CALLOC(1, specs->struct_size);
+		if(st == 0) _ASN_DECODE_FAILED;
+	}
+
+	for(;;) {
+		asn_TYPE_member_t *elm;
+		jer_type_decoder_f *decoder;
+		void *memb_ptr;		/* Pointer to the member */
+		void **memb_ptr2;	/* Pointer to that pointer */
+		char name[64];
+		const char *key;
+		ssize_t klen;
+
+		JER_NEXT_TOKEN();
+		if(tok.type == JT_OBJECT_END && first)
+			break;	/* {} */
+		first = 0;
+		if(tok.type != JT_STRING) _ASN_DECODE_FAILED;
+		key = tok.start;
+		klen = tok.length;
+		if(tok.escaped) {
+			if(tok.length > sizeof(name)) _ASN_DECODE_FAILED;
+			klen = jer_unescape(tok.start, tok.length, name);
+			if(klen < 0) _ASN_DECODE_FAILED;
+			key = name;
+		}
+
+		JER_NEXT_TOKEN();
+		if(tok.type != JT_COLON) _ASN_DECODE_FAILED;
+
+		edx = xer_find_member_name(&specs->xer_index, td, key, klen);
+		if(edx < 0) {
+			ssize_t vlen;
+			if(specs->extensible == 0) {
+				ASN_DEBUG("Unexpected member "
+					"in non-extensible SET %s", td->name);
+				_ASN_DECODE_FAILED;
+			}
+			/* Extensions unknown to us are skipped */
+			vlen = jer_value_length(buf + consumed,
+				size - consumed, 0);
+			if(vlen == 0) goto want_more;
+			if(vlen < 0) _ASN_DECODE_FAILED;
+			consumed += vlen;
+		} else {
+			if(ASN_SET_ISPRESENT2((char *)st + specs->pres_offset,
+					edx)) {
+				ASN_DEBUG("SET %s: Duplicate member %s",
+					td->name, td->elements[edx].name);
+				_ASN_DECODE_FAILED;
+			}
+
+			elm = &td->elements[edx];
+			if(elm->flags & ATF_POINTER) {
+				/* Member is a pointer to another structure */
+				memb_ptr2 = (void **)((char *)st
+					+ elm->memb_offset);
+			} else {
+				memb_ptr = (char *)st + elm->memb_offset;
+				memb_ptr2 = &memb_ptr;
+			}
+
+			decoder = jer_type_decoder(elm->type);
+			if(!decoder) _ASN_DECODE_FAILED;
+			rval = decoder(opt_codec_ctx, elm->type, memb_ptr2,
+				buf + consumed, size - consumed);
+			if(rval.code != RC_OK) {
+				ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+					elm->name, -1, consumed);
+				rval.consumed = 0;
+				return rval;
+			}
+			consumed += rval.consumed;
+			ASN_SET_MKPRESENT((char *)st + specs->pres_offset, edx);
+		}
+
+		JER_NEXT_TOKEN();
+		if(tok.type == JT_OBJECT_END) break;
+		if(tok.type != JT_COMMA) _ASN_DECODE_FAILED;
+	}
+#undef	JER_NEXT_TOKEN
+
+	if(!_SET_is_populated(td, st)) {
+		ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_MISSING, 0);
+		_ASN_DECODE_FAILED;
+	}
+
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+
+want_more:
+	rval.code = RC_WMORE;
+	rval.consumed = 0;
+	return rval;
+}
+
 int
 SET_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 		asn_app_consume_bytes_f *cb, void *app_key) {
@@ -939,6 +1200,89 @@ SET_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 	}
 }
 
+/*
+ * Fetch the member to be compared or hashed: 0 if it is absent
+ * or has its DEFAULT value, so either way compares the same.
+ */
+static void *
+_SET_compared_member(asn_TYPE_member_t *elm, const void *sptr) {
+	void *memb_ptr;
+
+	if(elm->flags & ATF_POINTER) {
+		memb_ptr = *(void * const *)((const char *)sptr + elm->memb_offset);
+		if(!memb_ptr) return 0;
+	} else {
+		memb_ptr = (void *)((const char *)sptr + elm->memb_offset);
+	}
+
+	if(elm->default_value && elm->default_value(0, &memb_ptr) == 1)
+		return 0;
+
+	return memb_ptr;
+}
+
+/*
+ * The members are compared in their places in the structure,
+ * whatever the order they were encoded in.
+ */
+int
+SET_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	int edx;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		if(!asn_equals(elm->type,
+				_SET_compared_member(elm, struct_a),
+				_SET_compared_member(elm, struct_b)))
+			return 0;
+	}
+
+	return 1;
+}
+
+uint64_t
+SET_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	uint64_t hash = 0;
+	int edx;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		void *memb_ptr = _SET_compared_member(elm, sptr);
+		if(!memb_ptr) continue;
+		hash = asn_hash__value(hash, edx);
+		hash = asn_hash__value(hash, asn_hash(elm->type, memb_ptr));
+	}
+
+	return asn_hash__end(hash);
+}
+
+int
+SET_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	void *st;
+	int edx;
+
+	st = asn_copy__struct(copy, struct_dst, specs->struct_size);
+	if(!st) return -1;
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		if(asn_copy__member(copy, &td->elements[edx], st, struct_src))
+			return -1;
+	}
+
+	/* The presence of the members, as the decoder has left it */
+	if(!ASN_COPY_MEASURING(copy))
+		memcpy((char *)st + specs->pres_offset,
+			(const char *)struct_src + specs->pres_offset,
+			((td->elements_count + (8 * sizeof(unsigned int)) - 1)
+				/ (8 * sizeof(unsigned int)))
+				* sizeof(unsigned int));
+
+	return 0;
+}
+
 int
 SET_constraint(asn_TYPE_descriptor_t *td, const void *sptr,
 		asn_app_constraint_failed_f *ctfailcb, void *app_key) {
@@ -990,3 +1334,235 @@ SET_constraint(asn_TYPE_descriptor_t *td, const void *sptr,
 
 	return 0;
 }
+
+/*
+ * The canonical order of the SET members (X.680 #8.6), in which OER
+ * and CER place them: an untagged CHOICE goes by the smallest of its tags.
+ */
+static void
+SET__canonical_order(asn_TYPE_descriptor_t *td, int *order) {
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	int n = 0;
+	int i, j;
+
+	for(i = 0; i < specs->tag2el_count; i++) {
+		int el_no = specs->tag2el[i].el_no;
+		if(specs->tag2el_count != td->elements_count) {
+			/* Skip the other tags of the untagged CHOICE */
+			for(j = 0; j < n && order[j] != el_no; j++);
+			if(j < n) continue;
+		}
+		order[n++] = el_no;
+	}
+}
+
+asn_dec_rval_t
+SET_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **sptr,
+		const void *buf_ptr, size_t size) {
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	const uint8_t *buf = (const uint8_t *)buf_ptr;
+	const uint8_t *opres;	/* Presence of optional members */
+	void *st = *sptr;	/* Target structure. */
+	int extpresent = 0;	/* Extension additions are present */
+	size_t consumed;
+	size_t nbits;
+	asn_dec_rval_t rv;
+	int *order;
+	int i;
+
+	(void)constraints;
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	ASN_DEBUG("Decoding %s as SET (OER)", td->name);
+
+	/* X.696 #16.2: the preamble */
+	nbits = (specs->extensible != 0);
+	for(i = 0; i < td->elements_count; i++)
+		if(td->elements[i].optional)
+			nbits++;
+	consumed = (nbits + 7) >> 3;
+	if(size < consumed) {
+		rv.code = RC_WMORE;
+		rv.consumed = 0;
+		return rv;
+	}
+	opres = buf;
+	nbits = (specs->extensible != 0);
+	if(specs->extensible)
+		extpresent = OER_BITMAP_GET(opres, 0);
+
+	order = (int *)alloca((td->elements_count + 1) * sizeof(order[0]));
+	if(!order) _ASN_DECODE_FAILED;	/* There are such platforms */
+	SET__canonical_order(td, order);
+
+	if(!st) {
+		st = *sptr = CALLOC(1, specs->struct_size);
+		if(!st) _ASN_DECODE_FAILED;
+	}
+
+	for(i = 0; i < td->elements_count; i++) {
+		int edx = order[i];
+		asn_TYPE_member_t *elm = &td->elements[edx];
+		oer_type_decoder_f *decoder;
+		void *memb_ptr;		/* Pointer to the member */
+		void **memb_ptr2;	/* Pointer to that pointer */
+
+		if(elm->optional) {
+			int present = OER_BITMAP_GET(opres, nbits);
+			nbits++;
+			if(!present) continue;
+		}
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr2 = (void **)((char *)st + elm->memb_offset);
+		} else {
+			memb_ptr = (char *)st + elm->memb_offset;
+			memb_ptr2 = &memb_ptr;
+		}
+
+		decoder = oer_type_decoder(elm->type);
+		if(!decoder) _ASN_DECODE_FAILED;
+		rv = decoder(opt_codec_ctx, elm->type, elm->per_constraints,
+			memb_ptr2, buf + consumed, size - consumed);
+		if(rv.code != RC_OK) {
+			ASN_DEBUG("Failed decode %s in %s",
+				elm->name, td->name);
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+				elm->name, -1, consumed);
+			return rv;
+		}
+		consumed += rv.consumed;
+		ASN_SET_MKPRESENT((char *)st + specs->pres_offset, edx);
+	}
+
+	/*
+	 * The SET additions are not told from the root members,
+	 * so all the extensions present are unknown to us and skipped.
+	 */
+	if(extpresent) {
+		const uint8_t *emap;
+		size_t len, n;
+		ssize_t skip;
+
+		skip = oer_fetch_length(buf + consumed, size - consumed, &len);
+		if(skip < 0 || (skip && len == 0)) _ASN_DECODE_FAILED;
+		if(skip == 0 || size - consumed - skip < len) {
+			rv.code = RC_WMORE;
+			rv.consumed = 0;
+			return rv;
+		}
+		emap = buf + consumed + skip;
+		if(emap[0] > 7 || (len == 1 && emap[0]))
+			_ASN_DECODE_FAILED;
+		nbits = (len - 1) * 8 - emap[0];
+		emap++;
+		consumed += skip + len;
+
+		for(n = 0; n < nbits; n++) {
+			if(!OER_BITMAP_GET(emap, n)) continue;
+			skip = oer_open_type_skip(buf + consumed,
+				size - consumed);
+			if(skip < 0) _ASN_DECODE_FAILED;
+			if(skip == 0) {
+				rv.code = RC_WMORE;
+				rv.consumed = 0;
+				return rv;
+			}
+			consumed += skip;
+		}
+	}
+
+	if(!_SET_is_populated(td, st)) {
+		ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_MISSING, 0);
+		_ASN_DECODE_FAILED;
+	}
+
+	rv.code = RC_OK;
+	rv.consumed = consumed;
+	return rv;
+}
+
+asn_enc_rval_t
+SET_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_SET_specifics_t *specs = (asn_SET_specifics_t *)td->specifics;
+	uint8_t *map;
+	size_t map_size;
+	size_t nbits;
+	asn_enc_rval_t er;
+	int *order;
+	int i;
+
+	(void)constraints;
+
+	if(!sptr)
+		_ASN_ENCODE_FAILED;
+
+	ASN_DEBUG("Encoding %s as SET (OER)", td->name);
+
+	order = (int *)alloca((td->elements_count + 1) * sizeof(order[0]));
+	if(!order) _ASN_ENCODE_FAILED;	/* There are such platforms */
+	SET__canonical_order(td, order);
+
+	/* X.696 #16.2: the preamble, the extension bit is always clear */
+	nbits = (specs->extensible != 0);
+	for(i = 0; i < td->elements_count; i++)
+		if(td->elements[i].optional)
+			nbits++;
+	map_size = (nbits + 7) >> 3;
+	map = (uint8_t *)alloca(map_size + 1);
+	if(!map) _ASN_ENCODE_FAILED;
+	memset(map, 0, map_size);
+
+	nbits = (specs->extensible != 0);
+	for(i = 0; i < td->elements_count; i++) {
+		asn_TYPE_member_t *elm = &td->elements[order[i]];
+		void *memb_ptr;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+			if(!memb_ptr && !elm->optional) {
+				ASN_DEBUG("Mandatory element %s missing",
+					elm->name);
+				_ASN_ENCODE_FAILED;
+			}
+		} else {
+			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+		}
+		if(elm->optional) {
+			if(memb_ptr) OER_BITMAP_SET(map, nbits);
+			nbits++;
+		}
+	}
+	if(map_size && cb(map, map_size, app_key) < 0)
+		_ASN_ENCODE_FAILED;
+	er.encoded = map_size;
+
+	for(i = 0; i < td->elements_count; i++) {
+		asn_TYPE_member_t *elm = &td->elements[order[i]];
+		oer_type_encoder_f *encoder;
+		asn_enc_rval_t tmper;
+		void *memb_ptr;
+
+		if(elm->flags & ATF_POINTER) {
+			memb_ptr = *(void **)((char *)sptr + elm->memb_offset);
+			if(!memb_ptr) continue;
+		} else {
+			memb_ptr = (void *)((char *)sptr + elm->memb_offset);
+		}
+
+		encoder = oer_type_encoder(elm->type);
+		if(!encoder) _ASN_ENCODE_FAILED;
+		tmper = encoder(elm->type, elm->per_constraints, memb_ptr,
+			flags, cb, app_key);
+		if(tmper.encoded == -1) return tmper;
+		er.encoded += tmper.encoded;
+	}
+
+	_ASN_ENCODED_OK(er);
+}
@@ -5,7 +5,9 @@
  */
 #include <asn_internal.h>
 #include <constr_SET_OF.h>
+#include <jer_support.h>	/* JSON tokenizer */
 #include <asn_SET_OF.h>
+#include <asn_parallel.h>	/* Parallel DER encoding */
 
 /*
  * Number of bytes left for this structure.
@@ -49,8 +51,12 @@
 #define	NEXT_PHASE(ctx)	do {			\
 		ctx->phase++;			\
 		ctx->step = 0;			\
+		ASN_TRACE_PHASE(td, ctx->phase, consumed_myself);\
+	} while(0)
+#define	PHASE_OUT(ctx)	do {			\
+		ctx->phase = 10;		\
+		ASN_TRACE_PHASE(td, ctx->phase, consumed_myself);\
 	} while(0)
-#define	PHASE_OUT(ctx)	do { ctx->phase = 10; } while(0)
 
 /*
  * Return a standardized complex structure.
@@ -62,6 +68,15 @@
 		return rval;			\
 	} while(0)
 
+/*
+ * Whether the elements of the list are to be handed to the application
+ * one by one rather than accumulated (see asn_dec_opts_t).
+ */
+#define	SET_OF__streamed(opts, td)				\
+	((opts) && (opts)->element_cb				\
+	&& ((opts)->stream_type == (td)				\
+		|| (opts)->stream_type == (td)->elements->type))
+
 /*
  * The decoder of the SET OF type.
  */
@@ -82,6 +97,7 @@ SET_OF_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 
 	ber_tlv_tag_t tlv_tag;	/* T from TLV */
 	asn_dec_rval_t rval;	/* Return code from subparsers */
+	const asn_dec_opts_t *opts = ASN_DEC_OPTS(opt_codec_ctx);
 
 	ssize_t consumed_myself = 0;	/* Consumed bytes from ptr */
 
@@ -192,6 +208,8 @@ SET_OF_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				ber_tlv_tag_string(tlv_tag), td->name);
 			ASN_DEBUG("%s SET OF has tag %s",
 				td->name, ber_tlv_tag_string(elm->tag));
+			ASN_DEC_ERROR(opt_codec_ctx, td,
+				ASN_DEC_ERROR_TAG, consumed_myself);
 			RETURN(RC_FAIL);
 		    }
 		}
@@ -205,14 +223,23 @@ SET_OF_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		/*
 		 * Invoke the member fetch routine according to member's type
 		 */
-		rval = elm->type->ber_decoder(opt_codec_ctx,
+		rval = ASN_CODEC(elm->type, ber_decoder)(opt_codec_ctx,
 				elm->type, &ctx->ptr, ptr, LEFT, 0);
 		ASN_DEBUG("In %s SET OF %s code %d consumed %d",
 			td->name, elm->type->name,
 			rval.code, (int)rval.consumed);
 		switch(rval.code) {
 		case RC_OK:
-			{
+			if(SET_OF__streamed(opts, td)) {
+				/* Hand the element over instead of keeping it */
+				int ret = opts->element_cb(td,
+					ctx->ptr, opts->cb_key);
+				if(ret != 1)
+					ASN_STRUCT_FREE(*elm->type, ctx->ptr);
+				ctx->ptr = 0;
+				if(ret < 0)
+					RETURN(RC_FAIL);
+			} else {
 				asn_anonymous_set_ *list = _A_SET_FROM_VOID(st);
 				if(ASN_SET_ADD(list, ctx->ptr) != 0)
 					RETURN(RC_FAIL);
@@ -225,8 +252,12 @@ SET_OF_decode_ber(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				ADVANCE(rval.consumed);
 				RETURN(RC_WMORE);
 			}
+			ASN_DEC_ERROR(opt_codec_ctx, elm->type,
+				ASN_DEC_ERROR_LENGTH, 0);
 			/* Fall through */
 		case RC_FAIL: /* Fatal error */
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type, 0,
+				_A_SET_FROM_VOID(st)->count, consumed_myself);
 			RETURN(RC_FAIL);
 		} /* switch(rval) */
 		
@@ -313,7 +344,7 @@ SET_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	asn_app_consume_bytes_f *cb, void *app_key) {
 	asn_TYPE_member_t *elm = td->elements;
 	asn_TYPE_descriptor_t *elm_type = elm->type;
-	der_type_encoder_f *der_encoder = elm_type->der_encoder;
+	der_type_encoder_f *der_encoder = ASN_CODEC(elm_type, der_encoder);
 	asn_anonymous_set_ *list = _A_SET_FROM_VOID(ptr);
 	size_t computed_size = 0;
 	ssize_t encoding_size = 0;
@@ -321,9 +352,16 @@ SET_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	ssize_t eels_count = 0;
 	size_t max_encoded_len = 1;
 	asn_enc_rval_t erval;
+	asn_parallel_t *pool;
 	int ret;
 	int edx;
 
+	/* Large sets are encoded and sorted by the threads, if asked to */
+	if(list->count >= ASN_PARALLEL_DER_MIN
+	&& (pool = asn_parallel_current()))
+		return asn_parallel_der_list(pool, td, ptr, tag_mode, tag, 1,
+			cb, app_key);
+
 	ASN_DEBUG("Estimating size for SET OF %s", td->name);
 
 	/*
@@ -452,6 +490,108 @@ SET_OF_encode_der(asn_TYPE_descriptor_t *td, void *ptr,
 	_ASN_ENCODED_OK(erval);
 }
 
+/* Append bytes to the above structure, growing it as necessary */
+static int _el_growbytes(const void *buffer, size_t size, void *el_buf_ptr) {
+	struct _el_buffer *el_buf = (struct _el_buffer *)el_buf_ptr;
+
+	if(el_buf->length + size > el_buf->size) {
+		size_t new_size = el_buf->size ? el_buf->size : 256;
+		void *p;
+		while(new_size < el_buf->length + size)
+			new_size <<= 1;
+		p = REALLOC(el_buf->buf, new_size);
+		if(!p) return -1;
+		el_buf->buf = (uint8_t *)p;
+		el_buf->size = new_size;
+	}
+
+	memcpy(el_buf->buf + el_buf->length, buffer, size);
+
+	el_buf->length += size;
+	return 0;
+}
+
+/*
+ * The CER encoder of the SET OF type. The elements have to be sorted
+ * according to their encodings (X.690 #9.3), so they are encoded into
+ * a single buffer first; the rest is streamed out.
+ */
+asn_enc_rval_t
+SET_OF_encode_cer(asn_TYPE_descriptor_t *td, void *ptr,
+	int tag_mode, ber_tlv_tag_t tag,
+	asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_TYPE_member_t *elm = td->elements;
+	asn_anonymous_set_ *list = _A_SET_FROM_VOID(ptr);
+	cer_type_encoder_f *cer_encoder = cer_type_encoder(elm->type);
+	struct _el_buffer encoded = { 0, 0, 0 };
+	struct _el_buffer *encoded_els = 0;
+	ssize_t eels_count = 0;
+	asn_enc_rval_t erval;
+	ssize_t ret;
+	int edx;
+
+	ASN_DEBUG("Encoding SET OF %s (CER)", td->name);
+
+	if(list->count) {
+		encoded_els = (struct _el_buffer *)MALLOC(
+				list->count * sizeof(encoded_els[0]));
+		if(encoded_els == NULL) goto failed;
+	}
+
+	/*
+	 * Encode all members one after another,
+	 * remembering where each one starts.
+	 */
+	for(edx = 0; edx < list->count; edx++) {
+		void *memb_ptr = list->array[edx];
+		struct _el_buffer *encoded_el = &encoded_els[eels_count];
+		size_t start = encoded.length;
+
+		if(!memb_ptr) continue;
+
+		erval = cer_encoder(elm->type, memb_ptr, 0, elm->tag,
+			_el_growbytes, &encoded);
+		if(erval.encoded == -1) {
+			FREEMEM(encoded.buf);
+			FREEMEM(encoded_els);
+			return erval;
+		}
+		encoded_el->size = start;
+		encoded_el->length = encoded.length - start;
+		eels_count++;
+	}
+	for(edx = 0; edx < eels_count; edx++)
+		encoded_els[edx].buf = encoded.buf + encoded_els[edx].size;
+
+	qsort(encoded_els, eels_count, sizeof(encoded_els[0]), _el_buf_cmp);
+
+	ret = cer_write_tags(td, 0, tag_mode, 1, tag, cb, app_key);
+	if(ret == -1) goto failed;
+	erval.encoded = ret;
+
+	for(edx = 0; edx < eels_count; edx++) {
+		struct _el_buffer *encoded_el = &encoded_els[edx];
+		if(cb(encoded_el->buf, encoded_el->length, app_key) < 0)
+			goto failed;
+		erval.encoded += encoded_el->length;
+	}
+
+	ret = cer_write_eocs(td, tag_mode, 1, cb, app_key);
+	if(ret == -1) goto failed;
+	erval.encoded += ret;
+
+	FREEMEM(encoded.buf);
+	FREEMEM(encoded_els);
+	_ASN_ENCODED_OK(erval);
+failed:
+	FREEMEM(encoded.buf);
+	FREEMEM(encoded_els);
+	erval.encoded = -1;
+	erval.failed_type = td;
+	erval.structure_ptr = ptr;
+	return erval;
+}
+
 #undef	XER_ADVANCE
 #define	XER_ADVANCE(num_bytes)	do {			\
 		size_t num = num_bytes;			\
@@ -524,9 +664,9 @@ SET_OF_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 
 			/* Invoke the inner type decoder, m.b. multiple times */
 			ASN_DEBUG("XER/SET OF element [%s]", elm_tag);
-			tmprval = element->type->xer_decoder(opt_codec_ctx,
-					element->type, &ctx->ptr, elm_tag,
-					buf_ptr, size);
+			tmprval = ASN_CODEC(element->type, xer_decoder)(
+					opt_codec_ctx, element->type, &ctx->ptr,
+					elm_tag, buf_ptr, size);
 			if(tmprval.code == RC_OK) {
 				asn_anonymous_set_ *list = _A_SET_FROM_VOID(st);
 				if(ASN_SET_ADD(list, ctx->ptr) != 0)
@@ -534,6 +674,11 @@ SET_OF_decode_xer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 				ctx->ptr = 0;
 				XER_ADVANCE(tmprval.consumed);
 			} else {
+				if(tmprval.code == RC_FAIL)
+					ASN_DEC_ERROR_MEMBER(opt_codec_ctx,
+						element->type, 0,
+						_A_SET_FROM_VOID(st)->count,
+						consumed_myself);
 				XER_ADVANCE(tmprval.consumed);
 				RETURN(tmprval.code);
 			}
@@ -694,7 +839,7 @@ SET_OF_encode_xer(asn_TYPE_descriptor_t *td, void *sptr,
 
 		if(!xcan && specs->as_XMLValueList == 1)
 			_i_ASN_TEXT_INDENT(1, ilevel + 1);
-		tmper = elm->type->xer_encoder(elm->type, memb_ptr,
+		tmper = ASN_CODEC(elm->type, xer_encoder)(elm->type, memb_ptr,
 				ilevel + (specs->as_XMLValueList != 2),
 				flags, cb, app_key);
 		if(tmper.encoded == -1) {
@@ -752,6 +897,248 @@ cleanup:
 	_ASN_ENCODED_OK(er);
 }
 
+/*
+ * JER represents both SET OF and SEQUENCE OF by the array.
+ * There is no canonical variant, so the order is kept.
+ */
+asn_enc_rval_t
+SET_OF_encode_jer(asn_TYPE_descriptor_t *td, void *sptr,
+	int ilevel, enum jer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_TYPE_member_t *elm = td->elements;
+	asn_anonymous_set_ *list = _A_SET_FROM_VOID(sptr);
+	jer_type_encoder_f *encoder;
+	int pretty = !(flags & JER_F_MINIFIED);
+	asn_enc_rval_t er;
+	int members = 0;
+	int i;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+
+	encoder = jer_type_encoder(elm->type);
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	_ASN_CALLBACK("[", 1);
+	er.encoded = 1;
+
+	for(i = 0; i < list->count; i++) {
+		asn_enc_rval_t tmper;
+		void *memb_ptr = list->array[i];
+		if(!memb_ptr) continue;
+
+		if(members++) {
+			_ASN_CALLBACK(",", 1);
+			er.encoded++;
+		}
+		if(pretty) _i_ASN_TEXT_INDENT(1, ilevel + 1);
+
+		tmper = encoder(elm->type, memb_ptr,
+				ilevel + 1, flags, cb, app_key);
+		if(tmper.encoded == -1) return tmper;
+		er.encoded += tmper.encoded;
+	}
+
+	if(pretty && members) _i_ASN_TEXT_INDENT(1, ilevel);
+	_ASN_CALLBACK("]", 1);
+	er.encoded++;
+
+	_ASN_ENCODED_OK(er);
+cb_failed:
+	_ASN_ENCODE_FAILED;
+}
+
+/*
+ * Decode the JER array of elements.
+ * The value is complete: jer_decode() has delimited it already.
+ */
+asn_dec_rval_t
+SET_OF_decode_jer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	void **struct_ptr, const void *buf_ptr, size_t size) {
+	asn_SET_OF_specifics_t *specs = (asn_SET_OF_specifics_t *)td->specifics;
+	asn_TYPE_member_t *element = td->elements;
+	const char *buf = (const char *)buf_ptr;
+	void *st = *struct_ptr;	/* Target structure. */
+	jer_type_decoder_f *decoder;
+	asn_dec_rval_t rval;
+	jer_token_t tok;
+	size_t consumed = 0;
+	size_t n;
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	decoder = jer_type_decoder(element->type);
+	if(!decoder) _ASN_DECODE_FAILED;
+
+	n = jer_next_token(buf, size, &tok);
+	if(tok.type == JT_MORE) goto want_more;
+	if(tok.type != JT_ARRAY_START) _ASN_DECODE_FAILED;
+	consumed += n;
+
+	/*
+	 * Create the target structure if it is not present already.
+	 */
+	if(st == 0) {
+		st = *struct_ptr = CALLOC(1, specs->struct_size);
+		if(st == 0) _ASN_DECODE_FAILED;
+	}
+
+	/* Look ahead for the empty array */
+	n = jer_next_token(buf + consumed, size - consumed, &tok);
+	if(tok.type == JT_MORE) goto want_more;
+	if(tok.type == JT_ARRAY_END) {
+		consumed += n;
+	} else for(;;) {
+		void *elm = 0;
+
+		rval = decoder(opt_codec_ctx, element->type, &elm,
+			buf + consumed, size - consumed);
+		if(rval.code != RC_OK || ASN_SET_ADD(st, elm)) {
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, element->type, 0,
+				_A_SET_FROM_VOID(st)->count, consumed);
+			ASN_STRUCT_FREE(*element->type, elm);
+			if(rval.code == RC_OK) rval.code = RC_FAIL;
+			rval.consumed = 0;
+			return rval;
+		}
+		consumed += rval.consumed;
+
+		n = jer_next_token(buf + consumed, size - consumed, &tok);
+		if(tok.type == JT_MORE) goto want_more;
+		consumed += n;
+		if(tok.type == JT_ARRAY_END) break;
+		if(tok.type != JT_COMMA) _ASN_DECODE_FAILED;
+	}
+
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+
+want_more:
+	rval.code = RC_WMORE;
+	rval.consumed = 0;
+	return rval;
+}
+
+/*
+ * X.696 #21, #22: the quantity of the components, then the components.
+ * The components go in the order they are stored for CANONICAL-OER, too.
+ */
+asn_enc_rval_t
+SET_OF_encode_oer(asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void *sptr,
+	enum oer_encoder_flags_e flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_TYPE_member_t *elm = td->elements;
+	asn_anonymous_set_ *list = _A_SET_FROM_VOID(sptr);
+	oer_type_encoder_f *encoder;
+	asn_enc_rval_t er;
+	int i;
+
+	(void)constraints;
+
+	if(!sptr) _ASN_ENCODE_FAILED;
+
+	encoder = oer_type_encoder(elm->type);
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	for(i = 0; i < list->count; i++)
+		if(!list->array[i]) _ASN_ENCODE_FAILED;
+
+	er.encoded = oer_serialize_long(list->count, 0, 1, cb, app_key);
+	if(er.encoded < 0) _ASN_ENCODE_FAILED;
+
+	for(i = 0; i < list->count; i++) {
+		asn_enc_rval_t tmper;
+
+		tmper = encoder(elm->type, elm->per_constraints,
+				list->array[i], flags, cb, app_key);
+		if(tmper.encoded == -1) return tmper;
+		er.encoded += tmper.encoded;
+	}
+
+	_ASN_ENCODED_OK(er);
+}
+
+/*
+ * The encoding of a type is either always empty (NULL and alike)
+ * or at least one octet long, so only the quantity of the former
+ * is not bounded by the input size.
+ */
+#define	SET_OF_OER_EMPTY_MAX	65536
+
+asn_dec_rval_t
+SET_OF_decode_oer(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+	asn_per_constraints_t *constraints, void **struct_ptr,
+		const void *buf_ptr, size_t size) {
+	asn_SET_OF_specifics_t *specs = (asn_SET_OF_specifics_t *)td->specifics;
+	asn_TYPE_member_t *element = td->elements;
+	const char *buf = (const char *)buf_ptr;
+	void *st = *struct_ptr;	/* Target structure. */
+	oer_type_decoder_f *decoder;
+	asn_dec_rval_t rval;
+	ssize_t consumed;
+	long count;
+	long i;
+
+	(void)constraints;
+
+	if(_ASN_STACK_OVERFLOW_CHECK(opt_codec_ctx))
+		_ASN_DECODE_FAILED;
+
+	decoder = oer_type_decoder(element->type);
+	if(!decoder) _ASN_DECODE_FAILED;
+
+	consumed = oer_fetch_long(buf, size, 0, 1, &count);
+	if(consumed < 0) _ASN_DECODE_FAILED;
+	if(consumed == 0) {
+		rval.code = RC_WMORE;
+		rval.consumed = 0;
+		return rval;
+	}
+
+	/*
+	 * Create the target structure if it is not present already.
+	 */
+	if(st == 0) {
+		st = *struct_ptr = CALLOC(1, specs->struct_size);
+		if(st == 0) _ASN_DECODE_FAILED;
+	}
+
+	for(i = 0; i < count; i++) {
+		void *elm = 0;
+
+		rval = decoder(opt_codec_ctx, element->type,
+			element->per_constraints, &elm,
+			buf + consumed, size - consumed);
+		if(rval.code != RC_OK || ASN_SET_ADD(st, elm)) {
+			ASN_DEC_ERROR_MEMBER(opt_codec_ctx, element->type, 0,
+				_A_SET_FROM_VOID(st)->count, consumed);
+			ASN_STRUCT_FREE(*element->type, elm);
+			if(rval.code == RC_OK) rval.code = RC_FAIL;
+			rval.consumed = 0;
+			return rval;
+		}
+		consumed += rval.consumed;
+
+		/* Check the quantity against the size of the first element */
+		if(i == 0) {
+			if(rval.consumed == 0) {
+				if(count > SET_OF_OER_EMPTY_MAX)
+					_ASN_DECODE_FAILED;
+			} else if((unsigned long)(count - 1) > size - consumed) {
+				rval.code = RC_WMORE;
+				rval.consumed = 0;
+				return rval;
+			}
+		}
+	}
+
+	rval.code = RC_OK;
+	rval.consumed = consumed;
+	return rval;
+}
+
 int
 SET_OF_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 		asn_app_consume_bytes_f *cb, void *app_key) {
@@ -787,10 +1174,14 @@ SET_OF_print(asn_TYPE_descriptor_t *td, const void *sptr, int ilevel,
 void
 SET_OF_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 	if(td && ptr) {
+		asn_SET_OF_specifics_t *specs;
 		asn_TYPE_member_t *elm = td->elements;
 		asn_anonymous_set_ *list = _A_SET_FROM_VOID(ptr);
+		asn_struct_ctx_t *ctx;	/* Decoder context */
 		int i;
 
+		specs = (asn_SET_OF_specifics_t *)td->specifics;
+
 		/*
 		 * Could not use set_of_empty() because of (*free)
 		 * incompatibility.
@@ -804,12 +1195,182 @@ SET_OF_free(asn_TYPE_descriptor_t *td, void *ptr, int contents_only) {
 
 		asn_set_empty(list);	/* Remove (list->array) */
 
+		/* The element left half-decoded by an interrupted decoding */
+		ctx = (asn_struct_ctx_t *)((char *)ptr + specs->ctx_offset);
+		if(ctx->ptr) {
+			ASN_STRUCT_FREE(*elm->type, ctx->ptr);
+			ctx->ptr = 0;
+		}
+
 		if(!contents_only) {
 			FREEMEM(ptr);
 		}
 	}
 }
 
+/*
+ * The SET OF lists are equal if they have the same elements,
+ * in whatever order. The elements are sorted by their hashes to find
+ * the candidates for the equal ones; without the memory for that,
+ * every element is counted in both lists instead.
+ */
+#define	SET_OF_EQUALS_LOCAL	16	/* Elements hashed on the stack */
+struct _el_hashed {
+	uint64_t hash;
+	const void *ptr;
+};
+static int _el_hashed_cmp(const void *ap, const void *bp) {
+	const struct _el_hashed *a = (const struct _el_hashed *)ap;
+	const struct _el_hashed *b = (const struct _el_hashed *)bp;
+	if(a->hash != b->hash)
+		return a->hash < b->hash ? -1 : 1;
+	return 0;
+}
+
+static int
+SET_OF__counted_equals(asn_TYPE_descriptor_t *elm_type,
+		const asn_anonymous_set_ *a, const asn_anonymous_set_ *b) {
+	int i, j;
+
+	for(i = 0; i < a->count; i++) {
+		int a_count = 0, b_count = 0;
+		for(j = 0; j < a->count; j++)
+			a_count += asn_equals(elm_type, a->array[i], a->array[j]);
+		for(j = 0; j < b->count; j++)
+			b_count += asn_equals(elm_type, a->array[i], b->array[j]);
+		if(a_count != b_count)
+			return 0;
+	}
+
+	return 1;
+}
+
+int
+SET_OF_equals(asn_TYPE_descriptor_t *td,
+		const void *struct_a, const void *struct_b) {
+	asn_TYPE_descriptor_t *elm_type = td->elements->type;
+	const asn_anonymous_set_ *a = _A_CSET_FROM_VOID(struct_a);
+	const asn_anonymous_set_ *b = _A_CSET_FROM_VOID(struct_b);
+	struct _el_hashed local[2 * SET_OF_EQUALS_LOCAL];
+	struct _el_hashed *a_els, *b_els;
+	int equal = 1;
+	int i, j, k;
+
+	if(a->count != b->count)
+		return 0;
+
+	/* Most often, the equal lists are in the same order */
+	for(i = 0; i < a->count; i++) {
+		if(!asn_equals(elm_type, a->array[i], b->array[i]))
+			break;
+	}
+	if(i == a->count)
+		return 1;
+
+	if(a->count <= SET_OF_EQUALS_LOCAL) {
+		a_els = local;
+	} else {
+		a_els = (struct _el_hashed *)MALLOC(
+			2 * a->count * sizeof(a_els[0]));
+		if(!a_els)
+			return SET_OF__counted_equals(elm_type, a, b);
+	}
+	b_els = a_els + a->count;
+
+	for(i = 0; i < a->count; i++) {
+		a_els[i].ptr = a->array[i];
+		a_els[i].hash = asn_hash(elm_type, a_els[i].ptr);
+		b_els[i].ptr = b->array[i];
+		b_els[i].hash = asn_hash(elm_type, b_els[i].ptr);
+	}
+	qsort(a_els, a->count, sizeof(a_els[0]), _el_hashed_cmp);
+	qsort(b_els, b->count, sizeof(b_els[0]), _el_hashed_cmp);
+
+	/*
+	 * Match every element to an equal one with the same hash,
+	 * taking the matched ones out of (b_els).
+	 */
+	for(i = 0; i < a->count; i++) {
+		if(a_els[i].hash != b_els[i].hash) {
+			equal = 0;
+			break;
+		}
+		for(j = i; j < b->count && b_els[j].hash == a_els[i].hash; j++) {
+			if(asn_equals(elm_type, a_els[i].ptr, b_els[j].ptr))
+				break;
+		}
+		if(j == b->count || b_els[j].hash != a_els[i].hash) {
+			equal = 0;
+			break;
+		}
+		/* Keep the unmatched ones of the same hash sorted */
+		for(k = j; k > i; k--)
+			b_els[k] = b_els[k - 1];
+	}
+
+	if(a_els != local)
+		FREEMEM(a_els);
+
+	return equal;
+}
+
+/*
+ * The hashes of the elements are added up, in whatever order.
+ */
+uint64_t
+SET_OF_hash(asn_TYPE_descriptor_t *td, const void *sptr) {
+	asn_TYPE_descriptor_t *elm_type = td->elements->type;
+	const asn_anonymous_set_ *list = _A_CSET_FROM_VOID(sptr);
+	uint64_t sum = 0;
+	int i;
+
+	for(i = 0; i < list->count; i++)
+		sum += asn_hash(elm_type, list->array[i]);
+
+	return asn_hash__end(asn_hash__value(
+		asn_hash__value(0, list->count), sum));
+}
+
+/*
+ * The copy of the list has the exact size. Its elements are always
+ * pointers, so each is copied as the member of its slot of the array.
+ */
+int
+SET_OF_copy(asn_TYPE_descriptor_t *td, void **struct_dst,
+		const void *struct_src, asn_copy_t *copy) {
+	asn_SET_OF_specifics_t *specs = (asn_SET_OF_specifics_t *)td->specifics;
+	const asn_anonymous_set_ *src = _A_CSET_FROM_VOID(struct_src);
+	asn_anonymous_set_ *list;
+	void **array = 0;
+	int i;
+
+	list = _A_SET_FROM_VOID(asn_copy__struct(copy, struct_dst,
+		specs->struct_size));
+	if(!list) return -1;
+	if(src->count > 0) {
+		array = (void **)asn_copy__alloc(copy,
+			src->count * sizeof(array[0]));
+		if(!array) return -1;
+	}
+
+	if(!ASN_COPY_MEASURING(copy)) {
+		list->array = array;
+		list->size = src->count > 0 ? src->count : 0;
+	}
+
+	for(i = 0; i < src->count; i++) {
+		void *slot = 0;
+		if(!ASN_COPY_MEASURING(copy)) {
+			list->count = i + 1;	/* Freed along if it fails */
+			slot = &list->array[i];
+		}
+		if(asn_copy__member(copy, td->elements, slot, &src->array[i]))
+			return -1;
+	}
+
+	return 0;
+}
+
 int
 SET_OF_constraint(asn_TYPE_descriptor_t *td, const void *sptr,
 		asn_app_constraint_failed_f *ctfailcb, void *app_key) {
@@ -908,11 +1469,17 @@ SET_OF_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			if(nelems < 0) _ASN_DECODE_STARVED;
 		}
 
+		if(nelems && !elm->type->uper_decoder) {
+			/* No PER support for the elements */
+			ASN_DEC_ERROR(opt_codec_ctx, elm->type,
+				ASN_DEC_ERROR_UNSUPPORTED, 0);
+			_ASN_DECODE_FAILED;
+		}
 		for(i = 0; i < nelems; i++) {
 			void *ptr = 0;
 			ASN_DEBUG("SET OF %s decoding", elm->type->name);
-			rv = elm->type->uper_decoder(opt_codec_ctx, elm->type,
-				elm->per_constraints, &ptr, pd);
+			rv = ASN_CODEC(elm->type, uper_decoder)(opt_codec_ctx,
+				elm->type, elm->per_constraints, &ptr, pd);
 			ASN_DEBUG("%s SET OF %s decoded %d, %p",
 				td->name, elm->type->name, rv.code, ptr);
 			if(rv.code == RC_OK) {
@@ -925,6 +1492,8 @@ SET_OF_decode_uper(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 			} else {
 				ASN_DEBUG("Failed decoding %s of %s (SET OF)",
 					elm->type->name, td->name);
+				ASN_DEC_ERROR_MEMBER(opt_codec_ctx, elm->type,
+					0, list->count, 0);
 			}
 			if(ptr) ASN_STRUCT_FREE(*elm->type, ptr);
 			return rv;
@@ -29,23 +29,50 @@ asn_TYPE_outmost_tag(asn_TYPE_descriptor_t *type_descriptor,
 	return type_descriptor->outmost_tag(type_descriptor, struct_ptr, 0, 0);
 }
 
+int
+asn_TYPE_resolve(asn_TYPE_descriptor_t *td) {
+	asn_struct_free_f *free_struct;
+	int changed = 0;
+
+	/*
+	 * The types derived by the compiler copy the functions
+	 * of their base type into the descriptor on the first use,
+	 * possibly through a chain of the derived types.
+	 * Freeing nothing is a harmless use.
+	 */
+	while((free_struct = td->free_struct)) {
+		free_struct(td, 0, 0);
+		if(td->free_struct == free_struct)
+			break;
+		changed = 1;
+	}
+
+	return changed;
+}
+
 /*
  * Print the target language's structure in human readable form.
  */
 int
 asn_fprint(FILE *stream, asn_TYPE_descriptor_t *td, const void *struct_ptr) {
+	asn_output_buffer_t ob;
+	int ret;
+
 	if(!stream) stream = stdout;
 	if(!td || !struct_ptr) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Invoke type-specific printer */
-	if(td->print_struct(td, struct_ptr, 1, _print2fp, stream))
-		return -1;
+	/* Coalesce the printer's output into larger fwrite() calls */
+	asn_output_buffer_init(&ob, _print2fp, stream);
 
-	/* Terminate the output */
-	if(_print2fp("\n", 1, stream))
+	/* Invoke type-specific printer, then terminate the output */
+	ret = td->print_struct(td, struct_ptr, 1,
+			asn_output_buffer_consume, &ob);
+	if(ret == 0)
+		ret = asn_output_buffer_consume("\n", 1, &ob);
+	if(asn_output_buffer_flush(&ob) || ret)
 		return -1;
 
 	return fflush(stream);
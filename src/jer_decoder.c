@@ -0,0 +1,139 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_application.h>
+#include <asn_internal.h>
+#include <jer_support.h>		/* JSON tokenizer */
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <REAL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <BIT_STRING.h>
+#include <BMPString.h>
+#include <UniversalString.h>
+#include <OBJECT_IDENTIFIER.h>
+#include <RELATIVE-OID.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SET_OF.h>
+
+/*
+ * The runtime's JER decoders matched by the XER decoder of the type.
+ */
+static const struct {
+	xer_type_decoder_f *xer_decoder;
+	jer_type_decoder_f *jer_decoder;
+} jer_decoders[] = {
+	{ INTEGER_decode_xer,		INTEGER_decode_jer },
+	{ NativeInteger_decode_xer,	NativeInteger_decode_jer },
+	{ BOOLEAN_decode_xer,		BOOLEAN_decode_jer },
+	{ NULL_decode_xer,		NULL_decode_jer },
+	{ REAL_decode_xer,		REAL_decode_jer },
+	{ NativeReal_decode_xer,	NativeReal_decode_jer },
+	{ OCTET_STRING_decode_xer_hex,	OCTET_STRING_decode_jer_hex },
+	{ OCTET_STRING_decode_xer_utf8,	OCTET_STRING_decode_jer_utf8 },
+	{ OCTET_STRING_decode_xer_binary, BIT_STRING_decode_jer },
+	{ BMPString_decode_xer,		BMPString_decode_jer },
+	{ UniversalString_decode_xer,	UniversalString_decode_jer },
+	{ OBJECT_IDENTIFIER_decode_xer,	OBJECT_IDENTIFIER_decode_jer },
+	{ RELATIVE_OID_decode_xer,	RELATIVE_OID_decode_jer },
+	{ SEQUENCE_decode_xer,		SEQUENCE_decode_jer },
+	{ SET_decode_xer,		SET_decode_jer },
+	{ CHOICE_decode_xer,		CHOICE_decode_jer },
+	{ SET_OF_decode_xer,		SET_OF_decode_jer }
+};
+
+jer_type_decoder_f *
+jer_type_decoder(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	if(td->jer_decoder)
+		return td->jer_decoder;
+
+	do {
+		for(i = 0; i < sizeof(jer_decoders)/sizeof(jer_decoders[0]); i++) {
+			if(jer_decoders[i].xer_decoder == td->xer_decoder)
+				return jer_decoders[i].jer_decoder;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	return 0;
+}
+
+/*
+ * Decode the JER encoding of a given type.
+ */
+asn_dec_rval_t
+jer_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+		void **struct_ptr, const void *buffer, size_t size) {
+	asn_codec_ctx_t s_codec_ctx;
+	asn_mem_account_t account;
+	jer_type_decoder_f *decoder;
+	asn_dec_rval_t rval;
+	size_t broken;
+	ssize_t len;
+
+	/*
+	 * Stack checker requires that the codec context
+	 * must be allocated on the stack.
+	 */
+	if(opt_codec_ctx) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
+			s_codec_ctx = *opt_codec_ctx;
+			opt_codec_ctx = &s_codec_ctx;
+		}
+	} else {
+		/* If context is not given, be security-conscious anyway */
+		memset(&s_codec_ctx, 0, sizeof(s_codec_ctx));
+		s_codec_ctx.max_stack_size = _ASN_DEFAULT_STACK_MAX;
+		opt_codec_ctx = &s_codec_ctx;
+	}
+
+	ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+
+	decoder = jer_type_decoder(td);
+	if(!decoder) {
+		ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_UNSUPPORTED, 0);
+		ASN_DEC_ERROR_END(opt_codec_ctx, td, RC_FAIL, -1);
+		rval.code = RC_FAIL;
+		rval.consumed = 0;
+		return rval;
+	}
+
+	/*
+	 * Delimit the value first: the type decoders are not restartable,
+	 * so nothing is decoded until the whole value is there.
+	 */
+	len = jer_value_length(buffer, size, &broken);
+	switch(len) {
+	case -1:
+		ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_VALUE,
+			(long)broken);
+		ASN_DEC_ERROR_END(opt_codec_ctx, td, RC_FAIL, -1);
+		rval.code = RC_FAIL;
+		rval.consumed = 0;
+		return rval;
+	case 0:
+		rval.code = RC_WMORE;
+		rval.consumed = 0;
+		return rval;
+	}
+
+	/*
+	 * Invoke type-specific decoder.
+	 */
+	asn_mem__begin(&account, opt_codec_ctx, 0);
+	rval = decoder(opt_codec_ctx, td, struct_ptr, buffer, len);
+	asn_mem__end(&account);
+	if(rval.code == RC_WMORE) {
+		/* The value is complete; it must have been broken */
+		rval.code = RC_FAIL;
+	}
+	ASN_DEC_ERROR_END(opt_codec_ctx, td, rval.code, -1);
+	return rval;
+}
@@ -0,0 +1,209 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <stdio.h>
+#include <errno.h>
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <NativeEnumerated.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <REAL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <BIT_STRING.h>
+#include <BMPString.h>
+#include <UniversalString.h>
+#include <OBJECT_IDENTIFIER.h>
+#include <RELATIVE-OID.h>
+#include <GeneralizedTime.h>
+#include <UTCTime.h>
+#include <ANY.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SEQUENCE_OF.h>
+#include <constr_SET_OF.h>
+
+/*
+ * The runtime's JER encoders matched by the XER encoder of the type.
+ */
+static const struct {
+	xer_type_encoder_f *xer_encoder;
+	jer_type_encoder_f *jer_encoder;
+} jer_encoders[] = {
+	{ INTEGER_encode_xer,		INTEGER_encode_jer },
+	{ NativeInteger_encode_xer,	NativeInteger_encode_jer },
+	{ NativeEnumerated_encode_xer,	NativeEnumerated_encode_jer },
+	{ BOOLEAN_encode_xer,		BOOLEAN_encode_jer },
+	{ NULL_encode_xer,		NULL_encode_jer },
+	{ REAL_encode_xer,		REAL_encode_jer },
+	{ NativeReal_encode_xer,	NativeReal_encode_jer },
+	{ OCTET_STRING_encode_xer,	OCTET_STRING_encode_jer },
+	{ OCTET_STRING_encode_xer_utf8,	OCTET_STRING_encode_jer_utf8 },
+	{ GeneralizedTime_encode_xer,	OCTET_STRING_encode_jer_utf8 },
+	{ UTCTime_encode_xer,		OCTET_STRING_encode_jer_utf8 },
+	{ ANY_encode_xer,		OCTET_STRING_encode_jer },
+	{ BIT_STRING_encode_xer,	BIT_STRING_encode_jer },
+	{ BMPString_encode_xer,		BMPString_encode_jer },
+	{ UniversalString_encode_xer,	UniversalString_encode_jer },
+	{ OBJECT_IDENTIFIER_encode_xer,	OBJECT_IDENTIFIER_encode_jer },
+	{ RELATIVE_OID_encode_xer,	RELATIVE_OID_encode_jer },
+	{ SEQUENCE_encode_xer,		SEQUENCE_encode_jer },
+	{ SET_encode_xer,		SET_encode_jer },
+	{ CHOICE_encode_xer,		CHOICE_encode_jer },
+	{ SEQUENCE_OF_encode_xer,	SEQUENCE_OF_encode_jer },
+	{ SET_OF_encode_xer,		SET_OF_encode_jer }
+};
+
+jer_type_encoder_f *
+jer_type_encoder(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	if(td->jer_encoder)
+		return td->jer_encoder;
+
+	do {
+		for(i = 0; i < sizeof(jer_encoders)/sizeof(jer_encoders[0]); i++) {
+			if(jer_encoders[i].xer_encoder == td->xer_encoder)
+				return jer_encoders[i].jer_encoder;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	return 0;
+}
+
+/*
+ * The JER encoder of any type. May be invoked by the application.
+ */
+asn_enc_rval_t
+jer_encode(asn_TYPE_descriptor_t *td, void *sptr,
+	enum jer_encoder_flags_e jer_flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	jer_type_encoder_f *encoder;
+	asn_output_buffer_t ob;
+	asn_enc_rval_t er;
+
+	if(!td || !sptr) _ASN_ENCODE_FAILED;
+
+	encoder = jer_type_encoder(td);
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	/* Coalesce the output as xer_encode() does */
+	asn_output_buffer_init(&ob, cb, app_key);
+	er = encoder(td, sptr, 0, jer_flags, asn_output_buffer_consume, &ob);
+	if(er.encoded == -1) {
+		(void)asn_output_buffer_flush(&ob);
+		return er;
+	}
+	if(jer_flags & JER_F_BASIC) {
+		if(asn_output_buffer_consume("\n", 1, &ob))
+			_ASN_ENCODE_FAILED;
+		er.encoded++;
+	}
+	if(asn_output_buffer_flush(&ob))
+		_ASN_ENCODE_FAILED;
+
+	return er;
+}
+
+/*
+ * This is a helper function for jer_fprint, which directs all incoming data
+ * into the provided file descriptor.
+ */
+static int
+jer__print2fp(const void *buffer, size_t size, void *app_key) {
+	FILE *stream = (FILE *)app_key;
+
+	if(fwrite(buffer, 1, size, stream) != size)
+		return -1;
+
+	return 0;
+}
+
+int
+jer_fprint(FILE *stream, asn_TYPE_descriptor_t *td, void *sptr) {
+	asn_enc_rval_t er;
+
+	if(!stream) stream = stdout;
+	if(!td || !sptr)
+		return -1;
+
+	er = jer_encode(td, sptr, JER_F_BASIC, jer__print2fp, stream);
+	if(er.encoded == -1)
+		return -1;
+
+	return fflush(stream);
+}
+
+int
+jer_escape_consume(const void *buffer, size_t size, void *key) {
+	jer_escape_arg_t *arg = (jer_escape_arg_t *)key;
+	const uint8_t *buf = (const uint8_t *)buffer;
+	const uint8_t *end = buf + size;
+	const uint8_t *run;
+
+	for(run = buf; buf < end; buf++) {
+		static const char h2c[] = "0123456789abcdef";
+		char scratch[6];
+		const char *esc;
+		size_t esc_len = 2;
+
+		switch(*buf) {
+		case 0x22: esc = "\\\""; break;
+		case 0x5c: esc = "\\\\"; break;
+		case 0x08: esc = "\\b"; break;
+		case 0x0c: esc = "\\f"; break;
+		case 0x0a: esc = "\\n"; break;
+		case 0x0d: esc = "\\r"; break;
+		case 0x09: esc = "\\t"; break;
+		default:
+			if(*buf >= 0x20) continue;
+			scratch[0] = '\\';
+			scratch[1] = 'u';
+			scratch[2] = '0';
+			scratch[3] = '0';
+			scratch[4] = h2c[*buf >> 4];
+			scratch[5] = h2c[*buf & 0x0f];
+			esc = scratch;
+			esc_len = 6;
+		}
+
+		/* Flush the run of the plain characters */
+		if(buf > run) {
+			if(arg->cb(run, buf - run, arg->app_key) < 0)
+				return -1;
+			arg->encoded += buf - run;
+		}
+		if(arg->cb(esc, esc_len, arg->app_key) < 0)
+			return -1;
+		arg->encoded += esc_len;
+		run = buf + 1;
+	}
+
+	if(buf > run) {
+		if(arg->cb(run, buf - run, arg->app_key) < 0)
+			return -1;
+		arg->encoded += buf - run;
+	}
+
+	return 0;
+}
+
+ssize_t
+jer_encode_string(const void *buf, size_t size,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	jer_escape_arg_t arg;
+
+	arg.cb = cb;
+	arg.app_key = app_key;
+	arg.encoded = 0;
+
+	if(cb("\"", 1, app_key) < 0
+	|| jer_escape_consume(buf, size, &arg) < 0
+	|| cb("\"", 1, app_key) < 0)
+		return -1;
+
+	return arg.encoded + 2;
+}
@@ -0,0 +1,271 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_system.h>
+#include <jer_support.h>
+
+#define	JER_IS_SPACE(c)	((c) == 0x20 || (c) == 0x09 || (c) == 0x0a || (c) == 0x0d)
+#define	JER_IS_DIGIT(c)	((c) >= 0x30 && (c) <= 0x39)
+
+/*
+ * Check the literal (true, false, null) at the start of the buffer.
+ */
+static jer_token_e
+_jer_literal(const char *p, size_t size, const char *lit, size_t lit_len,
+		jer_token_e type) {
+	if(size < lit_len)
+		return memcmp(p, lit, size) ? JT_BROKEN : JT_MORE;
+	return memcmp(p, lit, lit_len) ? JT_BROKEN : type;
+}
+
+size_t
+jer_next_token(const void *buf_ptr, size_t size, jer_token_t *tok) {
+	const char *buf = (const char *)buf_ptr;
+	const char *p = buf;
+	const char *end = buf + size;
+
+	while(p < end && JER_IS_SPACE(*p)) p++;
+
+	tok->start = p;
+	tok->length = 0;
+	tok->escaped = 0;
+
+	if(p == end) {
+		tok->type = JT_MORE;
+		return 0;
+	}
+
+	switch(*p) {
+	case 0x7b: tok->type = JT_OBJECT_START; break;	/* { */
+	case 0x7d: tok->type = JT_OBJECT_END; break;	/* } */
+	case 0x5b: tok->type = JT_ARRAY_START; break;	/* [ */
+	case 0x5d: tok->type = JT_ARRAY_END; break;	/* ] */
+	case 0x2c: tok->type = JT_COMMA; break;		/* , */
+	case 0x3a: tok->type = JT_COLON; break;		/* : */
+	case 0x22:	/* " */
+	    {
+		const char *q;
+		for(p++; p < end; p = q + 1) {
+			/* Most of the string needs no attention */
+			q = (const char *)memchr(p, 0x22, end - p);
+			if(!q) break;
+			for(; p < q; p++) {
+				unsigned char ch = *p;
+				if(ch < 0x20) {
+					tok->type = JT_BROKEN;
+					return 0;
+				}
+				if(ch == 0x5c) {	/* \ */
+					tok->escaped = 1;
+					p++;	/* Skip the escaped character */
+				}
+			}
+			if(p == q) {
+				tok->type = JT_STRING;
+				tok->start++;
+				tok->length = q - tok->start;
+				return (q + 1) - buf;
+			}
+			/* Otherwise the quote was escaped */
+		}
+		tok->type = JT_MORE;
+		return 0;
+	    }
+	case 0x74:	/* t */
+		tok->type = _jer_literal(p, end - p, "true", 4, JT_TRUE);
+		tok->length = 4;
+		break;
+	case 0x66:	/* f */
+		tok->type = _jer_literal(p, end - p, "false", 5, JT_FALSE);
+		tok->length = 5;
+		break;
+	case 0x6e:	/* n */
+		tok->type = _jer_literal(p, end - p, "null", 4, JT_NULL);
+		tok->length = 4;
+		break;
+	case 0x2d:	/* - */
+	case 0x30: case 0x31: case 0x32: case 0x33: case 0x34:
+	case 0x35: case 0x36: case 0x37: case 0x38: case 0x39:
+	    {
+		const char *q = p;
+		if(*q == 0x2d) q++;
+		if(q == end || !JER_IS_DIGIT(*q)) {
+			tok->type = (q == end) ? JT_MORE : JT_BROKEN;
+			return 0;
+		}
+		if(*q == 0x30) {
+			q++;	/* No leading zeroes */
+		} else {
+			while(q < end && JER_IS_DIGIT(*q)) q++;
+		}
+		if(q < end && *q == 0x2e) {	/* . */
+			if(++q == end || !JER_IS_DIGIT(*q)) {
+				tok->type = (q == end) ? JT_MORE : JT_BROKEN;
+				return 0;
+			}
+			while(q < end && JER_IS_DIGIT(*q)) q++;
+		}
+		if(q < end && (*q == 0x65 || *q == 0x45)) {	/* e E */
+			if(++q < end && (*q == 0x2b || *q == 0x2d)) q++;
+			if(q == end || !JER_IS_DIGIT(*q)) {
+				tok->type = (q == end) ? JT_MORE : JT_BROKEN;
+				return 0;
+			}
+			while(q < end && JER_IS_DIGIT(*q)) q++;
+		}
+		tok->type = JT_NUMBER;
+		tok->length = q - p;
+		return q - buf;
+	    }
+	default:
+		tok->type = JT_BROKEN;
+		return 0;
+	}
+
+	switch(tok->type) {
+	case JT_BROKEN:
+	case JT_MORE:
+		return 0;
+	default:
+		if(!tok->length) tok->length = 1;
+		return (p + tok->length) - buf;
+	}
+}
+
+ssize_t
+jer_value_length(const void *buf_ptr, size_t size, size_t *opt_broken) {
+	const char *buf = (const char *)buf_ptr;
+	size_t consumed = 0;
+	size_t depth = 0;
+	jer_token_t tok;
+	/*
+	 * The state is tracked per nesting level only as far as
+	 * it is needed to reject the obviously broken input;
+	 * the type decoders check the rest.
+	 */
+	int want_value = 1;
+
+	for(;;) {
+		size_t n = jer_next_token(buf + consumed, size - consumed, &tok);
+		switch(tok.type) {
+		case JT_BROKEN:
+			goto broken;
+		case JT_MORE:
+			return 0;
+		case JT_OBJECT_START:
+		case JT_ARRAY_START:
+			if(!want_value) goto broken;
+			depth++;
+			break;
+		case JT_OBJECT_END:
+		case JT_ARRAY_END:
+			if(!depth) goto broken;
+			depth--;
+			want_value = 0;
+			break;
+		case JT_COMMA:
+		case JT_COLON:
+			if(want_value || !depth) goto broken;
+			want_value = 1;
+			break;
+		default:
+			if(!want_value) goto broken;
+			want_value = 0;
+			break;
+		}
+		consumed += n;
+		if(!depth && !want_value)
+			return consumed;
+		if(tok.type == JT_OBJECT_START || tok.type == JT_ARRAY_START)
+			want_value = 1;
+	}
+
+broken:
+	if(opt_broken) *opt_broken = tok.start - buf;
+	return -1;
+}
+
+static int
+_jer_hex4(const char *p) {
+	int v = 0;
+	int i;
+	for(i = 0; i < 4; i++) {
+		int ch = p[i];
+		v <<= 4;
+		if(ch >= 0x30 && ch <= 0x39) v |= ch - 0x30;
+		else if(ch >= 0x41 && ch <= 0x46) v |= ch - 0x41 + 10;
+		else if(ch >= 0x61 && ch <= 0x66) v |= ch - 0x61 + 10;
+		else return -1;
+	}
+	return v;
+}
+
+ssize_t
+jer_unescape(const char *str, size_t size, char *dst) {
+	const char *end = str + size;
+	char *d = dst;
+
+	while(str < end) {
+		const char *bs = (const char *)memchr(str, 0x5c, end - str);
+		uint32_t wc;
+		int v;
+
+		if(!bs) bs = end;
+		memcpy(d, str, bs - str);
+		d += bs - str;
+		if(bs == end) break;
+
+		if(end - bs < 2) return -1;
+		switch(bs[1]) {
+		case 0x22: *d++ = 0x22; str = bs + 2; continue;	/* \" */
+		case 0x5c: *d++ = 0x5c; str = bs + 2; continue;	/* \\ */
+		case 0x2f: *d++ = 0x2f; str = bs + 2; continue;	/* \/ */
+		case 0x62: *d++ = 0x08; str = bs + 2; continue;	/* \b */
+		case 0x66: *d++ = 0x0c; str = bs + 2; continue;	/* \f */
+		case 0x6e: *d++ = 0x0a; str = bs + 2; continue;	/* \n */
+		case 0x72: *d++ = 0x0d; str = bs + 2; continue;	/* \r */
+		case 0x74: *d++ = 0x09; str = bs + 2; continue;	/* \t */
+		case 0x75:	/* \uXXXX */
+			if(end - bs < 6) return -1;
+			if((v = _jer_hex4(bs + 2)) < 0) return -1;
+			wc = v;
+			str = bs + 6;
+			if(wc >= 0xd800 && wc <= 0xdbff) {
+				/* Surrogate pair */
+				int lo;
+				if(end - str < 6 || str[0] != 0x5c
+				|| str[1] != 0x75
+				|| (lo = _jer_hex4(str + 2)) < 0xdc00
+				|| lo > 0xdfff)
+					return -1;
+				wc = 0x10000 + ((wc - 0xd800) << 10)
+					+ (lo - 0xdc00);
+				str += 6;
+			} else if(wc >= 0xdc00 && wc <= 0xdfff) {
+				return -1;	/* Unpaired low surrogate */
+			}
+			break;
+		default:
+			return -1;
+		}
+
+		/* Encode (wc) in UTF-8 */
+		if(wc < 0x80) {
+			*d++ = (char)wc;
+		} else if(wc < 0x800) {
+			*d++ = (char)(0xc0 | (wc >> 6));
+			*d++ = (char)(0x80 | (wc & 0x3f));
+		} else if(wc < 0x10000) {
+			*d++ = (char)(0xe0 | (wc >> 12));
+			*d++ = (char)(0x80 | ((wc >> 6) & 0x3f));
+			*d++ = (char)(0x80 | (wc & 0x3f));
+		} else {
+			*d++ = (char)(0xf0 | (wc >> 18));
+			*d++ = (char)(0x80 | ((wc >> 12) & 0x3f));
+			*d++ = (char)(0x80 | ((wc >> 6) & 0x3f));
+			*d++ = (char)(0x80 | (wc & 0x3f));
+		}
+	}
+
+	return d - dst;
+}
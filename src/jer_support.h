@@ -0,0 +1,75 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_JER_SUPPORT_H_
+#define	_JER_SUPPORT_H_
+
+#include <asn_system.h>		/* Platform-specific types */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Types of the JSON tokens.
+ */
+typedef enum {
+	JT_BROKEN,	/* Not a valid JSON token */
+	JT_MORE,	/* The token continues past the end of the buffer */
+	JT_OBJECT_START,	/* { */
+	JT_OBJECT_END,		/* } */
+	JT_ARRAY_START,		/* [ */
+	JT_ARRAY_END,		/* ] */
+	JT_COMMA,		/* , */
+	JT_COLON,		/* : */
+	JT_STRING,	/* "...", the (start, length) excludes the quotes */
+	JT_NUMBER,	/* -?int(.frac)?(e[+-]?exp)? */
+	JT_TRUE,	/* true */
+	JT_FALSE,	/* false */
+	JT_NULL		/* null */
+} jer_token_e;
+
+typedef struct jer_token_s {
+	jer_token_e type;
+	const char *start;	/* Token text, NOT '\0'-terminated */
+	size_t length;		/* Token text length */
+	int escaped;		/* JT_STRING contains backslash escapes */
+} jer_token_t;
+
+/*
+ * Fetch the next JSON token from the buffer. The tokenizer keeps no state
+ * and allocates no memory: the token refers to the input buffer.
+ * A number or a literal ending at the end of the buffer is deemed complete.
+ * RETURN VALUES:
+ * Number of bytes consumed, including the leading whitespace.
+ * The (tok->type) is set to JT_BROKEN or JT_MORE if nothing is consumed.
+ */
+size_t jer_next_token(const void *buf_ptr, size_t size, jer_token_t *tok);
+
+/*
+ * Delimit the complete JSON value (scalar, object or array) at the start
+ * of the buffer without decoding it.
+ * RETURN VALUES:
+ * >0:	Length of the value, including the leading whitespace
+ *  0:	The value is not complete yet
+ * -1:	The value is not valid JSON; the offset of the offending token
+ *	is placed in (*opt_broken) unless it is NULL
+ */
+ssize_t jer_value_length(const void *buf_ptr, size_t size,
+	size_t *opt_broken);
+
+/*
+ * Resolve the escape sequences of the JT_STRING token contents into UTF-8.
+ * The (dst) must have at least (size) bytes of space; the output is never
+ * longer than the input.
+ * RETURN VALUES:
+ * >=0:	Number of bytes written into (dst)
+ * -1:	Broken escape sequence
+ */
+ssize_t jer_unescape(const char *str, size_t size, char *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _JER_SUPPORT_H_ */
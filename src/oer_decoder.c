@@ -0,0 +1,166 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_application.h>
+#include <asn_internal.h>
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <NativeEnumerated.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <REAL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <BIT_STRING.h>
+#include <BMPString.h>
+#include <UniversalString.h>
+#include <OBJECT_IDENTIFIER.h>
+#include <RELATIVE-OID.h>
+#include <GeneralizedTime.h>
+#include <UTCTime.h>
+#include <ANY.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SEQUENCE_OF.h>
+#include <constr_SET_OF.h>
+
+/*
+ * The runtime's OER decoders matched by the XER encoder of the type.
+ * The XER encoder tells the enumerated types apart from the integers.
+ */
+static const struct {
+	xer_type_encoder_f *xer_encoder;
+	oer_type_decoder_f *oer_decoder;
+} oer_decoders[] = {
+	{ INTEGER_encode_xer,		INTEGER_decode_oer },
+	{ NativeInteger_encode_xer,	NativeInteger_decode_oer },
+	{ NativeEnumerated_encode_xer,	NativeEnumerated_decode_oer },
+	{ BOOLEAN_encode_xer,		BOOLEAN_decode_oer },
+	{ NULL_encode_xer,		NULL_decode_oer },
+	{ REAL_encode_xer,		oer_decode_primitive },
+	{ NativeReal_encode_xer,	NativeReal_decode_oer },
+	{ OCTET_STRING_encode_xer,	OCTET_STRING_decode_oer },
+	{ OCTET_STRING_encode_xer_utf8,	OCTET_STRING_decode_oer },
+	{ GeneralizedTime_encode_xer,	OCTET_STRING_decode_oer },
+	{ UTCTime_encode_xer,		OCTET_STRING_decode_oer },
+	{ ANY_encode_xer,		OCTET_STRING_decode_oer },
+	{ BIT_STRING_encode_xer,	BIT_STRING_decode_oer },
+	{ BMPString_encode_xer,		OCTET_STRING_decode_oer },
+	{ UniversalString_encode_xer,	OCTET_STRING_decode_oer },
+	{ OBJECT_IDENTIFIER_encode_xer,	oer_decode_primitive },
+	{ RELATIVE_OID_encode_xer,	oer_decode_primitive },
+	{ SEQUENCE_encode_xer,		SEQUENCE_decode_oer },
+	{ SET_encode_xer,		SET_decode_oer },
+	{ CHOICE_encode_xer,		CHOICE_decode_oer },
+	{ SEQUENCE_OF_encode_xer,	SEQUENCE_OF_decode_oer },
+	{ SET_OF_encode_xer,		SET_OF_decode_oer }
+};
+
+oer_type_decoder_f *
+oer_type_decoder(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	if(td->oer_decoder)
+		return td->oer_decoder;
+
+	do {
+		for(i = 0; i < sizeof(oer_decoders)/sizeof(oer_decoders[0]); i++) {
+			if(oer_decoders[i].xer_encoder == td->xer_encoder)
+				return oer_decoders[i].oer_decoder;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	return 0;
+}
+
+/*
+ * Decode the OER encoding of a given type.
+ */
+asn_dec_rval_t
+oer_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+		void **struct_ptr, const void *buffer, size_t size) {
+	asn_codec_ctx_t s_codec_ctx;
+	asn_mem_account_t account;
+	oer_type_decoder_f *decoder;
+	asn_dec_rval_t rval;
+	int allocated = (*struct_ptr == 0);
+
+	/*
+	 * Stack checker requires that the codec context
+	 * must be allocated on the stack.
+	 */
+	if(opt_codec_ctx) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
+			s_codec_ctx = *opt_codec_ctx;
+			opt_codec_ctx = &s_codec_ctx;
+		}
+	} else {
+		/* If context is not given, be security-conscious anyway */
+		memset(&s_codec_ctx, 0, sizeof(s_codec_ctx));
+		s_codec_ctx.max_stack_size = _ASN_DEFAULT_STACK_MAX;
+		opt_codec_ctx = &s_codec_ctx;
+	}
+
+	ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+
+	decoder = oer_type_decoder(td);
+	if(!decoder) {
+		ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_UNSUPPORTED, 0);
+		ASN_DEC_ERROR_END(opt_codec_ctx, td, RC_FAIL, -1);
+		rval.code = RC_FAIL;
+		rval.consumed = 0;
+		return rval;
+	}
+
+	/*
+	 * Invoke type-specific decoder.
+	 */
+	asn_mem__begin(&account, opt_codec_ctx, 0);
+	rval = decoder(opt_codec_ctx, td, 0, struct_ptr, buffer, size);
+	if(rval.code == RC_WMORE) {
+		/* The type decoders are not restartable */
+		if(allocated && *struct_ptr) {
+			td->free_struct(td, *struct_ptr, 0);
+			*struct_ptr = 0;
+		}
+		rval.consumed = 0;
+	}
+	asn_mem__end(&account);
+	ASN_DEC_ERROR_END(opt_codec_ctx, td, rval.code, -1);
+	return rval;
+}
+
+asn_dec_rval_t
+oer_open_type_get(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
+		asn_per_constraints_t *constraints,
+		void **struct_ptr, const void *buf_ptr, size_t size) {
+	oer_type_decoder_f *decoder = oer_type_decoder(td);
+	asn_dec_rval_t rv;
+	size_t len;
+	ssize_t skip;
+
+	if(!decoder) {
+		rv.code = RC_FAIL;
+		rv.consumed = 0;
+		return rv;
+	}
+
+	skip = oer_fetch_length(buf_ptr, size, &len);
+	if(skip <= 0 || size - skip < len) {
+		rv.code = skip < 0 ? RC_FAIL : RC_WMORE;
+		rv.consumed = 0;
+		return rv;
+	}
+
+	rv = decoder(opt_codec_ctx, td, constraints, struct_ptr,
+		(const char *)buf_ptr + skip, len);
+	if(rv.code == RC_OK && rv.consumed != len)
+		rv.code = RC_FAIL;	/* Garbage inside the wrapper */
+	else if(rv.code == RC_WMORE)
+		rv.code = RC_FAIL;	/* Truncated inside the wrapper */
+	if(rv.code == RC_OK)
+		rv.consumed += skip;
+	return rv;
+}
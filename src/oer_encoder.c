@@ -0,0 +1,184 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_internal.h>
+#include <errno.h>
+#include <INTEGER.h>
+#include <NativeInteger.h>
+#include <NativeEnumerated.h>
+#include <BOOLEAN.h>
+#include <NULL.h>
+#include <REAL.h>
+#include <NativeReal.h>
+#include <OCTET_STRING.h>
+#include <BIT_STRING.h>
+#include <BMPString.h>
+#include <UniversalString.h>
+#include <OBJECT_IDENTIFIER.h>
+#include <RELATIVE-OID.h>
+#include <GeneralizedTime.h>
+#include <UTCTime.h>
+#include <ANY.h>
+#include <constr_SEQUENCE.h>
+#include <constr_SET.h>
+#include <constr_CHOICE.h>
+#include <constr_SEQUENCE_OF.h>
+#include <constr_SET_OF.h>
+
+/*
+ * The runtime's OER encoders matched by the XER encoder of the type.
+ */
+static const struct {
+	xer_type_encoder_f *xer_encoder;
+	oer_type_encoder_f *oer_encoder;
+} oer_encoders[] = {
+	{ INTEGER_encode_xer,		INTEGER_encode_oer },
+	{ NativeInteger_encode_xer,	NativeInteger_encode_oer },
+	{ NativeEnumerated_encode_xer,	NativeEnumerated_encode_oer },
+	{ BOOLEAN_encode_xer,		BOOLEAN_encode_oer },
+	{ NULL_encode_xer,		NULL_encode_oer },
+	{ REAL_encode_xer,		REAL_encode_oer },
+	{ NativeReal_encode_xer,	NativeReal_encode_oer },
+	{ OCTET_STRING_encode_xer,	OCTET_STRING_encode_oer },
+	{ OCTET_STRING_encode_xer_utf8,	OCTET_STRING_encode_oer },
+	{ GeneralizedTime_encode_xer,	OCTET_STRING_encode_oer },
+	{ UTCTime_encode_xer,		OCTET_STRING_encode_oer },
+	{ ANY_encode_xer,		OCTET_STRING_encode_oer },
+	{ BIT_STRING_encode_xer,	BIT_STRING_encode_oer },
+	{ BMPString_encode_xer,		OCTET_STRING_encode_oer },
+	{ UniversalString_encode_xer,	OCTET_STRING_encode_oer },
+	{ OBJECT_IDENTIFIER_encode_xer,	oer_encode_primitive },
+	{ RELATIVE_OID_encode_xer,	oer_encode_primitive },
+	{ SEQUENCE_encode_xer,		SEQUENCE_encode_oer },
+	{ SET_encode_xer,		SET_encode_oer },
+	{ CHOICE_encode_xer,		CHOICE_encode_oer },
+	{ SEQUENCE_OF_encode_xer,	SEQUENCE_OF_encode_oer },
+	{ SET_OF_encode_xer,		SET_OF_encode_oer }
+};
+
+oer_type_encoder_f *
+oer_type_encoder(asn_TYPE_descriptor_t *td) {
+	size_t i;
+
+	if(td->oer_encoder)
+		return td->oer_encoder;
+
+	do {
+		for(i = 0; i < sizeof(oer_encoders)/sizeof(oer_encoders[0]); i++) {
+			if(oer_encoders[i].xer_encoder == td->xer_encoder)
+				return oer_encoders[i].oer_encoder;
+		}
+	} while(asn_TYPE_resolve(td));	/* Retry as the base type */
+
+	return 0;
+}
+
+/*
+ * The OER encoder of any type. May be invoked by the application.
+ */
+asn_enc_rval_t
+oer_encode(asn_TYPE_descriptor_t *td, void *sptr,
+	enum oer_encoder_flags_e oer_flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	oer_type_encoder_f *encoder;
+	asn_output_buffer_t ob;
+	asn_enc_rval_t er;
+
+	if(!td || !sptr || !cb) _ASN_ENCODE_FAILED;
+
+	encoder = oer_type_encoder(td);
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	/* Coalesce the small pieces as xer_encode() does */
+	asn_output_buffer_init(&ob, cb, app_key);
+	er = encoder(td, 0, sptr, oer_flags, asn_output_buffer_consume, &ob);
+	if(er.encoded == -1) {
+		(void)asn_output_buffer_flush(&ob);
+		return er;
+	}
+	if(asn_output_buffer_flush(&ob))
+		_ASN_ENCODE_FAILED;
+
+	return er;
+}
+
+/*
+ * Argument type and callback necessary for oer_encode_to_buffer().
+ */
+typedef struct enc_to_buf_arg {
+	void *buffer;
+	size_t left;
+} enc_to_buf_arg;
+static int encode_to_buffer_cb(const void *buffer, size_t size, void *key) {
+	enc_to_buf_arg *arg = (enc_to_buf_arg *)key;
+
+	if(arg->left < size)
+		return -1;	/* Data exceeds the available buffer size */
+
+	memcpy(arg->buffer, buffer, size);
+	arg->buffer = ((char *)arg->buffer) + size;
+	arg->left -= size;
+
+	return 0;
+}
+
+/*
+ * A variant of the oer_encode() which encodes the data into the provided buffer
+ */
+asn_enc_rval_t
+oer_encode_to_buffer(asn_TYPE_descriptor_t *td, void *sptr,
+	enum oer_encoder_flags_e oer_flags, void *buffer, size_t buffer_size) {
+	oer_type_encoder_f *encoder;
+	enc_to_buf_arg arg;
+	asn_enc_rval_t er;
+
+	if(!td || !sptr) _ASN_ENCODE_FAILED;
+
+	encoder = oer_type_encoder(td);
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	arg.buffer = buffer;
+	arg.left = buffer_size;
+
+	er = encoder(td, 0, sptr, oer_flags, encode_to_buffer_cb, &arg);
+	if(er.encoded != -1) {
+		assert(er.encoded == (ssize_t)(buffer_size - arg.left));
+		/* Return the encoded contents size */
+	}
+	return er;
+}
+
+static int
+oer__count_bytes(const void *buffer, size_t size, void *key) {
+	(void)buffer;
+	(void)size;
+	(void)key;
+	return 0;
+}
+
+asn_enc_rval_t
+oer_open_type_put(asn_TYPE_descriptor_t *td,
+		asn_per_constraints_t *constraints, void *sptr,
+		enum oer_encoder_flags_e oer_flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	oer_type_encoder_f *encoder = oer_type_encoder(td);
+	asn_enc_rval_t er;
+	ssize_t ret;
+
+	if(!encoder) _ASN_ENCODE_FAILED;
+
+	/* The length goes first, so measure the value beforehand */
+	er = encoder(td, constraints, sptr, oer_flags, oer__count_bytes, 0);
+	if(er.encoded == -1)
+		return er;
+
+	ret = oer_serialize_length(er.encoded, cb, app_key);
+	if(ret < 0) _ASN_ENCODE_FAILED;
+
+	er = encoder(td, constraints, sptr, oer_flags, cb, app_key);
+	if(er.encoded == -1)
+		return er;
+	er.encoded += ret;
+
+	return er;
+}
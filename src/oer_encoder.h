@@ -0,0 +1,83 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#ifndef	_OER_ENCODER_H_
+#define	_OER_ENCODER_H_
+
+#include <asn_application.h>
+#include <oer_support.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct asn_TYPE_descriptor_s;	/* Forward declaration */
+
+/* Flags used by the oer_encode() and (*oer_type_encoder_f), defined below */
+enum oer_encoder_flags_e {
+	/* Mode of encoding */
+	OER_F_BASIC	= 0x01,	/* BASIC-OER */
+	OER_F_CANONICAL	= 0x02	/* CANONICAL-OER, suitable for signing */
+};
+
+/*
+ * The Octet Encoding Rules (OER) encoder of any type.
+ * May be invoked by the application.
+ */
+asn_enc_rval_t oer_encode(struct asn_TYPE_descriptor_s *type_descriptor,
+		void *struct_ptr,	/* Structure to be encoded */
+		enum oer_encoder_flags_e oer_flags,
+		asn_app_consume_bytes_f *consume_bytes_cb,
+		void *app_key		/* Arbitrary callback argument */
+	);
+
+/*
+ * A variant of oer_encode() which encodes data into the pre-allocated buffer.
+ * Fails if the buffer is too small; asn_encode_to_buffer() tells the size.
+ */
+asn_enc_rval_t oer_encode_to_buffer(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		void *struct_ptr,	/* Structure to be encoded */
+		enum oer_encoder_flags_e oer_flags,
+		void *buffer,		/* Pre-allocated buffer */
+		size_t buffer_size	/* Initial buffer size (maximum) */
+	);
+
+/*
+ * Type of the generic OER encoder.
+ * The (constraints) of the member override those of the type.
+ */
+typedef asn_enc_rval_t (oer_type_encoder_f)(
+		struct asn_TYPE_descriptor_s *type_descriptor,
+		asn_per_constraints_t *constraints,
+		void *struct_ptr,	/* Structure to be encoded */
+		enum oer_encoder_flags_e oer_flags,
+		asn_app_consume_bytes_f *consume_bytes_cb,	/* Callback */
+		void *app_key		/* Arbitrary callback argument */
+	);
+
+/*******************************
+ * INTERNALLY USEFUL FUNCTIONS *
+ *******************************/
+
+/*
+ * Get the OER encoder of the type. Descriptors compiled without the OER
+ * slot are served by the runtime's encoder matching their XER encoder.
+ * Returns 0 if the type has no OER encoder.
+ */
+oer_type_encoder_f *oer_type_encoder(struct asn_TYPE_descriptor_s *td);
+
+/*
+ * Encode the value wrapped into the open type (length-prefixed),
+ * as used for the extension additions.
+ */
+asn_enc_rval_t oer_open_type_put(struct asn_TYPE_descriptor_s *td,
+	asn_per_constraints_t *constraints, void *struct_ptr,
+	enum oer_encoder_flags_e oer_flags,
+	asn_app_consume_bytes_f *cb, void *app_key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _OER_ENCODER_H_ */
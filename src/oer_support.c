@@ -0,0 +1,310 @@
+/*-
+ * Redistribution and modifications are permitted subject to BSD license.
+ */
+#include <asn_system.h>
+#include <asn_internal.h>
+#include <oer_support.h>
+#include <limits.h>	/* for LONG_MAX */
+
+ssize_t
+oer_fetch_length(const void *bufptr, size_t size, size_t *len_r) {
+	const uint8_t *buf = (const uint8_t *)bufptr;
+	size_t len = 0;
+	size_t n, i;
+
+	if(size == 0)
+		return 0;	/* Want more */
+
+	if(!(buf[0] & 0x80)) {
+		*len_r = buf[0];
+		return 1;
+	}
+
+	n = buf[0] & 0x7f;
+	if(n == 0)
+		return -1;	/* Reserved */
+	if(size < 1 + n)
+		return 0;	/* Want more */
+
+	for(i = 1; i <= n; i++) {
+		if(len >> (8 * sizeof(len) - 8))
+			return -1;	/* Too large for this platform */
+		len = (len << 8) | buf[i];
+	}
+	if((ssize_t)len < 0)
+		return -1;
+
+	*len_r = len;
+	return 1 + n;
+}
+
+ssize_t
+oer_serialize_length(size_t length,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	uint8_t scratch[1 + sizeof(length)];
+	uint8_t *p = scratch + sizeof(scratch);
+	size_t n;
+
+	if(length < 128) {
+		scratch[0] = (uint8_t)length;
+		return cb(scratch, 1, app_key) < 0 ? -1 : 1;
+	}
+
+	for(n = 0; length; n++, length >>= 8)
+		*--p = (uint8_t)length;
+	*--p = (uint8_t)(0x80 | n);
+
+	if(cb(p, n + 1, app_key) < 0)
+		return -1;
+	return n + 1;
+}
+
+ssize_t
+oer_fetch_tag(const void *bufptr, size_t size, ber_tlv_tag_t *tag_r) {
+	const uint8_t *buf = (const uint8_t *)bufptr;
+	ber_tlv_tag_t tclass;
+	ber_tlv_tag_t val = 0;
+	size_t i;
+
+	if(size == 0)
+		return 0;
+
+	tclass = buf[0] >> 6;
+	if((buf[0] & 0x3f) != 0x3f) {
+		*tag_r = ((buf[0] & 0x3f) << 2) | tclass;
+		return 1;
+	}
+
+	/* The long form of the tag number */
+	for(i = 1; i < size; i++) {
+		if(i == 1 && buf[i] == 0x80)
+			return -1;	/* Leading zero bits */
+		if(val >> (8 * sizeof(val) - 2 - 7))
+			return -1;	/* Too large for ber_tlv_tag_t */
+		val = (val << 7) | (buf[i] & 0x7f);
+		if(!(buf[i] & 0x80)) {
+			if(val < 63)
+				return -1;	/* Should be the short form */
+			*tag_r = (val << 2) | tclass;
+			return i + 1;
+		}
+	}
+
+	return 0;	/* Want more */
+}
+
+ssize_t
+oer_serialize_tag(ber_tlv_tag_t tag,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	ber_tlv_tag_t tval = BER_TAG_VALUE(tag);
+	uint8_t scratch[1 + (8 * sizeof(tag) + 6) / 7];
+	uint8_t *p = scratch + sizeof(scratch);
+	uint8_t cont = 0;
+	size_t n;
+
+	if(tval < 63) {
+		scratch[0] = (uint8_t)((BER_TAG_CLASS(tag) << 6) | tval);
+		return cb(scratch, 1, app_key) < 0 ? -1 : 1;
+	}
+
+	for(; tval; tval >>= 7, cont = 0x80)
+		*--p = (uint8_t)(cont | (tval & 0x7f));
+	*--p = (uint8_t)((BER_TAG_CLASS(tag) << 6) | 0x3f);
+
+	n = (scratch + sizeof(scratch)) - p;
+	if(cb(p, n, app_key) < 0)
+		return -1;
+	return n;
+}
+
+int
+oer_integer_width(const asn_per_constraint_t *ct, int *is_unsigned) {
+	*is_unsigned = 0;
+
+	if(!ct || (ct->flags & APC_EXTENSIBLE))
+		return 0;
+
+	switch(ct->flags) {
+	case APC_SEMI_CONSTRAINED:
+		*is_unsigned = (ct->lower_bound >= 0);
+		return 0;
+	case APC_CONSTRAINED:
+		break;
+	default:
+		return 0;
+	}
+
+	if(ct->lower_bound >= 0) {
+		unsigned long ub = ct->upper_bound;
+		*is_unsigned = 1;
+		if(ub <= 0xffUL) return 1;
+		if(ub <= 0xffffUL) return 2;
+		if(ub <= 0xffffffffUL) return 4;
+		return sizeof(long) >= 8 ? 8 : 0;
+	} else {
+		long lb = ct->lower_bound;
+		long ub = ct->upper_bound;
+		if(lb >= -128 && ub <= 127) return 1;
+		if(lb >= -32768 && ub <= 32767) return 2;
+		if(lb >= -2147483647L - 1 && ub <= 2147483647L) return 4;
+		return sizeof(long) >= 8 ? 8 : 0;
+	}
+}
+
+/*
+ * Convert the (len) octets of the two's complement or unsigned number.
+ */
+static int
+oer__octets2long(const uint8_t *buf, size_t len, int is_unsigned,
+		long *value_r) {
+	unsigned long value;
+	size_t i;
+
+	if(len == 0)
+		return -1;	/* At least one octet */
+
+	/* Strip the redundant sign octets */
+	for(i = 0; i < len - 1; i++) {
+		if(buf[i] == 0x00 && (is_unsigned || !(buf[i+1] & 0x80)))
+			continue;
+		if(buf[i] == 0xff && !is_unsigned && (buf[i+1] & 0x80))
+			continue;
+		break;
+	}
+	if(len - i > sizeof(value))
+		return -1;
+
+	value = (!is_unsigned && (buf[i] & 0x80)) ? ~0UL : 0;
+	for(; i < len; i++)
+		value = (value << 8) | buf[i];
+
+	if(is_unsigned && value > (unsigned long)LONG_MAX)
+		return -1;	/* Does not fit the signed long */
+
+	*value_r = (long)value;
+	return 0;
+}
+
+/*
+ * Put the minimal octets of the (value) right before the (end),
+ * returning the pointer to the first one.
+ */
+static uint8_t *
+oer__long2octets(long value, int is_unsigned, uint8_t *end) {
+	unsigned long uv = value;
+	uint8_t *p = end;
+
+	do {
+		*--p = (uint8_t)uv;
+		uv = (unsigned long)((long)uv >> 8);
+	} while(uv != 0 && uv != ~0UL);
+	if(!is_unsigned) {
+		if(value >= 0 && (*p & 0x80)) *--p = 0x00;
+		if(value < 0 && !(*p & 0x80)) *--p = 0xff;
+	}
+
+	return p;
+}
+
+ssize_t
+oer_fetch_long(const void *bufptr, size_t size,
+		int width, int is_unsigned, long *value_r) {
+	const uint8_t *buf = (const uint8_t *)bufptr;
+	ssize_t skip = 0;
+	size_t len;
+
+	if(width) {
+		len = width;
+	} else {
+		skip = oer_fetch_length(buf, size, &len);
+		if(skip <= 0) return skip;
+	}
+	if(size - skip < len)
+		return 0;
+
+	if(oer__octets2long(buf + skip, len, is_unsigned, value_r))
+		return -1;
+	return skip + len;
+}
+
+ssize_t
+oer_serialize_long(long value, int width, int is_unsigned,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	uint8_t scratch[2 + sizeof(value)];
+	uint8_t *end = scratch + sizeof(scratch);
+	uint8_t *p = end;
+
+	if(is_unsigned && value < 0)
+		return -1;
+
+	if(width) {
+		unsigned long uv = value;
+		int n;
+		if(width > (int)sizeof(value))
+			return -1;
+		for(n = 0; n < width; n++, uv >>= 8)
+			*--p = (uint8_t)uv;
+		return cb(p, width, app_key) < 0 ? -1 : width;
+	}
+
+	/* Minimal number of octets (X.696 #10.3, #10.4) */
+	p = oer__long2octets(value, is_unsigned, end);
+	p[-1] = (uint8_t)(end - p);	/* Length determinant */
+	p--;
+	if(cb(p, end - p, app_key) < 0)
+		return -1;
+	return end - p;
+}
+
+ssize_t
+oer_fetch_enumerated(const void *bufptr, size_t size, long *value_r) {
+	const uint8_t *buf = (const uint8_t *)bufptr;
+	size_t len;
+
+	if(size == 0)
+		return 0;
+
+	if(!(buf[0] & 0x80)) {
+		*value_r = buf[0];
+		return 1;
+	}
+
+	len = buf[0] & 0x7f;
+	if(size - 1 < len)
+		return 0;
+	if(oer__octets2long(buf + 1, len, 0, value_r))
+		return -1;
+	return 1 + len;
+}
+
+ssize_t
+oer_serialize_enumerated(long value,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	uint8_t scratch[2 + sizeof(value)];
+	uint8_t *end = scratch + sizeof(scratch);
+	uint8_t *p;
+
+	if(value >= 0 && value <= 127) {
+		scratch[0] = (uint8_t)value;
+		return cb(scratch, 1, app_key) < 0 ? -1 : 1;
+	}
+
+	p = oer__long2octets(value, 0, end);
+	p[-1] = (uint8_t)(0x80 | (end - p));
+	p--;
+	if(cb(p, end - p, app_key) < 0)
+		return -1;
+	return end - p;
+}
+
+ssize_t
+oer_open_type_skip(const void *bufptr, size_t size) {
+	size_t len;
+	ssize_t skip;
+
+	skip = oer_fetch_length(bufptr, size, &len);
+	if(skip <= 0) return skip;
+	if(size - skip < len)
+		return 0;
+	return skip + len;
+}
@@ -5,6 +5,7 @@
 asn_dec_rval_t
 uper_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td, void **sptr, const void *buffer, size_t size, int skip_bits, int unused_bits) {
 	asn_codec_ctx_t s_codec_ctx;
+	asn_mem_account_t account;
 	asn_dec_rval_t rval;
 	asn_per_data_t pd;
 
@@ -18,7 +19,8 @@ uper_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td, void **sp
 	 * must be allocated on the stack.
 	 */
 	if(opt_codec_ctx) {
-		if(opt_codec_ctx->max_stack_size) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
 			s_codec_ctx = *opt_codec_ctx;
 			opt_codec_ctx = &s_codec_ctx;
 		}
@@ -39,17 +41,83 @@ uper_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td, void **sp
 	/*
 	 * Invoke type-specific decoder.
 	 */
-	if(!td->uper_decoder)
-		_ASN_DECODE_FAILED;	/* PER is not compiled in */
-	rval = td->uper_decoder(opt_codec_ctx, td, 0, sptr, &pd);
-	if(rval.code == RC_OK) {
-		/* Return the number of consumed bits */
-		rval.consumed = ((pd.buffer - (const uint8_t *)buffer) << 3)
-					+ pd.nboff - skip_bits;
-	} else {
+	ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+	if(!td->uper_decoder) {
+		/* PER is not compiled in */
+		ASN_DEC_ERROR(opt_codec_ctx, td, ASN_DEC_ERROR_UNSUPPORTED, 0);
+		ASN_DEC_ERROR_END(opt_codec_ctx, td, RC_FAIL, -1);
+		_ASN_DECODE_FAILED;
+	}
+	asn_mem__begin(&account, opt_codec_ctx, 0);
+	rval = ASN_CODEC(td, uper_decoder)(opt_codec_ctx, td, 0, sptr, &pd);
+	asn_mem__end(&account);
+	/* The number of consumed bits, or where the decoder has stopped */
+	rval.consumed = ((pd.buffer - (const uint8_t *)buffer) << 3)
+				+ pd.nboff - skip_bits;
+	ASN_DEC_ERROR_END(opt_codec_ctx, td, rval.code, (long)rval.consumed);
+	if(rval.code != RC_OK) {
 		/* PER codec is not a restartable */
 		rval.consumed = 0;
 	}
 	return rval;
 }
 
+
+size_t
+uper_decode_batch(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td, asn_dec_batch_item_t *items, size_t count) {
+	asn_codec_ctx_t s_codec_ctx;
+	per_type_decoder_f *decoder = ASN_CODEC(td, uper_decoder);
+	size_t decoded = 0;
+	size_t i;
+
+	/* The same stack base serves all the items */
+	if(opt_codec_ctx) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
+			s_codec_ctx = *opt_codec_ctx;
+			opt_codec_ctx = &s_codec_ctx;
+		}
+	} else {
+		memset(&s_codec_ctx, 0, sizeof(s_codec_ctx));
+		s_codec_ctx.max_stack_size = _ASN_DEFAULT_STACK_MAX;
+		opt_codec_ctx = &s_codec_ctx;
+	}
+
+	for(i = 0; i < count; i++) {
+		asn_dec_batch_item_t *item = &items[i];
+		asn_mem_account_t account;	/* Budget is per item */
+		asn_per_data_t pd;
+
+		if(!decoder) {
+			/* PER is not compiled in */
+			item->result.code = RC_FAIL;
+			item->result.consumed = 0;
+			continue;
+		}
+
+		/* The structure of the previous batch is decoded into */
+		asn_copy__recycle(td, &item->structure);
+
+		pd.buffer = (const uint8_t *)item->buffer;
+		pd.nboff = 0;
+		pd.nbits = 8 * item->size;
+
+		ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+		asn_mem__begin(&account, opt_codec_ctx, 0);
+		item->result = decoder(opt_codec_ctx, td, 0,
+			&item->structure, &pd);
+		item->result.consumed = ((pd.buffer
+			- (const uint8_t *)item->buffer) << 3) + pd.nboff;
+		ASN_DEC_ERROR_END(opt_codec_ctx, td, item->result.code,
+			(long)item->result.consumed);
+		if(item->result.code == RC_OK) {
+			decoded++;
+		} else {
+			item->result.consumed = 0;
+			asn_copy__recycle(td, &item->structure);
+		}
+		asn_mem__end(&account);
+	}
+
+	return decoded;
+}
@@ -23,7 +23,7 @@ uper_encode(asn_TYPE_descriptor_t *td, void *sptr, asn_app_consume_bytes_f *cb,
 	po.op_key = app_key;
 	po.flushed_bytes = 0;
 
-	er = td->uper_encoder(td, 0, sptr, &po);
+	er = ASN_CODEC(td, uper_encoder)(td, 0, sptr, &po);
 	if(er.encoded != -1) {
 		size_t bits_to_flush;
 
@@ -14,13 +14,16 @@ asn_dec_rval_t
 xer_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 		void **struct_ptr, const void *buffer, size_t size) {
 	asn_codec_ctx_t s_codec_ctx;
+	asn_mem_account_t account;
+	asn_dec_rval_t rval;
 
 	/*
 	 * Stack checker requires that the codec context
 	 * must be allocated on the stack.
 	 */
 	if(opt_codec_ctx) {
-		if(opt_codec_ctx->max_stack_size) {
+		if(opt_codec_ctx->max_stack_size
+		&& !ASN_DEC_OPTS(opt_codec_ctx)) {
 			s_codec_ctx = *opt_codec_ctx;
 			opt_codec_ctx = &s_codec_ctx;
 		}
@@ -34,7 +37,14 @@ xer_decode(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td,
 	/*
 	 * Invoke type-specific decoder.
 	 */
-	return td->xer_decoder(opt_codec_ctx, td, struct_ptr, 0, buffer, size);
+	ASN_DEC_ERROR_BEGIN(opt_codec_ctx);
+	asn_mem__begin(&account, opt_codec_ctx, 0);
+	rval = ASN_CODEC(td, xer_decoder)(opt_codec_ctx, td, struct_ptr, 0,
+		buffer, size);
+	asn_mem__end(&account);
+	ASN_DEC_ERROR_END(opt_codec_ctx, td, rval.code, -1);
+
+	return rval;
 }
 
 
@@ -161,6 +171,193 @@ xer_check_tag(const void *buf_ptr, int size, const char *need_tag) {
 }
 
 
+/*
+ * Open addressing hash of the member names, followed by the pre-formatted
+ * member tags used by the XER encoders.
+ */
+struct asn_xer_member_index_s {
+	xer_member_tags_t *tags;	/* One per member */
+	unsigned int mask;	/* Number of slots - 1 */
+	int slot[1];		/* Member index + 1, or 0 if empty */
+};
+
+/* FNV-1a */
+static unsigned int
+_xer_name_hash(const char *name, size_t len) {
+	unsigned int h = 2166136261U;
+	for(; len; len--, name++)
+		h = (h ^ (unsigned char)*name) * 16777619U;
+	return h;
+}
+
+static struct asn_xer_member_index_s *
+_xer_member_index_build(asn_TYPE_descriptor_t *td) {
+	struct asn_xer_member_index_s *idx;
+	size_t tags_off;
+	size_t size;
+	char *p;
+	unsigned int slots;
+	int edx;
+
+	/* Keep the load factor under 1/2 */
+	for(slots = 8; slots < 2 * (unsigned)td->elements_count; slots <<= 1);
+
+	/* Everything goes into a single allocation */
+	tags_off = sizeof(*idx) + (slots - 1) * sizeof(idx->slot[0]);
+	tags_off = (tags_off + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+	size = tags_off + td->elements_count * sizeof(xer_member_tags_t);
+	for(edx = 0; edx < td->elements_count; edx++) {
+		const char *name = td->elements[edx].name;
+		size += 5 + 2 * (name ? strlen(name) : 0) + 2;
+	}
+
+	idx = (struct asn_xer_member_index_s *)CALLOC(1, size);
+	if(!idx) return 0;
+	idx->mask = slots - 1;
+	idx->tags = (xer_member_tags_t *)((char *)idx + tags_off);
+	p = (char *)(idx->tags + td->elements_count);
+
+	for(edx = 0; edx < td->elements_count; edx++) {
+		xer_member_tags_t *tags = &idx->tags[edx];
+		const char *name = td->elements[edx].name;
+		size_t len;
+		unsigned int h;
+
+		if(!name) name = "";
+		len = strlen(name);
+
+		/* "<name>" */
+		tags->name_len = len;
+		tags->open = p;
+		*p++ = '<';
+		memcpy(p, name, len); p += len;
+		*p++ = '>';
+		*p++ = '\0';
+		/* "</name>" */
+		tags->close = p;
+		*p++ = '<';
+		*p++ = '/';
+		memcpy(p, name, len); p += len;
+		*p++ = '>';
+		*p++ = '\0';
+
+		if(!len) continue;	/* Never matches */
+		h = _xer_name_hash(name, len);
+		while(idx->slot[h & idx->mask]) h++;
+		idx->slot[h & idx->mask] = edx + 1;
+	}
+
+	return idx;
+}
+
+/*
+ * Get the type's member index, building and publishing it on first use.
+ */
+static struct asn_xer_member_index_s *
+_xer_member_index(struct asn_xer_member_index_s **index,
+		asn_TYPE_descriptor_t *td) {
+	struct asn_xer_member_index_s *idx = 0;
+
+#ifdef	ASN_ATOMIC_CAS_PTR
+	if(index) {
+		idx = (struct asn_xer_member_index_s *)
+			ASN_ATOMIC_LOAD_PTR(index);
+		if(!idx) {
+			idx = _xer_member_index_build(td);
+			if(idx && !ASN_ATOMIC_CAS_PTR(index,
+					(struct asn_xer_member_index_s *)0,
+					idx)) {
+				/* Another thread has published one */
+				FREEMEM(idx);
+				idx = (struct asn_xer_member_index_s *)
+					ASN_ATOMIC_LOAD_PTR(index);
+			}
+		}
+	}
+#else	/* !ASN_ATOMIC_CAS_PTR */
+	(void)index;
+	(void)td;
+#endif	/* ASN_ATOMIC_CAS_PTR */
+
+	return idx;
+}
+
+const xer_member_tags_t *
+xer_member_tags(struct asn_xer_member_index_s **index,
+		asn_TYPE_descriptor_t *td, int edx) {
+	struct asn_xer_member_index_s *idx = _xer_member_index(index, td);
+	if(idx && edx >= 0 && edx < td->elements_count)
+		return &idx->tags[edx];
+	return 0;
+}
+
+int
+xer_find_member(struct asn_xer_member_index_s **index,
+		asn_TYPE_descriptor_t *td, const void *buf_ptr, int size) {
+	const char *name = (const char *)buf_ptr;
+	const char *end;
+	size_t len;
+
+	/*
+	 * Isolate the tag name the same way xer_check_tag() does.
+	 */
+	if(size < 2 || name[0] != LANGLE || name[size-1] != RANGLE)
+		return -1;
+	if(name[1] == CSLASH) {
+		name += 2;
+		size -= 3;
+	} else {
+		name++;
+		size -= 2;
+		if(size > 0 && name[size-1] == CSLASH)
+			size--;
+	}
+	for(end = name; end < name + size; end++) {
+		switch(*end) {
+		case 0x09: case 0x0a: case 0x0c: case 0x0d: case 0x20:
+			break;
+		case 0:
+			return -1;	/* Embedded 0 in buf?! */
+		default:
+			continue;
+		}
+		break;
+	}
+	len = end - name;
+	if(!len) return -1;
+
+	return xer_find_member_name(index, td, name, len);
+}
+
+int
+xer_find_member_name(struct asn_xer_member_index_s **index,
+		asn_TYPE_descriptor_t *td, const char *name, size_t len) {
+	struct asn_xer_member_index_s *idx;
+	int edx;
+
+	idx = _xer_member_index(index, td);
+
+	if(idx) {
+		unsigned int h = _xer_name_hash(name, len);
+		for(; (edx = idx->slot[h & idx->mask]); h++) {
+			const char *mname = td->elements[edx - 1].name;
+			if(strncmp(mname, name, len) == 0 && mname[len] == 0)
+				return edx - 1;
+		}
+	} else {
+		/* No table: fall back to the linear search */
+		for(edx = 0; edx < td->elements_count; edx++) {
+			const char *mname = td->elements[edx].name;
+			if(mname && strncmp(mname, name, len) == 0
+			&& mname[len] == 0)
+				return edx;
+		}
+	}
+
+	return -1;
+}
+
+
 #undef	ADVANCE
 #define	ADVANCE(num_bytes)	do {				\
 		size_t num = (num_bytes);			\
@@ -86,6 +86,22 @@ ssize_t xer_next_token(int *stateContext,
 xer_check_tag_e xer_check_tag(const void *buf_ptr, int size,
 		const char *need_tag);
 
+/*
+ * Find the member of the constructed type (SEQUENCE, SET, CHOICE) whose
+ * name matches the given XML tag, in constant time. The name lookup table
+ * is built from td->elements on the first use and published via (*index),
+ * normally a member of the type's specifics.
+ * RETURN VALUES:
+ * >=0:	Index of the matching member
+ * -1:	No member has this name
+ */
+struct asn_xer_member_index_s;	/* Opaque */
+int xer_find_member(struct asn_xer_member_index_s **index,
+	struct asn_TYPE_descriptor_s *td, const void *buf_ptr, int size);
+/* Same, but for the bare member name (not '\0'-terminated) */
+int xer_find_member_name(struct asn_xer_member_index_s **index,
+	struct asn_TYPE_descriptor_s *td, const char *name, size_t len);
+
 /*
  * Check whether this buffer consists of entirely XER whitespace characters.
  * RETURN VALUES:
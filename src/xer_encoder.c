@@ -6,11 +6,8 @@
 #include <stdio.h>
 #include <errno.h>
 
-/*
- * The XER encoder of any type. May be invoked by the application.
- */
-asn_enc_rval_t
-xer_encode(asn_TYPE_descriptor_t *td, void *sptr,
+static asn_enc_rval_t
+xer__encode(asn_TYPE_descriptor_t *td, void *sptr,
 	enum xer_encoder_flags_e xer_flags,
 		asn_app_consume_bytes_f *cb, void *app_key) {
 	asn_enc_rval_t er, tmper;
@@ -18,14 +15,12 @@ xer_encode(asn_TYPE_descriptor_t *td, void *sptr,
 	size_t mlen;
 	int xcan = (xer_flags & XER_F_CANONICAL) ? 1 : 2;
 
-	if(!td || !sptr) goto cb_failed;
-
 	mname = td->xml_tag;
 	mlen = strlen(mname);
 
 	_ASN_CALLBACK3("<", 1, mname, mlen, ">", 1);
 
-	tmper = td->xer_encoder(td, sptr, 1, xer_flags, cb, app_key);
+	tmper = ASN_CODEC(td, xer_encoder)(td, sptr, 1, xer_flags, cb, app_key);
 	if(tmper.encoded == -1) return tmper;
 
 	_ASN_CALLBACK3("</", 2, mname, mlen, ">\n", xcan);
@@ -37,6 +32,81 @@ cb_failed:
 	_ASN_ENCODE_FAILED;
 }
 
+/*
+ * The XER encoder of any type. May be invoked by the application.
+ */
+asn_enc_rval_t
+xer_encode(asn_TYPE_descriptor_t *td, void *sptr,
+	enum xer_encoder_flags_e xer_flags,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	asn_output_buffer_t ob;
+	asn_enc_rval_t er;
+
+	if(!td || !sptr) _ASN_ENCODE_FAILED;
+
+	/*
+	 * The type encoders emit the output in pieces of a few bytes;
+	 * collect them into larger chunks for the application.
+	 */
+	asn_output_buffer_init(&ob, cb, app_key);
+	er = xer__encode(td, sptr, xer_flags, asn_output_buffer_consume, &ob);
+	if(asn_output_buffer_flush(&ob) == -1 && er.encoded != -1)
+		_ASN_ENCODE_FAILED;
+
+	return er;
+}
+
+void
+asn_output_buffer_init(asn_output_buffer_t *ob,
+		asn_app_consume_bytes_f *cb, void *app_key) {
+	ob->cb = cb;
+	ob->app_key = app_key;
+	ob->fill = 0;
+	ob->failed = 0;
+}
+
+int
+asn_output_buffer_flush(asn_output_buffer_t *ob) {
+	if(ob->failed)
+		return -1;
+	if(ob->fill) {
+		if(ob->cb(ob->buf, ob->fill, ob->app_key) < 0) {
+			ob->failed = 1;
+			return -1;
+		}
+		ob->fill = 0;
+	}
+	return 0;
+}
+
+int
+asn_output_buffer_consume(const void *buffer, size_t size, void *key) {
+	asn_output_buffer_t *ob = (asn_output_buffer_t *)key;
+
+	if(ob->failed)
+		return -1;
+
+	if(size <= sizeof(ob->buf) - ob->fill) {
+		memcpy(ob->buf + ob->fill, buffer, size);
+		ob->fill += size;
+		return 0;
+	}
+
+	if(asn_output_buffer_flush(ob))
+		return -1;
+
+	if(size < sizeof(ob->buf)) {
+		memcpy(ob->buf, buffer, size);
+		ob->fill = size;
+	} else if(ob->cb(buffer, size, ob->app_key) < 0) {
+		/* Large chunks are passed through as is */
+		ob->failed = 1;
+		return -1;
+	}
+
+	return 0;
+}
+
 /*
  * This is a helper function for xer_fprint, which directs all incoming data
  * into the provided file descriptor.
@@ -76,6 +76,21 @@ _charclass[256] = {
 		state = ns;					\
 	} while(0)
 
+/*
+ * Advance to the next (ch) within the buffer, using memchr(3),
+ * which is vectorized by the libc, over the long uninteresting runs.
+ * If there is none, consume the whole rest of the buffer.
+ */
+#define	SKIP_TO(ch)	do {					\
+		const char *_q = (const char *)memchr(p + 1, (ch),	\
+					end - (p + 1));		\
+		if(!_q) {					\
+			p = end - 1;				\
+			goto next_byte;				\
+		}						\
+		p = _q;						\
+	} while(0)
+
 #define TOKEN_CB(_type, _ns, _current_too)			\
 	TOKEN_CB_CALL(_type, _ns, _current_too, 0)
 
@@ -99,9 +114,12 @@ ssize_t pxml_parse(int *stateContext, const void *xmlbuf, size_t size, pxml_call
 		 * Initial state: we're in the middle of some text,
 		 * or just have started.
 		 */
-		if (C == LANGLE) 
-			/* We're now in the tag, probably */
-			TOKEN_CB(PXML_TEXT, ST_TAG_START, 0);
+		if (C != LANGLE) {
+			/* Skip the rest of the text run at once */
+			SKIP_TO(LANGLE);
+		}
+		/* We're now in the tag, probably */
+		TOKEN_CB(PXML_TEXT, ST_TAG_START, 0);
 		break;
 	  case ST_TAG_START:
 		if (ALPHA(C) || (C == CSLASH))
@@ -155,10 +173,10 @@ ssize_t pxml_parse(int *stateContext, const void *xmlbuf, size_t size, pxml_call
 		/*
 		 * Tag attribute's string value in quotes.
 		 */
-		if(C == CQUOTE) {
-			/* Return back to the tag state */
-			state = ST_TAG_BODY;
-		}
+		if(C != CQUOTE)
+			SKIP_TO(CQUOTE);
+		/* Return back to the tag state */
+		state = ST_TAG_BODY;
 		break;
 	  case ST_TAG_UNQUOTED_STRING:
 		if(C == RANGLE) {
@@ -187,9 +205,9 @@ ssize_t pxml_parse(int *stateContext, const void *xmlbuf, size_t size, pxml_call
 		}
 		break;
 	  case ST_COMMENT:
-		if(C == CDASH) {
-			state = ST_COMMENT_CLO_DASH2;
-		}
+		if(C != CDASH)
+			SKIP_TO(CDASH);
+		state = ST_COMMENT_CLO_DASH2;
 		break;
 	  case ST_COMMENT_CLO_DASH2:
 		if(C == CDASH) {
@@ -209,6 +227,7 @@ ssize_t pxml_parse(int *stateContext, const void *xmlbuf, size_t size, pxml_call
 		}
 		break;
 	  } /* switch(*ptr) */
+	next_byte: ;
 	} /* for() */
 
 	/*